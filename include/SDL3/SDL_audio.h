@@ -1388,6 +1388,139 @@ extern DECLSPEC int SDLCALL SDL_LoadWAV_RW(SDL_RWops * src, SDL_bool freesrc,
 extern DECLSPEC int SDLCALL SDL_LoadWAV(const char *path, SDL_AudioSpec * spec,
                                         Uint8 ** audio_buf, Uint32 * audio_len);
 
+/**
+ * A WAVE file being decoded a piece at a time.
+ *
+ * \since This struct is available since SDL 3.0.0.
+ *
+ * \sa SDL_OpenWAVReader
+ * \sa SDL_ReadWAVFrames
+ */
+typedef struct SDL_WAVReader SDL_WAVReader;
+
+/**
+ * Open a WAVE file for decoding a piece at a time.
+ *
+ * Unlike SDL_LoadWAV_RW(), this only reads the headers of the file. The audio
+ * data is read and decoded as SDL_ReadWAVFrames() asks for it, a block at a
+ * time, so memory use doesn't depend on the length of the file. This reader
+ * supports the same formats, and honors the same hints, as SDL_LoadWAV_RW().
+ *
+ * The stream must stay valid, and must not be used by anything else, until
+ * the reader is closed.
+ *
+ * \param src The data source for the WAVE data
+ * \param freesrc If SDL_TRUE, calls SDL_RWclose() on `src` when the reader is
+ *                closed, or before returning if this function fails
+ * \param spec A pointer to an SDL_AudioSpec that will be set to the format of
+ *             the decoded data
+ * \returns a new reader, or NULL on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CloseWAVReader
+ * \sa SDL_ReadWAVFrames
+ * \sa SDL_SeekWAVFrame
+ */
+extern DECLSPEC SDL_WAVReader *SDLCALL SDL_OpenWAVReader(SDL_RWops *src, SDL_bool freesrc, SDL_AudioSpec *spec);
+
+/**
+ * Get the number of sample frames in a WAVE file.
+ *
+ * This is worked out from the headers, so if the file is truncated, fewer
+ * frames may actually be decoded.
+ *
+ * \param reader the reader to query
+ * \returns the number of sample frames, or a negative error code on failure;
+ *          call SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread, but not
+ *               on the same reader at the same time.
+ *
+ * \since This function is available since SDL 3.0.0.
+ */
+extern DECLSPEC Sint64 SDLCALL SDL_GetWAVFrameCount(SDL_WAVReader *reader);
+
+/**
+ * Decode sample frames from a WAVE file into an audio stream.
+ *
+ * Up to `frames` sample frames are decoded, starting at the current position
+ * of the reader, and put into `stream` with SDL_PutAudioStreamData(). The
+ * input format of the stream must be the one reported by
+ * SDL_OpenWAVReader().
+ *
+ * \param reader the reader to decode from
+ * \param stream the audio stream to put the decoded data into
+ * \param frames the maximum number of sample frames to decode
+ * \returns the number of sample frames decoded, 0 at the end of the file, or
+ *          a negative error code on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread, but not
+ *               on the same reader at the same time.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_SeekWAVFrame
+ */
+extern DECLSPEC int SDLCALL SDL_ReadWAVFrames(SDL_WAVReader *reader, SDL_AudioStream *stream, int frames);
+
+/**
+ * Set the sample frame that the next call to SDL_ReadWAVFrames() starts at.
+ *
+ * Compressed formats are decoded from the start of the block that contains
+ * the frame, so seeking is cheap for all formats.
+ *
+ * \param reader the reader to seek
+ * \param frame the sample frame to seek to, past the end is clamped to the end
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread, but not
+ *               on the same reader at the same time.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_TellWAVFrame
+ */
+extern DECLSPEC int SDLCALL SDL_SeekWAVFrame(SDL_WAVReader *reader, Sint64 frame);
+
+/**
+ * Get the sample frame that the next call to SDL_ReadWAVFrames() starts at.
+ *
+ * \param reader the reader to query
+ * \returns the current sample frame, or a negative error code on failure;
+ *          call SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread, but not
+ *               on the same reader at the same time.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_SeekWAVFrame
+ */
+extern DECLSPEC Sint64 SDLCALL SDL_TellWAVFrame(SDL_WAVReader *reader);
+
+/**
+ * Close a WAVE reader.
+ *
+ * If the reader was opened with `freesrc` set, its stream is closed too.
+ * Otherwise the stream is left positioned after the end of the WAVE file, as
+ * SDL_LoadWAV_RW() does.
+ *
+ * \param reader the reader to close
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_OpenWAVReader
+ */
+extern DECLSPEC void SDLCALL SDL_CloseWAVReader(SDL_WAVReader *reader);
+
 
 
 #define SDL_MIX_MAXVOLUME 128
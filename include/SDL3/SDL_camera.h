@@ -409,6 +409,26 @@ extern DECLSPEC int SDLCALL SDL_GetCameraFormat(SDL_Camera *camera, SDL_CameraSp
  * SDL_EVENT_CAMERA_DEVICE_DENIED) event, or poll SDL_IsCameraApproved()
  * occasionally until it returns non-zero.
  *
+ * If the frame is going straight from the camera driver to the app without
+ * conversion or scaling, and the driver can share its buffers with other
+ * APIs, the surface's properties (see SDL_GetSurfaceProperties()) describe
+ * the driver's buffer, so it can be passed to a video encoder or imported
+ * into a GPU API without a copy. These are valid until the frame is released:
+ *
+ * - `SDL_PROP_CAMERA_FRAME_DMABUF_FD_NUMBER`: the Linux DMABUF file
+ *   descriptor holding the frame. Don't close it; import it (or dup() it)
+ *   instead.
+ * - `SDL_PROP_CAMERA_FRAME_NUM_PLANES_NUMBER`: the number of planes in the
+ *   frame's pixel format.
+ * - `SDL_PROP_CAMERA_FRAME_PLANE0_OFFSET_NUMBER`,
+ *   `SDL_PROP_CAMERA_FRAME_PLANE1_OFFSET_NUMBER`,
+ *   `SDL_PROP_CAMERA_FRAME_PLANE2_OFFSET_NUMBER`: the byte offset of each
+ *   plane from the start of the buffer.
+ * - `SDL_PROP_CAMERA_FRAME_PLANE0_PITCH_NUMBER`,
+ *   `SDL_PROP_CAMERA_FRAME_PLANE1_PITCH_NUMBER`,
+ *   `SDL_PROP_CAMERA_FRAME_PLANE2_PITCH_NUMBER`: the pitch, in bytes, of each
+ *   plane.
+ *
  * \param camera opened camera device
  * \param timestampNS a pointer filled in with the frame's timestamp, or 0 on
  *                    error. Can be NULL.
@@ -423,6 +443,15 @@ extern DECLSPEC int SDLCALL SDL_GetCameraFormat(SDL_Camera *camera, SDL_CameraSp
  */
 extern DECLSPEC SDL_Surface * SDLCALL SDL_AcquireCameraFrame(SDL_Camera *camera, Uint64 *timestampNS);
 
+#define SDL_PROP_CAMERA_FRAME_DMABUF_FD_NUMBER      "SDL.camera.frame.dmabuf.fd"
+#define SDL_PROP_CAMERA_FRAME_NUM_PLANES_NUMBER     "SDL.camera.frame.num_planes"
+#define SDL_PROP_CAMERA_FRAME_PLANE0_OFFSET_NUMBER  "SDL.camera.frame.plane0.offset"
+#define SDL_PROP_CAMERA_FRAME_PLANE0_PITCH_NUMBER   "SDL.camera.frame.plane0.pitch"
+#define SDL_PROP_CAMERA_FRAME_PLANE1_OFFSET_NUMBER  "SDL.camera.frame.plane1.offset"
+#define SDL_PROP_CAMERA_FRAME_PLANE1_PITCH_NUMBER   "SDL.camera.frame.plane1.pitch"
+#define SDL_PROP_CAMERA_FRAME_PLANE2_OFFSET_NUMBER  "SDL.camera.frame.plane2.offset"
+#define SDL_PROP_CAMERA_FRAME_PLANE2_PITCH_NUMBER   "SDL.camera.frame.plane2.pitch"
+
 /**
  * Release a frame of video acquired from a camera.
  *
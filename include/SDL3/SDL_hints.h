@@ -371,6 +371,27 @@ extern "C" {
  */
 #define SDL_HINT_CAMERA_DRIVER "SDL_CAMERA_DRIVER"
 
+/**
+ *  A variable controlling how many threads are used to convert and scale
+ *  camera frames.
+ *
+ *  When an opened camera's frames need to be converted to a different
+ *  format or size, the work is handed off to a pool of threads shared by
+ *  all open cameras, so the camera device threads only have to collect
+ *  frames from the hardware. Frames that don't need conversion are handed
+ *  to the app without being copied, and never touch these threads.
+ *
+ *  The variable can be set to the following values:
+ *    "0"       - Convert frames on each camera's own thread.
+ *    "N"       - Use N threads to convert frames.
+ *
+ *  By default SDL uses one thread per CPU core, up to 4. This hint needs to
+ *  be set before the first camera that needs conversion is opened.
+ *
+ *  This hint is available since SDL 3.0.0.
+ */
+#define SDL_HINT_CAMERA_CONVERSION_THREADS "SDL_CAMERA_CONVERSION_THREADS"
+
 /**
  * A variable controlling whether DirectInput should be used for controllers
  *
@@ -1441,6 +1462,21 @@ extern "C" {
  */
 #define SDL_HINT_LOGGING   "SDL_LOGGING"
 
+/**
+ * A variable controlling whether log messages are output on a separate thread.
+ *
+ * When enabled, SDL_LogMessageV() formats the message on the calling thread and queues it for a dedicated log thread, which calls the log output function. This keeps slow output, like writing to a console, off time critical threads such as audio callbacks. If messages are logged faster than they can be output, new messages are dropped and a warning with the number of dropped messages is logged once the log thread catches up.
+ *
+ * Queued messages are always output before SDL_LogSetOutputFunction() changes the output function and before SDL_Quit() returns.
+ *
+ * The variable can be set to the following values:
+ *   "0"       - Log messages are output on the thread that logs them. (default)
+ *   "1"       - Log messages are output on a separate log thread.
+ *
+ * This hint can be set anytime.
+ */
+#define SDL_HINT_LOGGING_ASYNC  "SDL_LOGGING_ASYNC"
+
 /**
  * A variable controlling whether to force the application to become the foreground process when launched on macOS.
  *
@@ -1864,6 +1900,17 @@ extern "C" {
  */
 #define SDL_HINT_RPI_VIDEO_LAYER           "SDL_RPI_VIDEO_LAYER"
 
+/**
+ * A variable controlling whether asynchronous stream requests use io_uring on Linux.
+ *
+ * The variable can be set to the following values:
+ *   "0"       - Asynchronous requests run on a pool of threads.
+ *   "1"       - Asynchronous requests on files use io_uring, if the kernel supports it. (default)
+ *
+ * This hint is checked when an SDL_RWQueue is created.
+ */
+#define SDL_HINT_RWOPS_IO_URING "SDL_RWOPS_IO_URING"
+
 /**
  * Specify an "activity name" for screensaver inhibition.
  *
@@ -52,6 +52,16 @@ typedef enum
     SDL_PROPERTY_TYPE_BOOLEAN,
 } SDL_PropertyType;
 
+/**
+ * SDL property atom
+ *
+ * An atom is an integer that stands for a property name, and can be used to
+ * look up properties without hashing the name every time.
+ *
+ * \sa SDL_GetPropertyAtom
+ */
+typedef Uint32 SDL_PropertyAtom;
+
 /**
  * Get the global SDL properties
  *
@@ -395,6 +405,136 @@ extern DECLSPEC float SDLCALL SDL_GetFloatProperty(SDL_PropertiesID props, const
  */
 extern DECLSPEC SDL_bool SDLCALL SDL_GetBooleanProperty(SDL_PropertiesID props, const char *name, SDL_bool default_value);
 
+/**
+ * Get the atom for a property name
+ *
+ * The atom can be passed to SDL_GetPropertyByAtom() and the other
+ * `ByAtom` getters, which don't take any locks and don't need to hash the
+ * name, so they are cheap enough to call every frame.
+ *
+ * Atoms are valid until SDL_Quit() is called.
+ *
+ * \param name the name of the property
+ * \returns the atom for the name, or 0 on failure; call SDL_GetError() for
+ *          more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetPropertyByAtom
+ */
+extern DECLSPEC SDL_PropertyAtom SDLCALL SDL_GetPropertyAtom(const char *name);
+
+/**
+ * Get a property on a set of properties by atom
+ *
+ * This is the same as SDL_GetProperty(), but the property is identified by
+ * an atom returned by SDL_GetPropertyAtom().
+ *
+ * \param props the properties to query
+ * \param atom the atom of the property to query
+ * \param default_value the default value of the property
+ * \returns the value of the property, or `default_value` if it is not set or
+ *          not a pointer property.
+ *
+ * \threadsafety It is safe to call this function from any thread, although
+ *               the data returned is not protected and could potentially be
+ *               freed if you call SDL_SetProperty() or SDL_ClearProperty() on
+ *               these properties from another thread. If you need to avoid
+ *               this, use SDL_LockProperties() and SDL_UnlockProperties().
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetProperty
+ * \sa SDL_GetPropertyAtom
+ */
+extern DECLSPEC void *SDLCALL SDL_GetPropertyByAtom(SDL_PropertiesID props, SDL_PropertyAtom atom, void *default_value);
+
+/**
+ * Get a string property on a set of properties by atom
+ *
+ * This is the same as SDL_GetStringProperty(), but the property is
+ * identified by an atom returned by SDL_GetPropertyAtom().
+ *
+ * \param props the properties to query
+ * \param atom the atom of the property to query
+ * \param default_value the default value of the property
+ * \returns the value of the property, or `default_value` if it is not set or
+ *          not a string property.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetStringProperty
+ * \sa SDL_GetPropertyAtom
+ */
+extern DECLSPEC const char *SDLCALL SDL_GetStringPropertyByAtom(SDL_PropertiesID props, SDL_PropertyAtom atom, const char *default_value);
+
+/**
+ * Get a number property on a set of properties by atom
+ *
+ * This is the same as SDL_GetNumberProperty(), but the property is
+ * identified by an atom returned by SDL_GetPropertyAtom().
+ *
+ * \param props the properties to query
+ * \param atom the atom of the property to query
+ * \param default_value the default value of the property
+ * \returns the value of the property, or `default_value` if it is not set or
+ *          not a number property.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetNumberProperty
+ * \sa SDL_GetPropertyAtom
+ */
+extern DECLSPEC Sint64 SDLCALL SDL_GetNumberPropertyByAtom(SDL_PropertiesID props, SDL_PropertyAtom atom, Sint64 default_value);
+
+/**
+ * Get a floating point property on a set of properties by atom
+ *
+ * This is the same as SDL_GetFloatProperty(), but the property is identified
+ * by an atom returned by SDL_GetPropertyAtom().
+ *
+ * \param props the properties to query
+ * \param atom the atom of the property to query
+ * \param default_value the default value of the property
+ * \returns the value of the property, or `default_value` if it is not set or
+ *          not a float property.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetFloatProperty
+ * \sa SDL_GetPropertyAtom
+ */
+extern DECLSPEC float SDLCALL SDL_GetFloatPropertyByAtom(SDL_PropertiesID props, SDL_PropertyAtom atom, float default_value);
+
+/**
+ * Get a boolean property on a set of properties by atom
+ *
+ * This is the same as SDL_GetBooleanProperty(), but the property is
+ * identified by an atom returned by SDL_GetPropertyAtom().
+ *
+ * \param props the properties to query
+ * \param atom the atom of the property to query
+ * \param default_value the default value of the property
+ * \returns the value of the property, or `default_value` if it is not set or
+ *          not a boolean property.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetBooleanProperty
+ * \sa SDL_GetPropertyAtom
+ */
+extern DECLSPEC SDL_bool SDLCALL SDL_GetBooleanPropertyByAtom(SDL_PropertiesID props, SDL_PropertyAtom atom, SDL_bool default_value);
+
 /**
  * Clear a property on a set of properties
  *
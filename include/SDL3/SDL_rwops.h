@@ -143,8 +143,86 @@ typedef struct SDL_RWops
         } unknown;
     } hidden;
 
+    /**
+     *  The read-ahead and write-behind buffer, managed by SDL_SetRWBuffer()
+     *
+     *  It holds either data read ahead of the stream position, from \c pos
+     *  to \c len, or data waiting to be written, from 0 to \c len.
+     */
+    struct
+    {
+        Uint8 *data;
+        size_t size;
+        size_t pos;
+        size_t len;
+        SDL_bool writing;
+    } buffer;
+
 } SDL_RWops;
 
+/**
+ * A queue of asynchronous reads and writes on SDL_RWops streams.
+ *
+ * \since This struct is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateRWQueue
+ * \sa SDL_ReadRWAsync
+ * \sa SDL_WriteRWAsync
+ * \sa SDL_GetRWCompletion
+ */
+typedef struct SDL_RWQueue SDL_RWQueue;
+
+/**
+ * One buffer of a scattered read or a gathered write.
+ *
+ * \since This struct is available since SDL 3.0.0.
+ */
+typedef struct SDL_RWSegment
+{
+    void *data;     /**< The memory to read into or write from */
+    size_t size;    /**< The size of the memory, in bytes */
+} SDL_RWSegment;
+
+/**
+ * The kind of an asynchronous request.
+ *
+ * \since This enum is available since SDL 3.0.0.
+ */
+typedef enum
+{
+    SDL_RWREQUEST_READ,
+    SDL_RWREQUEST_WRITE
+} SDL_RWRequestType;
+
+/**
+ * The outcome of an asynchronous request.
+ *
+ * \since This enum is available since SDL 3.0.0.
+ */
+typedef enum
+{
+    SDL_RWREQUEST_COMPLETE,     /**< The request finished, transferring fewer bytes than requested only at the end of the stream */
+    SDL_RWREQUEST_FAILED,       /**< The stream reported an error */
+    SDL_RWREQUEST_CANCELED      /**< The request was canceled before it finished */
+} SDL_RWRequestStatus;
+
+/**
+ * A finished asynchronous request, as returned by SDL_GetRWCompletion().
+ *
+ * \since This struct is available since SDL 3.0.0.
+ */
+typedef struct SDL_RWCompletion
+{
+    Uint64 request;             /**< The ID returned when the request was submitted */
+    SDL_RWRequestType type;     /**< Whether this was a read or a write */
+    SDL_RWRequestStatus status; /**< How the request ended */
+    SDL_RWops *context;         /**< The stream the request was made on */
+    Uint64 offset;              /**< The position in the stream the request started at */
+    size_t requested;           /**< The total size of the request's buffers, in bytes */
+    size_t transferred;         /**< The number of bytes actually read or written */
+    void *userdata;             /**< The pointer passed when the request was submitted */
+} SDL_RWCompletion;
+
 
 /**
  *  \name RWFrom functions
@@ -280,6 +358,37 @@ extern DECLSPEC SDL_RWops *SDLCALL SDL_RWFromMem(void *mem, size_t size);
  */
 extern DECLSPEC SDL_RWops *SDLCALL SDL_RWFromConstMem(const void *mem, size_t size);
 
+/**
+ * Use this function to open a file for reading directly from memory.
+ *
+ * This function maps the contents of a file into memory, where the operating
+ * system supports it, and sets up a read-only SDL_RWops struct for it.
+ * Otherwise, the contents of the file are loaded into memory when it's
+ * opened.
+ *
+ * The contents of the file can be parsed in place, without any copies, using
+ * the pointer in the `SDL_PROP_RWOPS_DATA_POINTER` property of the stream,
+ * and the size returned by SDL_RWsize(). The pointer remains valid until the
+ * stream is closed. The data must not be modified.
+ *
+ * The results are undefined if the file is modified or truncated by another
+ * process while it is mapped.
+ *
+ * \param file a UTF-8 string representing the filename to open
+ * \returns a pointer to a new SDL_RWops structure, or NULL if it fails; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetRWProperties
+ * \sa SDL_RWclose
+ * \sa SDL_RWFromFile
+ * \sa SDL_RWsize
+ */
+extern DECLSPEC SDL_RWops *SDLCALL SDL_RWFromMappedFile(const char *file);
+
+#define SDL_PROP_RWOPS_DATA_POINTER "SDL.rwops.data"
+
 /* @} *//* RWFrom functions */
 
 
@@ -543,6 +652,186 @@ extern DECLSPEC size_t SDLCALL SDL_RWprintf(SDL_RWops *context, SDL_PRINTF_FORMA
  */
 extern DECLSPEC size_t SDLCALL SDL_RWvprintf(SDL_RWops *context, SDL_PRINTF_FORMAT_STRING const char *fmt, va_list ap) SDL_PRINTF_VARARG_FUNCV(2);
 
+/**
+ * Set the size of the buffer used to read ahead and write behind a stream.
+ *
+ * Buffering is off by default. When it's on, reads are served from data read
+ * ahead of the stream position, in blocks of up to `size` bytes, and writes
+ * are collected until the buffer is full, the stream is flushed, seeked or
+ * read from, or the stream is closed. This makes small reads and writes, like
+ * SDL_ReadU16LE() and SDL_WriteU32BE(), much cheaper, especially for custom
+ * SDL_RWops implementations that don't do their own buffering.
+ *
+ * Reads and writes larger than the buffer go to the stream directly.
+ *
+ * Any buffered data is flushed before the buffer is resized. Switching from
+ * reading to writing, or disabling the buffer after reading, needs the stream
+ * to support seeking.
+ *
+ * \param context the SDL_RWops structure to buffer
+ * \param size the size of the buffer, in bytes, or 0 to turn buffering off
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_FlushRW
+ * \sa SDL_RWread
+ * \sa SDL_RWwrite
+ */
+extern DECLSPEC int SDLCALL SDL_SetRWBuffer(SDL_RWops *context, size_t size);
+
+/**
+ * Write any data waiting in the buffer of a stream.
+ *
+ * This does nothing if the stream isn't buffered, see SDL_SetRWBuffer().
+ *
+ * \param context the SDL_RWops structure to flush
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_SetRWBuffer
+ */
+extern DECLSPEC int SDLCALL SDL_FlushRW(SDL_RWops *context);
+
+/**
+ * Create a queue for asynchronous reads and writes.
+ *
+ * Requests are submitted with SDL_ReadRWAsync() and SDL_WriteRWAsync(), and
+ * their results are collected with SDL_GetRWCompletion(), so one thread can
+ * keep many reads in flight at once.
+ *
+ * Requests on file streams use io_uring on Linux when the kernel supports it
+ * (see SDL_HINT_RWOPS_IO_URING), and positional reads and writes on a small
+ * pool of threads elsewhere. Requests on other streams run on the thread
+ * pool, one at a time per queue, by seeking and reading the stream.
+ *
+ * \param depth the number of requests the queue should be able to keep in
+ *              flight at once, or 0 for a default; more requests than this
+ *              can be submitted, they wait until earlier ones finish
+ * \returns a new queue, or NULL on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_DestroyRWQueue
+ * \sa SDL_GetRWCompletion
+ * \sa SDL_ReadRWAsync
+ * \sa SDL_WriteRWAsync
+ */
+extern DECLSPEC SDL_RWQueue *SDLCALL SDL_CreateRWQueue(int depth);
+
+/**
+ * Destroy a queue of asynchronous requests.
+ *
+ * Requests that haven't finished are canceled, and this waits until the
+ * streams and buffers involved are no longer in use. Completions that
+ * weren't collected are discarded.
+ *
+ * \param queue the queue to destroy
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateRWQueue
+ */
+extern DECLSPEC void SDLCALL SDL_DestroyRWQueue(SDL_RWQueue *queue);
+
+/**
+ * Start reading from a stream in the background.
+ *
+ * The data at `offset` is read into each of the buffers in turn, so one
+ * request can fill several buffers. The buffers must stay valid until the
+ * request completes; the array describing them is copied.
+ *
+ * Asynchronous requests don't change the position of the stream, but the
+ * queue owns the stream while it has requests in flight: the stream must
+ * not be used directly, closed, or given requests on another queue until
+ * they complete. Streams that aren't files are seeked and read for each
+ * request, and that is only serialized within one queue. Any data buffered
+ * by SDL_SetRWBuffer() is flushed first.
+ *
+ * \param queue the queue to submit the request to
+ * \param context the stream to read from
+ * \param offset the position in the stream to read from, in bytes
+ * \param segments the buffers to fill
+ * \param num_segments the number of elements in `segments`
+ * \param userdata a pointer returned with the completion
+ * \returns an ID for the request, or 0 on failure; call SDL_GetError() for
+ *          more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CancelRWRequest
+ * \sa SDL_GetRWCompletion
+ * \sa SDL_WriteRWAsync
+ */
+extern DECLSPEC Uint64 SDLCALL SDL_ReadRWAsync(SDL_RWQueue *queue, SDL_RWops *context, Uint64 offset, const SDL_RWSegment *segments, int num_segments, void *userdata);
+
+/**
+ * Start writing to a stream in the background.
+ *
+ * This works like SDL_ReadRWAsync(), writing the buffers one after the other
+ * at `offset`.
+ *
+ * \param queue the queue to submit the request to
+ * \param context the stream to write to
+ * \param offset the position in the stream to write to, in bytes
+ * \param segments the buffers to write
+ * \param num_segments the number of elements in `segments`
+ * \param userdata a pointer returned with the completion
+ * \returns an ID for the request, or 0 on failure; call SDL_GetError() for
+ *          more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CancelRWRequest
+ * \sa SDL_GetRWCompletion
+ * \sa SDL_ReadRWAsync
+ */
+extern DECLSPEC Uint64 SDLCALL SDL_WriteRWAsync(SDL_RWQueue *queue, SDL_RWops *context, Uint64 offset, const SDL_RWSegment *segments, int num_segments, void *userdata);
+
+/**
+ * Ask for an asynchronous request to be canceled.
+ *
+ * Cancellation is best effort: a request that is already being carried out
+ * may still finish. Either way the request is reported by
+ * SDL_GetRWCompletion(), with a status of SDL_RWREQUEST_CANCELED if it was
+ * stopped.
+ *
+ * \param queue the queue the request was submitted to
+ * \param request the ID returned when the request was submitted
+ * \returns 0 on success or a negative error code if the request isn't in
+ *          flight; call SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetRWCompletion
+ */
+extern DECLSPEC int SDLCALL SDL_CancelRWRequest(SDL_RWQueue *queue, Uint64 request);
+
+/**
+ * Get the next finished request from a queue.
+ *
+ * Requests are reported in the order they finish, which isn't necessarily
+ * the order they were submitted in. Each request is reported exactly once.
+ *
+ * \param queue the queue to check
+ * \param completion filled in with the finished request
+ * \param timeoutMS the time to wait for a request to finish, in
+ *                  milliseconds, 0 to return immediately, or -1 to wait
+ *                  until one does
+ * \returns SDL_TRUE if a request was returned, or SDL_FALSE if none
+ *          finished in time or the queue has no requests in flight.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_ReadRWAsync
+ * \sa SDL_WriteRWAsync
+ */
+extern DECLSPEC SDL_bool SDLCALL SDL_GetRWCompletion(SDL_RWQueue *queue, SDL_RWCompletion *completion, Sint32 timeoutMS);
+
 /**
  * Close and free an allocated SDL_RWops structure.
  *
@@ -492,12 +492,187 @@ extern DECLSPEC void SDLCALL SDL_aligned_free(void *mem);
  */
 extern DECLSPEC int SDLCALL SDL_GetNumAllocations(void);
 
+/**
+ * The number of size classes in SDL_MemoryStats::allocations_by_size
+ *
+ * \since This macro is available since SDL 3.0.0.
+ */
+#define SDL_NUM_MEMORY_SIZE_CLASSES 16
+
+/**
+ * Statistics for SDL's built-in memory allocator.
+ *
+ * The byte counts are for the blocks handed out by the allocator, which may
+ * be a little larger than the sizes that were requested.
+ *
+ * \since This struct is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetMemoryStats
+ */
+typedef struct SDL_MemoryStats
+{
+    size_t bytes_in_use;    /**< Bytes in blocks that are currently allocated */
+    size_t bytes_cached;    /**< Bytes in freed blocks kept by threads for reuse */
+    size_t peak_bytes;      /**< The most bytes taken from the heap at once, in use or cached */
+    Uint64 num_allocations; /**< The number of blocks allocated */
+    Uint64 num_frees;       /**< The number of blocks freed */
+    Uint64 num_cache_hits;  /**< The number of allocations that reused a cached block */
+    Uint64 allocations_by_size[SDL_NUM_MEMORY_SIZE_CLASSES]; /**< Allocations by size, element i counts sizes up to (16 << i) and the last one counts everything larger */
+} SDL_MemoryStats;
+
+/**
+ * Get statistics for SDL's built-in memory allocator.
+ *
+ * SDL has its own allocator when it is built without the C runtime. It keeps
+ * a cache of recently freed blocks for each thread, so most allocations don't
+ * have to take the global heap lock.
+ *
+ * Only memory allocated through SDL's original memory functions is counted,
+ * see SDL_GetOriginalMemoryFunctions(). While other threads are allocating
+ * the results are approximate.
+ *
+ * \param stats a pointer filled in with the current statistics
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information. This fails if SDL uses the C
+ *          runtime's allocator.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetNumAllocations
+ */
+extern DECLSPEC int SDLCALL SDL_GetMemoryStats(SDL_MemoryStats *stats);
+
 extern DECLSPEC char *SDLCALL SDL_getenv(const char *name);
 extern DECLSPEC int SDLCALL SDL_setenv(const char *name, const char *value, int overwrite);
 
 extern DECLSPEC void SDLCALL SDL_qsort(void *base, size_t nmemb, size_t size, int (SDLCALL *compare) (const void *, const void *));
 extern DECLSPEC void * SDLCALL SDL_bsearch(const void *key, const void *base, size_t nmemb, size_t size, int (SDLCALL *compare) (const void *, const void *));
 
+/**
+ * A comparison function taking an application pointer, used by
+ * SDL_qsort_r(), SDL_bsearch_r() and SDL_ParallelSort().
+ *
+ * \param userdata the pointer passed to the sort or search function
+ * \param a the first element to compare
+ * \param b the second element to compare
+ * \returns a negative value if a sorts before b, a positive value if a sorts
+ *          after b and 0 if they are equivalent.
+ *
+ * \since This datatype is available since SDL 3.0.0.
+ */
+typedef int (SDLCALL *SDL_CompareCallback_r)(void *userdata, const void *a, const void *b);
+
+/**
+ * Sort an array, passing an application pointer to the comparison function.
+ *
+ * This always uses SDL's own sort, so the order of equivalent elements is
+ * the same on every platform, but it is not preserved from the input.
+ *
+ * \param base the array to sort
+ * \param nmemb the number of elements in the array
+ * \param size the size of each element, in bytes
+ * \param compare the comparison function
+ * \param userdata a pointer passed to each call of `compare`
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_bsearch_r
+ * \sa SDL_ParallelSort
+ * \sa SDL_qsort
+ */
+extern DECLSPEC void SDLCALL SDL_qsort_r(void *base, size_t nmemb, size_t size, SDL_CompareCallback_r compare, void *userdata);
+
+/**
+ * Search a sorted array, passing an application pointer to the comparison
+ * function.
+ *
+ * \param key a pointer passed as the first argument to `compare`
+ * \param base the sorted array to search
+ * \param nmemb the number of elements in the array
+ * \param size the size of each element, in bytes
+ * \param compare the comparison function
+ * \param userdata a pointer passed to each call of `compare`
+ * \returns a pointer to a matching element, or NULL if there is none.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_qsort_r
+ */
+extern DECLSPEC void * SDLCALL SDL_bsearch_r(const void *key, const void *base, size_t nmemb, size_t size, SDL_CompareCallback_r compare, void *userdata);
+
+/**
+ * Sort an array with a merge sort that uses several threads for large
+ * arrays.
+ *
+ * The sort is stable, equivalent elements keep their order from the input.
+ * Arrays of more than a few thousand elements are split between up to
+ * SDL_GetCPUCount() threads, so `compare` must be safe to call from several
+ * threads at once. If threads can't be created the array is sorted on the
+ * calling thread.
+ *
+ * \param base the array to sort
+ * \param nmemb the number of elements in the array
+ * \param size the size of each element, in bytes
+ * \param compare the comparison function
+ * \param userdata a pointer passed to each call of `compare`
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information. This fails if the
+ *          temporary buffer of `nmemb` elements can't be allocated, and
+ *          the array is left unchanged.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_qsort_r
+ * \sa SDL_RadixSort
+ */
+extern DECLSPEC int SDLCALL SDL_ParallelSort(void *base, size_t nmemb, size_t size, SDL_CompareCallback_r compare, void *userdata);
+
+/**
+ * The type of the key used by SDL_RadixSort().
+ *
+ * \since This enum is available since SDL 3.0.0.
+ */
+typedef enum
+{
+    SDL_SORTKEY_UINT32,     /**< Uint32, in native byte order */
+    SDL_SORTKEY_SINT32,     /**< Sint32, in native byte order */
+    SDL_SORTKEY_UINT64,     /**< Uint64, in native byte order */
+    SDL_SORTKEY_SINT64,     /**< Sint64, in native byte order */
+    SDL_SORTKEY_FLOAT,      /**< IEEE 754 float, in native byte order */
+    SDL_SORTKEY_DOUBLE      /**< IEEE 754 double, in native byte order */
+} SDL_SortKeyType;
+
+/**
+ * Sort an array by a numeric key stored in each element.
+ *
+ * This is a least significant digit radix sort, which takes time linear in
+ * the number of elements and doesn't call a comparison function, so it is
+ * usually much faster than SDL_qsort() for large arrays. The elements are
+ * sorted in ascending order of their keys, and the sort is stable.
+ *
+ * Floating point keys are ordered by value, except that -0.0 sorts before
+ * 0.0, and NaNs with the sign bit set sort before everything else while
+ * other NaNs sort after everything else.
+ *
+ * The key doesn't need to be aligned within the element.
+ *
+ * \param base the array to sort
+ * \param nmemb the number of elements in the array
+ * \param size the size of each element, in bytes
+ * \param key_offset the offset of the key within each element, in bytes
+ * \param key_type the type of the key
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information. This fails if the
+ *          temporary buffer of `nmemb` elements can't be allocated, and
+ *          the array is left unchanged.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_ParallelSort
+ * \sa SDL_qsort
+ */
+extern DECLSPEC int SDLCALL SDL_RadixSort(void *base, size_t nmemb, size_t size, size_t key_offset, SDL_SortKeyType key_type);
+
 extern DECLSPEC int SDLCALL SDL_abs(int x);
 
 /* NOTE: these double-evaluate their arguments, so you should never have side effects in the parameters */
@@ -755,6 +755,10 @@ extern DECLSPEC SDL_Surface *SDLCALL SDL_ConvertSurfaceFormatAndColorspace(SDL_S
 /**
  * Copy a block of pixels of one format to another format.
  *
+ * For formats other than YUV, `src_pitch` may be negative, with `src`
+ * pointing at the last row of the source pixels, to flip the pixels
+ * vertically while they're converted.
+ *
  * \param width the width of the block to copy, in pixels
  * \param height the height of the block to copy, in pixels
  * \param src_format an SDL_PixelFormatEnum value of the `src` pixels format
@@ -774,6 +778,10 @@ extern DECLSPEC int SDLCALL SDL_ConvertPixels(int width, int height, Uint32 src_
  * Copy a block of pixels of one format and colorspace to another format and
  * colorspace.
  *
+ * For formats other than YUV, `src_pitch` may be negative, with `src`
+ * pointing at the last row of the source pixels, to flip the pixels
+ * vertically while they're converted.
+ *
  * \param width the width of the block to copy, in pixels
  * \param height the height of the block to copy, in pixels
  * \param src_format an SDL_PixelFormatEnum value of the `src` pixels format
@@ -798,7 +806,10 @@ extern DECLSPEC int SDLCALL SDL_ConvertPixelsAndColorspace(int width, int height
  *
  * This is safe to use with src == dst, but not for other overlapping areas.
  *
- * This function is currently only implemented for SDL_PIXELFORMAT_ARGB8888.
+ * The source and destination formats can be any of SDL_PIXELFORMAT_ARGB8888,
+ * SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ABGR8888 and
+ * SDL_PIXELFORMAT_BGRA8888, and they don't have to match. Each color channel
+ * becomes `(color * alpha + 127) / 255`.
  *
  * \param width the width of the block to convert, in pixels
  * \param height the height of the block to convert, in pixels
@@ -812,9 +823,40 @@ extern DECLSPEC int SDLCALL SDL_ConvertPixelsAndColorspace(int width, int height
  *          SDL_GetError() for more information.
  *
  * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_UnpremultiplyAlpha
  */
 extern DECLSPEC int SDLCALL SDL_PremultiplyAlpha(int width, int height, Uint32 src_format, const void *src, int src_pitch, Uint32 dst_format, void *dst, int dst_pitch);
 
+/**
+ * Undo alpha premultiplication on a block of pixels.
+ *
+ * This is safe to use with src == dst, but not for other overlapping areas.
+ *
+ * The source and destination formats can be any of SDL_PIXELFORMAT_ARGB8888,
+ * SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ABGR8888 and
+ * SDL_PIXELFORMAT_BGRA8888, and they don't have to match. Each color channel
+ * becomes `(color * 255 + alpha / 2) / alpha`, clamped to 255, and fully
+ * transparent pixels become 0. Precision lost when the colors were
+ * premultiplied can't be recovered.
+ *
+ * \param width the width of the block to convert, in pixels
+ * \param height the height of the block to convert, in pixels
+ * \param src_format an SDL_PixelFormatEnum value of the `src` pixels format
+ * \param src a pointer to the source pixels
+ * \param src_pitch the pitch of the source pixels, in bytes
+ * \param dst_format an SDL_PixelFormatEnum value of the `dst` pixels format
+ * \param dst a pointer to be filled in with straight alpha pixel data
+ * \param dst_pitch the pitch of the destination pixels, in bytes
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_PremultiplyAlpha
+ */
+extern DECLSPEC int SDLCALL SDL_UnpremultiplyAlpha(int width, int height, Uint32 src_format, const void *src, int src_pitch, Uint32 dst_format, void *dst, int dst_pitch);
+
 /**
  * Perform a fast fill of a rectangle with a specific color.
  *
@@ -224,6 +224,7 @@
 #cmakedefine HAVE_O_CLOEXEC 1
 
 #cmakedefine HAVE_LINUX_INPUT_H 1
+#cmakedefine HAVE_LINUX_IO_URING_H 1
 #cmakedefine HAVE_LIBUDEV_H 1
 #cmakedefine HAVE_LIBDECOR_H 1
 
@@ -53,6 +53,7 @@
 
 /* Initialization/Cleanup routines */
 #include "timer/SDL_timer_c.h"
+#include "thread/SDL_thread_c.h"
 #ifdef SDL_VIDEO_DRIVER_WINDOWS
 extern int SDL_HelperWindowCreate(void);
 extern int SDL_HelperWindowDestroy(void);
@@ -185,6 +186,9 @@ int SDL_InitSubSystem(Uint32 flags)
         return SDL_SetError("Application didn't initialize properly, did you include SDL_main.h in the file containing your main() function?");
     }
 
+    /* SDL_Quit() cleans up the TLS of this thread, so it can cache allocations */
+    SDL_EnableMallocThreadCache();
+
     SDL_InitLog();
     SDL_InitProperties();
     SDL_GetGlobalProperties();
@@ -544,6 +548,7 @@ void SDL_Quit(void)
     SDL_ClearHints();
     SDL_AssertionsQuit();
 
+    SDL_QuitPixelConversion();
     SDL_QuitProperties();
     SDL_QuitLog();
 
@@ -21,17 +21,33 @@
 #include "SDL_internal.h"
 #include "SDL_hashtable.h"
 
+// This is an open-addressing hash table using Robin Hood hashing: every item
+//  remembers how far it is from its home slot (probe_len), and an insert takes
+//  the slot of any item that is closer to home than the item being inserted.
+//  This keeps the probe sequences short and lets lookups stop early.
+
 typedef struct SDL_HashItem
 {
     const void *key;
     const void *value;
-    struct SDL_HashItem *next;
+    Uint32 hash;
+    Uint32 probe_len : 31;
+    Uint32 live : 1;
 } SDL_HashItem;
 
+// Must be a power of 2 >= sizeof(SDL_HashItem)
+#define MAX_HASHITEM_SIZEOF 32u
+SDL_COMPILE_TIME_ASSERT(sizeof_SDL_HashItem, sizeof(SDL_HashItem) <= MAX_HASHITEM_SIZEOF);
+
+// Anything larger than this will cause integer overflows
+#define MAX_HASHTABLE_SIZE (0x80000000u / (MAX_HASHITEM_SIZEOF))
+
 struct SDL_HashTable
 {
-    SDL_HashItem **table;
-    Uint32 table_len;
+    SDL_HashItem *table;
+    Uint32 hash_mask;
+    Uint32 max_probe_len;
+    Uint32 num_occupied_slots;
     SDL_bool stackable;
     void *data;
     SDL_HashTable_HashFn hash;
@@ -52,18 +68,23 @@ SDL_HashTable *SDL_CreateHashTable(void *data, const Uint32 num_buckets, const S
         return NULL;
     }
 
+    if (num_buckets > MAX_HASHTABLE_SIZE) {
+        SDL_SetError("num_buckets is too large");
+        return NULL;
+    }
+
     table = (SDL_HashTable *) SDL_calloc(1, sizeof (SDL_HashTable));
     if (!table) {
         return NULL;
     }
 
-    table->table = (SDL_HashItem **) SDL_calloc(num_buckets, sizeof (SDL_HashItem *));
+    table->table = (SDL_HashItem *) SDL_calloc(num_buckets, sizeof (SDL_HashItem));
     if (!table->table) {
         SDL_free(table);
         return NULL;
     }
 
-    table->table_len = num_buckets;
+    table->hash_mask = num_buckets - 1;
     table->stackable = stackable;
     table->data = data;
     table->hash = hashfn;
@@ -74,46 +95,192 @@ SDL_HashTable *SDL_CreateHashTable(void *data, const Uint32 num_buckets, const S
 
 static SDL_INLINE Uint32 calc_hash(const SDL_HashTable *table, const void *key)
 {
-    return table->hash(key, table->data) & (table->table_len - 1);
+    return table->hash(key, table->data);
+}
+
+// Walk the probe sequence starting at slot *i, which is *probe_len slots away from the home slot of hash.
+//  On success, *i and *probe_len are left pointing at the returned item, so the search can be resumed from there.
+static SDL_HashItem *find_item(const SDL_HashTable *ht, const void *key, Uint32 hash, Uint32 *i, Uint32 *probe_len)
+{
+    const Uint32 hash_mask = ht->hash_mask;
+    const Uint32 max_probe_len = ht->max_probe_len;
+    SDL_HashItem *table = ht->table;
+
+    for (;;) {
+        SDL_HashItem *item = &table[*i];
+
+        if (!item->live) {
+            return NULL;
+        }
+
+        if ((item->hash == hash) && ht->keymatch(key, item->key, ht->data)) {
+            return item;
+        }
+
+        // Robin Hood invariant: if the key was here, it would have displaced this item.
+        if (item->probe_len < *probe_len) {
+            return NULL;
+        }
+
+        if (++*probe_len > max_probe_len) {
+            return NULL;
+        }
+
+        *i = (*i + 1) & hash_mask;
+    }
+}
+
+static SDL_HashItem *find_first_item(const SDL_HashTable *ht, const void *key, Uint32 hash)
+{
+    Uint32 i = hash & ht->hash_mask;
+    Uint32 probe_len = 0;
+    return find_item(ht, key, hash, &i, &probe_len);
+}
+
+static void insert_item(SDL_HashItem *item_to_insert, SDL_HashItem *table, Uint32 hash_mask, Uint32 *max_probe_len_ptr)
+{
+    Uint32 idx = item_to_insert->hash & hash_mask;
+    SDL_HashItem temp_item;
+
+    for (;;) {
+        SDL_HashItem *candidate = &table[idx];
+
+        if (!candidate->live) {
+            // Found an empty slot. Put it here and we're done.
+            *candidate = *item_to_insert;
+            candidate->live = SDL_TRUE;
+
+            if (candidate->probe_len > *max_probe_len_ptr) {
+                *max_probe_len_ptr = candidate->probe_len;
+            }
+            return;
+        }
+
+        // Steal the slot from items that are closer to their home, and carry those on instead.
+        if (candidate->probe_len < item_to_insert->probe_len) {
+            temp_item = *candidate;
+            *candidate = *item_to_insert;
+
+            if (candidate->probe_len > *max_probe_len_ptr) {
+                *max_probe_len_ptr = candidate->probe_len;
+            }
+
+            *item_to_insert = temp_item;
+        }
+
+        item_to_insert->probe_len++;
+        idx = (idx + 1) & hash_mask;
+    }
+}
+
+static void delete_item(SDL_HashTable *ht, SDL_HashItem *item)
+{
+    const Uint32 hash_mask = ht->hash_mask;
+    SDL_HashItem *table = ht->table;
+    Uint32 idx = (Uint32)(item - table);
+
+    // Backward shift deletion: pull every following item of the same run one slot back, so no tombstones are needed.
+    for (;;) {
+        SDL_HashItem *next_item;
+
+        idx = (idx + 1) & hash_mask;
+        next_item = &table[idx];
+
+        if (!next_item->live || (next_item->probe_len == 0)) {
+            SDL_zerop(item);
+            ht->num_occupied_slots--;
+            return;
+        }
+
+        *item = *next_item;
+        item->probe_len--;
+        item = next_item;
+    }
+}
+
+static SDL_bool resize(SDL_HashTable *ht, Uint32 new_size)
+{
+    SDL_HashItem *old_table = ht->table;
+    const Uint32 old_size = ht->hash_mask + 1;
+    const Uint32 new_hash_mask = new_size - 1;
+    Uint32 max_probe_len = 0;
+    SDL_HashItem *new_table;
+    Uint32 i;
+
+    new_table = (SDL_HashItem *) SDL_calloc(new_size, sizeof (SDL_HashItem));
+    if (!new_table) {
+        return SDL_FALSE;
+    }
+
+    for (i = 0; i < old_size; ++i) {
+        SDL_HashItem *item = &old_table[i];
+        if (item->live) {
+            item->probe_len = 0;
+            insert_item(item, new_table, new_hash_mask, &max_probe_len);
+        }
+    }
+
+    SDL_free(old_table);
+
+    ht->table = new_table;
+    ht->hash_mask = new_hash_mask;
+    ht->max_probe_len = max_probe_len;
+    return SDL_TRUE;
 }
 
+static SDL_bool maybe_resize(SDL_HashTable *ht)
+{
+    const Uint32 capacity = ht->hash_mask + 1;
+    Uint32 max_load_factor;
+
+    if (capacity >= MAX_HASHTABLE_SIZE) {
+        // Can't grow any further, keep using the table until it is completely full.
+        return (ht->num_occupied_slots < capacity) ? SDL_TRUE : SDL_FALSE;
+    }
+
+    // Grow when the table is more than 3/4 full; 1/2 for small tables, where the collisions hurt relatively more.
+    max_load_factor = (capacity > 32) ? (capacity / 4) * 3 : (capacity / 2);
+    if (ht->num_occupied_slots < max_load_factor) {
+        return SDL_TRUE;
+    }
+
+    return resize(ht, capacity * 2);
+}
 
 SDL_bool SDL_InsertIntoHashTable(SDL_HashTable *table, const void *key, const void *value)
 {
-    SDL_HashItem *item;
+    SDL_HashItem new_item;
     const Uint32 hash = calc_hash(table, key);
 
-    if ( (!table->stackable) && (SDL_FindInHashTable(table, key, NULL)) ) {
+    if ( (!table->stackable) && (find_first_item(table, key, hash)) ) {
         return SDL_FALSE;
     }
 
-    // !!! FIXME: grow and rehash table if it gets too saturated.
-    item = (SDL_HashItem *) SDL_malloc(sizeof (SDL_HashItem));
-    if (!item) {
+    if (!maybe_resize(table)) {
         return SDL_FALSE;
     }
 
-    item->key = key;
-    item->value = value;
-    item->next = table->table[hash];
-    table->table[hash] = item;
+    new_item.key = key;
+    new_item.value = value;
+    new_item.hash = hash;
+    new_item.probe_len = 0;
+    new_item.live = SDL_TRUE;
+
+    insert_item(&new_item, table->table, table->hash_mask, &table->max_probe_len);
+    table->num_occupied_slots++;
 
     return SDL_TRUE;
 }
 
 SDL_bool SDL_FindInHashTable(const SDL_HashTable *table, const void *key, const void **_value)
 {
-    const Uint32 hash = calc_hash(table, key);
-    void *data = table->data;
-    SDL_HashItem *i;
+    const SDL_HashItem *i = find_first_item(table, key, calc_hash(table, key));
 
-    for (i = table->table[hash]; i; i = i->next) {
-        if (table->keymatch(key, i->key, data)) {
-            if (_value) {
-                *_value = i->value;
-            }
-            return SDL_TRUE;
+    if (i) {
+        if (_value) {
+            *_value = i->value;
         }
+        return SDL_TRUE;
     }
 
     return SDL_FALSE;
@@ -121,25 +288,15 @@ SDL_bool SDL_FindInHashTable(const SDL_HashTable *table, const void *key, const
 
 SDL_bool SDL_RemoveFromHashTable(SDL_HashTable *table, const void *key)
 {
-    const Uint32 hash = calc_hash(table, key);
-    SDL_HashItem *item = NULL;
-    SDL_HashItem *prev = NULL;
-    void *data = table->data;
-
-    for (item = table->table[hash]; item; item = item->next) {
-        if (table->keymatch(key, item->key, data)) {
-            if (prev) {
-                prev->next = item->next;
-            } else {
-                table->table[hash] = item->next;
-            }
+    SDL_HashItem *item = find_first_item(table, key, calc_hash(table, key));
 
-            table->nuke(item->key, item->value, data);
-            SDL_free(item);
-            return SDL_TRUE;
-        }
+    if (item) {
+        const void *item_key = item->key;
+        const void *item_value = item->value;
 
-        prev = item;
+        delete_item(table, item);
+        table->nuke(item_key, item_value, table->data);
+        return SDL_TRUE;
     }
 
     return SDL_FALSE;
@@ -147,15 +304,23 @@ SDL_bool SDL_RemoveFromHashTable(SDL_HashTable *table, const void *key)
 
 SDL_bool SDL_IterateHashTableKey(const SDL_HashTable *table, const void *key, const void **_value, void **iter)
 {
-    SDL_HashItem *item = *iter ? ((SDL_HashItem *) *iter)->next : table->table[calc_hash(table, key)];
+    SDL_HashItem *item = (SDL_HashItem *) *iter;
+    const Uint32 hash = calc_hash(table, key);
+    Uint32 i, probe_len;
 
-    while (item) {
-        if (table->keymatch(key, item->key, table->data)) {
-            *_value = item->value;
-            *iter = item;
-            return SDL_TRUE;
-        }
-        item = item->next;
+    if (item) {
+        // continue right after the last match; items with the same hash share a home slot.
+        i = ((Uint32)(item - table->table) + 1) & table->hash_mask;
+        probe_len = item->probe_len + 1;
+        item = (probe_len <= table->max_probe_len) ? find_item(table, key, hash, &i, &probe_len) : NULL;
+    } else {
+        item = find_first_item(table, key, hash);
+    }
+
+    if (item) {
+        *_value = item->value;
+        *iter = item;
+        return SDL_TRUE;
     }
 
     // no more matches.
@@ -167,61 +332,41 @@ SDL_bool SDL_IterateHashTableKey(const SDL_HashTable *table, const void *key, co
 SDL_bool SDL_IterateHashTable(const SDL_HashTable *table, const void **_key, const void **_value, void **iter)
 {
     SDL_HashItem *item = (SDL_HashItem *) *iter;
-    Uint32 idx = 0;
+    const Uint32 table_len = table->hash_mask + 1;
+    Uint32 idx = item ? (Uint32)(item - table->table) + 1 : 0;
 
-    if (item) {
-        const SDL_HashItem *orig = item;
-        item = item->next;
-        if (!item) {
-            idx = calc_hash(table, orig->key) + 1;  // !!! FIXME: we probably shouldn't rehash each time.
+    while (idx < table_len) {
+        item = &table->table[idx++];
+        if (item->live) {
+            *_key = item->key;
+            *_value = item->value;
+            *iter = item;
+            return SDL_TRUE;
         }
     }
 
-    while (!item && (idx < table->table_len)) {
-        item = table->table[idx++];  // skip empty buckets...
-    }
-
-    if (!item) {  // no more matches?
-        *_key = NULL;
-        *iter = NULL;
-        return SDL_FALSE;
-    }
-
-    *_key = item->key;
-    *_value = item->value;
-    *iter = item;
-
-    return SDL_TRUE;
+    // no more matches.
+    *_key = NULL;
+    *iter = NULL;
+    return SDL_FALSE;
 }
 
 SDL_bool SDL_HashTableEmpty(SDL_HashTable *table)
 {
-    if (table) {
-        Uint32 i;
-
-        for (i = 0; i < table->table_len; i++) {
-            SDL_HashItem *item = table->table[i];
-            if (item) {
-                return SDL_FALSE;
-            }
-        }
-    }
-    return SDL_TRUE;
+    return !(table && table->num_occupied_slots);
 }
 
 void SDL_DestroyHashTable(SDL_HashTable *table)
 {
     if (table) {
         void *data = table->data;
+        const Uint32 table_len = table->hash_mask + 1;
         Uint32 i;
 
-        for (i = 0; i < table->table_len; i++) {
-            SDL_HashItem *item = table->table[i];
-            while (item) {
-                SDL_HashItem *next = item->next;
+        for (i = 0; i < table_len; i++) {
+            SDL_HashItem *item = &table->table[i];
+            if (item->live) {
                 table->nuke(item->key, item->value, data);
-                SDL_free(item);
-                item = next;
             }
         }
 
@@ -230,20 +375,50 @@ void SDL_DestroyHashTable(SDL_HashTable *table)
     }
 }
 
-// this is djb's xor hashing function.
-static SDL_INLINE Uint32 hash_string_djbxor(const char *str, size_t len)
+// The string hash folds the string in 8 bytes at a time with a multiply, so
+//  every input bit affects the high bits of the state, and the final mix pushes
+//  those back down into the low bits that the table masks against. The length
+//  is found up front, since the libc strlen is vectorized and much cheaper than
+//  testing every byte for the terminator inside the hash loop.
+#define HASH_PRIME1 0x9E3779B185EBCA87ull
+#define HASH_PRIME2 0xC2B2AE3D27D4EB4Full
+
+static SDL_INLINE Uint64 hash_round64(Uint64 hash, Uint64 word)
 {
-    Uint32 hash = 5381;
-    while (len--) {
-        hash = ((hash << 5) + hash) ^ *(str++);
-    }
+    hash = (hash ^ word) * HASH_PRIME1;
+    hash ^= hash >> 31;
+    return hash;
+}
+
+static SDL_INLINE Uint64 hash_mix64(Uint64 hash)
+{
+    hash ^= hash >> 33;
+    hash *= HASH_PRIME2;
+    hash ^= hash >> 29;
+    hash *= HASH_PRIME1;
+    hash ^= hash >> 32;
     return hash;
 }
 
 Uint32 SDL_HashString(const void *key, void *data)
 {
     const char *str = (const char *)key;
-    return hash_string_djbxor(str, SDL_strlen(str));
+    size_t len = SDL_strlen(str);
+    Uint64 hash = HASH_PRIME2 ^ (Uint64)len;
+    Uint64 word;
+
+    while (len >= sizeof(word)) {
+        SDL_memcpy(&word, str, sizeof(word));
+        hash = hash_round64(hash, word);
+        str += sizeof(word);
+        len -= sizeof(word);
+    }
+
+    word = 0;
+    SDL_memcpy(&word, str, len);
+    hash = hash_round64(hash, word);
+
+    return (Uint32)hash_mix64(hash);
 }
 
 SDL_bool SDL_KeyMatchString(const void *a, const void *b, void *data)
@@ -261,7 +436,14 @@ SDL_COMPILE_TIME_ASSERT(SDL_HashID_KeySize, sizeof(Uint32) <= sizeof(const void
 
 Uint32 SDL_HashID(const void *key, void *unused)
 {
-    return (Uint32)(uintptr_t)key;
+    // IDs are usually small sequential integers, scramble them so they don't cluster in the low bits.
+    Uint32 hash = (Uint32)(uintptr_t)key;
+    hash ^= hash >> 16;
+    hash *= 0x21F0AAADu;
+    hash ^= hash >> 15;
+    hash *= 0x735A2D97u;
+    hash ^= hash >> 15;
+    return hash;
 }
 
 SDL_bool SDL_KeyMatchID(const void *a, const void *b, void *unused)
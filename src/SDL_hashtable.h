@@ -23,6 +23,10 @@
 
 /* this is not (currently) a public API. But maybe it should be! */
 
+/* The table uses open addressing and grows automatically, so num_buckets is
+   only the initial capacity. Inserting or removing items invalidates any
+   iterators into the table. */
+
 struct SDL_HashTable;
 typedef struct SDL_HashTable SDL_HashTable;
 typedef Uint32 (*SDL_HashTable_HashFn)(const void *key, void *data);
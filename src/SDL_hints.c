@@ -21,9 +21,15 @@
 #include "SDL_internal.h"
 
 #include "SDL_hints_c.h"
-
-/* Assuming there aren't many hints set and they aren't being queried in
-   critical performance paths, we'll just use linked lists here.
+#include "SDL_hashtable.h"
+
+/* Hints are kept in a hash table by name, along with a snapshot of the
+   environment variable of the same name, which is refreshed only after
+   SDL_setenv() changed the environment. Hints that are only ever read get an
+   entry too, so a missing hint or one only set in the environment can be
+   looked up again without calling getenv(). The hints lock only covers table
+   lookups; getenv() and allocations happen outside of it. Callbacks are always
+   called without the hints lock held, so they can get and set hints themselves.
  */
 typedef struct SDL_HintWatch
 {
@@ -34,66 +40,222 @@ typedef struct SDL_HintWatch
 
 typedef struct SDL_Hint
 {
-    char *name;
     char *value;
     SDL_HintPriority priority;
     SDL_HintWatch *callbacks;
-    struct SDL_Hint *next;
+    char *env_value;
+    int env_generation;
+    SDL_bool lookup_only; /* only added to remember the environment for SDL_GetHint() */
 } SDL_Hint;
 
-static SDL_Hint *SDL_hints;
+static SDL_HashTable *SDL_hints;
+static SDL_SpinLock SDL_hints_lock;
+static SDL_AtomicInt SDL_hint_generation = { 1 };
+
+static void SDL_NukeHint(const void *key, const void *value, void *data)
+{
+    SDL_Hint *hint = (SDL_Hint *)value;
+    SDL_HintWatch *entry;
+
+    SDL_free((void *)key);
+    SDL_free(hint->value);
+    SDL_free(hint->env_value);
+    for (entry = hint->callbacks; entry;) {
+        SDL_HintWatch *freeable = entry;
+        entry = entry->next;
+        SDL_free(freeable);
+    }
+    SDL_free(hint);
+}
+
+/* This must be called with SDL_hints_lock held */
+static SDL_Hint *SDL_FindHint(const char *name)
+{
+    SDL_Hint *hint = NULL;
+
+    if (SDL_hints) {
+        SDL_FindInHashTable(SDL_hints, name, (const void **)&hint);
+    }
+    return hint;
+}
+
+/* Make sure there is an entry for the hint, allocating it without SDL_hints_lock held */
+static SDL_bool SDL_AddHint(const char *name, SDL_bool lookup_only)
+{
+    SDL_HashTable *table = NULL;
+    SDL_Hint *hint;
+    char *key;
+    SDL_bool need_table;
+    SDL_bool result;
+
+    SDL_LockSpinlock(&SDL_hints_lock);
+    hint = SDL_FindHint(name);
+    if (hint && !lookup_only) {
+        hint->lookup_only = SDL_FALSE;
+    }
+    result = hint ? SDL_TRUE : SDL_FALSE;
+    need_table = SDL_hints ? SDL_FALSE : SDL_TRUE;
+    SDL_UnlockSpinlock(&SDL_hints_lock);
+
+    if (result) {
+        return SDL_TRUE;
+    }
+
+    hint = (SDL_Hint *)SDL_calloc(1, sizeof(*hint));
+    key = SDL_strdup(name);
+    if (need_table) {
+        table = SDL_CreateHashTable(NULL, 32, SDL_HashString, SDL_KeyMatchString, SDL_NukeHint, SDL_FALSE);
+    }
+    if (!hint || !key || (need_table && !table)) {
+        SDL_free(hint);
+        SDL_free(key);
+        SDL_DestroyHashTable(table);
+        return SDL_FALSE;
+    }
+    hint->priority = SDL_HINT_DEFAULT;
+    hint->env_generation = SDL_GetEnvironmentGeneration() - 1;
+    hint->lookup_only = lookup_only;
+
+    /* Another thread may have added the same hint in the meantime */
+    SDL_LockSpinlock(&SDL_hints_lock);
+    if (!SDL_hints) {
+        SDL_hints = table;
+        table = NULL;
+    }
+    result = SDL_TRUE;
+    if (SDL_hints) {
+        SDL_Hint *existing = SDL_FindHint(name);
+        if (existing) {
+            if (!lookup_only) {
+                existing->lookup_only = SDL_FALSE;
+            }
+        } else if (SDL_InsertIntoHashTable(SDL_hints, key, hint)) {
+            hint = NULL;
+            key = NULL;
+        } else {
+            result = SDL_FALSE;
+        }
+    }
+    SDL_UnlockSpinlock(&SDL_hints_lock);
+
+    SDL_free(hint);
+    SDL_free(key);
+    SDL_DestroyHashTable(table);
+    return result;
+}
+
+/* Refresh the copy of the environment variable if the environment changed since it was taken.
+   The copy is only replaced if the value itself changed, so a pointer returned by SDL_GetHint()
+   isn't invalidated by SDL_setenv() calls for other variables.
+ */
+static void SDL_UpdateHintEnvironment(const char *name)
+{
+    const int generation = SDL_GetEnvironmentGeneration();
+    const char *env;
+    char *env_value;
+    char *old_value = NULL;
+    SDL_Hint *hint;
+    SDL_bool stale;
+
+    SDL_LockSpinlock(&SDL_hints_lock);
+    hint = SDL_FindHint(name);
+    stale = (hint && hint->env_generation != generation) ? SDL_TRUE : SDL_FALSE;
+    SDL_UnlockSpinlock(&SDL_hints_lock);
+
+    if (!stale) {
+        return;
+    }
+
+    env = SDL_getenv(name);
+    env_value = env ? SDL_strdup(env) : NULL;
+    if (env && !env_value) {
+        return;
+    }
+
+    SDL_LockSpinlock(&SDL_hints_lock);
+    hint = SDL_FindHint(name);
+    if (hint && hint->env_generation != generation) {
+        if (!env_value != !hint->env_value ||
+            (env_value && SDL_strcmp(env_value, hint->env_value) != 0)) {
+            old_value = hint->env_value;
+            hint->env_value = env_value;
+            env_value = NULL;
+        }
+        hint->env_generation = generation;
+    }
+    SDL_UnlockSpinlock(&SDL_hints_lock);
+
+    SDL_free(env_value);
+    SDL_free(old_value);
+}
+
+static void SDL_CallHintCallbacks(SDL_HintWatch *entry, const char *name, const char *old_value, const char *new_value)
+{
+    while (entry) {
+        /* Save the next entry in case this one is deleted */
+        SDL_HintWatch *next = entry->next;
+        entry->callback(entry->userdata, name, old_value, new_value);
+        entry = next;
+    }
+}
 
 SDL_bool SDL_SetHintWithPriority(const char *name, const char *value, SDL_HintPriority priority)
 {
     const char *env;
     SDL_Hint *hint;
-    SDL_HintWatch *entry;
+    SDL_HintWatch *callbacks = NULL;
+    char *old_value = NULL;
+    char *new_value = NULL;
+    SDL_bool changed = SDL_FALSE;
 
     if (!name) {
         return SDL_FALSE;
     }
 
-    env = SDL_getenv(name);
-    if (env && priority < SDL_HINT_OVERRIDE) {
+    if (!SDL_AddHint(name, SDL_FALSE)) {
         return SDL_FALSE;
     }
+    SDL_UpdateHintEnvironment(name);
 
-    for (hint = SDL_hints; hint; hint = hint->next) {
-        if (SDL_strcmp(name, hint->name) == 0) {
-            if (priority < hint->priority) {
-                return SDL_FALSE;
-            }
-            if (hint->value != value &&
-                (!value || !hint->value || SDL_strcmp(hint->value, value) != 0)) {
-                char *old_value = hint->value;
-
-                hint->value = value ? SDL_strdup(value) : NULL;
-                for (entry = hint->callbacks; entry;) {
-                    /* Save the next entry in case this one is deleted */
-                    SDL_HintWatch *next = entry->next;
-                    entry->callback(entry->userdata, name, old_value, value);
-                    entry = next;
-                }
-                if (old_value) {
-                    SDL_free(old_value);
-                }
-            }
-            hint->priority = priority;
-            return SDL_TRUE;
+    if (value) {
+        new_value = SDL_strdup(value);
+        if (!new_value) {
+            return SDL_FALSE;
         }
     }
 
-    /* Couldn't find the hint, add a new one */
-    hint = (SDL_Hint *)SDL_malloc(sizeof(*hint));
+    SDL_LockSpinlock(&SDL_hints_lock);
+    hint = SDL_FindHint(name);
     if (!hint) {
+        SDL_UnlockSpinlock(&SDL_hints_lock);
+        SDL_free(new_value);
         return SDL_FALSE;
     }
-    hint->name = SDL_strdup(name);
-    hint->value = value ? SDL_strdup(value) : NULL;
+
+    env = hint->env_value;
+    if ((env && priority < SDL_HINT_OVERRIDE) || priority < hint->priority) {
+        SDL_UnlockSpinlock(&SDL_hints_lock);
+        SDL_free(new_value);
+        return SDL_FALSE;
+    }
+
+    if (hint->value != value &&
+        (!value || !hint->value || SDL_strcmp(hint->value, value) != 0)) {
+        old_value = hint->value;
+        hint->value = new_value;
+        new_value = NULL;
+        callbacks = hint->callbacks;
+        changed = SDL_TRUE;
+        SDL_AtomicIncRef(&SDL_hint_generation);
+    }
     hint->priority = priority;
-    hint->callbacks = NULL;
-    hint->next = SDL_hints;
-    SDL_hints = hint;
+    SDL_UnlockSpinlock(&SDL_hints_lock);
+
+    SDL_free(new_value);
+    if (changed) {
+        SDL_CallHintCallbacks(callbacks, name, old_value, value);
+        SDL_free(old_value);
+    }
     return SDL_TRUE;
 }
 
@@ -101,56 +263,88 @@ SDL_bool SDL_ResetHint(const char *name)
 {
     const char *env;
     SDL_Hint *hint;
-    SDL_HintWatch *entry;
+    SDL_HintWatch *callbacks = NULL;
+    char *old_value;
 
     if (!name) {
         return SDL_FALSE;
     }
 
-    env = SDL_getenv(name);
-    for (hint = SDL_hints; hint; hint = hint->next) {
-        if (SDL_strcmp(name, hint->name) == 0) {
-            if ((!env && hint->value) ||
-                (env && !hint->value) ||
-                (env && SDL_strcmp(env, hint->value) != 0)) {
-                for (entry = hint->callbacks; entry;) {
-                    /* Save the next entry in case this one is deleted */
-                    SDL_HintWatch *next = entry->next;
-                    entry->callback(entry->userdata, name, hint->value, env);
-                    entry = next;
-                }
+    SDL_UpdateHintEnvironment(name);
+
+    SDL_LockSpinlock(&SDL_hints_lock);
+    hint = SDL_FindHint(name);
+    if (!hint || hint->lookup_only) {
+        SDL_UnlockSpinlock(&SDL_hints_lock);
+        return SDL_FALSE;
+    }
+
+    env = hint->env_value;
+    old_value = hint->value;
+    if ((!env && old_value) ||
+        (env && !old_value) ||
+        (env && SDL_strcmp(env, old_value) != 0)) {
+        callbacks = hint->callbacks;
+    }
+    hint->value = NULL;
+    hint->priority = SDL_HINT_DEFAULT;
+    SDL_AtomicIncRef(&SDL_hint_generation);
+    SDL_UnlockSpinlock(&SDL_hints_lock);
+
+    SDL_CallHintCallbacks(callbacks, name, old_value, env);
+    SDL_free(old_value);
+    return SDL_TRUE;
+}
+
+static int SDL_CollectHintNames(const char **names, int max_names)
+{
+    int num_names = 0;
+
+    SDL_LockSpinlock(&SDL_hints_lock);
+    if (SDL_hints) {
+        const void *key;
+        const void *value;
+        void *iter = NULL;
+
+        while (SDL_IterateHashTable(SDL_hints, &key, &value, &iter)) {
+            if (num_names < max_names) {
+                names[num_names] = (const char *)key;
             }
-            SDL_free(hint->value);
-            hint->value = NULL;
-            hint->priority = SDL_HINT_DEFAULT;
-            return SDL_TRUE;
+            ++num_names;
         }
     }
-    return SDL_FALSE;
+    SDL_UnlockSpinlock(&SDL_hints_lock);
+
+    return num_names;
 }
 
 void SDL_ResetHints(void)
 {
-    const char *env;
-    SDL_Hint *hint;
-    SDL_HintWatch *entry;
-
-    for (hint = SDL_hints; hint; hint = hint->next) {
-        env = SDL_getenv(hint->name);
-        if ((!env && hint->value) ||
-            (env && !hint->value) ||
-            (env && SDL_strcmp(env, hint->value) != 0)) {
-            for (entry = hint->callbacks; entry;) {
-                /* Save the next entry in case this one is deleted */
-                SDL_HintWatch *next = entry->next;
-                entry->callback(entry->userdata, hint->name, hint->value, env);
-                entry = next;
-            }
+    const char **names = NULL;
+    int num_names = 0;
+    int max_names;
+    int i;
+
+    /* Callbacks can add hints, so collect the names first and reset them one at a time.
+       The names are owned by the hint table and stay valid until SDL_ClearHints().
+       The array is allocated without the lock held, so retry if hints were added meanwhile. */
+    for (;;) {
+        max_names = num_names;
+        num_names = SDL_CollectHintNames(names, max_names);
+        if (num_names <= max_names) {
+            break;
         }
-        SDL_free(hint->value);
-        hint->value = NULL;
-        hint->priority = SDL_HINT_DEFAULT;
+        SDL_free(names);
+        names = (const char **)SDL_malloc(num_names * sizeof(*names));
+        if (!names) {
+            return;
+        }
+    }
+
+    for (i = 0; i < num_names; ++i) {
+        SDL_ResetHint(names[i]);
     }
+    SDL_free(names);
 }
 
 SDL_bool SDL_SetHint(const char *name, const char *value)
@@ -158,21 +352,59 @@ SDL_bool SDL_SetHint(const char *name, const char *value)
     return SDL_SetHintWithPriority(name, value, SDL_HINT_NORMAL);
 }
 
+/* This must be called with SDL_hints_lock held */
+static const char *SDL_GetHintValue(SDL_Hint *hint)
+{
+    const char *env = hint->env_value;
+
+    if (!env || hint->priority == SDL_HINT_OVERRIDE) {
+        return hint->value;
+    }
+    return env;
+}
+
 const char *SDL_GetHint(const char *name)
 {
-    const char *env;
+    const int generation = SDL_GetEnvironmentGeneration();
+    const char *value = NULL;
     SDL_Hint *hint;
+    SDL_bool found;
 
-    env = SDL_getenv(name);
-    for (hint = SDL_hints; hint; hint = hint->next) {
-        if (SDL_strcmp(name, hint->name) == 0) {
-            if (!env || hint->priority == SDL_HINT_OVERRIDE) {
-                return hint->value;
-            }
-            break;
-        }
+    if (!name) {
+        return NULL;
     }
-    return env;
+
+    /* Usually the environment snapshot is current and this is a single lookup */
+    SDL_LockSpinlock(&SDL_hints_lock);
+    hint = SDL_FindHint(name);
+    found = (hint && hint->env_generation == generation) ? SDL_TRUE : SDL_FALSE;
+    if (found) {
+        value = SDL_GetHintValue(hint);
+    }
+    SDL_UnlockSpinlock(&SDL_hints_lock);
+
+    if (found) {
+        return value;
+    }
+
+    if (!hint && !SDL_AddHint(name, SDL_TRUE)) {
+        return SDL_getenv(name);
+    }
+    SDL_UpdateHintEnvironment(name);
+
+    SDL_LockSpinlock(&SDL_hints_lock);
+    hint = SDL_FindHint(name);
+    if (hint) {
+        value = SDL_GetHintValue(hint);
+    }
+    SDL_UnlockSpinlock(&SDL_hints_lock);
+
+    return value;
+}
+
+int SDL_GetHintGeneration(void)
+{
+    return SDL_AtomicGet(&SDL_hint_generation) + SDL_GetEnvironmentGeneration();
 }
 
 int SDL_GetStringInteger(const char *value, int default_value)
@@ -209,6 +441,21 @@ SDL_bool SDL_GetHintBoolean(const char *name, SDL_bool default_value)
     return SDL_GetStringBoolean(hint, default_value);
 }
 
+SDL_bool SDL_GetCachedHintBoolean(const char *name, SDL_bool default_value, SDL_CachedHintBoolean *cache)
+{
+    /* Read the generation first, so a change that races us just causes another refresh next time.
+       The low bit of the state is the value, the rest is the generation it was read at. */
+    const Uint32 generation = ((Uint32)SDL_GetHintGeneration() << 1);
+    Uint32 state = (Uint32)SDL_AtomicGet(&cache->state);
+
+    if ((state & ~1u) != generation) {
+        const SDL_bool value = SDL_GetHintBoolean(name, default_value);
+        state = generation | (value ? 1u : 0u);
+        SDL_AtomicSet(&cache->state, (int)state);
+    }
+    return (state & 1u) ? SDL_TRUE : SDL_FALSE;
+}
+
 int SDL_AddHintCallback(const char *name, SDL_HintCallback callback, void *userdata)
 {
     SDL_Hint *hint;
@@ -231,34 +478,23 @@ int SDL_AddHintCallback(const char *name, SDL_HintCallback callback, void *userd
     entry->callback = callback;
     entry->userdata = userdata;
 
-    for (hint = SDL_hints; hint; hint = hint->next) {
-        if (SDL_strcmp(name, hint->name) == 0) {
-            break;
-        }
+    if (!SDL_AddHint(name, SDL_FALSE)) {
+        SDL_free(entry);
+        return -1;
     }
+
+    SDL_LockSpinlock(&SDL_hints_lock);
+    hint = SDL_FindHint(name);
     if (!hint) {
-        /* Need to add a hint entry for this watcher */
-        hint = (SDL_Hint *)SDL_malloc(sizeof(*hint));
-        if (!hint) {
-            SDL_free(entry);
-            return -1;
-        }
-        hint->name = SDL_strdup(name);
-        if (!hint->name) {
-            SDL_free(entry);
-            SDL_free(hint);
-            return -1;
-        }
-        hint->value = NULL;
-        hint->priority = SDL_HINT_DEFAULT;
-        hint->callbacks = NULL;
-        hint->next = SDL_hints;
-        SDL_hints = hint;
+        SDL_UnlockSpinlock(&SDL_hints_lock);
+        SDL_free(entry);
+        return -1;
     }
 
     /* Add it to the callbacks for this hint */
     entry->next = hint->callbacks;
     hint->callbacks = entry;
+    SDL_UnlockSpinlock(&SDL_hints_lock);
 
     /* Now call it with the current value */
     value = SDL_GetHint(name);
@@ -271,42 +507,39 @@ void SDL_DelHintCallback(const char *name, SDL_HintCallback callback, void *user
     SDL_Hint *hint;
     SDL_HintWatch *entry, *prev;
 
-    for (hint = SDL_hints; hint; hint = hint->next) {
-        if (SDL_strcmp(name, hint->name) == 0) {
-            prev = NULL;
-            for (entry = hint->callbacks; entry; entry = entry->next) {
-                if (callback == entry->callback && userdata == entry->userdata) {
-                    if (prev) {
-                        prev->next = entry->next;
-                    } else {
-                        hint->callbacks = entry->next;
-                    }
-                    SDL_free(entry);
-                    break;
+    if (!name) {
+        return;
+    }
+
+    SDL_LockSpinlock(&SDL_hints_lock);
+    hint = SDL_FindHint(name);
+    if (hint) {
+        prev = NULL;
+        for (entry = hint->callbacks; entry; entry = entry->next) {
+            if (callback == entry->callback && userdata == entry->userdata) {
+                if (prev) {
+                    prev->next = entry->next;
+                } else {
+                    hint->callbacks = entry->next;
                 }
-                prev = entry;
+                SDL_free(entry);
+                break;
             }
-            return;
+            prev = entry;
         }
     }
+    SDL_UnlockSpinlock(&SDL_hints_lock);
 }
 
 void SDL_ClearHints(void)
 {
-    SDL_Hint *hint;
-    SDL_HintWatch *entry;
+    SDL_HashTable *hints;
 
-    while (SDL_hints) {
-        hint = SDL_hints;
-        SDL_hints = hint->next;
+    SDL_LockSpinlock(&SDL_hints_lock);
+    hints = SDL_hints;
+    SDL_hints = NULL;
+    SDL_AtomicIncRef(&SDL_hint_generation);
+    SDL_UnlockSpinlock(&SDL_hints_lock);
 
-        SDL_free(hint->name);
-        SDL_free(hint->value);
-        for (entry = hint->callbacks; entry;) {
-            SDL_HintWatch *freeable = entry;
-            entry = entry->next;
-            SDL_free(freeable);
-        }
-        SDL_free(hint);
-    }
+    SDL_DestroyHashTable(hints);
 }
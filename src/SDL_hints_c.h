@@ -25,8 +25,20 @@
 #ifndef SDL_hints_c_h_
 #define SDL_hints_c_h_
 
+/* A hint value that is only parsed again after a hint or the environment changed.
+   The generation and the value are packed into one atomic, so any thread can use it. */
+typedef struct SDL_CachedHintBoolean
+{
+    SDL_AtomicInt state;
+} SDL_CachedHintBoolean;
+
 extern SDL_bool SDL_GetStringBoolean(const char *value, SDL_bool default_value);
 extern int SDL_GetStringInteger(const char *value, int default_value);
+extern int SDL_GetHintGeneration(void);
+extern SDL_bool SDL_GetCachedHintBoolean(const char *name, SDL_bool default_value, SDL_CachedHintBoolean *cache);
 extern void SDL_ClearHints(void);
 
+/* This is bumped whenever SDL_setenv() changes the environment, see stdlib/SDL_getenv.c */
+extern int SDL_GetEnvironmentGeneration(void);
+
 #endif /* SDL_hints_c_h_ */
@@ -27,6 +27,8 @@
 /* Simple log messages in SDL */
 
 #include "SDL_log_c.h"
+#include "SDL_hints_c.h"
+#include "thread/SDL_systhread.h"
 
 #ifdef HAVE_STDIO_H
 #include <stdio.h>
@@ -43,6 +45,9 @@
 
 #define DEFAULT_CATEGORY -1
 
+/* The number of messages that can be waiting for the log thread, must be a power of two */
+#define SDL_LOG_QUEUE_SIZE 256
+
 typedef struct SDL_LogLevel
 {
     int category;
@@ -60,6 +65,45 @@ static SDL_LogOutputFunction SDL_log_function = SDL_LogOutput;
 static void *SDL_log_userdata = NULL;
 static SDL_Mutex *log_function_mutex = NULL;
 
+/* Asynchronous logging
+
+   Messages are formatted on the calling thread and pushed into a bounded
+   multi-producer, single-consumer ring. Each entry carries a sequence number:
+   entry N is free for position P when its sequence is P, and holds a message
+   for the log thread when its sequence is P + 1. Producers claim positions by
+   advancing the tail with a compare-and-swap, so logging never waits on the
+   output function. If the ring is full the message is dropped and counted,
+   and the log thread reports the number of dropped messages once it catches up.
+ */
+typedef struct SDL_LogQueueEntry
+{
+    SDL_AtomicInt sequence;
+    int category;
+    SDL_LogPriority priority;
+    char *allocated; /* set if the message didn't fit in text */
+    char text[SDL_MAX_LOG_MESSAGE_STACK];
+} SDL_LogQueueEntry;
+
+typedef struct SDL_LogQueue
+{
+    SDL_LogQueueEntry entries[SDL_LOG_QUEUE_SIZE];
+    SDL_AtomicInt tail;    /* the next position producers will claim */
+    SDL_AtomicInt drained; /* every position before this has been output */
+    SDL_AtomicInt dropped; /* messages dropped since the last report */
+    SDL_AtomicInt waiting; /* set while the log thread is waiting for messages */
+    SDL_AtomicInt quit;
+    Uint32 head; /* the next position to output, only used by the log thread */
+    SDL_Semaphore *wakeup;
+    SDL_Condition *drained_condition;
+    SDL_Thread *thread;
+    SDL_ThreadID thread_id;
+} SDL_LogQueue;
+
+static SDL_LogQueue *SDL_log_queue;
+static SDL_AtomicInt SDL_log_queue_users;
+static SDL_bool SDL_log_async_allowed = SDL_FALSE;
+static SDL_CachedHintBoolean SDL_log_async_hint;
+
 #ifdef HAVE_GCC_DIAGNOSTIC_PRAGMA
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-variable"
@@ -107,16 +151,272 @@ static int SDL_android_priority[SDL_NUM_LOG_PRIORITIES] = {
 };
 #endif /* SDL_PLATFORM_ANDROID */
 
+static void SDL_DrainLogQueue(SDL_LogQueue *queue)
+{
+    SDL_LogQueueEntry *entry;
+    const char *message;
+    int dropped;
+
+    SDL_LockMutex(log_function_mutex);
+    for (;;) {
+        entry = &queue->entries[queue->head & (SDL_LOG_QUEUE_SIZE - 1)];
+        if ((Uint32)SDL_AtomicGet(&entry->sequence) != queue->head + 1) {
+            break;
+        }
+
+        message = entry->allocated ? entry->allocated : entry->text;
+        if (SDL_log_function) {
+            SDL_log_function(SDL_log_userdata, entry->category, entry->priority, message);
+        }
+        if (entry->allocated) {
+            SDL_free(entry->allocated);
+            entry->allocated = NULL;
+        }
+
+        /* Hand the entry back to the producers for the next lap around the ring */
+        SDL_AtomicSet(&entry->sequence, (int)(queue->head + SDL_LOG_QUEUE_SIZE));
+        ++queue->head;
+    }
+
+    dropped = SDL_AtomicSet(&queue->dropped, 0);
+    if (dropped > 0 && SDL_log_function) {
+        char text[SDL_MAX_LOG_MESSAGE_STACK];
+
+        (void)SDL_snprintf(text, sizeof(text), "%d log messages were dropped because the log queue was full", dropped);
+        SDL_log_function(SDL_log_userdata, SDL_LOG_CATEGORY_SYSTEM, SDL_LOG_PRIORITY_WARN, text);
+    }
+
+    SDL_AtomicSet(&queue->drained, (int)queue->head);
+    SDL_BroadcastCondition(queue->drained_condition);
+    SDL_UnlockMutex(log_function_mutex);
+}
+
+static SDL_bool SDL_LogQueueIsEmpty(SDL_LogQueue *queue)
+{
+    SDL_LogQueueEntry *entry = &queue->entries[queue->head & (SDL_LOG_QUEUE_SIZE - 1)];
+
+    return (Uint32)SDL_AtomicGet(&entry->sequence) != queue->head + 1;
+}
+
+static int SDLCALL SDL_LogThread(void *data)
+{
+    SDL_LogQueue *queue = (SDL_LogQueue *)data;
+    SDL_bool quit;
+
+    queue->thread_id = SDL_GetCurrentThreadID();
+
+    for (;;) {
+        /* Everything queued before we were asked to quit gets output first */
+        quit = (SDL_AtomicGet(&queue->quit) != 0);
+        SDL_DrainLogQueue(queue);
+        if (quit) {
+            break;
+        }
+
+        /* Producers only post the semaphore if they see this flag set, so
+           check the queue again after setting it to avoid missing a wakeup. */
+        SDL_AtomicSet(&queue->waiting, 1);
+        if (SDL_LogQueueIsEmpty(queue) && !SDL_AtomicGet(&queue->quit)) {
+            SDL_WaitSemaphore(queue->wakeup);
+        }
+        SDL_AtomicSet(&queue->waiting, 0);
+    }
+    return 0;
+}
+
+static void SDL_WakeLogThread(SDL_LogQueue *queue)
+{
+    if (SDL_AtomicGet(&queue->waiting) && SDL_AtomicCompareAndSwap(&queue->waiting, 1, 0)) {
+        SDL_PostSemaphore(queue->wakeup);
+    }
+}
+
+static void SDL_DestroyLogQueue(SDL_LogQueue *queue)
+{
+    int i;
+
+    for (i = 0; i < SDL_LOG_QUEUE_SIZE; ++i) {
+        SDL_free(queue->entries[i].allocated);
+    }
+    SDL_DestroyCondition(queue->drained_condition);
+    SDL_DestroySemaphore(queue->wakeup);
+    SDL_free(queue);
+}
+
+static void SDL_StartLogThread(void)
+{
+    SDL_LogQueue *queue;
+    int i;
+
+    SDL_LockMutex(log_function_mutex);
+    if (SDL_log_async_allowed && !SDL_AtomicGetPtr((void **)&SDL_log_queue)) {
+        /* Anything logged while we're setting up, e.g. thread creation errors, is output directly */
+        SDL_log_async_allowed = SDL_FALSE;
+
+        queue = (SDL_LogQueue *)SDL_calloc(1, sizeof(*queue));
+        if (queue) {
+            for (i = 0; i < SDL_LOG_QUEUE_SIZE; ++i) {
+                SDL_AtomicSet(&queue->entries[i].sequence, i);
+            }
+            queue->wakeup = SDL_CreateSemaphore(0);
+            queue->drained_condition = SDL_CreateCondition();
+            if (queue->wakeup && queue->drained_condition) {
+                queue->thread = SDL_CreateThreadInternal(SDL_LogThread, "SDLLog", 0, queue);
+            }
+            if (queue->thread) {
+                SDL_AtomicSetPtr((void **)&SDL_log_queue, queue);
+                SDL_log_async_allowed = SDL_TRUE;
+            } else {
+                /* Leave asynchronous logging disabled rather than retrying for every message */
+                SDL_DestroyLogQueue(queue);
+            }
+        }
+    }
+    SDL_UnlockMutex(log_function_mutex);
+}
+
+static void SDL_StopLogThread(void)
+{
+    SDL_LogQueue *queue = (SDL_LogQueue *)SDL_AtomicSetPtr((void **)&SDL_log_queue, NULL);
+
+    if (!queue) {
+        return;
+    }
+
+    /* Wait for threads that are in the middle of queuing a message */
+    while (SDL_AtomicGet(&SDL_log_queue_users) > 0) {
+        SDL_Delay(1);
+    }
+
+    SDL_AtomicSet(&queue->quit, 1);
+    SDL_PostSemaphore(queue->wakeup);
+    SDL_WaitThread(queue->thread, NULL);
+    SDL_DestroyLogQueue(queue);
+}
+
+static SDL_LogQueue *SDL_AcquireLogQueue(void)
+{
+    SDL_LogQueue *queue;
+
+    SDL_AtomicIncRef(&SDL_log_queue_users);
+    queue = (SDL_LogQueue *)SDL_AtomicGetPtr((void **)&SDL_log_queue);
+    if (!queue) {
+        SDL_AtomicAdd(&SDL_log_queue_users, -1);
+    }
+    return queue;
+}
+
+static void SDL_ReleaseLogQueue(void)
+{
+    SDL_AtomicAdd(&SDL_log_queue_users, -1);
+}
+
+/* Wait until every message queued so far has been output */
+static void SDL_FlushLogQueue(void)
+{
+    SDL_LogQueue *queue;
+    Uint32 target;
+
+    if (!SDL_AtomicGetPtr((void **)&SDL_log_queue)) {
+        return;
+    }
+
+    queue = SDL_AcquireLogQueue();
+    if (!queue) {
+        return;
+    }
+
+    /* The log thread can't wait on itself, e.g. if the output function logs */
+    if (SDL_GetCurrentThreadID() != queue->thread_id) {
+        target = (Uint32)SDL_AtomicGet(&queue->tail);
+
+        SDL_LockMutex(log_function_mutex);
+        while ((int)((Uint32)SDL_AtomicGet(&queue->drained) - target) < 0) {
+            SDL_PostSemaphore(queue->wakeup);
+            SDL_WaitConditionTimeout(queue->drained_condition, log_function_mutex, 10);
+        }
+        SDL_UnlockMutex(log_function_mutex);
+    }
+    SDL_ReleaseLogQueue();
+}
+
+/* Queue a message for the log thread, taking ownership of it if it was allocated.
+   Returns SDL_FALSE if asynchronous logging isn't active and the caller should output the message itself. */
+static SDL_bool SDL_QueueLogMessage(int category, SDL_LogPriority priority, char *message, size_t length, SDL_bool allocated)
+{
+    SDL_LogQueue *queue;
+    SDL_LogQueueEntry *entry;
+    Uint32 position;
+    int diff;
+
+    if (!SDL_GetCachedHintBoolean(SDL_HINT_LOGGING_ASYNC, SDL_FALSE, &SDL_log_async_hint)) {
+        /* Make sure anything still queued is output before this message */
+        SDL_FlushLogQueue();
+        return SDL_FALSE;
+    }
+
+    if (!SDL_AtomicGetPtr((void **)&SDL_log_queue)) {
+        if (!SDL_log_async_allowed) {
+            return SDL_FALSE;
+        }
+        SDL_StartLogThread();
+    }
+
+    queue = SDL_AcquireLogQueue();
+    if (!queue) {
+        return SDL_FALSE;
+    }
+
+    position = (Uint32)SDL_AtomicGet(&queue->tail);
+    for (;;) {
+        entry = &queue->entries[position & (SDL_LOG_QUEUE_SIZE - 1)];
+        diff = (int)((Uint32)SDL_AtomicGet(&entry->sequence) - position);
+        if (diff == 0) {
+            if (SDL_AtomicCompareAndSwap(&queue->tail, (int)position, (int)(position + 1))) {
+                break;
+            }
+        } else if (diff < 0) {
+            /* The log thread is a full lap behind, drop the message rather than block */
+            SDL_AtomicIncRef(&queue->dropped);
+            if (allocated) {
+                SDL_free(message);
+            }
+            SDL_WakeLogThread(queue);
+            SDL_ReleaseLogQueue();
+            return SDL_TRUE;
+        }
+        position = (Uint32)SDL_AtomicGet(&queue->tail);
+    }
+
+    entry->category = category;
+    entry->priority = priority;
+    if (allocated) {
+        entry->allocated = message;
+    } else {
+        SDL_memcpy(entry->text, message, length + 1);
+    }
+    SDL_AtomicSet(&entry->sequence, (int)(position + 1));
+
+    SDL_WakeLogThread(queue);
+    SDL_ReleaseLogQueue();
+    return SDL_TRUE;
+}
+
 void SDL_InitLog(void)
 {
     if (!log_function_mutex) {
         /* if this fails we'll try to continue without it. */
         log_function_mutex = SDL_CreateMutex();
     }
+    SDL_log_async_allowed = SDL_TRUE;
 }
 
 void SDL_QuitLog(void)
 {
+    /* Output everything that's still queued before shutting down */
+    SDL_log_async_allowed = SDL_FALSE;
+    SDL_StopLogThread();
+
     SDL_LogResetPriorities();
     if (log_function_mutex) {
         SDL_DestroyMutex(log_function_mutex);
@@ -446,6 +746,10 @@ void SDL_LogMessageV(int category, SDL_LogPriority priority, SDL_PRINTF_FORMAT_S
         }
     }
 
+    if (SDL_QueueLogMessage(category, priority, message, (size_t)len, (message != stack_buf))) {
+        return;
+    }
+
     SDL_LockMutex(log_function_mutex);
     SDL_log_function(SDL_log_userdata, category, priority, message);
     SDL_UnlockMutex(log_function_mutex);
@@ -596,16 +900,24 @@ static void SDLCALL SDL_LogOutput(void *userdata, int category, SDL_LogPriority
 
 void SDL_LogGetOutputFunction(SDL_LogOutputFunction *callback, void **userdata)
 {
+    SDL_LockMutex(log_function_mutex);
     if (callback) {
         *callback = SDL_log_function;
     }
     if (userdata) {
         *userdata = SDL_log_userdata;
     }
+    SDL_UnlockMutex(log_function_mutex);
 }
 
 void SDL_LogSetOutputFunction(SDL_LogOutputFunction callback, void *userdata)
 {
+    /* Messages that were queued before this call go to the previous output function */
+    SDL_FlushLogQueue();
+
+    /* The log thread reads the pair under the same lock */
+    SDL_LockMutex(log_function_mutex);
     SDL_log_function = callback;
     SDL_log_userdata = userdata;
+    SDL_UnlockMutex(log_function_mutex);
 }
@@ -1,5 +1,5 @@
 /*
-  Simple DiretMedia Layer
+  Simple DirectMedia Layer
   Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
 
   This software is provided 'as-is', without any express or implied
@@ -23,18 +23,35 @@
 #include "SDL_hints_c.h"
 #include "SDL_properties_c.h"
 
+/* Property names are interned into atoms, and each set of properties is an
+ * open addressing table keyed by atom, with the values stored inline.
+ *
+ * Writers are serialized by the per-set mutex and bump a sequence number
+ * around every change, so readers can copy a value out without taking any
+ * lock and just retry if the sequence changed under them. While
+ * SDL_LockProperties() has a batch of changes open, readers take the lock
+ * instead, so they never see half of the batch. Tables that are replaced
+ * when growing are kept alive until the set is destroyed, so a reader that
+ * is still looking at an old table never touches freed memory.
+ *
+ * The sets themselves are looked up by ID in a registry that is one of
+ * these tables too, keyed by SDL_PropertiesID instead of atom.
+ */
+
+typedef union
+{
+    void *pointer_value;
+    char *string_value;
+    Sint64 number_value;
+    float float_value;
+    SDL_bool boolean_value;
+} SDL_PropertyValue;
 
 typedef struct
 {
     SDL_PropertyType type;
 
-    union {
-        void *pointer_value;
-        char *string_value;
-        Sint64 number_value;
-        float float_value;
-        SDL_bool boolean_value;
-    } value;
+    SDL_PropertyValue value;
 
     char *string_storage;
 
@@ -44,71 +61,460 @@ typedef struct
 
 typedef struct
 {
-    SDL_HashTable *props;
+    SDL_PropertyAtom atom;  /* 0 if the slot is empty */
+    const char *name;
+    SDL_Property property;
+} SDL_PropertySlot;
+
+typedef struct SDL_PropertySlots
+{
+    Uint32 mask;
+    struct SDL_PropertySlots *retired;
+    SDL_PropertySlot slots[1];
+} SDL_PropertySlots;
+
+typedef struct
+{
+    SDL_PropertySlots *slots;
+    Uint32 count;
+    SDL_AtomicInt sequence;
+    SDL_AtomicInt batches;  /* nesting depth of SDL_LockProperties() */
     SDL_Mutex *lock;
 } SDL_Properties;
 
-static SDL_HashTable *SDL_properties;
-static SDL_Mutex *SDL_properties_lock;
+typedef struct
+{
+    Uint32 hash;
+    SDL_PropertyAtom atom;  /* 0 if the slot is empty */
+    const char *name;
+} SDL_PropertyName;
+
+typedef struct SDL_PropertyNames
+{
+    Uint32 mask;
+    struct SDL_PropertyNames *retired;
+    SDL_PropertyName names[1];
+} SDL_PropertyNames;
+
+#define SDL_PROPERTIES_INITIAL_SIZE 8
+
+static SDL_Properties *SDL_properties;
 static SDL_PropertiesID SDL_last_properties_id;
 static SDL_PropertiesID SDL_global_properties;
 
+static SDL_PropertyNames *SDL_property_names;
+static SDL_Mutex *SDL_property_names_lock;
+static Uint32 SDL_num_property_names;
+static SDL_PropertyAtom SDL_last_property_atom;
 
-static void SDL_FreePropertyWithCleanup(const void *key, const void *value, void *data, SDL_bool cleanup)
+
+static void SDL_FreePropertyWithCleanup(SDL_Property *property, SDL_bool cleanup)
 {
-    SDL_Property *property = (SDL_Property *)value;
-    if (property) {
-        switch (property->type) {
-        case SDL_PROPERTY_TYPE_POINTER:
-            if (property->cleanup && cleanup) {
-                property->cleanup(property->userdata, property->value.pointer_value);
-            }
-            break;
-        case SDL_PROPERTY_TYPE_STRING:
-            SDL_free(property->value.string_value);
+    switch (property->type) {
+    case SDL_PROPERTY_TYPE_POINTER:
+        if (property->cleanup && cleanup) {
+            property->cleanup(property->userdata, property->value.pointer_value);
+        }
+        break;
+    case SDL_PROPERTY_TYPE_STRING:
+        SDL_free(property->value.string_value);
+        break;
+    default:
+        break;
+    }
+    if (property->string_storage) {
+        SDL_free(property->string_storage);
+    }
+}
+
+static SDL_PropertySlots *SDL_CreatePropertySlots(Uint32 size)
+{
+    SDL_PropertySlots *slots = (SDL_PropertySlots *)SDL_calloc(1, sizeof(*slots) + (size - 1) * sizeof(slots->slots[0]));
+    if (slots) {
+        slots->mask = size - 1;
+    }
+    return slots;
+}
+
+static void SDL_DestroyPropertySlots(SDL_PropertySlots *slots)
+{
+    while (slots) {
+        SDL_PropertySlots *retired = slots->retired;
+        SDL_free(slots);
+        slots = retired;
+    }
+}
+
+static SDL_PropertySlot *SDL_FindPropertySlot(SDL_PropertySlots *slots, SDL_PropertyAtom atom)
+{
+    Uint32 i = atom & slots->mask;
+    Uint32 n;
+
+    /* The table is never full, but bound the walk anyway, since lock-free readers may see it mid-change */
+    for (n = 0; n <= slots->mask; ++n) {
+        SDL_PropertySlot *slot = &slots->slots[i];
+        if (slot->atom == atom) {
+            return slot;
+        }
+        if (slot->atom == 0) {
             break;
-        default:
+        }
+        i = (i + 1) & slots->mask;
+    }
+    return NULL;
+}
+
+static SDL_PropertySlot *SDL_FindEmptyPropertySlot(SDL_PropertySlots *slots, SDL_PropertyAtom atom)
+{
+    Uint32 i = atom & slots->mask;
+
+    while (slots->slots[i].atom != 0) {
+        i = (i + 1) & slots->mask;
+    }
+    return &slots->slots[i];
+}
+
+static void SDL_RemovePropertySlot(SDL_PropertySlots *slots, SDL_PropertySlot *slot)
+{
+    Uint32 i = (Uint32)(slot - slots->slots);
+    Uint32 j = i;
+
+    /* Shift following entries back into the hole, so lookups don't stop early */
+    for (;;) {
+        SDL_PropertySlot *next;
+        Uint32 home;
+
+        j = (j + 1) & slots->mask;
+        next = &slots->slots[j];
+        if (next->atom == 0) {
             break;
         }
-        if (property->string_storage) {
-            SDL_free(property->string_storage);
+
+        /* Entries whose home slot lies cyclically in (i, j] have to stay where they are */
+        home = next->atom & slots->mask;
+        if ((i <= j) ? ((i < home) && (home <= j)) : ((i < home) || (home <= j))) {
+            continue;
         }
+
+        slots->slots[i] = *next;
+        i = j;
     }
-    SDL_free((void *)key);
-    SDL_free((void *)value);
+    SDL_zero(slots->slots[i]);
 }
 
-static void SDL_FreeProperty(const void *key, const void *value, void *data)
+/* Must be called with properties->lock held and outside of a write, since readers may still use the old table */
+static SDL_bool SDL_GrowPropertySlots(SDL_Properties *properties)
 {
-    SDL_FreePropertyWithCleanup(key, value, data, SDL_TRUE);
+    SDL_PropertySlots *old_slots = properties->slots;
+    SDL_PropertySlots *new_slots;
+    Uint32 i;
+
+    if ((properties->count + 1) <= ((old_slots->mask + 1) / 4) * 3) {
+        return SDL_TRUE;
+    }
+
+    new_slots = SDL_CreatePropertySlots((old_slots->mask + 1) * 2);
+    if (!new_slots) {
+        return SDL_FALSE;
+    }
+    for (i = 0; i <= old_slots->mask; ++i) {
+        SDL_PropertySlot *slot = &old_slots->slots[i];
+        if (slot->atom) {
+            *SDL_FindEmptyPropertySlot(new_slots, slot->atom) = *slot;
+        }
+    }
+    new_slots->retired = old_slots;
+
+    /* Make sure the new table is complete before readers can see it */
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSetPtr((void **)&properties->slots, new_slots);
+    return SDL_TRUE;
 }
 
-static void SDL_FreeProperties(const void *key, const void *value, void *data)
+static void SDL_BeginPropertiesWrite(SDL_Properties *properties)
 {
-    SDL_Properties *properties = (SDL_Properties *)value;
-    if (properties) {
-        if (properties->props) {
-            SDL_DestroyHashTable(properties->props);
-            properties->props = NULL;
+    SDL_AtomicIncRef(&properties->sequence);
+    SDL_MemoryBarrierRelease();
+}
+
+static void SDL_EndPropertiesWrite(SDL_Properties *properties)
+{
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicIncRef(&properties->sequence);
+}
+
+static SDL_PropertyType SDL_ReadPropertyLocked(SDL_Properties *properties, SDL_PropertyAtom atom, SDL_PropertyValue *value)
+{
+    SDL_PropertyType type = SDL_PROPERTY_TYPE_INVALID;
+    SDL_PropertySlot *slot;
+
+    SDL_LockMutex(properties->lock);
+    slot = SDL_FindPropertySlot(properties->slots, atom);
+    if (slot) {
+        type = slot->property.type;
+        *value = slot->property.value;
+    }
+    SDL_UnlockMutex(properties->lock);
+
+    return type;
+}
+
+/* Copy a property value out of a set without taking its lock, unless a batch of changes is open */
+static SDL_PropertyType SDL_ReadProperty(SDL_Properties *properties, SDL_PropertyAtom atom, SDL_PropertyValue *value)
+{
+    for (;;) {
+        const int sequence = SDL_AtomicGet(&properties->sequence);
+        SDL_PropertyType type = SDL_PROPERTY_TYPE_INVALID;
+        SDL_PropertySlot *slot;
+
+        if (sequence & 1) {
+            /* A write is in progress */
+            SDL_CPUPauseInstruction();
+            continue;
         }
-        if (properties->lock) {
-            SDL_DestroyMutex(properties->lock);
-            properties->lock = NULL;
+
+        /* The batch count is raised before the first change of the batch bumps the sequence,
+           so a reader that could see any of those changes sees the batch here too, and waits
+           for it to be finished. The lock is recursive, so the thread holding it gets through. */
+        if (SDL_AtomicGet(&properties->batches) > 0) {
+            return SDL_ReadPropertyLocked(properties, atom, value);
         }
+
+        SDL_MemoryBarrierAcquire();
+        slot = SDL_FindPropertySlot((SDL_PropertySlots *)SDL_AtomicGetPtr((void **)&properties->slots), atom);
+        if (slot) {
+            type = slot->property.type;
+            *value = slot->property.value;
+        }
+        SDL_MemoryBarrierAcquire();
+
+        if (SDL_AtomicGet(&properties->sequence) == sequence) {
+            return type;
+        }
+    }
+}
+
+/* Replace, or remove if property is NULL, a property in a set. The old value is returned in old_property. */
+static int SDL_WriteProperty(SDL_Properties *properties, SDL_PropertyAtom atom, const char *name, const SDL_Property *property, SDL_Property *old_property)
+{
+    SDL_PropertySlot *slot;
+    int result = 0;
+
+    SDL_zerop(old_property);
+
+    SDL_LockMutex(properties->lock);
+    {
+        slot = SDL_FindPropertySlot(properties->slots, atom);
+        if (!slot && property) {
+            if (!SDL_GrowPropertySlots(properties)) {
+                result = -1;
+            }
+        }
+
+        if (result == 0) {
+            SDL_BeginPropertiesWrite(properties);
+            if (slot) {
+                *old_property = slot->property;
+                if (property) {
+                    slot->property = *property;
+                } else {
+                    SDL_RemovePropertySlot(properties->slots, slot);
+                    --properties->count;
+                }
+            } else if (property) {
+                slot = SDL_FindEmptyPropertySlot(properties->slots, atom);
+                slot->name = name;
+                slot->property = *property;
+                slot->atom = atom;
+                ++properties->count;
+            }
+            SDL_EndPropertiesWrite(properties);
+        }
+    }
+    SDL_UnlockMutex(properties->lock);
+
+    return result;
+}
+
+static SDL_Properties *SDL_AllocProperties(void)
+{
+    SDL_Properties *properties = (SDL_Properties *)SDL_calloc(1, sizeof(*properties));
+    if (!properties) {
+        return NULL;
+    }
+    properties->slots = SDL_CreatePropertySlots(SDL_PROPERTIES_INITIAL_SIZE);
+    if (!properties->slots) {
+        SDL_free(properties);
+        return NULL;
+    }
+    properties->lock = SDL_CreateMutex();
+    if (!properties->lock) {
+        SDL_DestroyPropertySlots(properties->slots);
         SDL_free(properties);
+        return NULL;
+    }
+    return properties;
+}
+
+static void SDL_FreeProperties(SDL_Properties *properties)
+{
+    if (properties) {
+        SDL_PropertySlots *slots = properties->slots;
+        Uint32 i;
+
+        for (i = 0; i <= slots->mask; ++i) {
+            if (slots->slots[i].atom) {
+                SDL_FreePropertyWithCleanup(&slots->slots[i].property, SDL_TRUE);
+            }
+        }
+        SDL_DestroyPropertySlots(slots);
+        SDL_DestroyMutex(properties->lock);
+        SDL_free(properties);
+    }
+}
+
+static void SDLCALL CleanupProperties(void *userdata, void *value)
+{
+    SDL_FreeProperties((SDL_Properties *)value);
+}
+
+static SDL_Properties *SDL_GetPropertiesObject(SDL_PropertiesID props)
+{
+    SDL_PropertyValue value;
+
+    if (!props || !SDL_properties) {
+        return NULL;
+    }
+    if (SDL_ReadProperty(SDL_properties, props, &value) != SDL_PROPERTY_TYPE_POINTER) {
+        return NULL;
+    }
+    return (SDL_Properties *)value.pointer_value;
+}
+
+static SDL_PropertyNames *SDL_CreatePropertyNames(Uint32 size)
+{
+    SDL_PropertyNames *names = (SDL_PropertyNames *)SDL_calloc(1, sizeof(*names) + (size - 1) * sizeof(names->names[0]));
+    if (names) {
+        names->mask = size - 1;
+    }
+    return names;
+}
+
+static SDL_PropertyName *SDL_FindPropertyName(SDL_PropertyNames *names, const char *name, Uint32 hash)
+{
+    Uint32 i = hash & names->mask;
+
+    for (;;) {
+        SDL_PropertyName *entry = &names->names[i];
+        if (entry->atom == 0) {
+            return entry;
+        }
+
+        /* The name is published before the atom, and never changes after that */
+        SDL_MemoryBarrierAcquire();
+        if (entry->hash == hash && SDL_strcmp(entry->name, name) == 0) {
+            return entry;
+        }
+        i = (i + 1) & names->mask;
+    }
+}
+
+static SDL_bool SDL_GrowPropertyNames(void)
+{
+    SDL_PropertyNames *old_names = SDL_property_names;
+    SDL_PropertyNames *new_names;
+    Uint32 i;
+
+    if (old_names && (SDL_num_property_names + 1) <= ((old_names->mask + 1) / 4) * 3) {
+        return SDL_TRUE;
+    }
+
+    new_names = SDL_CreatePropertyNames(old_names ? (old_names->mask + 1) * 2 : 256);
+    if (!new_names) {
+        return SDL_FALSE;
+    }
+    if (old_names) {
+        for (i = 0; i <= old_names->mask; ++i) {
+            SDL_PropertyName *entry = &old_names->names[i];
+            if (entry->atom) {
+                *SDL_FindPropertyName(new_names, entry->name, entry->hash) = *entry;
+            }
+        }
     }
+    new_names->retired = old_names;
+
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSetPtr((void **)&SDL_property_names, new_names);
+    return SDL_TRUE;
+}
+
+/* Look up the atom for a name, creating it if requested. The interned copy of the name is returned in interned. */
+static SDL_PropertyAtom SDL_InternPropertyName(const char *name, SDL_bool create, const char **interned)
+{
+    SDL_PropertyNames *names;
+    SDL_PropertyName *entry;
+    SDL_PropertyAtom atom = 0;
+    Uint32 hash;
+
+    if (!name || !*name) {
+        return 0;
+    }
+
+    hash = SDL_HashString(name, NULL);
+
+    names = (SDL_PropertyNames *)SDL_AtomicGetPtr((void **)&SDL_property_names);
+    if (names) {
+        entry = SDL_FindPropertyName(names, name, hash);
+        if (entry->atom) {
+            if (interned) {
+                *interned = entry->name;
+            }
+            return entry->atom;
+        }
+    }
+    if (!create || !SDL_property_names_lock) {
+        return 0;
+    }
+
+    SDL_LockMutex(SDL_property_names_lock);
+    {
+        if (SDL_GrowPropertyNames()) {
+            entry = SDL_FindPropertyName(SDL_property_names, name, hash);
+            if (!entry->atom) {
+                char *copy = SDL_strdup(name);
+                if (copy) {
+                    ++SDL_last_property_atom;
+                    if (SDL_last_property_atom == 0) {
+                        ++SDL_last_property_atom;
+                    }
+                    entry->hash = hash;
+                    entry->name = copy;
+                    SDL_MemoryBarrierRelease();
+                    entry->atom = SDL_last_property_atom;
+                    ++SDL_num_property_names;
+                }
+            }
+            atom = entry->atom;
+            if (atom && interned) {
+                *interned = entry->name;
+            }
+        }
+    }
+    SDL_UnlockMutex(SDL_property_names_lock);
+
+    return atom;
 }
 
 int SDL_InitProperties(void)
 {
-    if (!SDL_properties_lock) {
-        SDL_properties_lock = SDL_CreateMutex();
-        if (!SDL_properties_lock) {
+    if (!SDL_property_names_lock) {
+        SDL_property_names_lock = SDL_CreateMutex();
+        if (!SDL_property_names_lock) {
             return -1;
         }
     }
     if (!SDL_properties) {
-        SDL_properties = SDL_CreateHashTable(NULL, 16, SDL_HashID, SDL_KeyMatchID, SDL_FreeProperties, SDL_FALSE);
+        SDL_properties = SDL_AllocProperties();
         if (!SDL_properties) {
             return -1;
         }
@@ -123,12 +529,30 @@ void SDL_QuitProperties(void)
         SDL_global_properties = 0;
     }
     if (SDL_properties) {
-        SDL_DestroyHashTable(SDL_properties);
+        SDL_FreeProperties(SDL_properties);
         SDL_properties = NULL;
     }
-    if (SDL_properties_lock) {
-        SDL_DestroyMutex(SDL_properties_lock);
-        SDL_properties_lock = NULL;
+    if (SDL_property_names) {
+        SDL_PropertyNames *names = SDL_property_names;
+        Uint32 i;
+
+        for (i = 0; i <= names->mask; ++i) {
+            if (names->names[i].atom) {
+                SDL_free((void *)names->names[i].name);
+            }
+        }
+        while (names) {
+            SDL_PropertyNames *retired = names->retired;
+            SDL_free(names);
+            names = retired;
+        }
+        SDL_property_names = NULL;
+        SDL_num_property_names = 0;
+        /* SDL_last_property_atom keeps counting, so stale atoms don't match new names */
+    }
+    if (SDL_property_names_lock) {
+        SDL_DestroyMutex(SDL_property_names_lock);
+        SDL_property_names_lock = NULL;
     }
 }
 
@@ -144,48 +568,38 @@ SDL_PropertiesID SDL_CreateProperties(void)
 {
     SDL_PropertiesID props = 0;
     SDL_Properties *properties = NULL;
-    SDL_bool inserted = SDL_FALSE;
+    SDL_Property property;
+    SDL_Property old_property;
 
-    if (!SDL_properties && SDL_InitProperties() < 0) {
+    if (SDL_InitProperties() < 0) {
         return 0;
     }
 
-    properties = SDL_calloc(1, sizeof(*properties));
+    properties = SDL_AllocProperties();
     if (!properties) {
-        goto error;
-    }
-    properties->props = SDL_CreateHashTable(NULL, 4, SDL_HashString, SDL_KeyMatchString, SDL_FreeProperty, SDL_FALSE);
-    if (!properties->props) {
-        goto error;
-    }
-    properties->lock = SDL_CreateMutex();
-    if (!properties->lock) {
-        goto error;
+        return 0;
     }
 
-    if (SDL_InitProperties() < 0) {
-        goto error;
-    }
+    SDL_zero(property);
+    property.type = SDL_PROPERTY_TYPE_POINTER;
+    property.value.pointer_value = properties;
+    property.cleanup = CleanupProperties;
 
-    SDL_LockMutex(SDL_properties_lock);
+    SDL_LockMutex(SDL_properties->lock);
     ++SDL_last_properties_id;
     if (SDL_last_properties_id == 0) {
         ++SDL_last_properties_id;
     }
     props = SDL_last_properties_id;
-    if (SDL_InsertIntoHashTable(SDL_properties, (const void *)(uintptr_t)props, properties)) {
-        inserted = SDL_TRUE;
+    if (SDL_WriteProperty(SDL_properties, props, NULL, &property, &old_property) < 0) {
+        props = 0;
     }
-    SDL_UnlockMutex(SDL_properties_lock);
+    SDL_UnlockMutex(SDL_properties->lock);
 
-    if (inserted) {
-        /* All done! */
-        return props;
+    if (!props) {
+        SDL_FreeProperties(properties);
     }
-
-error:
-    SDL_FreeProperties(NULL, properties, NULL);
-    return 0;
+    return props;
 }
 
 int SDL_CopyProperties(SDL_PropertiesID src, SDL_PropertiesID dst)
@@ -201,10 +615,8 @@ int SDL_CopyProperties(SDL_PropertiesID src, SDL_PropertiesID dst)
         return SDL_InvalidParamError("dst");
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)src, (const void **)&src_properties);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)dst, (const void **)&dst_properties);
-    SDL_UnlockMutex(SDL_properties_lock);
+    src_properties = SDL_GetPropertiesObject(src);
+    dst_properties = SDL_GetPropertiesObject(dst);
 
     if (!src_properties) {
         return SDL_InvalidParamError("src");
@@ -216,42 +628,37 @@ int SDL_CopyProperties(SDL_PropertiesID src, SDL_PropertiesID dst)
     SDL_LockMutex(src_properties->lock);
     SDL_LockMutex(dst_properties->lock);
     {
-        void *iter;
-        const void *key, *value;
+        SDL_PropertySlots *slots = src_properties->slots;
+        Uint32 i;
 
-        iter = NULL;
-        while (SDL_IterateHashTable(src_properties->props, &key, &value, &iter)) {
-            const char *src_name = (const char *)key;
-            const SDL_Property *src_property = (const SDL_Property *)value;
-            char *dst_name;
-            SDL_Property *dst_property;
+        for (i = 0; i <= slots->mask; ++i) {
+            const SDL_PropertySlot *src_slot = &slots->slots[i];
+            SDL_Property dst_property;
+            SDL_Property old_property;
 
-            if (src_property->cleanup) {
-                /* Can't copy properties with cleanup functions, we don't know how to duplicate the data */
+            if (!src_slot->atom) {
                 continue;
             }
 
-            SDL_RemoveFromHashTable(dst_properties->props, src_name);
-
-            dst_name = SDL_strdup(src_name);
-            if (!dst_name) {
-                result = -1;
-                continue;
-            }
-            dst_property = (SDL_Property *)SDL_malloc(sizeof(*dst_property));
-            if (!dst_property) {
-                SDL_free(dst_name);
-                result = -1;
+            if (src_slot->property.cleanup) {
+                /* Can't copy properties with cleanup functions, we don't know how to duplicate the data */
                 continue;
             }
-            SDL_copyp(dst_property, src_property);
-            if (src_property->type == SDL_PROPERTY_TYPE_STRING) {
-                dst_property->value.string_value = SDL_strdup(src_property->value.string_value);
+
+            SDL_copyp(&dst_property, &src_slot->property);
+            dst_property.string_storage = NULL;
+            if (src_slot->property.type == SDL_PROPERTY_TYPE_STRING) {
+                dst_property.value.string_value = SDL_strdup(src_slot->property.value.string_value);
+                if (!dst_property.value.string_value) {
+                    result = -1;
+                    continue;
+                }
             }
-            if (!SDL_InsertIntoHashTable(dst_properties->props, dst_name, dst_property)) {
-                SDL_FreePropertyWithCleanup(dst_name, dst_property, NULL, SDL_FALSE);
+            if (SDL_WriteProperty(dst_properties, src_slot->atom, src_slot->name, &dst_property, &old_property) < 0) {
+                SDL_FreePropertyWithCleanup(&dst_property, SDL_FALSE);
                 result = -1;
             }
+            SDL_FreePropertyWithCleanup(&old_property, SDL_TRUE);
         }
     }
     SDL_UnlockMutex(dst_properties->lock);
@@ -268,15 +675,13 @@ int SDL_LockProperties(SDL_PropertiesID props)
         return SDL_InvalidParamError("props");
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
-
+    properties = SDL_GetPropertiesObject(props);
     if (!properties) {
         return SDL_InvalidParamError("props");
     }
 
     SDL_LockMutex(properties->lock);
+    SDL_AtomicIncRef(&properties->batches);
     return 0;
 }
 
@@ -288,91 +693,89 @@ void SDL_UnlockProperties(SDL_PropertiesID props)
         return;
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
-
+    properties = SDL_GetPropertiesObject(props);
     if (!properties) {
         return;
     }
 
+    SDL_AtomicDecRef(&properties->batches);
     SDL_UnlockMutex(properties->lock);
 }
 
 static int SDL_PrivateSetProperty(SDL_PropertiesID props, const char *name, SDL_Property *property)
 {
     SDL_Properties *properties = NULL;
-    int result = 0;
+    SDL_PropertyAtom atom;
+    const char *interned = NULL;
+    SDL_Property old_property;
 
     if (!props) {
-        SDL_FreePropertyWithCleanup(NULL, property, NULL, SDL_FALSE);
+        if (property) {
+            SDL_FreePropertyWithCleanup(property, SDL_FALSE);
+        }
         return SDL_InvalidParamError("props");
     }
     if (!name || !*name) {
-        SDL_FreePropertyWithCleanup(NULL, property, NULL, SDL_FALSE);
+        if (property) {
+            SDL_FreePropertyWithCleanup(property, SDL_FALSE);
+        }
         return SDL_InvalidParamError("name");
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
-
+    properties = SDL_GetPropertiesObject(props);
     if (!properties) {
-        SDL_FreePropertyWithCleanup(NULL, property, NULL, SDL_FALSE);
+        if (property) {
+            SDL_FreePropertyWithCleanup(property, SDL_FALSE);
+        }
         return SDL_InvalidParamError("props");
     }
 
-    SDL_LockMutex(properties->lock);
-    {
-        SDL_RemoveFromHashTable(properties->props, name);
+    atom = SDL_InternPropertyName(name, property ? SDL_TRUE : SDL_FALSE, &interned);
+    if (!atom) {
         if (property) {
-            char *key = SDL_strdup(name);
-            if (!SDL_InsertIntoHashTable(properties->props, key, property)) {
-                SDL_FreePropertyWithCleanup(key, property, NULL, SDL_FALSE);
-                result = -1;
-            }
+            SDL_FreePropertyWithCleanup(property, SDL_FALSE);
+            return -1;
         }
+        /* Nobody ever used this name, so there's nothing to clear */
+        return 0;
     }
-    SDL_UnlockMutex(properties->lock);
 
-    return result;
+    if (SDL_WriteProperty(properties, atom, interned, property, &old_property) < 0) {
+        SDL_FreePropertyWithCleanup(property, SDL_FALSE);
+        return -1;
+    }
+    SDL_FreePropertyWithCleanup(&old_property, SDL_TRUE);
+    return 0;
 }
 
 int SDL_SetPropertyWithCleanup(SDL_PropertiesID props, const char *name, void *value, void (SDLCALL *cleanup)(void *userdata, void *value), void *userdata)
 {
-    SDL_Property *property;
+    SDL_Property property;
 
     if (!value) {
         return SDL_ClearProperty(props, name);
     }
 
-    property = (SDL_Property *)SDL_calloc(1, sizeof(*property));
-    if (!property) {
-        SDL_FreePropertyWithCleanup(NULL, property, NULL, SDL_FALSE);
-        return -1;
-    }
-    property->type = SDL_PROPERTY_TYPE_POINTER;
-    property->value.pointer_value = value;
-    property->cleanup = cleanup;
-    property->userdata = userdata;
-    return SDL_PrivateSetProperty(props, name, property);
+    SDL_zero(property);
+    property.type = SDL_PROPERTY_TYPE_POINTER;
+    property.value.pointer_value = value;
+    property.cleanup = cleanup;
+    property.userdata = userdata;
+    return SDL_PrivateSetProperty(props, name, &property);
 }
 
 int SDL_SetProperty(SDL_PropertiesID props, const char *name, void *value)
 {
-    SDL_Property *property;
+    SDL_Property property;
 
     if (!value) {
         return SDL_ClearProperty(props, name);
     }
 
-    property = (SDL_Property *)SDL_calloc(1, sizeof(*property));
-    if (!property) {
-        return -1;
-    }
-    property->type = SDL_PROPERTY_TYPE_POINTER;
-    property->value.pointer_value = value;
-    return SDL_PrivateSetProperty(props, name, property);
+    SDL_zero(property);
+    property.type = SDL_PROPERTY_TYPE_POINTER;
+    property.value.pointer_value = value;
+    return SDL_PrivateSetProperty(props, name, &property);
 }
 
 static void SDLCALL CleanupFreeableProperty(void *userdata, void *value)
@@ -399,56 +802,49 @@ int SDL_SetSurfaceProperty(SDL_PropertiesID props, const char *name, SDL_Surface
 
 int SDL_SetStringProperty(SDL_PropertiesID props, const char *name, const char *value)
 {
-    SDL_Property *property;
+    SDL_Property property;
 
     if (!value) {
         return SDL_ClearProperty(props, name);
     }
 
-    property = (SDL_Property *)SDL_calloc(1, sizeof(*property));
-    if (!property) {
-        return -1;
-    }
-    property->type = SDL_PROPERTY_TYPE_STRING;
-    property->value.string_value = SDL_strdup(value);
-    if (!property->value.string_value) {
-        SDL_free(property);
+    SDL_zero(property);
+    property.type = SDL_PROPERTY_TYPE_STRING;
+    property.value.string_value = SDL_strdup(value);
+    if (!property.value.string_value) {
         return -1;
     }
-    return SDL_PrivateSetProperty(props, name, property);
+    return SDL_PrivateSetProperty(props, name, &property);
 }
 
 int SDL_SetNumberProperty(SDL_PropertiesID props, const char *name, Sint64 value)
 {
-    SDL_Property *property = (SDL_Property *)SDL_calloc(1, sizeof(*property));
-    if (!property) {
-        return -1;
-    }
-    property->type = SDL_PROPERTY_TYPE_NUMBER;
-    property->value.number_value = value;
-    return SDL_PrivateSetProperty(props, name, property);
+    SDL_Property property;
+
+    SDL_zero(property);
+    property.type = SDL_PROPERTY_TYPE_NUMBER;
+    property.value.number_value = value;
+    return SDL_PrivateSetProperty(props, name, &property);
 }
 
 int SDL_SetFloatProperty(SDL_PropertiesID props, const char *name, float value)
 {
-    SDL_Property *property = (SDL_Property *)SDL_calloc(1, sizeof(*property));
-    if (!property) {
-        return -1;
-    }
-    property->type = SDL_PROPERTY_TYPE_FLOAT;
-    property->value.float_value = value;
-    return SDL_PrivateSetProperty(props, name, property);
+    SDL_Property property;
+
+    SDL_zero(property);
+    property.type = SDL_PROPERTY_TYPE_FLOAT;
+    property.value.float_value = value;
+    return SDL_PrivateSetProperty(props, name, &property);
 }
 
 int SDL_SetBooleanProperty(SDL_PropertiesID props, const char *name, SDL_bool value)
 {
-    SDL_Property *property = (SDL_Property *)SDL_calloc(1, sizeof(*property));
-    if (!property) {
-        return -1;
-    }
-    property->type = SDL_PROPERTY_TYPE_BOOLEAN;
-    property->value.boolean_value = value ? SDL_TRUE : SDL_FALSE;
-    return SDL_PrivateSetProperty(props, name, property);
+    SDL_Property property;
+
+    SDL_zero(property);
+    property.type = SDL_PROPERTY_TYPE_BOOLEAN;
+    property.value.boolean_value = value ? SDL_TRUE : SDL_FALSE;
+    return SDL_PrivateSetProperty(props, name, &property);
 }
 
 SDL_bool SDL_HasProperty(SDL_PropertiesID props, const char *name)
@@ -456,284 +852,231 @@ SDL_bool SDL_HasProperty(SDL_PropertiesID props, const char *name)
     return (SDL_GetPropertyType(props, name) != SDL_PROPERTY_TYPE_INVALID);
 }
 
-SDL_PropertyType SDL_GetPropertyType(SDL_PropertiesID props, const char *name)
+static SDL_PropertyType SDL_PrivateGetProperty(SDL_PropertiesID props, SDL_PropertyAtom atom, SDL_Properties **properties, SDL_PropertyValue *value)
 {
-    SDL_Properties *properties = NULL;
-    SDL_PropertyType type = SDL_PROPERTY_TYPE_INVALID;
-
-    if (!props) {
-        return SDL_PROPERTY_TYPE_INVALID;
-    }
-    if (!name || !*name) {
+    if (!atom) {
         return SDL_PROPERTY_TYPE_INVALID;
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
-
-    if (!properties) {
+    *properties = SDL_GetPropertiesObject(props);
+    if (!*properties) {
         return SDL_PROPERTY_TYPE_INVALID;
     }
 
-    SDL_LockMutex(properties->lock);
-    {
-        SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
-            type = property->type;
-        }
-    }
-    SDL_UnlockMutex(properties->lock);
-
-    return type;
+    return SDL_ReadProperty(*properties, atom, value);
 }
 
-void *SDL_GetProperty(SDL_PropertiesID props, const char *name, void *default_value)
+SDL_PropertyType SDL_GetPropertyType(SDL_PropertiesID props, const char *name)
 {
     SDL_Properties *properties = NULL;
-    void *value = default_value;
+    SDL_PropertyValue value;
 
-    if (!props) {
-        return value;
-    }
-    if (!name || !*name) {
-        return value;
-    }
+    return SDL_PrivateGetProperty(props, SDL_InternPropertyName(name, SDL_FALSE, NULL), &properties, &value);
+}
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
+SDL_PropertyAtom SDL_GetPropertyAtom(const char *name)
+{
+    SDL_PropertyAtom atom;
 
-    if (!properties) {
-        return value;
+    if (!name || !*name) {
+        SDL_InvalidParamError("name");
+        return 0;
     }
 
-    /* Note that taking the lock here only guarantees that we won't read the
-     * hashtable while it's being modified. The value itself can easily be
-     * freed from another thread after it is returned here.
-     */
-    SDL_LockMutex(properties->lock);
-    {
-        SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
-            if (property->type == SDL_PROPERTY_TYPE_POINTER) {
-                value = property->value.pointer_value;
-            }
-        }
+    if (SDL_InitProperties() < 0) {
+        return 0;
     }
-    SDL_UnlockMutex(properties->lock);
 
-    return value;
+    atom = SDL_InternPropertyName(name, SDL_TRUE, NULL);
+    if (!atom) {
+        SDL_OutOfMemory();
+    }
+    return atom;
 }
 
-const char *SDL_GetStringProperty(SDL_PropertiesID props, const char *name, const char *default_value)
+void *SDL_GetPropertyByAtom(SDL_PropertiesID props, SDL_PropertyAtom atom, void *default_value)
 {
     SDL_Properties *properties = NULL;
-    const char *value = default_value;
+    SDL_PropertyValue property;
+    void *value = default_value;
 
-    if (!props) {
-        return value;
-    }
-    if (!name || !*name) {
-        return value;
+    /* Note that the value itself can easily be freed from another thread after it is returned here. */
+    if (SDL_PrivateGetProperty(props, atom, &properties, &property) == SDL_PROPERTY_TYPE_POINTER) {
+        value = property.pointer_value;
     }
+    return value;
+}
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
+void *SDL_GetProperty(SDL_PropertiesID props, const char *name, void *default_value)
+{
+    return SDL_GetPropertyByAtom(props, SDL_InternPropertyName(name, SDL_FALSE, NULL), default_value);
+}
 
-    if (!properties) {
-        return value;
-    }
+const char *SDL_GetStringPropertyByAtom(SDL_PropertiesID props, SDL_PropertyAtom atom, const char *default_value)
+{
+    SDL_Properties *properties = NULL;
+    SDL_PropertyValue property;
+    const char *value = default_value;
 
-    /* Note that taking the lock here only guarantees that we won't read the
-     * hashtable while it's being modified. The value itself can easily be
-     * freed from another thread after it is returned here.
+    /* Note that the value itself can easily be freed from another thread after it is returned here.
      *
      * FIXME: Should we SDL_strdup() the return value to avoid this?
      */
-    SDL_LockMutex(properties->lock);
-    {
-        SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
-            switch (property->type) {
-            case SDL_PROPERTY_TYPE_STRING:
-                value = property->value.string_value;
-                break;
-            case SDL_PROPERTY_TYPE_NUMBER:
-                if (property->string_storage) {
-                    value = property->string_storage;
-                } else {
-                    SDL_asprintf(&property->string_storage, "%" SDL_PRIs64, property->value.number_value);
-                    if (property->string_storage) {
-                        value = property->string_storage;
-                    }
-                }
-                break;
-            case SDL_PROPERTY_TYPE_FLOAT:
-                if (property->string_storage) {
-                    value = property->string_storage;
-                } else {
-                    SDL_asprintf(&property->string_storage, "%f", property->value.float_value);
-                    if (property->string_storage) {
-                        value = property->string_storage;
-                    }
+    switch (SDL_PrivateGetProperty(props, atom, &properties, &property)) {
+    case SDL_PROPERTY_TYPE_STRING:
+        value = property.string_value;
+        break;
+    case SDL_PROPERTY_TYPE_NUMBER:
+    case SDL_PROPERTY_TYPE_FLOAT:
+        /* The string form is created on demand, which needs the lock */
+        SDL_LockMutex(properties->lock);
+        {
+            SDL_PropertySlot *slot = SDL_FindPropertySlot(properties->slots, atom);
+            SDL_Property *p = slot ? &slot->property : NULL;
+            if (p && !p->string_storage) {
+                if (p->type == SDL_PROPERTY_TYPE_NUMBER) {
+                    SDL_asprintf(&p->string_storage, "%" SDL_PRIs64, p->value.number_value);
+                } else if (p->type == SDL_PROPERTY_TYPE_FLOAT) {
+                    SDL_asprintf(&p->string_storage, "%f", p->value.float_value);
                 }
-                break;
-            case SDL_PROPERTY_TYPE_BOOLEAN:
-                value = property->value.boolean_value ? "true" : "false";
-                break;
-            default:
-                break;
+            }
+            if (p && p->string_storage) {
+                value = p->string_storage;
             }
         }
+        SDL_UnlockMutex(properties->lock);
+        break;
+    case SDL_PROPERTY_TYPE_BOOLEAN:
+        value = property.boolean_value ? "true" : "false";
+        break;
+    default:
+        break;
     }
-    SDL_UnlockMutex(properties->lock);
-
     return value;
 }
 
-Sint64 SDL_GetNumberProperty(SDL_PropertiesID props, const char *name, Sint64 default_value)
+const char *SDL_GetStringProperty(SDL_PropertiesID props, const char *name, const char *default_value)
 {
-    SDL_Properties *properties = NULL;
-    Sint64 value = default_value;
-
-    if (!props) {
-        return value;
-    }
-    if (!name || !*name) {
-        return value;
-    }
-
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
+    return SDL_GetStringPropertyByAtom(props, SDL_InternPropertyName(name, SDL_FALSE, NULL), default_value);
+}
 
-    if (!properties) {
-        return value;
-    }
+/* Strings can be freed by another thread, so they are only parsed with the properties locked */
+static SDL_bool SDL_LockStringProperty(SDL_Properties *properties, SDL_PropertyAtom atom, const char **string)
+{
+    SDL_PropertySlot *slot;
 
     SDL_LockMutex(properties->lock);
-    {
-        SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
-            switch (property->type) {
-            case SDL_PROPERTY_TYPE_STRING:
-                value = SDL_strtoll(property->value.string_value, NULL, 0);
-                break;
-            case SDL_PROPERTY_TYPE_NUMBER:
-                value = property->value.number_value;
-                break;
-            case SDL_PROPERTY_TYPE_FLOAT:
-                value = (Sint64)SDL_round((double)property->value.float_value);
-                break;
-            case SDL_PROPERTY_TYPE_BOOLEAN:
-                value = property->value.boolean_value;
-                break;
-            default:
-                break;
-            }
-        }
+    slot = SDL_FindPropertySlot(properties->slots, atom);
+    if (slot && slot->property.type == SDL_PROPERTY_TYPE_STRING) {
+        *string = slot->property.value.string_value;
+        return SDL_TRUE;
     }
     SDL_UnlockMutex(properties->lock);
-
-    return value;
+    return SDL_FALSE;
 }
 
-float SDL_GetFloatProperty(SDL_PropertiesID props, const char *name, float default_value)
+Sint64 SDL_GetNumberPropertyByAtom(SDL_PropertiesID props, SDL_PropertyAtom atom, Sint64 default_value)
 {
     SDL_Properties *properties = NULL;
-    float value = default_value;
+    SDL_PropertyValue property;
+    const char *string;
+    Sint64 value = default_value;
 
-    if (!props) {
-        return value;
-    }
-    if (!name || !*name) {
-        return value;
+    switch (SDL_PrivateGetProperty(props, atom, &properties, &property)) {
+    case SDL_PROPERTY_TYPE_STRING:
+        if (SDL_LockStringProperty(properties, atom, &string)) {
+            value = SDL_strtoll(string, NULL, 0);
+            SDL_UnlockMutex(properties->lock);
+        }
+        break;
+    case SDL_PROPERTY_TYPE_NUMBER:
+        value = property.number_value;
+        break;
+    case SDL_PROPERTY_TYPE_FLOAT:
+        value = (Sint64)SDL_round((double)property.float_value);
+        break;
+    case SDL_PROPERTY_TYPE_BOOLEAN:
+        value = property.boolean_value;
+        break;
+    default:
+        break;
     }
+    return value;
+}
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
+Sint64 SDL_GetNumberProperty(SDL_PropertiesID props, const char *name, Sint64 default_value)
+{
+    return SDL_GetNumberPropertyByAtom(props, SDL_InternPropertyName(name, SDL_FALSE, NULL), default_value);
+}
 
-    if (!properties) {
-        return value;
-    }
+float SDL_GetFloatPropertyByAtom(SDL_PropertiesID props, SDL_PropertyAtom atom, float default_value)
+{
+    SDL_Properties *properties = NULL;
+    SDL_PropertyValue property;
+    const char *string;
+    float value = default_value;
 
-    SDL_LockMutex(properties->lock);
-    {
-        SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
-            switch (property->type) {
-            case SDL_PROPERTY_TYPE_STRING:
-                value = (float)SDL_atof(property->value.string_value);
-                break;
-            case SDL_PROPERTY_TYPE_NUMBER:
-                value = (float)property->value.number_value;
-                break;
-            case SDL_PROPERTY_TYPE_FLOAT:
-                value = property->value.float_value;
-                break;
-            case SDL_PROPERTY_TYPE_BOOLEAN:
-                value = (float)property->value.boolean_value;
-                break;
-            default:
-                break;
-            }
+    switch (SDL_PrivateGetProperty(props, atom, &properties, &property)) {
+    case SDL_PROPERTY_TYPE_STRING:
+        if (SDL_LockStringProperty(properties, atom, &string)) {
+            value = (float)SDL_atof(string);
+            SDL_UnlockMutex(properties->lock);
         }
+        break;
+    case SDL_PROPERTY_TYPE_NUMBER:
+        value = (float)property.number_value;
+        break;
+    case SDL_PROPERTY_TYPE_FLOAT:
+        value = property.float_value;
+        break;
+    case SDL_PROPERTY_TYPE_BOOLEAN:
+        value = (float)property.boolean_value;
+        break;
+    default:
+        break;
     }
-    SDL_UnlockMutex(properties->lock);
-
     return value;
 }
 
-SDL_bool SDL_GetBooleanProperty(SDL_PropertiesID props, const char *name, SDL_bool default_value)
+float SDL_GetFloatProperty(SDL_PropertiesID props, const char *name, float default_value)
+{
+    return SDL_GetFloatPropertyByAtom(props, SDL_InternPropertyName(name, SDL_FALSE, NULL), default_value);
+}
+
+SDL_bool SDL_GetBooleanPropertyByAtom(SDL_PropertiesID props, SDL_PropertyAtom atom, SDL_bool default_value)
 {
     SDL_Properties *properties = NULL;
+    SDL_PropertyValue property;
+    const char *string;
     SDL_bool value = default_value;
 
-    if (!props) {
-        return value;
-    }
-    if (!name || !*name) {
-        return value;
-    }
-
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
-
-    if (!properties) {
-        return value;
-    }
-
-    SDL_LockMutex(properties->lock);
-    {
-        SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
-            switch (property->type) {
-            case SDL_PROPERTY_TYPE_STRING:
-                value = SDL_GetStringBoolean(property->value.string_value, default_value);
-                break;
-            case SDL_PROPERTY_TYPE_NUMBER:
-                value = (property->value.number_value != 0);
-                break;
-            case SDL_PROPERTY_TYPE_FLOAT:
-                value = (property->value.float_value != 0.0f);
-                break;
-            case SDL_PROPERTY_TYPE_BOOLEAN:
-                value = property->value.boolean_value;
-                break;
-            default:
-                break;
-            }
+    switch (SDL_PrivateGetProperty(props, atom, &properties, &property)) {
+    case SDL_PROPERTY_TYPE_STRING:
+        if (SDL_LockStringProperty(properties, atom, &string)) {
+            value = SDL_GetStringBoolean(string, default_value);
+            SDL_UnlockMutex(properties->lock);
         }
+        break;
+    case SDL_PROPERTY_TYPE_NUMBER:
+        value = (property.number_value != 0);
+        break;
+    case SDL_PROPERTY_TYPE_FLOAT:
+        value = (property.float_value != 0.0f);
+        break;
+    case SDL_PROPERTY_TYPE_BOOLEAN:
+        value = property.boolean_value;
+        break;
+    default:
+        break;
     }
-    SDL_UnlockMutex(properties->lock);
-
     return value;
 }
 
+SDL_bool SDL_GetBooleanProperty(SDL_PropertiesID props, const char *name, SDL_bool default_value)
+{
+    return SDL_GetBooleanPropertyByAtom(props, SDL_InternPropertyName(name, SDL_FALSE, NULL), default_value);
+}
+
 int SDL_ClearProperty(SDL_PropertiesID props, const char *name)
 {
     return SDL_PrivateSetProperty(props, name, NULL);
@@ -750,22 +1093,21 @@ int SDL_EnumerateProperties(SDL_PropertiesID props, SDL_EnumeratePropertiesCallb
         return SDL_InvalidParamError("callback");
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
-
+    properties = SDL_GetPropertiesObject(props);
     if (!properties) {
         return SDL_InvalidParamError("props");
     }
 
     SDL_LockMutex(properties->lock);
     {
-        void *iter;
-        const void *key, *value;
+        /* Tables replaced by the callback stay valid until the properties are destroyed */
+        SDL_PropertySlots *slots = properties->slots;
+        Uint32 i;
 
-        iter = NULL;
-        while (SDL_IterateHashTable(properties->props, &key, &value, &iter)) {
-            callback(userdata, props, (const char *)key);
+        for (i = 0; i <= slots->mask; ++i) {
+            if (slots->slots[i].atom) {
+                callback(userdata, props, slots->slots[i].name);
+            }
         }
     }
     SDL_UnlockMutex(properties->lock);
@@ -775,11 +1117,13 @@ int SDL_EnumerateProperties(SDL_PropertiesID props, SDL_EnumeratePropertiesCallb
 
 void SDL_DestroyProperties(SDL_PropertiesID props)
 {
-    if (!props) {
+    SDL_Property old_property;
+
+    if (!props || !SDL_properties) {
         return;
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_RemoveFromHashTable(SDL_properties, (const void *)(uintptr_t)props);
-    SDL_UnlockMutex(SDL_properties_lock);
+    if (SDL_WriteProperty(SDL_properties, props, NULL, NULL, &old_property) == 0) {
+        SDL_FreePropertyWithCleanup(&old_property, SDL_TRUE);
+    }
 }
@@ -35,6 +35,7 @@
 
 #include "SDL_wave.h"
 #include "SDL_sysaudio.h"
+#include "../thread/SDL_systhread.h"
 
 /* Reads the value stored at the location of the f1 pointer, multiplies it
  * with the second argument and then stores the result to f1.
@@ -333,6 +334,132 @@ static Sint64 WaveAdjustToFactValue(WaveFile *file, Sint64 sampleframes)
     return sampleframes;
 }
 
+/* Large ADPCM chunks get split into runs of complete blocks that are decoded
+ * on several threads. Every block starts with a header that resets the decoder,
+ * so the blocks are independent of each other.
+ */
+#define ADPCM_BLOCKS_PER_THREAD 512
+#define ADPCM_MAX_THREADS       16
+
+typedef int (*ADPCM_DecodeFunc)(ADPCM_DecoderState *state);
+
+typedef struct ADPCM_DecodeJob
+{
+    ADPCM_DecoderState state;
+    ADPCM_DecodeFunc decodeheader;
+    ADPCM_DecodeFunc decodedata;
+    size_t firstblock;
+    size_t lastblock;
+    size_t failedblock; /* First block that didn't decode, or lastblock. */
+} ADPCM_DecodeJob;
+
+static int SDLCALL ADPCM_DecodeJobThread(void *data)
+{
+    ADPCM_DecodeJob *job = (ADPCM_DecodeJob *)data;
+    ADPCM_DecoderState *state = &job->state;
+    const size_t blockframes = state->samplesperblock * state->channels;
+    size_t b;
+
+    job->failedblock = job->lastblock;
+    for (b = job->firstblock; b < job->lastblock; b++) {
+        state->block.data = state->input.data + b * state->blocksize;
+        state->block.size = state->blocksize;
+        state->block.pos = 0;
+        state->output.pos = b * blockframes;
+        state->framesleft = state->samplesperblock;
+
+        if (job->decodeheader(state) == -1 || job->decodedata(state) == -1) {
+            job->failedblock = b;
+            break;
+        }
+    }
+    return 0;
+}
+
+/* Decodes the complete blocks at the start of the input on multiple threads if
+ * there are enough of them. The state is advanced past the blocks that decoded
+ * without problems. Anything after that, including a broken block, is left to
+ * the sequential decoding loop so errors and truncation get handled as usual.
+ */
+static void ADPCM_DecodeBlocksInParallel(ADPCM_DecoderState *state, ADPCM_DecodeFunc decodeheader, ADPCM_DecodeFunc decodedata)
+{
+    ADPCM_DecodeJob *jobs;
+    SDL_Thread *threads[ADPCM_MAX_THREADS];
+    Uint8 *cstates;
+    size_t numblocks, blocksperjob, done;
+    int numjobs, i;
+
+    if (state->input.pos != 0 || state->output.pos != 0 || state->blocksize == 0 || state->samplesperblock == 0) {
+        return;
+    }
+
+    numblocks = state->input.size / state->blocksize;
+    if ((Uint64)numblocks > (Uint64)state->framesleft / state->samplesperblock) {
+        numblocks = (size_t)(state->framesleft / state->samplesperblock);
+    }
+
+    numjobs = SDL_GetCPUCount();
+    if ((size_t)numjobs > numblocks / ADPCM_BLOCKS_PER_THREAD) {
+        numjobs = (int)(numblocks / ADPCM_BLOCKS_PER_THREAD);
+    }
+    if (numjobs > ADPCM_MAX_THREADS) {
+        numjobs = ADPCM_MAX_THREADS;
+    }
+    if (numjobs < 2) {
+        return;
+    }
+
+    /* The MS ADPCM channel state is the larger one, it's used for both. */
+    jobs = (ADPCM_DecodeJob *)SDL_calloc(numjobs, sizeof(ADPCM_DecodeJob));
+    cstates = (Uint8 *)SDL_calloc((size_t)numjobs * state->channels, sizeof(MS_ADPCM_ChannelState));
+    if (!jobs || !cstates) {
+        SDL_free(jobs);
+        SDL_free(cstates);
+        return;
+    }
+
+    blocksperjob = (numblocks + numjobs - 1) / numjobs;
+    for (i = 0; i < numjobs; i++) {
+        ADPCM_DecodeJob *job = &jobs[i];
+        job->state = *state;
+        job->state.cstate = cstates + (size_t)i * state->channels * sizeof(MS_ADPCM_ChannelState);
+        job->decodeheader = decodeheader;
+        job->decodedata = decodedata;
+        job->firstblock = SDL_min(i * blocksperjob, numblocks);
+        job->lastblock = SDL_min(job->firstblock + blocksperjob, numblocks);
+    }
+
+    /* The first job runs on this thread. If a thread can't be started, its job
+     * runs here too.
+     */
+    for (i = 1; i < numjobs; i++) {
+        threads[i] = SDL_CreateThreadInternal(ADPCM_DecodeJobThread, "SDLWaveADPCM", 0, &jobs[i]);
+    }
+    ADPCM_DecodeJobThread(&jobs[0]);
+    for (i = 1; i < numjobs; i++) {
+        if (threads[i]) {
+            SDL_WaitThread(threads[i], NULL);
+        } else {
+            ADPCM_DecodeJobThread(&jobs[i]);
+        }
+    }
+
+    done = numblocks;
+    for (i = 0; i < numjobs; i++) {
+        if (jobs[i].failedblock < jobs[i].lastblock) {
+            done = jobs[i].failedblock;
+            break;
+        }
+    }
+
+    state->input.pos = done * state->blocksize;
+    state->output.pos = done * state->samplesperblock * state->channels;
+    state->framesleft -= (Sint64)done * state->samplesperblock;
+
+    SDL_free(cstates);
+    SDL_free(jobs);
+}
+
 static int MS_ADPCM_CalculateSampleFrames(WaveFile *file, size_t datalength)
 {
     WaveFormat *format = &file->format;
@@ -688,6 +815,8 @@ static int MS_ADPCM_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
 
     state.cstate = cstate;
 
+    ADPCM_DecodeBlocksInParallel(&state, MS_ADPCM_DecodeBlockHeader, MS_ADPCM_DecodeBlockData);
+
     /* Decode block by block. A truncated block will stop the decoding. */
     bytesleft = state.input.size - state.input.pos;
     while (state.framesleft > 0 && bytesleft >= state.blockheadersize) {
@@ -1084,6 +1213,8 @@ static int IMA_ADPCM_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len
     }
     state.cstate = cstate;
 
+    ADPCM_DecodeBlocksInParallel(&state, IMA_ADPCM_DecodeBlockHeader, IMA_ADPCM_DecodeBlockData);
+
     /* Decode block by block. A truncated block will stop the decoding. */
     bytesleft = state.input.size - state.input.pos;
     while (state.framesleft > 0 && bytesleft >= state.blockheadersize) {
@@ -1158,50 +1289,169 @@ static int LAW_Init(WaveFile *file, size_t datalength)
     return 0;
 }
 
-static int LAW_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
+/* G.711 expansion tables. The SIMD decoders below compute the same values:
+ *
+ *   A-law:  x = byte ^ 0x55, e = (x >> 4) & 7, m = x & 15
+ *           magnitude = e ? ((m << 4) + 0x108) << (e - 1) : (m << 4) + 8
+ *   mu-law: x = ~byte, e = (x >> 4) & 7, m = x & 15
+ *           magnitude = (((m << 3) + 0x84) << e) - 0x84
+ *
+ * with the sign in bit 7 (set for positive A-law and negative mu-law samples).
+ */
+static const Sint16 alaw_lut[256] = {
+    -5504, -5248, -6016, -5760, -4480, -4224, -4992, -4736, -7552, -7296, -8064, -7808, -6528, -6272, -7040, -6784, -2752,
+    -2624, -3008, -2880, -2240, -2112, -2496, -2368, -3776, -3648, -4032, -3904, -3264, -3136, -3520, -3392, -22016,
+    -20992, -24064, -23040, -17920, -16896, -19968, -18944, -30208, -29184, -32256, -31232, -26112, -25088, -28160, -27136, -11008,
+    -10496, -12032, -11520, -8960, -8448, -9984, -9472, -15104, -14592, -16128, -15616, -13056, -12544, -14080, -13568, -344,
+    -328, -376, -360, -280, -264, -312, -296, -472, -456, -504, -488, -408, -392, -440, -424, -88,
+    -72, -120, -104, -24, -8, -56, -40, -216, -200, -248, -232, -152, -136, -184, -168, -1376,
+    -1312, -1504, -1440, -1120, -1056, -1248, -1184, -1888, -1824, -2016, -1952, -1632, -1568, -1760, -1696, -688,
+    -656, -752, -720, -560, -528, -624, -592, -944, -912, -1008, -976, -816, -784, -880, -848, 5504,
+    5248, 6016, 5760, 4480, 4224, 4992, 4736, 7552, 7296, 8064, 7808, 6528, 6272, 7040, 6784, 2752,
+    2624, 3008, 2880, 2240, 2112, 2496, 2368, 3776, 3648, 4032, 3904, 3264, 3136, 3520, 3392, 22016,
+    20992, 24064, 23040, 17920, 16896, 19968, 18944, 30208, 29184, 32256, 31232, 26112, 25088, 28160, 27136, 11008,
+    10496, 12032, 11520, 8960, 8448, 9984, 9472, 15104, 14592, 16128, 15616, 13056, 12544, 14080, 13568, 344,
+    328, 376, 360, 280, 264, 312, 296, 472, 456, 504, 488, 408, 392, 440, 424, 88,
+    72, 120, 104, 24, 8, 56, 40, 216, 200, 248, 232, 152, 136, 184, 168, 1376,
+    1312, 1504, 1440, 1120, 1056, 1248, 1184, 1888, 1824, 2016, 1952, 1632, 1568, 1760, 1696, 688,
+    656, 752, 720, 560, 528, 624, 592, 944, 912, 1008, 976, 816, 784, 880, 848
+};
+static const Sint16 mulaw_lut[256] = {
+    -32124, -31100, -30076, -29052, -28028, -27004, -25980, -24956, -23932, -22908, -21884, -20860, -19836, -18812, -17788, -16764, -15996,
+    -15484, -14972, -14460, -13948, -13436, -12924, -12412, -11900, -11388, -10876, -10364, -9852, -9340, -8828, -8316, -7932,
+    -7676, -7420, -7164, -6908, -6652, -6396, -6140, -5884, -5628, -5372, -5116, -4860, -4604, -4348, -4092, -3900,
+    -3772, -3644, -3516, -3388, -3260, -3132, -3004, -2876, -2748, -2620, -2492, -2364, -2236, -2108, -1980, -1884,
+    -1820, -1756, -1692, -1628, -1564, -1500, -1436, -1372, -1308, -1244, -1180, -1116, -1052, -988, -924, -876,
+    -844, -812, -780, -748, -716, -684, -652, -620, -588, -556, -524, -492, -460, -428, -396, -372,
+    -356, -340, -324, -308, -292, -276, -260, -244, -228, -212, -196, -180, -164, -148, -132, -120,
+    -112, -104, -96, -88, -80, -72, -64, -56, -48, -40, -32, -24, -16, -8, 0, 32124,
+    31100, 30076, 29052, 28028, 27004, 25980, 24956, 23932, 22908, 21884, 20860, 19836, 18812, 17788, 16764, 15996,
+    15484, 14972, 14460, 13948, 13436, 12924, 12412, 11900, 11388, 10876, 10364, 9852, 9340, 8828, 8316, 7932,
+    7676, 7420, 7164, 6908, 6652, 6396, 6140, 5884, 5628, 5372, 5116, 4860, 4604, 4348, 4092, 3900,
+    3772, 3644, 3516, 3388, 3260, 3132, 3004, 2876, 2748, 2620, 2492, 2364, 2236, 2108, 1980, 1884,
+    1820, 1756, 1692, 1628, 1564, 1500, 1436, 1372, 1308, 1244, 1180, 1116, 1052, 988, 924, 876,
+    844, 812, 780, 748, 716, 684, 652, 620, 588, 556, 524, 492, 460, 428, 396, 372,
+    356, 340, 324, 308, 292, 276, 260, 244, 228, 212, 196, 180, 164, 148, 132, 120,
+    112, 104, 96, 88, 80, 72, 64, 56, 48, 40, 32, 24, 16, 8, 0
+};
+
+#ifdef SDL_SSE4_1_INTRINSICS
+/* Expands 16 samples per iteration. The mantissa, the power of two for the
+ * exponent and the A-law segment bit are looked up with byte shuffles, and
+ * put together with a 16-bit multiply. Works backwards like the scalar loop,
+ * so it's safe in-place. Returns the number of samples left at the start.
+ */
+static size_t SDL_TARGETING("sse4.1") LAW_DecodeSamples_SSE41(Uint16 encoding, const Uint8 *src, Sint16 *dst, size_t i)
 {
-#ifdef SDL_WAVE_LAW_LUT
-    const Sint16 alaw_lut[256] = {
-        -5504, -5248, -6016, -5760, -4480, -4224, -4992, -4736, -7552, -7296, -8064, -7808, -6528, -6272, -7040, -6784, -2752,
-        -2624, -3008, -2880, -2240, -2112, -2496, -2368, -3776, -3648, -4032, -3904, -3264, -3136, -3520, -3392, -22016,
-        -20992, -24064, -23040, -17920, -16896, -19968, -18944, -30208, -29184, -32256, -31232, -26112, -25088, -28160, -27136, -11008,
-        -10496, -12032, -11520, -8960, -8448, -9984, -9472, -15104, -14592, -16128, -15616, -13056, -12544, -14080, -13568, -344,
-        -328, -376, -360, -280, -264, -312, -296, -472, -456, -504, -488, -408, -392, -440, -424, -88,
-        -72, -120, -104, -24, -8, -56, -40, -216, -200, -248, -232, -152, -136, -184, -168, -1376,
-        -1312, -1504, -1440, -1120, -1056, -1248, -1184, -1888, -1824, -2016, -1952, -1632, -1568, -1760, -1696, -688,
-        -656, -752, -720, -560, -528, -624, -592, -944, -912, -1008, -976, -816, -784, -880, -848, 5504,
-        5248, 6016, 5760, 4480, 4224, 4992, 4736, 7552, 7296, 8064, 7808, 6528, 6272, 7040, 6784, 2752,
-        2624, 3008, 2880, 2240, 2112, 2496, 2368, 3776, 3648, 4032, 3904, 3264, 3136, 3520, 3392, 22016,
-        20992, 24064, 23040, 17920, 16896, 19968, 18944, 30208, 29184, 32256, 31232, 26112, 25088, 28160, 27136, 11008,
-        10496, 12032, 11520, 8960, 8448, 9984, 9472, 15104, 14592, 16128, 15616, 13056, 12544, 14080, 13568, 344,
-        328, 376, 360, 280, 264, 312, 296, 472, 456, 504, 488, 408, 392, 440, 424, 88,
-        72, 120, 104, 24, 8, 56, 40, 216, 200, 248, 232, 152, 136, 184, 168, 1376,
-        1312, 1504, 1440, 1120, 1056, 1248, 1184, 1888, 1824, 2016, 1952, 1632, 1568, 1760, 1696, 688,
-        656, 752, 720, 560, 528, 624, 592, 944, 912, 1008, 976, 816, 784, 880, 848
-    };
-    const Sint16 mulaw_lut[256] = {
-        -32124, -31100, -30076, -29052, -28028, -27004, -25980, -24956, -23932, -22908, -21884, -20860, -19836, -18812, -17788, -16764, -15996,
-        -15484, -14972, -14460, -13948, -13436, -12924, -12412, -11900, -11388, -10876, -10364, -9852, -9340, -8828, -8316, -7932,
-        -7676, -7420, -7164, -6908, -6652, -6396, -6140, -5884, -5628, -5372, -5116, -4860, -4604, -4348, -4092, -3900,
-        -3772, -3644, -3516, -3388, -3260, -3132, -3004, -2876, -2748, -2620, -2492, -2364, -2236, -2108, -1980, -1884,
-        -1820, -1756, -1692, -1628, -1564, -1500, -1436, -1372, -1308, -1244, -1180, -1116, -1052, -988, -924, -876,
-        -844, -812, -780, -748, -716, -684, -652, -620, -588, -556, -524, -492, -460, -428, -396, -372,
-        -356, -340, -324, -308, -292, -276, -260, -244, -228, -212, -196, -180, -164, -148, -132, -120,
-        -112, -104, -96, -88, -80, -72, -64, -56, -48, -40, -32, -24, -16, -8, 0, 32124,
-        31100, 30076, 29052, 28028, 27004, 25980, 24956, 23932, 22908, 21884, 20860, 19836, 18812, 17788, 16764, 15996,
-        15484, 14972, 14460, 13948, 13436, 12924, 12412, 11900, 11388, 10876, 10364, 9852, 9340, 8828, 8316, 7932,
-        7676, 7420, 7164, 6908, 6652, 6396, 6140, 5884, 5628, 5372, 5116, 4860, 4604, 4348, 4092, 3900,
-        3772, 3644, 3516, 3388, 3260, 3132, 3004, 2876, 2748, 2620, 2492, 2364, 2236, 2108, 1980, 1884,
-        1820, 1756, 1692, 1628, 1564, 1500, 1436, 1372, 1308, 1244, 1180, 1116, 1052, 988, 924, 876,
-        844, 812, 780, 748, 716, 684, 652, 620, 588, 556, 524, 492, 460, 428, 396, 372,
-        356, 340, 324, 308, 292, 276, 260, 244, 228, 212, 196, 180, 164, 148, 132, 120,
-        112, 104, 96, 88, 80, 72, 64, 56, 48, 40, 32, 24, 16, 8, 0
-    };
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i low3 = _mm_set1_epi8(0x07);
+    const __m128i low4 = _mm_set1_epi8(0x0f);
+    __m128i flip, mantissas, scales, segments, bias;
+
+    if (encoding == ALAW_CODE) {
+        /* Bit 7 is flipped as well, so it's set for negative samples in both encodings. */
+        flip = _mm_set1_epi8((char)0xd5);
+        mantissas = _mm_setr_epi8(0x08, 0x18, 0x28, 0x38, 0x48, 0x58, 0x68, 0x78,
+                                  (char)0x88, (char)0x98, (char)0xa8, (char)0xb8, (char)0xc8, (char)0xd8, (char)0xe8, (char)0xf8);
+        scales = _mm_setr_epi8(1, 1, 2, 4, 8, 16, 32, 64, 0, 0, 0, 0, 0, 0, 0, 0);
+        segments = _mm_setr_epi8(0, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0);
+        bias = zero;
+    } else {
+        flip = _mm_set1_epi8((char)0xff);
+        mantissas = _mm_setr_epi8((char)0x84, (char)0x8c, (char)0x94, (char)0x9c, (char)0xa4, (char)0xac, (char)0xb4, (char)0xbc,
+                                  (char)0xc4, (char)0xcc, (char)0xd4, (char)0xdc, (char)0xe4, (char)0xec, (char)0xf4, (char)0xfc);
+        scales = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, (char)128, 0, 0, 0, 0, 0, 0, 0, 0);
+        segments = zero;
+        bias = _mm_set1_epi16(0x84);
+    }
+
+    while (i >= 16) {
+        __m128i x, e, base, segment, scale, negative, lo, hi, nlo, nhi;
+
+        i -= 16;
+        x = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(src + i)), flip);
+        e = _mm_and_si128(_mm_srli_epi16(x, 4), low3);
+        base = _mm_shuffle_epi8(mantissas, _mm_and_si128(x, low4));
+        segment = _mm_shuffle_epi8(segments, e);
+        scale = _mm_shuffle_epi8(scales, e);
+        negative = _mm_cmplt_epi8(x, zero);
+
+        lo = _mm_sub_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(base, segment), _mm_unpacklo_epi8(scale, zero)), bias);
+        hi = _mm_sub_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(base, segment), _mm_unpackhi_epi8(scale, zero)), bias);
+        nlo = _mm_unpacklo_epi8(negative, negative);
+        nhi = _mm_unpackhi_epi8(negative, negative);
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_sub_epi16(_mm_xor_si128(lo, nlo), nlo));
+        _mm_storeu_si128((__m128i *)(dst + i + 8), _mm_sub_epi16(_mm_xor_si128(hi, nhi), nhi));
+    }
+    return i;
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#ifdef SDL_NEON_INTRINSICS
+/* The NEON version shifts by the exponent directly, 8 samples at a time. */
+static size_t LAW_DecodeSamples_NEON(Uint16 encoding, const Uint8 *src, Sint16 *dst, size_t i)
+{
+    const uint16x8_t low3 = vdupq_n_u16(0x07);
+    const uint16x8_t low4 = vdupq_n_u16(0x0f);
+    const uint16x8_t signbit = vdupq_n_u16(0x80);
+    const uint16x8_t one = vdupq_n_u16(1);
+    const SDL_bool alaw = (encoding == ALAW_CODE);
+    const uint16x8_t flip = vdupq_n_u16(alaw ? 0xd5 : 0xff);
+
+    while (i >= 8) {
+        uint16x8_t x, e, m, value, negative;
+
+        i -= 8;
+        x = veorq_u16(vmovl_u8(vld1_u8(src + i)), flip);
+        e = vandq_u16(vshrq_n_u16(x, 4), low3);
+        m = vandq_u16(x, low4);
+        if (alaw) {
+            /* Segments above 0 have the extra 0x100 bit and one shift less. */
+            const uint16x8_t segment = vminq_u16(e, one);
+            value = vaddq_u16(vshlq_n_u16(m, 4), vdupq_n_u16(0x08));
+            value = vorrq_u16(value, vshlq_n_u16(segment, 8));
+            value = vshlq_u16(value, vreinterpretq_s16_u16(vsubq_u16(e, segment)));
+        } else {
+            value = vaddq_u16(vshlq_n_u16(m, 3), vdupq_n_u16(0x84));
+            value = vsubq_u16(vshlq_u16(value, vreinterpretq_s16_u16(e)), vdupq_n_u16(0x84));
+        }
+        negative = vtstq_u16(x, signbit);
+        value = vsubq_u16(veorq_u16(value, negative), negative);
+        vst1q_u16((Uint16 *)(dst + i), value);
+    }
+    return i;
+}
+#endif /* SDL_NEON_INTRINSICS */
+
+/* Expands companded samples to 16 bits. Works backwards, so the expansion can
+ * happen in-place, with dst pointing to the same memory as src.
+ */
+static void LAW_DecodeSamples(Uint16 encoding, const Uint8 *src, Sint16 *dst, size_t sample_count)
+{
+    const Sint16 *lut = (encoding == ALAW_CODE) ? alaw_lut : mulaw_lut;
+    size_t i = sample_count;
+
+#ifdef SDL_SSE4_1_INTRINSICS
+    if (SDL_HasSSE41()) {
+        i = LAW_DecodeSamples_SSE41(encoding, src, dst, i);
+    }
 #endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        i = LAW_DecodeSamples_NEON(encoding, src, dst, i);
+    }
+#endif
+
+    while (i--) {
+        dst[i] = lut[src[i]];
+    }
+}
 
+static int LAW_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
+{
     WaveFormat *format = &file->format;
     WaveChunk *chunk = &file->chunk;
-    size_t i, sample_count, expanded_len;
+    size_t sample_count, expanded_len;
     Uint8 *src;
     Sint16 *dst;
 
@@ -1244,55 +1494,11 @@ static int LAW_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
     /* Work backwards, since we're expanding in-place. `format` will
      * inform the caller about the byte order.
      */
-    i = sample_count;
-    switch (file->format.encoding) {
-#ifdef SDL_WAVE_LAW_LUT
-    case ALAW_CODE:
-        while (i--) {
-            dst[i] = alaw_lut[src[i]];
-        }
-        break;
-    case MULAW_CODE:
-        while (i--) {
-            dst[i] = mulaw_lut[src[i]];
-        }
-        break;
-#else
-    case ALAW_CODE:
-        while (i--) {
-            Uint8 nibble = src[i];
-            Uint8 exponent = (nibble & 0x7f) ^ 0x55;
-            Sint16 mantissa = exponent & 0xf;
-
-            exponent >>= 4;
-            if (exponent > 0) {
-                mantissa |= 0x10;
-            }
-            mantissa = (mantissa << 4) | 0x8;
-            if (exponent > 1) {
-                mantissa <<= exponent - 1;
-            }
-
-            dst[i] = nibble & 0x80 ? mantissa : -mantissa;
-        }
-        break;
-    case MULAW_CODE:
-        while (i--) {
-            Uint8 nibble = ~src[i];
-            Sint16 mantissa = nibble & 0xf;
-            Uint8 exponent = (nibble >> 4) & 0x7;
-            Sint16 step = 4 << (exponent + 1);
-
-            mantissa = (0x80 << exponent) + step * mantissa + step / 2 - 132;
-
-            dst[i] = nibble & 0x80 ? -mantissa : mantissa;
-        }
-        break;
-#endif
-    default:
+    if (file->format.encoding != ALAW_CODE && file->format.encoding != MULAW_CODE) {
         SDL_free(src);
         return SDL_SetError("Unknown companded encoding");
     }
+    LAW_DecodeSamples(file->format.encoding, src, dst, sample_count);
 
     *audio_buf = src;
     *audio_len = (Uint32)expanded_len;
@@ -1343,11 +1549,86 @@ static int PCM_Init(WaveFile *file, size_t datalength)
     return 0;
 }
 
+#ifdef SDL_SSE4_1_INTRINSICS
+/* Expands 4 samples per iteration, from the top 12 bytes of a 16 byte load so
+ * the load never reaches past the last sample. Works backwards, like the
+ * scalar loop. Returns the number of samples left at the start.
+ */
+static size_t SDL_TARGETING("sse4.1") PCM_ExpandSint24ToSint32_SSE41(Uint8 *ptr, size_t i)
+{
+    const __m128i shuffle = _mm_setr_epi8(-1, 4, 5, 6, -1, 7, 8, 9, -1, 10, 11, 12, -1, 13, 14, 15);
+
+    /* The load starts 4 bytes before the first of the four samples. */
+    while (i >= 6) {
+        i -= 4;
+        _mm_storeu_si128((__m128i *)(ptr + i * 4), _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(ptr + i * 3 - 4)), shuffle));
+    }
+    return i;
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#ifdef SDL_NEON_INTRINSICS
+/* De-interleaves 16 samples into byte planes and interleaves them again with a
+ * zero low byte.
+ */
+static size_t PCM_ExpandSint24ToSint32_NEON(Uint8 *ptr, size_t i)
+{
+    while (i >= 16) {
+        uint8x16x3_t in;
+        uint8x16x4_t out;
+
+        i -= 16;
+        in = vld3q_u8(ptr + i * 3);
+        out.val[0] = vdupq_n_u8(0);
+        out.val[1] = in.val[0];
+        out.val[2] = in.val[1];
+        out.val[3] = in.val[2];
+        vst4q_u8(ptr + i * 4, out);
+    }
+    return i;
+}
+#endif /* SDL_NEON_INTRINSICS */
+
+/* Shifts 24-bit samples to 32 bits in-place. The buffer must have room for the
+ * expanded samples.
+ */
+static void PCM_ExpandSint24ToSint32(Uint8 *ptr, size_t sample_count)
+{
+    size_t i = sample_count;
+
+#ifdef SDL_SSE4_1_INTRINSICS
+    if (SDL_HasSSE41()) {
+        i = PCM_ExpandSint24ToSint32_SSE41(ptr, i);
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        i = PCM_ExpandSint24ToSint32_NEON(ptr, i);
+    }
+#endif
+
+    /* work from end to start, since we're expanding in-place. */
+    for (; i > 0; i--) {
+        const size_t o = i - 1;
+        uint8_t b[4];
+
+        b[0] = 0;
+        b[1] = ptr[o * 3];
+        b[2] = ptr[o * 3 + 1];
+        b[3] = ptr[o * 3 + 2];
+
+        ptr[o * 4 + 0] = b[0];
+        ptr[o * 4 + 1] = b[1];
+        ptr[o * 4 + 2] = b[2];
+        ptr[o * 4 + 3] = b[3];
+    }
+}
+
 static int PCM_ConvertSint24ToSint32(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
 {
     WaveFormat *format = &file->format;
     WaveChunk *chunk = &file->chunk;
-    size_t i, expanded_len, sample_count;
+    size_t expanded_len, sample_count;
     Uint8 *ptr;
 
     sample_count = (size_t)file->sampleframes;
@@ -1375,21 +1656,7 @@ static int PCM_ConvertSint24ToSint32(WaveFile *file, Uint8 **audio_buf, Uint32 *
     *audio_buf = ptr;
     *audio_len = (Uint32)expanded_len;
 
-    /* work from end to start, since we're expanding in-place. */
-    for (i = sample_count; i > 0; i--) {
-        const size_t o = i - 1;
-        uint8_t b[4];
-
-        b[0] = 0;
-        b[1] = ptr[o * 3];
-        b[2] = ptr[o * 3 + 1];
-        b[3] = ptr[o * 3 + 2];
-
-        ptr[o * 4 + 0] = b[0];
-        ptr[o * 4 + 1] = b[1];
-        ptr[o * 4 + 2] = b[2];
-        ptr[o * 4 + 3] = b[3];
-    }
+    PCM_ExpandSint24ToSint32(ptr, sample_count);
 
     return 0;
 }
@@ -1769,7 +2036,11 @@ static int WaveCheckFormat(WaveFile *file, size_t datalength)
     return 0;
 }
 
-static int WaveLoad(SDL_RWops *src, WaveFile *file, SDL_AudioSpec *spec, Uint8 **audio_buf, Uint32 *audio_len)
+/* Finds the chunks of the WAVE file and checks the format. On return, datachunk
+ * holds the position and length of the data chunk, and endposition where the
+ * WAVE file ends in the stream.
+ */
+static int WaveReadHeaders(SDL_RWops *src, WaveFile *file, WaveChunk *datachunk, Sint64 *endposition)
 {
     int result;
     Uint32 chunkcount = 0;
@@ -1777,15 +2048,13 @@ static int WaveLoad(SDL_RWops *src, WaveFile *file, SDL_AudioSpec *spec, Uint8 *
     char *envchunkcountlimit;
     Sint64 RIFFstart, RIFFend, lastchunkpos;
     SDL_bool RIFFlengthknown = SDL_FALSE;
-    WaveFormat *format = &file->format;
     WaveChunk *chunk = &file->chunk;
     WaveChunk RIFFchunk;
     WaveChunk fmtchunk;
-    WaveChunk datachunk;
 
     SDL_zero(RIFFchunk);
     SDL_zero(fmtchunk);
-    SDL_zero(datachunk);
+    SDL_zerop(datachunk);
 
     envchunkcountlimit = SDL_getenv("SDL_WAVE_CHUNK_LIMIT");
     if (envchunkcountlimit) {
@@ -1876,7 +2145,7 @@ static int WaveLoad(SDL_RWops *src, WaveFile *file, SDL_AudioSpec *spec, Uint8 *
                 /* Multiple fmt chunks. Ignore or error? */
             } else {
                 /* The fmt chunk must occur before the data chunk. */
-                if (datachunk.fourcc == DATA) {
+                if (datachunk->fourcc == DATA) {
                     return SDL_SetError("fmt chunk after data chunk in WAVE file");
                 }
                 fmtchunk = *chunk;
@@ -1885,8 +2154,8 @@ static int WaveLoad(SDL_RWops *src, WaveFile *file, SDL_AudioSpec *spec, Uint8 *
             /* Only use the first data chunk. Handling the wavl list madness
              * may require a different approach.
              */
-            if (datachunk.fourcc != DATA) {
-                datachunk = *chunk;
+            if (datachunk->fourcc != DATA) {
+                *datachunk = *chunk;
             }
         } else if (chunk->fourcc == FACT) {
             /* The fact chunk data must be at least 4 bytes for the
@@ -1914,7 +2183,7 @@ static int WaveLoad(SDL_RWops *src, WaveFile *file, SDL_AudioSpec *spec, Uint8 *
             if ((Uint64)RIFFend < (Uint64)chunk->position + chunk->length) {
                 return SDL_SetError("RIFF size truncates chunk");
             }
-        } else if (fmtchunk.fourcc == FMT && datachunk.fourcc == DATA) {
+        } else if (fmtchunk.fourcc == FMT && datachunk->fourcc == DATA) {
             if (file->fact.status == 1 || file->facthint == FactIgnore || file->facthint == FactNoHint) {
                 break;
             }
@@ -1925,13 +2194,18 @@ static int WaveLoad(SDL_RWops *src, WaveFile *file, SDL_AudioSpec *spec, Uint8 *
      * RIFF length is unknown.
      */
     lastchunkpos = chunk->position + chunk->length;
+    if (RIFFlengthknown) {
+        *endposition = RIFFend;
+    } else {
+        *endposition = lastchunkpos;
+    }
 
     /* The fmt chunk is mandatory. */
     if (fmtchunk.fourcc != FMT) {
         return SDL_SetError("Missing fmt chunk in WAVE file");
     }
     /* A data chunk must be present. */
-    if (datachunk.fourcc != DATA) {
+    if (datachunk->fourcc != DATA) {
         return SDL_SetError("Missing data chunk in WAVE file");
     }
     /* Check if the last chunk has all of its data in verystrict mode. */
@@ -1967,7 +2241,7 @@ static int WaveLoad(SDL_RWops *src, WaveFile *file, SDL_AudioSpec *spec, Uint8 *
         return SDL_SetError("Could not read data of WAVE fmt chunk");
     } else if (WaveReadFormat(file) < 0) {
         return -1;
-    } else if (WaveCheckFormat(file, (size_t)datachunk.length) < 0) {
+    } else if (WaveCheckFormat(file, (size_t)datachunk->length) < 0) {
         return -1;
     }
 
@@ -1975,11 +2249,72 @@ static int WaveLoad(SDL_RWops *src, WaveFile *file, SDL_AudioSpec *spec, Uint8 *
     WaveDebugLogFormat(file);
 #endif
 #ifdef SDL_WAVE_DEBUG_DUMP_FORMAT
-    WaveDebugDumpFormat(file, RIFFchunk.length, fmtchunk.length, datachunk.length);
+    WaveDebugDumpFormat(file, RIFFchunk.length, fmtchunk.length, datachunk->length);
 #endif
 
     WaveFreeChunkData(chunk);
 
+    return 0;
+}
+
+/* Reports the format of the decoded data. All unsupported formats were
+ * filtered out by the checks in WaveCheckFormat.
+ */
+static int WaveGetSpec(WaveFile *file, SDL_AudioSpec *spec)
+{
+    WaveFormat *format = &file->format;
+
+    spec->freq = format->frequency;
+    spec->channels = (Uint8)format->channels;
+    spec->format = 0;
+
+    switch (format->encoding) {
+    case MS_ADPCM_CODE:
+    case IMA_ADPCM_CODE:
+    case ALAW_CODE:
+    case MULAW_CODE:
+        /* These can be easily stored in the byte order of the system. */
+        spec->format = SDL_AUDIO_S16;
+        break;
+    case IEEE_FLOAT_CODE:
+        spec->format = SDL_AUDIO_F32LE;
+        break;
+    case PCM_CODE:
+        switch (format->bitspersample) {
+        case 8:
+            spec->format = SDL_AUDIO_U8;
+            break;
+        case 16:
+            spec->format = SDL_AUDIO_S16LE;
+            break;
+        case 24: /* Has been shifted to 32 bits. */
+        case 32:
+            spec->format = SDL_AUDIO_S32LE;
+            break;
+        default:
+            /* Just in case something unexpected happened in the checks. */
+            return SDL_SetError("Unexpected %u-bit PCM data format", (unsigned int)format->bitspersample);
+        }
+        break;
+    default:
+        return SDL_SetError("Unexpected data format");
+    }
+
+    return 0;
+}
+
+static int WaveLoad(SDL_RWops *src, WaveFile *file, SDL_AudioSpec *spec, Uint8 **audio_buf, Uint32 *audio_len)
+{
+    int result;
+    Sint64 endposition;
+    WaveFormat *format = &file->format;
+    WaveChunk *chunk = &file->chunk;
+    WaveChunk datachunk;
+
+    if (WaveReadHeaders(src, file, &datachunk, &endposition) < 0) {
+        return -1;
+    }
+
     /* Process data chunk. */
     *chunk = datachunk;
 
@@ -2026,51 +2361,12 @@ static int WaveLoad(SDL_RWops *src, WaveFile *file, SDL_AudioSpec *spec, Uint8 *
         break;
     }
 
-    /* Setting up the specs. All unsupported formats were filtered out
-     * by checks earlier in this function.
-     */
-    spec->freq = format->frequency;
-    spec->channels = (Uint8)format->channels;
-    spec->format = 0;
-
-    switch (format->encoding) {
-    case MS_ADPCM_CODE:
-    case IMA_ADPCM_CODE:
-    case ALAW_CODE:
-    case MULAW_CODE:
-        /* These can be easily stored in the byte order of the system. */
-        spec->format = SDL_AUDIO_S16;
-        break;
-    case IEEE_FLOAT_CODE:
-        spec->format = SDL_AUDIO_F32LE;
-        break;
-    case PCM_CODE:
-        switch (format->bitspersample) {
-        case 8:
-            spec->format = SDL_AUDIO_U8;
-            break;
-        case 16:
-            spec->format = SDL_AUDIO_S16LE;
-            break;
-        case 24: /* Has been shifted to 32 bits. */
-        case 32:
-            spec->format = SDL_AUDIO_S32LE;
-            break;
-        default:
-            /* Just in case something unexpected happened in the checks. */
-            return SDL_SetError("Unexpected %u-bit PCM data format", (unsigned int)format->bitspersample);
-        }
-        break;
-    default:
-        return SDL_SetError("Unexpected data format");
+    if (WaveGetSpec(file, spec) < 0) {
+        return -1;
     }
 
     /* Report the end position back to the cleanup code. */
-    if (RIFFlengthknown) {
-        chunk->position = RIFFend;
-    } else {
-        chunk->position = lastchunkpos;
-    }
+    chunk->position = endposition;
 
     return 0;
 }
@@ -2127,3 +2423,331 @@ int SDL_LoadWAV(const char *path, SDL_AudioSpec *spec, Uint8 **audio_buf, Uint32
     return SDL_LoadWAV_RW(SDL_RWFromFile(path, "rb"), 1, spec, audio_buf, audio_len);
 }
 
+
+/* Streaming decoder. The data chunk is read in units of one ADPCM block, or
+ * of a fixed number of sample frames for the other encodings, and only the
+ * unit being played is kept in memory.
+ */
+
+#define WAVE_READER_UNIT_SIZE 65536 /* Target size of a PCM or companded read unit in bytes. */
+
+struct SDL_WAVReader
+{
+    SDL_RWops *src;
+    SDL_bool freesrc;
+    WaveFile file;
+    SDL_AudioSpec spec;
+    Sint64 datastart;    /* Position of the data chunk in the stream. */
+    Uint32 datalength;   /* Length of the data chunk in bytes. */
+    Sint64 endposition;  /* Where the stream is left when the reader is closed. */
+    Sint64 frames;       /* Total number of sample frames. */
+    Sint64 frame;        /* The next sample frame to decode. */
+    size_t framesize;    /* Size of a decoded sample frame in bytes. */
+    size_t unitframes;   /* Number of sample frames in a read unit. */
+    size_t unitsize;     /* Size of a read unit in the data chunk in bytes. */
+    Uint8 *input;        /* The raw data of the read unit. */
+    Uint8 *output;       /* The decoded read unit. Can be the same as input. */
+    Sint64 unit;         /* The read unit in output, or -1. */
+    size_t unitdecoded;  /* Number of sample frames in output. */
+    union
+    {
+        MS_ADPCM_ChannelState ms[2];
+        Sint8 ima[1];    /* One per channel, allocated with the reader. Has to be last member. */
+    } cstate;
+};
+
+static int WaveReaderDecodeADPCM(SDL_WAVReader *reader, size_t length, Sint64 framesleft)
+{
+    WaveFile *file = &reader->file;
+    ADPCM_DecoderState state;
+    int result;
+
+    SDL_zero(state);
+    state.channels = file->format.channels;
+    state.blocksize = file->format.blockalign;
+    state.samplesperblock = file->format.samplesperblock;
+    state.framesize = state.channels * sizeof(Sint16);
+    state.ddata = file->decoderdata;
+    state.framestotal = framesleft;
+    state.framesleft = framesleft;
+
+    state.block.data = reader->input;
+    state.block.size = length;
+    state.block.pos = 0;
+
+    state.output.data = (Sint16 *)reader->output;
+    state.output.size = reader->unitframes * state.channels;
+    state.output.pos = 0;
+
+    if (file->format.encoding == MS_ADPCM_CODE) {
+        state.blockheadersize = (size_t)state.channels * 7;
+        state.cstate = reader->cstate.ms;
+    } else {
+        state.blockheadersize = (size_t)state.channels * 4;
+        state.cstate = reader->cstate.ima;
+    }
+    if (length < state.blockheadersize) {
+        /* Truncated in the block header. Nothing to get out of it. */
+        reader->unitdecoded = 0;
+        return 0;
+    }
+
+    if (file->format.encoding == MS_ADPCM_CODE) {
+        result = MS_ADPCM_DecodeBlockHeader(&state);
+        if (result == 0) {
+            result = MS_ADPCM_DecodeBlockData(&state);
+        }
+    } else {
+        result = IMA_ADPCM_DecodeBlockHeader(&state);
+        if (result == 0) {
+            result = IMA_ADPCM_DecodeBlockData(&state);
+        }
+    }
+
+    if (result == -1) {
+        /* Truncated block, handled like the decoders of SDL_LoadWAV_RW do. */
+        if (file->trunchint == TruncVeryStrict || file->trunchint == TruncStrict) {
+            return SDL_SetError("Truncated data chunk");
+        } else if (file->trunchint != TruncDropFrame) {
+            state.output.pos = 0;
+        }
+    }
+
+    /* The MS ADPCM block header always holds two sample frames. */
+    reader->unitdecoded = state.output.pos / state.channels;
+    if ((Sint64)reader->unitdecoded > framesleft) {
+        reader->unitdecoded = (size_t)framesleft;
+    }
+    return 0;
+}
+
+/* Reads and decodes a read unit into reader->output. */
+static int WaveReaderDecodeUnit(SDL_WAVReader *reader, Sint64 unit)
+{
+    WaveFile *file = &reader->file;
+    const Uint64 offset = (Uint64)unit * reader->unitsize;
+    const Sint64 framesleft = SDL_min(reader->frames - unit * (Sint64)reader->unitframes, (Sint64)reader->unitframes);
+    size_t length, amount, samples;
+
+    reader->unit = -1;
+    reader->unitdecoded = 0;
+
+    if (framesleft <= 0 || offset >= reader->datalength) {
+        reader->unit = unit;
+        return 0;
+    }
+
+    length = (size_t)SDL_min((Uint64)reader->unitsize, reader->datalength - offset);
+    if (SDL_RWseek(reader->src, reader->datastart + (Sint64)offset, SDL_RW_SEEK_SET) != reader->datastart + (Sint64)offset) {
+        return SDL_SetError("Could not seek data of WAVE data chunk");
+    }
+    amount = SDL_RWread(reader->src, reader->input, length);
+    if (amount != length) {
+        /* I/O issues or corrupt file. */
+        if (reader->src->status == SDL_RWOPS_STATUS_ERROR) {
+            return -1;
+        } else if (file->trunchint == TruncVeryStrict || file->trunchint == TruncStrict) {
+            return SDL_SetError("Could not read data of WAVE data chunk");
+        }
+    }
+
+    switch (file->format.encoding) {
+    case MS_ADPCM_CODE:
+    case IMA_ADPCM_CODE:
+        if (WaveReaderDecodeADPCM(reader, amount, framesleft) < 0) {
+            return -1;
+        }
+        break;
+    default:
+        /* Incomplete sample frames are dropped. */
+        reader->unitdecoded = (size_t)SDL_min((Sint64)(amount / (reader->unitsize / reader->unitframes)), framesleft);
+        samples = reader->unitdecoded * file->format.channels;
+        if (file->format.encoding == ALAW_CODE || file->format.encoding == MULAW_CODE) {
+            LAW_DecodeSamples(file->format.encoding, reader->input, (Sint16 *)reader->output, samples);
+        } else if (file->format.encoding == PCM_CODE && file->format.bitspersample == 24) {
+            PCM_ExpandSint24ToSint32(reader->output, samples);
+        }
+        break;
+    }
+
+    reader->unit = unit;
+    return 0;
+}
+
+SDL_WAVReader *SDL_OpenWAVReader(SDL_RWops *src, SDL_bool freesrc, SDL_AudioSpec *spec)
+{
+    SDL_WAVReader *reader = NULL;
+    WaveFile file;
+    WaveChunk datachunk;
+    Sint64 endposition;
+    size_t inputframesize, unitframes, outputsize;
+
+    SDL_zero(file);
+
+    /* Make sure we are passed a valid data source */
+    if (!src) {
+        goto failed;  /* Error may come from RWops. */
+    } else if (!spec) {
+        SDL_InvalidParamError("spec");
+        goto failed;
+    }
+
+    file.riffhint = WaveGetRiffSizeHint();
+    file.trunchint = WaveGetTruncationHint();
+    file.facthint = WaveGetFactChunkHint();
+
+    if (WaveReadHeaders(src, &file, &datachunk, &endposition) < 0 || WaveGetSpec(&file, spec) < 0) {
+        goto failed;
+    }
+
+    switch (file.format.encoding) {
+    case MS_ADPCM_CODE:
+    case IMA_ADPCM_CODE:
+        inputframesize = 0;
+        unitframes = file.format.samplesperblock;
+        break;
+    default:
+        /* The PCM decoder counts the data in blocks. Count whole sample frames
+         * instead, they're the same for all but unusual block alignments.
+         */
+        inputframesize = ((size_t)file.format.channels * file.format.bitspersample) / 8;
+        unitframes = SDL_max(WAVE_READER_UNIT_SIZE / inputframesize, 1);
+        break;
+    }
+
+    reader = (SDL_WAVReader *)SDL_calloc(1, sizeof(*reader) + file.format.channels);
+    if (!reader) {
+        goto failed;
+    }
+    reader->src = src;
+    reader->freesrc = freesrc;
+    reader->file = file;
+    reader->spec = *spec;
+    reader->datastart = datachunk.position;
+    reader->datalength = datachunk.length;
+    reader->endposition = endposition;
+    reader->framesize = SDL_AUDIO_FRAMESIZE(*spec);
+    reader->unitframes = unitframes;
+    reader->unit = -1;
+
+    if (inputframesize) {
+        reader->frames = (file.sampleframes * file.format.blockalign) / (Sint64)inputframesize;
+        reader->unitsize = unitframes * inputframesize;
+    } else {
+        reader->frames = file.sampleframes;
+        reader->unitsize = file.format.blockalign;
+    }
+
+    /* Companded and 24-bit samples are expanded in place. */
+    outputsize = unitframes * reader->framesize;
+    reader->input = (Uint8 *)SDL_malloc(SDL_max(reader->unitsize, outputsize));
+    if (!reader->input) {
+        reader->file.decoderdata = NULL;  /* Freed below. */
+        SDL_free(reader);
+        goto failed;
+    }
+    if (inputframesize) {
+        reader->output = reader->input;
+    } else {
+        reader->output = (Uint8 *)SDL_malloc(outputsize);
+        if (!reader->output) {
+            SDL_free(reader->input);
+            reader->file.decoderdata = NULL;  /* Freed below. */
+            SDL_free(reader);
+            goto failed;
+        }
+    }
+
+    return reader;
+
+failed:
+    WaveFreeChunkData(&file.chunk);
+    SDL_free(file.decoderdata);
+    if (freesrc && src) {
+        SDL_RWclose(src);
+    }
+    return NULL;
+}
+
+Sint64 SDL_GetWAVFrameCount(SDL_WAVReader *reader)
+{
+    if (!reader) {
+        return SDL_InvalidParamError("reader");
+    }
+    return reader->frames;
+}
+
+int SDL_ReadWAVFrames(SDL_WAVReader *reader, SDL_AudioStream *stream, int frames)
+{
+    int total = 0;
+
+    if (!reader) {
+        return SDL_InvalidParamError("reader");
+    } else if (!stream) {
+        return SDL_InvalidParamError("stream");
+    } else if (frames < 0) {
+        return SDL_InvalidParamError("frames");
+    }
+
+    while (total < frames && reader->frame < reader->frames) {
+        const Sint64 unit = reader->frame / (Sint64)reader->unitframes;
+        const size_t skip = (size_t)(reader->frame - unit * (Sint64)reader->unitframes);
+        size_t amount;
+
+        if (unit != reader->unit && WaveReaderDecodeUnit(reader, unit) < 0) {
+            return -1;
+        }
+        if (reader->unitdecoded <= skip) {
+            /* The file ends early. */
+            break;
+        }
+
+        amount = SDL_min(reader->unitdecoded - skip, (size_t)(frames - total));
+        if (SDL_PutAudioStreamData(stream, reader->output + skip * reader->framesize, (int)(amount * reader->framesize)) < 0) {
+            return -1;
+        }
+        reader->frame += amount;
+        total += (int)amount;
+    }
+
+    return total;
+}
+
+int SDL_SeekWAVFrame(SDL_WAVReader *reader, Sint64 frame)
+{
+    if (!reader) {
+        return SDL_InvalidParamError("reader");
+    } else if (frame < 0) {
+        return SDL_InvalidParamError("frame");
+    }
+
+    reader->frame = SDL_min(frame, reader->frames);
+    return 0;
+}
+
+Sint64 SDL_TellWAVFrame(SDL_WAVReader *reader)
+{
+    if (!reader) {
+        return SDL_InvalidParamError("reader");
+    }
+    return reader->frame;
+}
+
+void SDL_CloseWAVReader(SDL_WAVReader *reader)
+{
+    if (!reader) {
+        return;
+    }
+
+    if (reader->freesrc) {
+        SDL_RWclose(reader->src);
+    } else {
+        SDL_RWseek(reader->src, reader->endposition, SDL_RW_SEEK_SET);
+    }
+    if (reader->output != reader->input) {
+        SDL_free(reader->output);
+    }
+    SDL_free(reader->input);
+    SDL_free(reader->file.decoderdata);
+    SDL_free(reader);
+}
@@ -54,6 +54,388 @@ static const CameraBootStrap *const bootstrap[] = {
 
 static SDL_CameraDriver camera_driver;
 
+// Frames that need conversion or scaling are handed off to a small pool of worker threads (shared by all open cameras),
+//  so the camera threads only have to acquire frames from the backend and can't fall behind the hardware.
+typedef struct CameraWorkerPool
+{
+    SDL_Mutex *lock;
+    SDL_Condition *work_cond;  // signaled when a frame is queued, or when shutting down.
+    SDL_Condition *done_cond;  // signaled when a worker finishes a frame.
+    SDL_Thread **threads;
+    int num_threads;
+    SurfaceList pending;       // frames waiting for a worker. This is FIFO.
+    SurfaceList *pending_tail;
+    SDL_bool shutting_down;
+} CameraWorkerPool;
+
+static CameraWorkerPool camera_workers;
+
+// Only the thread that moves this from NONE to STARTING sets up camera_workers, without holding a lock.
+#define CAMERA_WORKERS_NONE     0
+#define CAMERA_WORKERS_STARTING 1
+#define CAMERA_WORKERS_RUNNING  2
+static SDL_AtomicInt camera_workers_state;
+
+// Converted frames are scaled in bands of rows about this size, so the intermediate data stays in the CPU cache.
+#define CAMERA_BAND_BYTES (256 * 1024)
+
+static void FreeCameraConversionScratch(CameraConversionScratch *scratch)
+{
+    SDL_aligned_free(scratch->band);
+    SDL_aligned_free(scratch->planar);
+    SDL_DestroySurface(scratch->surface);
+    SDL_zerop(scratch);
+}
+
+static SDL_bool ReserveCameraScratch(Uint8 **buf, size_t *buflen, size_t len)
+{
+    if (*buflen < len) {
+        Uint8 *ptr = (Uint8 *) SDL_aligned_alloc(SDL_SIMDGetAlignment(), len);
+        if (!ptr) {
+            return SDL_FALSE;
+        }
+        SDL_aligned_free(*buf);
+        *buf = ptr;
+        *buflen = len;
+    }
+    return SDL_TRUE;
+}
+
+// Planar YUV formats store their chroma after the whole Y plane, so a band of rows isn't contiguous; gather it into scratch memory.
+//  `y` must be even, so the chroma rows line up.
+static const void *GetCameraFrameBand(SDL_Surface *src, int y, int h, CameraConversionScratch *scratch)
+{
+    const Uint8 *pixels = (const Uint8 *) src->pixels;
+    const int pitch = src->pitch;
+    int uv_pitch, num_uv_planes;
+
+    switch (src->format->format) {
+        case SDL_PIXELFORMAT_YV12:
+        case SDL_PIXELFORMAT_IYUV:
+            uv_pitch = (pitch + 1) / 2;
+            num_uv_planes = 2;
+            break;
+
+        case SDL_PIXELFORMAT_NV12:
+        case SDL_PIXELFORMAT_NV21:
+            uv_pitch = 2 * ((pitch + 1) / 2);
+            num_uv_planes = 1;
+            break;
+
+        case SDL_PIXELFORMAT_P010:
+        case SDL_PIXELFORMAT_P016:
+            uv_pitch = 4 * ((pitch / 2 + 1) / 2);
+            num_uv_planes = 1;
+            break;
+
+        default:
+            return pixels + ((size_t) y) * pitch;  // packed formats: the rows are already contiguous.
+    }
+
+    SDL_assert((y & 1) == 0);
+
+    const size_t ylen = ((size_t) pitch) * h;
+    const size_t uvlen = ((size_t) uv_pitch) * ((h + 1) / 2);
+    const size_t src_uv_plane_len = ((size_t) uv_pitch) * ((src->h + 1) / 2);
+    if (!ReserveCameraScratch(&scratch->planar, &scratch->planar_len, ylen + (uvlen * num_uv_planes))) {
+        return NULL;
+    }
+
+    SDL_memcpy(scratch->planar, pixels + ((size_t) y) * pitch, ylen);
+    const Uint8 *uv = pixels + ((size_t) pitch) * src->h + ((size_t) (y / 2)) * uv_pitch;
+    for (int i = 0; i < num_uv_planes; i++) {
+        SDL_memcpy(scratch->planar + ylen + (uvlen * i), uv + (src_uv_plane_len * i), uvlen);
+    }
+    return scratch->planar;
+}
+
+static void StretchCameraRowNearest(const Uint8 *src, Uint8 *dst, const int *xmap, int w, int bpp)
+{
+    int x;
+
+    switch (bpp) {
+        case 1:
+            for (x = 0; x < w; x++) {
+                dst[x] = src[xmap[x]];
+            }
+            break;
+
+        case 2:
+            for (x = 0; x < w; x++) {
+                ((Uint16 *) dst)[x] = ((const Uint16 *) src)[xmap[x]];
+            }
+            break;
+
+        case 4:
+            for (x = 0; x < w; x++) {
+                ((Uint32 *) dst)[x] = ((const Uint32 *) src)[xmap[x]];
+            }
+            break;
+
+        default:
+            for (x = 0; x < w; x++) {
+                SDL_memcpy(dst + (x * bpp), src + (xmap[x] * bpp), bpp);
+            }
+            break;
+    }
+}
+
+// Scale (nearest) and convert in one pass: a band of source rows is converted into a small cache-friendly buffer,
+//  and the output rows that sample from it are filled in from there, so we never write out a full-size middleman surface.
+static int ScaleAndConvertCameraFrame(SDL_CameraDevice *device, SDL_Surface *src, SDL_Surface *dst, CameraConversionScratch *scratch)
+{
+    const Uint32 src_format = src->format->format;
+    const Uint32 dst_format = dst->format->format;
+    const int bpp = SDL_BYTESPERPIXEL(dst_format);
+    const int *xmap = device->scale_map;
+    const int *ymap = xmap + dst->w;
+    const int rowlen = src->w * bpp;
+    const int bandh = SDL_clamp((CAMERA_BAND_BYTES / rowlen) & ~1, 2, src->h + (src->h & 1));
+    int dy = 0;
+
+    SDL_assert(!SDL_ISPIXELFORMAT_FOURCC(dst_format));
+
+    if (device->needs_conversion && !ReserveCameraScratch(&scratch->band, &scratch->band_len, ((size_t) rowlen) * bandh)) {
+        return -1;
+    }
+
+    for (int y = 0; (y < src->h) && (dy < dst->h); y += bandh) {
+        const int h = SDL_min(bandh, src->h - y);
+        const Uint8 *rows;
+        int rowpitch;
+
+        if (ymap[dy] >= (y + h)) {
+            continue;  // downscaling skipped this whole band.
+        }
+
+        if (device->needs_conversion) {
+            const void *band = GetCameraFrameBand(src, y, h, scratch);
+            if (!band || (SDL_ConvertPixels(src->w, h, src_format, band, src->pitch, dst_format, scratch->band, rowlen) < 0)) {
+                return -1;
+            }
+            rows = scratch->band;
+            rowpitch = rowlen;
+        } else {
+            rows = ((const Uint8 *) src->pixels) + ((size_t) y) * src->pitch;
+            rowpitch = src->pitch;
+        }
+
+        for (; (dy < dst->h) && (ymap[dy] < (y + h)); dy++) {
+            Uint8 *dstrow = ((Uint8 *) dst->pixels) + ((size_t) dy) * dst->pitch;
+            if ((dy > 0) && (ymap[dy] == ymap[dy - 1])) {  // upscaling repeats rows, just copy the one we already did.
+                SDL_memcpy(dstrow, dstrow - dst->pitch, ((size_t) dst->w) * bpp);
+            } else {
+                StretchCameraRowNearest(rows + ((size_t) (ymap[dy] - y)) * rowpitch, dstrow, xmap, dst->w, bpp);
+            }
+        }
+    }
+
+    return 0;
+}
+
+static int ConvertCameraFrame(SDL_CameraDevice *device, SDL_Surface *src, SDL_Surface *dst, CameraConversionScratch *scratch)
+{
+    if (!device->needs_scaling) {
+        return SDL_ConvertPixels(src->w, src->h, src->format->format, src->pixels, src->pitch,
+                                 dst->format->format, dst->pixels, dst->pitch);
+    } else if (!SDL_ISPIXELFORMAT_FOURCC(dst->format->format)) {
+        return ScaleAndConvertCameraFrame(device, src, dst, scratch);
+    }
+
+    // YUV output can't be scaled a few rows at a time, so go through a full-size middleman surface.
+    const SDL_bool downscaling_first = (device->needs_scaling < 0);
+    SDL_Surface *srcsurf = src;
+    if (device->needs_conversion) {
+        const int w = downscaling_first ? dst->w : src->w;
+        const int h = downscaling_first ? dst->h : src->h;
+        const Uint32 fmt = downscaling_first ? src->format->format : dst->format->format;
+        if (!scratch->surface || (scratch->surface->w != w) || (scratch->surface->h != h) || (scratch->surface->format->format != fmt)) {
+            SDL_DestroySurface(scratch->surface);
+            scratch->surface = SDL_CreateSurface(w, h, fmt);
+            if (!scratch->surface) {
+                return -1;
+            }
+        }
+    }
+
+    if (downscaling_first) {  // downscaling? Do it first.
+        SDL_Surface *dstsurf = device->needs_conversion ? scratch->surface : dst;
+        if (SDL_SoftStretch(srcsurf, NULL, dstsurf, NULL, SDL_SCALEMODE_NEAREST) < 0) {  // !!! FIXME: linear scale? letterboxing?
+            return -1;
+        }
+        srcsurf = dstsurf;
+    }
+    if (device->needs_conversion) {
+        SDL_Surface *dstsurf = downscaling_first ? dst : scratch->surface;
+        if (SDL_ConvertPixels(srcsurf->w, srcsurf->h,
+                              srcsurf->format->format, srcsurf->pixels, srcsurf->pitch,
+                              dstsurf->format->format, dstsurf->pixels, dstsurf->pitch) < 0) {
+            return -1;
+        }
+        srcsurf = dstsurf;
+    }
+    if (!downscaling_first) {  // upscaling? Do it last.
+        if (SDL_SoftStretch(srcsurf, NULL, dst, NULL, SDL_SCALEMODE_NEAREST) < 0) {  // !!! FIXME: linear scale? letterboxing?
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// Convert/scale an acquired frame into its output surface, give the backend its buffer back, and queue the result for the app.
+// If the conversion fails, the frame is dropped and the output surface goes back to the empty list.
+static void ProcessCameraFrame(SDL_CameraDevice *device, SurfaceList *slist, CameraConversionScratch *scratch)
+{
+    SDL_Surface *acquired = slist->acquired;
+
+    #if DEBUG_CAMERA
+    SDL_Log("CAMERA: Frame is getting converted!");
+    #endif
+
+    const int rc = ConvertCameraFrame(device, acquired, slist->surface, scratch);
+
+    SDL_LockMutex(device->lock);
+    // we made a copy, so we can give the driver back its resources.
+    device->ReleaseFrame(device, acquired);
+    acquired->pixels = NULL;
+    acquired->pitch = 0;
+    if (rc < 0) {
+        #if DEBUG_CAMERA
+        SDL_Log("CAMERA: Frame conversion failed, dropping frame: %s", SDL_GetError());
+        #endif
+        slist->timestampNS = 0;
+        slist->next = device->empty_output_surfaces.next;
+        device->empty_output_surfaces.next = slist;
+    } else {
+        // make the filled output surface available to the app.
+        slist->next = device->filled_output_surfaces.next;
+        device->filled_output_surfaces.next = slist;
+    }
+    SDL_UnlockMutex(device->lock);
+}
+
+static int SDLCALL CameraWorkerThread(void *data)
+{
+    CameraConversionScratch scratch;
+    SDL_zero(scratch);
+
+    SDL_LockMutex(camera_workers.lock);
+    for (;;) {
+        // Find the oldest queued frame from a camera that isn't already being worked on. Each camera's frames are
+        // converted one at a time, so they reach the app in order; different cameras are converted in parallel.
+        SurfaceList *prev = &camera_workers.pending;
+        while (prev->next && prev->next->device->converting) {
+            prev = prev->next;
+        }
+
+        SurfaceList *slist = prev->next;
+        if (!slist) {
+            if (camera_workers.shutting_down && !camera_workers.pending.next) {
+                break;  // shutting down and nothing left to do.
+            }
+            SDL_WaitCondition(camera_workers.work_cond, camera_workers.lock);
+            continue;
+        }
+
+        prev->next = slist->next;
+        if (!slist->next) {
+            camera_workers.pending_tail = prev;
+        }
+
+        SDL_CameraDevice *device = slist->device;
+        device->converting = SDL_TRUE;
+        SDL_UnlockMutex(camera_workers.lock);
+
+        ProcessCameraFrame(device, slist, &scratch);
+
+        SDL_LockMutex(camera_workers.lock);
+        device->converting = SDL_FALSE;
+        device->pending_conversions--;
+        SDL_BroadcastCondition(camera_workers.done_cond);
+    }
+    SDL_UnlockMutex(camera_workers.lock);
+
+    FreeCameraConversionScratch(&scratch);
+    return 0;
+}
+
+static void QuitCameraWorkers(void)
+{
+    if (camera_workers.lock) {
+        SDL_LockMutex(camera_workers.lock);
+        camera_workers.shutting_down = SDL_TRUE;
+        SDL_BroadcastCondition(camera_workers.work_cond);
+        SDL_UnlockMutex(camera_workers.lock);
+
+        for (int i = 0; i < camera_workers.num_threads; i++) {
+            SDL_WaitThread(camera_workers.threads[i], NULL);
+        }
+
+        SDL_free(camera_workers.threads);
+        SDL_DestroyCondition(camera_workers.done_cond);
+        SDL_DestroyCondition(camera_workers.work_cond);
+        SDL_DestroyMutex(camera_workers.lock);
+    }
+    SDL_zero(camera_workers);
+    SDL_AtomicSet(&camera_workers_state, CAMERA_WORKERS_NONE);
+}
+
+// Start the worker threads the first time a camera needs frames converted. Returns SDL_FALSE to convert on the camera thread instead.
+// A camera opened while another thread is still starting the workers converts on its own thread too.
+static SDL_bool InitCameraWorkers(void)
+{
+    if (SDL_AtomicGet(&camera_workers_state) == CAMERA_WORKERS_RUNNING) {
+        return SDL_TRUE;
+    }
+    if (!SDL_AtomicCompareAndSwap(&camera_workers_state, CAMERA_WORKERS_NONE, CAMERA_WORKERS_STARTING)) {
+        return SDL_FALSE;
+    }
+
+    int num_threads = SDL_min(SDL_GetCPUCount(), 4);
+    const char *hint = SDL_GetHint(SDL_HINT_CAMERA_CONVERSION_THREADS);
+    if (hint && *hint) {
+        num_threads = SDL_atoi(hint);
+    }
+
+    if (num_threads > 0) {
+        camera_workers.pending_tail = &camera_workers.pending;
+        camera_workers.lock = SDL_CreateMutex();
+        camera_workers.work_cond = SDL_CreateCondition();
+        camera_workers.done_cond = SDL_CreateCondition();
+        camera_workers.threads = (SDL_Thread **) SDL_calloc(num_threads, sizeof (SDL_Thread *));
+        if (camera_workers.lock && camera_workers.work_cond && camera_workers.done_cond && camera_workers.threads) {
+            for (int i = 0; i < num_threads; i++) {
+                char threadname[64];
+                (void)SDL_snprintf(threadname, sizeof (threadname), "SDLCameraWorker%d", i);
+                camera_workers.threads[i] = SDL_CreateThreadInternal(CameraWorkerThread, threadname, 0, NULL);
+                if (!camera_workers.threads[i]) {
+                    break;
+                }
+                camera_workers.num_threads++;
+            }
+        }
+    }
+
+    if (camera_workers.num_threads == 0) {
+        QuitCameraWorkers();  // this sets the state back to NONE, so the next camera tries again.
+        return SDL_FALSE;
+    }
+
+    SDL_AtomicSet(&camera_workers_state, CAMERA_WORKERS_RUNNING);
+    return SDL_TRUE;
+}
+
+static void QueueCameraConversion(SDL_CameraDevice *device, SurfaceList *slist)
+{
+    SDL_LockMutex(camera_workers.lock);
+    device->pending_conversions++;
+    slist->next = NULL;
+    camera_workers.pending_tail->next = slist;
+    camera_workers.pending_tail = slist;
+    SDL_SignalCondition(camera_workers.work_cond);
+    SDL_UnlockMutex(camera_workers.lock);
+}
+
 
 int SDL_GetNumCameraDrivers(void)
 {
@@ -235,6 +617,21 @@ static void ClosePhysicalCameraDevice(SDL_CameraDevice *device)
         device->thread = NULL;
     }
 
+    // a backend's own thread might be in the middle of feeding us; anything that starts now will see the shutdown flag.
+    while (SDL_AtomicGet(&device->iterating) > 0) {
+        SDL_Delay(1);
+    }
+
+    // wait for any frames still being converted on the worker threads, so they give the backend its buffers back first.
+    if (device->use_workers) {
+        SDL_LockMutex(camera_workers.lock);
+        while (device->pending_conversions > 0) {
+            SDL_WaitCondition(camera_workers.done_cond, camera_workers.lock);
+        }
+        SDL_UnlockMutex(camera_workers.lock);
+        device->use_workers = SDL_FALSE;
+    }
+
     // release frames that are queued up somewhere...
     if (!device->needs_conversion && !device->needs_scaling) {
         for (SurfaceList *i = device->filled_output_surfaces.next; i != NULL; i = i->next) {
@@ -251,11 +648,16 @@ static void ClosePhysicalCameraDevice(SDL_CameraDevice *device)
 
     SDL_DestroySurface(device->acquire_surface);
     device->acquire_surface = NULL;
-    SDL_DestroySurface(device->conversion_surface);
-    device->conversion_surface = NULL;
+    SDL_free(device->scale_map);
+    device->scale_map = NULL;
+    FreeCameraConversionScratch(&device->scratch);
 
     for (int i = 0; i < SDL_arraysize(device->output_surfaces); i++) {
-        SDL_DestroySurface(device->output_surfaces[i].surface);
+        SurfaceList *slist = &device->output_surfaces[i];
+        if (slist->acquired != slist->surface) {
+            SDL_DestroySurface(slist->acquired);
+        }
+        SDL_DestroySurface(slist->surface);
     }
     SDL_zeroa(device->output_surfaces);
 
@@ -761,7 +1163,7 @@ void SDL_CameraThreadSetup(SDL_CameraDevice *device)
 #endif
 }
 
-SDL_bool SDL_CameraThreadIterate(SDL_CameraDevice *device)
+static SDL_bool CameraThreadIterate(SDL_CameraDevice *device)
 {
     SDL_LockMutex(device->lock);
 
@@ -777,35 +1179,36 @@ SDL_bool SDL_CameraThreadIterate(SDL_CameraDevice *device)
     }
 
     SDL_bool failed = SDL_FALSE;  // set to true if disaster worthy of treating the device as lost has happened.
-    SDL_Surface *acquired = NULL;
-    SDL_Surface *output_surface = NULL;
-    SurfaceList *slist = NULL;
     Uint64 timestampNS = 0;
 
+    // Grab an empty output surface before acquiring, so the backend can fill it directly. If there isn't one (or we're
+    // dropping initial frames), acquire into acquire_surface and give it right back.
+    SurfaceList *slist = (device->drop_frames > 0) ? NULL : device->empty_output_surfaces.next;
+    SDL_Surface *acquired = slist ? slist->acquired : device->acquire_surface;
+
     // AcquireFrame SHOULD NOT BLOCK, as we are holding a lock right now. Block in WaitDevice instead!
-    const int rc = device->AcquireFrame(device, device->acquire_surface, &timestampNS);
+    const int rc = device->AcquireFrame(device, acquired, &timestampNS);
 
     if (rc == 1) {  // new frame acquired!
         #if DEBUG_CAMERA
-        SDL_Log("CAMERA: New frame available! pixels=%p pitch=%d", device->acquire_surface->pixels, device->acquire_surface->pitch);
+        SDL_Log("CAMERA: New frame available! pixels=%p pitch=%d", acquired->pixels, acquired->pitch);
         #endif
 
-        if (device->drop_frames > 0) {
-            #if DEBUG_CAMERA
-            SDL_Log("CAMERA: Dropping an initial frame");
-            #endif
-            device->drop_frames--;
-            device->ReleaseFrame(device, device->acquire_surface);
-            device->acquire_surface->pixels = NULL;
-            device->acquire_surface->pitch = 0;
-        } else if (device->empty_output_surfaces.next == NULL) {
-            // uhoh, no output frames available! Either the app is slow, or it forgot to release frames when done with them. Drop this new frame.
-            #if DEBUG_CAMERA
-            SDL_Log("CAMERA: No empty output surfaces! Dropping frame!");
-            #endif
-            device->ReleaseFrame(device, device->acquire_surface);
-            device->acquire_surface->pixels = NULL;
-            device->acquire_surface->pitch = 0;
+        if (!slist) {
+            if (device->drop_frames > 0) {
+                #if DEBUG_CAMERA
+                SDL_Log("CAMERA: Dropping an initial frame");
+                #endif
+                device->drop_frames--;
+            } else {
+                // uhoh, no output frames available! Either the app is slow, or it forgot to release frames when done with them. Drop this new frame.
+                #if DEBUG_CAMERA
+                SDL_Log("CAMERA: No empty output surfaces! Dropping frame!");
+                #endif
+            }
+            device->ReleaseFrame(device, acquired);
+            acquired->pixels = NULL;
+            acquired->pitch = 0;
         } else {
             if (!device->adjust_timestamp) {
                 device->adjust_timestamp = SDL_GetTicksNS();
@@ -813,22 +1216,33 @@ SDL_bool SDL_CameraThreadIterate(SDL_CameraDevice *device)
             }
             timestampNS = (timestampNS - device->base_timestamp) + device->adjust_timestamp;
 
-            slist = device->empty_output_surfaces.next;
-            output_surface = slist->surface;
             device->empty_output_surfaces.next = slist->next;
-            acquired = device->acquire_surface;
             slist->timestampNS = timestampNS;
+
+            if (!device->needs_scaling && !device->needs_conversion) {
+                // no conversion needed? The backend filled the output surface directly, so the app gets the
+                // pixels without a single copy. It'll be released to the backend when the app releases the frame.
+                #if DEBUG_CAMERA
+                SDL_Log("CAMERA: Frame is going through without conversion!");
+                #endif
+                slist->next = device->filled_output_surfaces.next;
+                device->filled_output_surfaces.next = slist;
+                slist = NULL;
+            }
+        }
+    } else {
+        slist = NULL;
+        if (rc == 0) {  // no frame available yet; not an error.
+            #if 0 //DEBUG_CAMERA
+            SDL_Log("CAMERA: No frame available yet.");
+            #endif
+        } else {  // fatal error!
+            SDL_assert(rc == -1);
+            #if DEBUG_CAMERA
+            SDL_Log("CAMERA: dev[%p] error AcquireFrame: %s", device, SDL_GetError());
+            #endif
+            failed = SDL_TRUE;
         }
-    } else if (rc == 0) {  // no frame available yet; not an error.
-        #if 0 //DEBUG_CAMERA
-        SDL_Log("CAMERA: No frame available yet.");
-        #endif
-    } else {  // fatal error!
-        SDL_assert(rc == -1);
-        #if DEBUG_CAMERA
-        SDL_Log("CAMERA: dev[%p] error AcquireFrame: %s", device, SDL_GetError());
-        #endif
-        failed = SDL_TRUE;
     }
 
     // we can let go of the lock once we've tried to grab a frame of video and maybe moved the output frame off the empty list.
@@ -837,55 +1251,26 @@ SDL_bool SDL_CameraThreadIterate(SDL_CameraDevice *device)
 
     if (failed) {
         SDL_assert(slist == NULL);
-        SDL_assert(acquired == NULL);
         SDL_CameraDeviceDisconnected(device);  // doh.
-    } else if (acquired) {  // we have a new frame, scale/convert if necessary and queue it for the app!
-        SDL_assert(slist != NULL);
-        if (!device->needs_scaling && !device->needs_conversion) {  // no conversion needed? Just move the pointer/pitch into the output surface.
-            #if DEBUG_CAMERA
-            SDL_Log("CAMERA: Frame is going through without conversion!");
-            #endif
-            output_surface->pixels = acquired->pixels;
-            output_surface->pitch = acquired->pitch;
-        } else {  // convert/scale into a different surface.
-            #if DEBUG_CAMERA
-            SDL_Log("CAMERA: Frame is getting converted!");
-            #endif
-            SDL_Surface *srcsurf = acquired;
-            if (device->needs_scaling == -1) {  // downscaling? Do it first.  -1: downscale, 0: no scaling, 1: upscale
-                SDL_Surface *dstsurf = device->needs_conversion ? device->conversion_surface : output_surface;
-                SDL_SoftStretch(srcsurf, NULL, dstsurf, NULL, SDL_SCALEMODE_NEAREST);  // !!! FIXME: linear scale? letterboxing?
-                srcsurf = dstsurf;
-            }
-            if (device->needs_conversion) {
-                SDL_Surface *dstsurf = (device->needs_scaling == 1) ? device->conversion_surface : output_surface;
-                SDL_ConvertPixels(srcsurf->w, srcsurf->h,
-                                  srcsurf->format->format, srcsurf->pixels, srcsurf->pitch,
-                                  dstsurf->format->format, dstsurf->pixels, dstsurf->pitch);
-                srcsurf = dstsurf;
-            }
-            if (device->needs_scaling == 1) {  // upscaling? Do it last.  -1: downscale, 0: no scaling, 1: upscale
-                SDL_SoftStretch(srcsurf, NULL, output_surface, NULL, SDL_SCALEMODE_NEAREST);  // !!! FIXME: linear scale? letterboxing?
-            }
-
-            // we made a copy, so we can give the driver back its resources.
-            device->ReleaseFrame(device, acquired);
+    } else if (slist) {  // we have a new frame that needs to be scaled/converted before we queue it for the app!
+        if (device->use_workers) {
+            QueueCameraConversion(device, slist);  // a worker thread will finish it, we can go back to waiting for the next frame.
+        } else {
+            ProcessCameraFrame(device, slist, &device->scratch);
         }
-
-        // we either released these already after we copied the data, or the pointer was migrated to output_surface.
-        acquired->pixels = NULL;
-        acquired->pitch = 0;
-
-        // make the filled output surface available to the app.
-        SDL_LockMutex(device->lock);
-        slist->next = device->filled_output_surfaces.next;
-        device->filled_output_surfaces.next = slist;
-        SDL_UnlockMutex(device->lock);
     }
 
     return SDL_TRUE;  // always go on if not shutting down, even if device failed.
 }
 
+SDL_bool SDL_CameraThreadIterate(SDL_CameraDevice *device)
+{
+    SDL_AtomicIncRef(&device->iterating);
+    const SDL_bool retval = CameraThreadIterate(device);
+    SDL_AtomicDecRef(&device->iterating);
+    return retval;
+}
+
 void SDL_CameraThreadShutdown(SDL_CameraDevice *device)
 {
     //device->FlushCapture(device);
@@ -1028,6 +1413,16 @@ static void ChooseBestCameraSpec(SDL_CameraDevice *device, const SDL_CameraSpec
     SDL_assert(closest->format != SDL_PIXELFORMAT_UNKNOWN);
 }
 
+// Once the backend has opened the device, it might be feeding it from its own thread, which needs the device lock to notice
+//  we're shutting down, so don't hold onto the lock while closing it.
+static void FailOpenCameraDevice(SDL_CameraDevice *device) SDL_NO_THREAD_SAFETY_ANALYSIS  // !!! FIXME: SDL_RELEASE
+{
+    SDL_AtomicSet(&device->shutdown, 1);
+    SDL_UnlockMutex(device->lock);
+    ClosePhysicalCameraDevice(device);
+    UnrefPhysicalCameraDevice(device);
+}
+
 SDL_Camera *SDL_OpenCameraDevice(SDL_CameraDeviceID instance_id, const SDL_CameraSpec *spec)
 {
     if (spec) {
@@ -1097,22 +1492,31 @@ SDL_Camera *SDL_OpenCameraDevice(SDL_CameraDeviceID instance_id, const SDL_Camer
 
     device->acquire_surface = SDL_CreateSurfaceFrom(NULL, closest.width, closest.height, 0, closest.format);
     if (!device->acquire_surface) {
-        ClosePhysicalCameraDevice(device);
-        ReleaseCameraDevice(device);
+        FailOpenCameraDevice(device);
         return NULL;
     }
 
-    // if we have to scale _and_ convert, we need a middleman surface, since we can't do both changes at once.
-    if (device->needs_scaling && device->needs_conversion) {
-        const SDL_bool downsampling_first = (device->needs_scaling < 0);
-        const SDL_CameraSpec *s = downsampling_first ? &device->spec : &closest;
-        const Uint32 fmt = downsampling_first ? closest.format : device->spec.format;
-        device->conversion_surface = SDL_CreateSurface(s->width, s->height, fmt);
+    // precalculate the nearest source row and column for each output pixel, so scaling doesn't have to do any math per-frame.
+    if (device->needs_scaling) {
+        const int dstw = device->spec.width;
+        const int dsth = device->spec.height;
+        device->scale_map = (int *) SDL_malloc(sizeof (int) * (dstw + dsth));
+        if (!device->scale_map) {
+            FailOpenCameraDevice(device);
+            return NULL;
+        }
+        for (int i = 0; i < dstw; i++) {
+            device->scale_map[i] = (int) ((((Uint64) (i * 2 + 1)) * closest.width) / (((Uint64) dstw) * 2));
+        }
+        for (int i = 0; i < dsth; i++) {
+            device->scale_map[dstw + i] = (int) ((((Uint64) (i * 2 + 1)) * closest.height) / (((Uint64) dsth) * 2));
+        }
     }
 
-    // output surfaces are in the app-requested format. If no conversion is necessary, we'll just use the pointers
-    // the backend fills into acquired_surface, and you can get all the way from DMA access in the camera hardware
-    // to the app without a single copy. Otherwise, these will be full surfaces that hold converted/scaled copies.
+    // output surfaces are in the app-requested format. If no conversion is necessary, the backend fills them in directly,
+    // and you can get all the way from DMA access in the camera hardware to the app without a single copy. Otherwise,
+    // these will be full surfaces that hold converted/scaled copies, and each one gets its own surface for the backend
+    // to fill, so the camera thread can acquire new frames while older ones are still being converted on worker threads.
 
     for (int i = 0; i < (SDL_arraysize(device->output_surfaces) - 1); i++) {
         device->output_surfaces[i].next = &device->output_surfaces[i + 1];
@@ -1120,20 +1524,24 @@ SDL_Camera *SDL_OpenCameraDevice(SDL_CameraDeviceID instance_id, const SDL_Camer
     device->empty_output_surfaces.next = device->output_surfaces;
 
     for (int i = 0; i < SDL_arraysize(device->output_surfaces); i++) {
-        SDL_Surface *surf;
+        SurfaceList *slist = &device->output_surfaces[i];
         if (device->needs_scaling || device->needs_conversion) {
-            surf = SDL_CreateSurface(device->spec.width, device->spec.height, device->spec.format);
+            slist->surface = SDL_CreateSurface(device->spec.width, device->spec.height, device->spec.format);
+            slist->acquired = SDL_CreateSurfaceFrom(NULL, closest.width, closest.height, 0, closest.format);
         } else {
-            surf = SDL_CreateSurfaceFrom(NULL, device->spec.width, device->spec.height, 0, device->spec.format);
+            slist->surface = SDL_CreateSurfaceFrom(NULL, device->spec.width, device->spec.height, 0, device->spec.format);
+            slist->acquired = slist->surface;
         }
+        slist->device = device;
 
-        if (!surf) {
-            ClosePhysicalCameraDevice(device);
-            ReleaseCameraDevice(device);
+        if (!slist->surface || !slist->acquired) {
+            FailOpenCameraDevice(device);
             return NULL;
         }
+    }
 
-        device->output_surfaces[i].surface = surf;
+    if (device->needs_scaling || device->needs_conversion) {
+        device->use_workers = InitCameraWorkers();
     }
 
     device->drop_frames = 1;
@@ -1144,8 +1552,7 @@ SDL_Camera *SDL_OpenCameraDevice(SDL_CameraDeviceID instance_id, const SDL_Camer
         SDL_GetCameraThreadName(device, threadname, sizeof (threadname));
         device->thread = SDL_CreateThreadInternal(CameraThread, threadname, 0, device);
         if (!device->thread) {
-            ClosePhysicalCameraDevice(device);
-            ReleaseCameraDevice(device);
+            FailOpenCameraDevice(device);
             SDL_SetError("Couldn't create camera thread");
             return NULL;
         }
@@ -1343,6 +1750,9 @@ void SDL_QuitCamera(void)
     // Free the driver data
     camera_driver.impl.Deinitialize();
 
+    // every device is closed, so nothing is using the worker threads anymore.
+    QuitCameraWorkers();
+
     SDL_DestroyRWLock(camera_driver.device_hash_lock);
     SDL_DestroyHashTable(device_hash);
 
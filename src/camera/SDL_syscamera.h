@@ -69,10 +69,22 @@ int SDL_AddCameraFormat(CameraFormatAddData *data, Uint32 fmt, int w, int h, int
 typedef struct SurfaceList
 {
     SDL_Surface *surface;
+    SDL_Surface *acquired;  // the backend fills this; it's `surface` itself if no conversion is needed.
+    SDL_CameraDevice *device;
     Uint64 timestampNS;
     struct SurfaceList *next;
 } SurfaceList;
 
+// Scratch memory for converting/scaling frames. Each camera worker thread owns one, so they can run in parallel.
+typedef struct CameraConversionScratch
+{
+    Uint8 *band;           // a few rows of converted pixels, waiting to be scaled into the output surface.
+    size_t band_len;
+    Uint8 *planar;         // a few rows of planar YUV data, gathered so they can be converted on their own.
+    size_t planar_len;
+    SDL_Surface *surface;  // full-size middleman, for scaling to YUV formats, which we can't do a few rows at a time.
+} CameraConversionScratch;
+
 // Define the SDL camera driver structure
 struct SDL_CameraDevice
 {
@@ -120,11 +132,14 @@ struct SDL_CameraDevice
     // SDL timestamp of first acquired frame, so we can roughly convert to SDL ticks.
     Uint64 adjust_timestamp;
 
-    // Pixel data flows from the driver into these, then gets converted for the app if necessary.
+    // Frames we're going to drop (no output surface available, etc) are acquired into this.
     SDL_Surface *acquire_surface;
 
-    // acquire_surface converts or scales to this surface before landing in output_surfaces, if necessary.
-    SDL_Surface *conversion_surface;
+    // Nearest source column for each output column, followed by nearest source row for each output row, if scaling.
+    int *scale_map;
+
+    // Scratch memory for converting on the camera thread, if not using the worker threads.
+    CameraConversionScratch scratch;
 
     // A queue of surfaces that buffer converted/scaled frames of video until the app claims them.
     SurfaceList output_surfaces[8];
@@ -141,10 +156,22 @@ struct SDL_CameraDevice
     // SDL_TRUE if acquire_surface needs to be converted for final output.
     SDL_bool needs_conversion;
 
+    // SDL_TRUE if frames are handed to the camera worker threads to be converted/scaled, so this device's thread only has to acquire them.
+    SDL_bool use_workers;
+
+    // Number of frames from this device queued or running on the worker threads. Protected by the worker pool's lock.
+    int pending_conversions;
+
+    // SDL_TRUE while a worker thread is converting one of this device's frames. Protected by the worker pool's lock.
+    SDL_bool converting;
+
     // Current state flags
     SDL_AtomicInt shutdown;
     SDL_AtomicInt zombie;
 
+    // Non-zero while a thread is inside SDL_CameraThreadIterate, so closing can wait on backends that feed the device from their own thread.
+    SDL_AtomicInt iterating;
+
     // A thread to feed the camera device
     SDL_Thread *thread;
 
@@ -29,6 +29,8 @@
 #include <errno.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <linux/videodev2.h>
 
 #ifndef V4L2_CAP_DEVICE_CAPS
@@ -66,17 +68,75 @@ struct buffer {
     void   *start;
     size_t  length;
     int available; // Is available in userspace
+    int dmabuf_fd; // exported with VIDIOC_EXPBUF, -1 if not available.
+};
+
+struct plane_layout {
+    size_t offset;  // from the start of the buffer.
+    int pitch;
 };
 
 struct SDL_PrivateCameraData
 {
     int fd;
     io_method io;
+    enum v4l2_buf_type type;  // V4L2_BUF_TYPE_VIDEO_CAPTURE or V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE
     int nb_buffers;
     struct buffer *buffers;
     int driver_pitch;
+    size_t driver_size;
+    int num_planes;
+    struct plane_layout planes[3];
+    SDL_bool zombie_listed;  // SDL_TRUE if the camera thread is feeding this device blank frames.
+    Uint64 next_zombie_frameNS;
 };
 
+// One thread waits on every opened camera with epoll and feeds whichever ones have frames ready, instead of a thread per camera.
+static struct
+{
+    SDL_Mutex *lock;  // held while the thread feeds cameras, so closing a camera can wait for it to let go.
+    SDL_Thread *thread;
+    int epollfd;
+    int wakefd;  // an eventfd, to get the thread's attention.
+    SDL_AtomicInt quit;
+    SDL_CameraDevice **devices;  // cameras that are open, so the thread can tell if an event is for one that has since closed.
+    int num_devices;
+    SDL_CameraDevice **zombies;  // disconnected cameras, which get blank frames on a timer until they're closed.
+    int num_zombies;
+} camera_thread;
+
+// the camera thread's device lists are tiny (one entry per open camera), so these are just unsorted arrays.
+static SDL_bool FindInDeviceList(SDL_CameraDevice **devices, int num_devices, SDL_CameraDevice *device)
+{
+    for (int i = 0; i < num_devices; i++) {
+        if (devices[i] == device) {
+            return SDL_TRUE;
+        }
+    }
+    return SDL_FALSE;
+}
+
+static int AddToDeviceList(SDL_CameraDevice ***devices, int *num_devices, SDL_CameraDevice *device)
+{
+    SDL_CameraDevice **ptr = (SDL_CameraDevice **) SDL_realloc(*devices, sizeof (**devices) * (*num_devices + 1));
+    if (!ptr) {
+        return -1;
+    }
+    ptr[(*num_devices)++] = device;
+    *devices = ptr;
+    return 0;
+}
+
+static void RemoveFromDeviceList(SDL_CameraDevice ***devices, int *num_devices, SDL_CameraDevice *device)
+{
+    for (int i = 0; i < *num_devices; i++) {
+        if ((*devices)[i] == device) {
+            (*devices)[i] = (*devices)[--(*num_devices)];
+            return;
+        }
+    }
+}
+
 static int xioctl(int fh, int request, void *arg)
 {
     int r;
@@ -88,28 +148,55 @@ static int xioctl(int fh, int request, void *arg)
     return r;
 }
 
-static int V4L2_WaitDevice(SDL_CameraDevice *device)
+// Multi-planar devices describe their buffers with an array of planes. We only use formats that fit in a single plane of memory.
+static void InitBuffer(SDL_CameraDevice *device, struct v4l2_buffer *buf, struct v4l2_plane *plane, enum v4l2_memory memory, int index)
 {
-    const int fd = device->hidden->fd;
-
-    int retval;
+    SDL_zerop(buf);
+    buf->type = device->hidden->type;
+    buf->memory = memory;
+    buf->index = index;
+    if (buf->type == V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE) {
+        SDL_zerop(plane);
+        buf->m.planes = plane;
+        buf->length = 1;
+    }
+}
 
-    do {
-        fd_set fds;
-        FD_ZERO(&fds);
-        FD_SET(fd, &fds);
+static void SetBufferUserPtr(struct v4l2_buffer *buf, void *ptr, size_t length)
+{
+    if (buf->type == V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE) {
+        buf->m.planes[0].m.userptr = (unsigned long)ptr;
+        buf->m.planes[0].length = (Uint32) length;
+    } else {
+        buf->m.userptr = (unsigned long)ptr;
+        buf->length = (Uint32) length;
+    }
+}
 
-        struct timeval tv;
-        tv.tv_sec = 0;
-        tv.tv_usec = 100 * 1000;
+static void *GetBufferUserPtr(const struct v4l2_buffer *buf, size_t *length)
+{
+    if (buf->type == V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE) {
+        *length = buf->m.planes[0].length;
+        return (void *)buf->m.planes[0].m.userptr;
+    }
+    *length = buf->length;
+    return (void *)buf->m.userptr;
+}
 
-        retval = select(fd + 1, &fds, NULL, NULL, &tv);
-        if ((retval == -1) && (errno == EINTR)) {
-            retval = 0;  // pretend it was a timeout, keep looping.
-        }
-    } while (retval == 0);
+// Wait for the next frame. The thread's epoll registration is one-shot, so it doesn't spin when the device reports
+//  an error because the app is holding every buffer; we rearm it when a buffer is queued again.
+static void ArmWaitDevice(SDL_CameraDevice *device)
+{
+    struct epoll_event event;
+    SDL_zero(event);
+    event.events = EPOLLIN | EPOLLONESHOT;
+    event.data.ptr = device;
+    epoll_ctl(camera_thread.epollfd, EPOLL_CTL_MOD, device->hidden->fd, &event);
+}
 
-    return retval;
+static int V4L2_WaitDevice(SDL_CameraDevice *device)
+{
+    return 0;  // this isn't used atm, since one thread waits on every camera with epoll.
 }
 
 static int V4L2_AcquireFrame(SDL_CameraDevice *device, SDL_Surface *frame, Uint64 *timestampNS)
@@ -118,6 +205,8 @@ static int V4L2_AcquireFrame(SDL_CameraDevice *device, SDL_Surface *frame, Uint6
     const io_method io = device->hidden->io;
     size_t size = device->hidden->buffers[0].length;
     struct v4l2_buffer buf;
+    struct v4l2_plane plane;
+    int i = 0;
 
     switch (io) {
         case IO_METHOD_READ:
@@ -141,10 +230,7 @@ static int V4L2_AcquireFrame(SDL_CameraDevice *device, SDL_Surface *frame, Uint6
             break;
 
         case IO_METHOD_MMAP:
-            SDL_zero(buf);
-
-            buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-            buf.memory = V4L2_MEMORY_MMAP;
+            InitBuffer(device, &buf, &plane, V4L2_MEMORY_MMAP, 0);
 
             if (xioctl(fd, VIDIOC_DQBUF, &buf) == -1) {
                 switch (errno) {
@@ -164,9 +250,10 @@ static int V4L2_AcquireFrame(SDL_CameraDevice *device, SDL_Surface *frame, Uint6
                 return SDL_SetError("invalid buffer index");
             }
 
-            frame->pixels = device->hidden->buffers[buf.index].start;
+            i = (int)buf.index;
+            frame->pixels = device->hidden->buffers[i].start;
             frame->pitch = device->hidden->driver_pitch;
-            device->hidden->buffers[buf.index].available = 1;
+            device->hidden->buffers[i].available = 1;
 
             *timestampNS = (((Uint64) buf.timestamp.tv_sec) * SDL_NS_PER_SECOND) + SDL_US_TO_NS(buf.timestamp.tv_usec);
 
@@ -176,10 +263,7 @@ static int V4L2_AcquireFrame(SDL_CameraDevice *device, SDL_Surface *frame, Uint6
             break;
 
         case IO_METHOD_USERPTR:
-            SDL_zero(buf);
-
-            buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-            buf.memory = V4L2_MEMORY_USERPTR;
+            InitBuffer(device, &buf, &plane, V4L2_MEMORY_USERPTR, 0);
 
             if (xioctl(fd, VIDIOC_DQBUF, &buf) == -1) {
                 switch (errno) {
@@ -196,9 +280,10 @@ static int V4L2_AcquireFrame(SDL_CameraDevice *device, SDL_Surface *frame, Uint6
                 }
             }
 
-            int i;
+            size_t length;
+            void *userptr = GetBufferUserPtr(&buf, &length);
             for (i = 0; i < device->hidden->nb_buffers; ++i) {
-                if (buf.m.userptr == (unsigned long)device->hidden->buffers[i].start && buf.length == size) {
+                if (userptr == device->hidden->buffers[i].start && length == size) {
                     break;
                 }
             }
@@ -207,7 +292,7 @@ static int V4L2_AcquireFrame(SDL_CameraDevice *device, SDL_Surface *frame, Uint6
                 return SDL_SetError("invalid buffer index");
             }
 
-            frame->pixels = (void*)buf.m.userptr;
+            frame->pixels = userptr;
             frame->pitch = device->hidden->driver_pitch;
             device->hidden->buffers[i].available = 1;
 
@@ -223,12 +308,28 @@ static int V4L2_AcquireFrame(SDL_CameraDevice *device, SDL_Surface *frame, Uint6
             break;
     }
 
+    // Describe the buffer, so the app can hand it to other APIs (an encoder, a GPU import, etc) without copying.
+    if (device->hidden->buffers[i].dmabuf_fd != -1) {
+        const SDL_PropertiesID props = SDL_GetSurfaceProperties(frame);
+        if (props) {
+            SDL_SetNumberProperty(props, SDL_PROP_CAMERA_FRAME_DMABUF_FD_NUMBER, device->hidden->buffers[i].dmabuf_fd);
+            SDL_SetNumberProperty(props, SDL_PROP_CAMERA_FRAME_NUM_PLANES_NUMBER, device->hidden->num_planes);
+            SDL_SetNumberProperty(props, SDL_PROP_CAMERA_FRAME_PLANE0_OFFSET_NUMBER, (Sint64) device->hidden->planes[0].offset);
+            SDL_SetNumberProperty(props, SDL_PROP_CAMERA_FRAME_PLANE0_PITCH_NUMBER, device->hidden->planes[0].pitch);
+            SDL_SetNumberProperty(props, SDL_PROP_CAMERA_FRAME_PLANE1_OFFSET_NUMBER, (Sint64) device->hidden->planes[1].offset);
+            SDL_SetNumberProperty(props, SDL_PROP_CAMERA_FRAME_PLANE1_PITCH_NUMBER, device->hidden->planes[1].pitch);
+            SDL_SetNumberProperty(props, SDL_PROP_CAMERA_FRAME_PLANE2_OFFSET_NUMBER, (Sint64) device->hidden->planes[2].offset);
+            SDL_SetNumberProperty(props, SDL_PROP_CAMERA_FRAME_PLANE2_PITCH_NUMBER, device->hidden->planes[2].pitch);
+        }
+    }
+
     return 1;
 }
 
 static void V4L2_ReleaseFrame(SDL_CameraDevice *device, SDL_Surface *frame)
 {
     struct v4l2_buffer buf;
+    struct v4l2_plane plane;
     const int fd = device->hidden->fd;
     const io_method io = device->hidden->io;
     int i;
@@ -243,38 +344,36 @@ static void V4L2_ReleaseFrame(SDL_CameraDevice *device, SDL_Surface *frame)
         return;  // oh well, we didn't own this.
     }
 
+    // the dmabuf belongs to the driver again, don't let anyone find it through this surface.
+    if (device->hidden->buffers[i].dmabuf_fd != -1) {
+        SDL_ClearProperty(SDL_GetSurfaceProperties(frame), SDL_PROP_CAMERA_FRAME_DMABUF_FD_NUMBER);
+    }
+
     switch (io) {
         case IO_METHOD_READ:
             break;
 
         case IO_METHOD_MMAP:
-            SDL_zero(buf);
-
-            buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-            buf.memory = V4L2_MEMORY_MMAP;
-            buf.index = i;
+            InitBuffer(device, &buf, &plane, V4L2_MEMORY_MMAP, i);
 
             if (xioctl(fd, VIDIOC_QBUF, &buf) == -1) {
                 // !!! FIXME: disconnect the device.
                 return; //SDL_SetError("VIDIOC_QBUF");
             }
             device->hidden->buffers[i].available = 0;
+            ArmWaitDevice(device);
             break;
 
         case IO_METHOD_USERPTR:
-            SDL_zero(buf);
-
-            buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-            buf.memory = V4L2_MEMORY_USERPTR;
-            buf.index = i;
-            buf.m.userptr = (unsigned long)frame->pixels;
-            buf.length = (int) device->hidden->buffers[i].length;
+            InitBuffer(device, &buf, &plane, V4L2_MEMORY_USERPTR, i);
+            SetBufferUserPtr(&buf, frame->pixels, device->hidden->buffers[i].length);
 
             if (xioctl(fd, VIDIOC_QBUF, &buf) == -1) {
                 // !!! FIXME: disconnect the device.
                 return; //SDL_SetError("VIDIOC_QBUF");
             }
             device->hidden->buffers[i].available = 0;
+            ArmWaitDevice(device);
             break;
 
         case IO_METHOD_INVALID:
@@ -295,11 +394,9 @@ static int EnqueueBuffers(SDL_CameraDevice *device)
             for (int i = 0; i < device->hidden->nb_buffers; ++i) {
                 if (device->hidden->buffers[i].available == 0) {
                     struct v4l2_buffer buf;
+                    struct v4l2_plane plane;
 
-                    SDL_zero(buf);
-                    buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-                    buf.memory = V4L2_MEMORY_MMAP;
-                    buf.index = i;
+                    InitBuffer(device, &buf, &plane, V4L2_MEMORY_MMAP, i);
 
                     if (xioctl(fd, VIDIOC_QBUF, &buf) == -1) {
                         return SDL_SetError("VIDIOC_QBUF");
@@ -312,13 +409,10 @@ static int EnqueueBuffers(SDL_CameraDevice *device)
             for (int i = 0; i < device->hidden->nb_buffers; ++i) {
                 if (device->hidden->buffers[i].available == 0) {
                     struct v4l2_buffer buf;
+                    struct v4l2_plane plane;
 
-                    SDL_zero(buf);
-                    buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-                    buf.memory = V4L2_MEMORY_USERPTR;
-                    buf.index = i;
-                    buf.m.userptr = (unsigned long)device->hidden->buffers[i].start;
-                    buf.length = (int) device->hidden->buffers[i].length;
+                    InitBuffer(device, &buf, &plane, V4L2_MEMORY_USERPTR, i);
+                    SetBufferUserPtr(&buf, device->hidden->buffers[i].start, device->hidden->buffers[i].length);
 
                     if (xioctl(fd, VIDIOC_QBUF, &buf) == -1) {
                         return SDL_SetError("VIDIOC_QBUF");
@@ -345,28 +439,47 @@ static int AllocBufferMmap(SDL_CameraDevice *device)
     int i;
     for (i = 0; i < device->hidden->nb_buffers; ++i) {
         struct v4l2_buffer buf;
+        struct v4l2_plane plane;
+        size_t length;
+        off_t offset;
 
-        SDL_zero(buf);
-
-        buf.type        = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-        buf.memory      = V4L2_MEMORY_MMAP;
-        buf.index       = i;
+        InitBuffer(device, &buf, &plane, V4L2_MEMORY_MMAP, i);
 
         if (xioctl(fd, VIDIOC_QUERYBUF, &buf) == -1) {
             return SDL_SetError("VIDIOC_QUERYBUF");
         }
 
-        device->hidden->buffers[i].length = buf.length;
+        if (buf.type == V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE) {
+            length = plane.length;
+            offset = (off_t) plane.m.mem_offset;
+        } else {
+            length = buf.length;
+            offset = (off_t) buf.m.offset;
+        }
+
+        device->hidden->buffers[i].length = length;
         device->hidden->buffers[i].start =
             mmap(NULL /* start anywhere */,
-                    buf.length,
+                    length,
                     PROT_READ | PROT_WRITE /* required */,
                     MAP_SHARED /* recommended */,
-                    fd, buf.m.offset);
+                    fd, offset);
 
         if (MAP_FAILED == device->hidden->buffers[i].start) {
+            device->hidden->buffers[i].start = NULL;
             return SDL_SetError("mmap");
         }
+
+        // Export the buffer as a DMABUF too, if the driver can, so apps can pass frames along without copying.
+        struct v4l2_exportbuffer expbuf;
+        SDL_zero(expbuf);
+        expbuf.type = buf.type;
+        expbuf.index = i;
+        expbuf.plane = 0;
+        expbuf.flags = O_RDONLY | O_CLOEXEC;
+        if (xioctl(fd, VIDIOC_EXPBUF, &expbuf) == 0) {
+            device->hidden->buffers[i].dmabuf_fd = expbuf.fd;
+        }
     }
     return 0;
 }
@@ -390,6 +503,19 @@ static Uint32 format_v4l2_to_sdl(Uint32 fmt)
     switch (fmt) {
         #define CASE(x, y)  case x: return y
         CASE(V4L2_PIX_FMT_YUYV, SDL_PIXELFORMAT_YUY2);
+        CASE(V4L2_PIX_FMT_UYVY, SDL_PIXELFORMAT_UYVY);
+        CASE(V4L2_PIX_FMT_YVYU, SDL_PIXELFORMAT_YVYU);
+        CASE(V4L2_PIX_FMT_NV12, SDL_PIXELFORMAT_NV12);
+        CASE(V4L2_PIX_FMT_NV21, SDL_PIXELFORMAT_NV21);
+        CASE(V4L2_PIX_FMT_YUV420, SDL_PIXELFORMAT_IYUV);
+        CASE(V4L2_PIX_FMT_YVU420, SDL_PIXELFORMAT_YV12);
+        #ifdef V4L2_PIX_FMT_P010
+        CASE(V4L2_PIX_FMT_P010, SDL_PIXELFORMAT_P010);
+        #endif
+        CASE(V4L2_PIX_FMT_RGB24, SDL_PIXELFORMAT_RGB24);
+        CASE(V4L2_PIX_FMT_BGR24, SDL_PIXELFORMAT_BGR24);
+        CASE(V4L2_PIX_FMT_ABGR32, SDL_PIXELFORMAT_BGRA32);
+        CASE(V4L2_PIX_FMT_XBGR32, SDL_PIXELFORMAT_BGRX32);
         CASE(V4L2_PIX_FMT_MJPEG, SDL_PIXELFORMAT_UNKNOWN);
         #undef CASE
         default:
@@ -405,6 +531,19 @@ static Uint32 format_sdl_to_v4l2(Uint32 fmt)
     switch (fmt) {
         #define CASE(y, x)  case x: return y
         CASE(V4L2_PIX_FMT_YUYV, SDL_PIXELFORMAT_YUY2);
+        CASE(V4L2_PIX_FMT_UYVY, SDL_PIXELFORMAT_UYVY);
+        CASE(V4L2_PIX_FMT_YVYU, SDL_PIXELFORMAT_YVYU);
+        CASE(V4L2_PIX_FMT_NV12, SDL_PIXELFORMAT_NV12);
+        CASE(V4L2_PIX_FMT_NV21, SDL_PIXELFORMAT_NV21);
+        CASE(V4L2_PIX_FMT_YUV420, SDL_PIXELFORMAT_IYUV);
+        CASE(V4L2_PIX_FMT_YVU420, SDL_PIXELFORMAT_YV12);
+        #ifdef V4L2_PIX_FMT_P010
+        CASE(V4L2_PIX_FMT_P010, SDL_PIXELFORMAT_P010);
+        #endif
+        CASE(V4L2_PIX_FMT_RGB24, SDL_PIXELFORMAT_RGB24);
+        CASE(V4L2_PIX_FMT_BGR24, SDL_PIXELFORMAT_BGR24);
+        CASE(V4L2_PIX_FMT_ABGR32, SDL_PIXELFORMAT_BGRA32);
+        CASE(V4L2_PIX_FMT_XBGR32, SDL_PIXELFORMAT_BGRX32);
         CASE(V4L2_PIX_FMT_MJPEG, SDL_PIXELFORMAT_UNKNOWN);
         #undef CASE
         default:
@@ -412,6 +551,54 @@ static Uint32 format_sdl_to_v4l2(Uint32 fmt)
     }
 }
 
+// Prefer the single-planar API, but some devices (a lot of ARM SoC capture hardware) only speak the multi-planar one.
+static enum v4l2_buf_type GetCaptureBufferType(const struct v4l2_capability *cap)
+{
+    if (cap->device_caps & V4L2_CAP_VIDEO_CAPTURE) {
+        return V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    } else if (cap->device_caps & V4L2_CAP_VIDEO_CAPTURE_MPLANE) {
+        return V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE;
+    }
+    return (enum v4l2_buf_type) 0;
+}
+
+// Where each plane of a frame lives inside a buffer, using the driver's pitch; V4L2 lays out
+//  chroma planes the same way SDL does, at half the luma pitch for the 4:2:0 three-plane formats.
+static void CalculatePlaneLayout(struct SDL_PrivateCameraData *hidden, Uint32 format, int h)
+{
+    const int pitch = hidden->driver_pitch;
+    const size_t luma_size = (size_t) pitch * h;
+
+    SDL_zeroa(hidden->planes);
+    hidden->num_planes = 1;
+    hidden->planes[0].pitch = pitch;
+
+    switch (format) {
+        case SDL_PIXELFORMAT_NV12:
+        case SDL_PIXELFORMAT_NV21:
+        case SDL_PIXELFORMAT_P010:
+            hidden->num_planes = 2;
+            hidden->planes[1].offset = luma_size;
+            hidden->planes[1].pitch = pitch;
+            break;
+
+        case SDL_PIXELFORMAT_IYUV:
+        case SDL_PIXELFORMAT_YV12:
+            hidden->num_planes = 3;
+            hidden->planes[1].offset = luma_size;
+            hidden->planes[1].pitch = pitch / 2;
+            hidden->planes[2].offset = luma_size + ((size_t) (pitch / 2) * ((h + 1) / 2));
+            hidden->planes[2].pitch = pitch / 2;
+            break;
+
+        default:
+            break;
+    }
+}
+
+// Start watching a freshly opened camera, spinning up the thread the first time we need it.
+static int StartWaitingOnDevice(SDL_CameraDevice *device);
+
 static void V4L2_CloseDevice(SDL_CameraDevice *device)
 {
     if (!device) {
@@ -422,8 +609,19 @@ static void V4L2_CloseDevice(SDL_CameraDevice *device)
         const io_method io = device->hidden->io;
         const int fd = device->hidden->fd;
 
+        // make sure the camera thread is done with this device and won't look at it again.
+        SDL_LockMutex(camera_thread.lock);
+        if (fd != -1) {
+            epoll_ctl(camera_thread.epollfd, EPOLL_CTL_DEL, fd, NULL);
+        }
+        if (device->hidden->zombie_listed) {
+            RemoveFromDeviceList(&camera_thread.zombies, &camera_thread.num_zombies, device);
+        }
+        RemoveFromDeviceList(&camera_thread.devices, &camera_thread.num_devices, device);
+        SDL_UnlockMutex(camera_thread.lock);
+
         if ((io == IO_METHOD_MMAP) || (io == IO_METHOD_USERPTR)) {
-            enum v4l2_buf_type type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+            enum v4l2_buf_type type = device->hidden->type;
             xioctl(fd, VIDIOC_STREAMOFF, &type);
         }
 
@@ -438,6 +636,12 @@ static void V4L2_CloseDevice(SDL_CameraDevice *device)
 
                 case IO_METHOD_MMAP:
                     for (int i = 0; i < device->hidden->nb_buffers; ++i) {
+                        if (device->hidden->buffers[i].dmabuf_fd != -1) {
+                            close(device->hidden->buffers[i].dmabuf_fd);
+                        }
+                        if (!device->hidden->buffers[i].start) {
+                            continue;  // mmap failed partway through opening.
+                        }
                         if (munmap(device->hidden->buffers[i].start, device->hidden->buffers[i].length) == -1) {
                             SDL_SetError("munmap");
                         }
@@ -486,7 +690,7 @@ static int V4L2_OpenDevice(SDL_CameraDevice *device, const SDL_CameraSpec *spec)
             return SDL_SetError("%s is unexpectedly not a V4L2 device", handle->path);
         }
         return SDL_SetError("Error VIDIOC_QUERYCAP errno=%d device%s is no V4L2 device", err, handle->path);
-    } else if ((cap.device_caps & V4L2_CAP_VIDEO_CAPTURE) == 0) {
+    } else if (!GetCaptureBufferType(&cap)) {
         close(fd);
         return SDL_SetError("%s is unexpectedly not a video capture device", handle->path);
     }
@@ -499,32 +703,44 @@ static int V4L2_OpenDevice(SDL_CameraDevice *device, const SDL_CameraSpec *spec)
 
     device->hidden->fd = fd;
     device->hidden->io = IO_METHOD_INVALID;
+    device->hidden->type = GetCaptureBufferType(&cap);
+
+    enum v4l2_buf_type type = device->hidden->type;
+    const SDL_bool mplane = (type == V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE);
 
     // Select video input, video standard and tune here.
     // errors in the crop code are not fatal.
     struct v4l2_cropcap cropcap;
     SDL_zero(cropcap);
-    cropcap.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    cropcap.type = type;
     if (xioctl(fd, VIDIOC_CROPCAP, &cropcap) == 0) {
         struct v4l2_crop crop;
         SDL_zero(crop);
-        crop.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        crop.type = type;
         crop.c = cropcap.defrect; // reset to default
         xioctl(fd, VIDIOC_S_CROP, &crop);
     }
 
     struct v4l2_format fmt;
     SDL_zero(fmt);
-    fmt.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-    fmt.fmt.pix.width = spec->width;
-    fmt.fmt.pix.height = spec->height;
-    fmt.fmt.pix.pixelformat = format_sdl_to_v4l2(spec->format);
-    //fmt.fmt.pix.field = V4L2_FIELD_INTERLACED;
-    fmt.fmt.pix.field = V4L2_FIELD_ANY;
+    fmt.type = type;
+    if (mplane) {
+        fmt.fmt.pix_mp.width = spec->width;
+        fmt.fmt.pix_mp.height = spec->height;
+        fmt.fmt.pix_mp.pixelformat = format_sdl_to_v4l2(spec->format);
+        fmt.fmt.pix_mp.field = V4L2_FIELD_ANY;
+        fmt.fmt.pix_mp.num_planes = 1;
+    } else {
+        fmt.fmt.pix.width = spec->width;
+        fmt.fmt.pix.height = spec->height;
+        fmt.fmt.pix.pixelformat = format_sdl_to_v4l2(spec->format);
+        //fmt.fmt.pix.field = V4L2_FIELD_INTERLACED;
+        fmt.fmt.pix.field = V4L2_FIELD_ANY;
+    }
 
     #if DEBUG_CAMERA
     SDL_Log("CAMERA: set SDL format %s", SDL_GetPixelFormatName(spec->format));
-    { const Uint32 f = fmt.fmt.pix.pixelformat; SDL_Log("CAMERA: set format V4L2_format=%d  %c%c%c%c", f, (f >> 0) & 0xff, (f >> 8) & 0xff, (f >> 16) & 0xff, (f >> 24) & 0xff); }
+    { const Uint32 f = format_sdl_to_v4l2(spec->format); SDL_Log("CAMERA: set format V4L2_format=%d  %c%c%c%c", f, (f >> 0) & 0xff, (f >> 8) & 0xff, (f >> 16) & 0xff, (f >> 24) & 0xff); }
     #endif
 
     if (xioctl(fd, VIDIOC_S_FMT, &fmt) == -1) {
@@ -534,11 +750,11 @@ static int V4L2_OpenDevice(SDL_CameraDevice *device, const SDL_CameraSpec *spec)
     if (spec->interval_numerator && spec->interval_denominator) {
         struct v4l2_streamparm setfps;
         SDL_zero(setfps);
-        setfps.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        setfps.type = type;
         if (xioctl(fd, VIDIOC_G_PARM, &setfps) == 0) {
             if ( (setfps.parm.capture.timeperframe.numerator != spec->interval_numerator) ||
                  (setfps.parm.capture.timeperframe.denominator = spec->interval_denominator) ) {
-                setfps.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+                setfps.type = type;
                 setfps.parm.capture.timeperframe.numerator = spec->interval_numerator;
                 setfps.parm.capture.timeperframe.denominator = spec->interval_denominator;
                 if (xioctl(fd, VIDIOC_S_PARM, &setfps) == -1) {
@@ -549,18 +765,27 @@ static int V4L2_OpenDevice(SDL_CameraDevice *device, const SDL_CameraSpec *spec)
     }
 
     SDL_zero(fmt);
-    fmt.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    fmt.type = type;
     if (xioctl(fd, VIDIOC_G_FMT, &fmt) == -1) {
         return SDL_SetError("Error VIDIOC_G_FMT");
+    } else if (mplane) {
+        if (fmt.fmt.pix_mp.num_planes != 1) {
+            return SDL_SetError("Multiple memory planes per frame aren't supported");
+        }
+        device->hidden->driver_pitch = fmt.fmt.pix_mp.plane_fmt[0].bytesperline;
+        device->hidden->driver_size = fmt.fmt.pix_mp.plane_fmt[0].sizeimage;
+    } else {
+        device->hidden->driver_pitch = fmt.fmt.pix.bytesperline;
+        device->hidden->driver_size = fmt.fmt.pix.sizeimage;
     }
-    device->hidden->driver_pitch = fmt.fmt.pix.bytesperline;
+    CalculatePlaneLayout(device->hidden, spec->format, spec->height);
 
     io_method io = IO_METHOD_INVALID;
     if ((io == IO_METHOD_INVALID) && (cap.device_caps & V4L2_CAP_STREAMING)) {
         struct v4l2_requestbuffers req;
         SDL_zero(req);
         req.count = 8;
-        req.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        req.type = type;
         req.memory = V4L2_MEMORY_MMAP;
         if ((xioctl(fd, VIDIOC_REQBUFS, &req) == 0) && (req.count >= 2)) {
             io = IO_METHOD_MMAP;
@@ -568,7 +793,7 @@ static int V4L2_OpenDevice(SDL_CameraDevice *device, const SDL_CameraSpec *spec)
         } else {  // mmap didn't work out? Try USERPTR.
             SDL_zero(req);
             req.count = 8;
-            req.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+            req.type = type;
             req.memory = V4L2_MEMORY_USERPTR;
             if (xioctl(fd, VIDIOC_REQBUFS, &req) == 0) {
                 io = IO_METHOD_USERPTR;
@@ -593,8 +818,13 @@ static int V4L2_OpenDevice(SDL_CameraDevice *device, const SDL_CameraSpec *spec)
         return -1;
     }
 
+    for (int i = 0; i < device->hidden->nb_buffers; i++) {
+        device->hidden->buffers[i].dmabuf_fd = -1;
+    }
+
     size_t size, pitch;
-    SDL_CalculateSize(device->spec.format, device->spec.width, device->spec.height, &size, &pitch, SDL_FALSE);
+    SDL_CalculateSize(spec->format, spec->width, spec->height, &size, &pitch, SDL_FALSE);
+    size = SDL_max(size, device->hidden->driver_size);  // the driver's pitch might have padding we don't know about.
 
     int rc = 0;
     switch (io) {
@@ -620,12 +850,15 @@ static int V4L2_OpenDevice(SDL_CameraDevice *device, const SDL_CameraSpec *spec)
     } else if (EnqueueBuffers(device) < 0) {
         return -1;
     } else if (io != IO_METHOD_READ) {
-        enum v4l2_buf_type type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
         if (xioctl(fd, VIDIOC_STREAMON, &type) == -1) {
             return SDL_SetError("VIDIOC_STREAMON");
         }
     }
 
+    if (StartWaitingOnDevice(device) < 0) {
+        return -1;
+    }
+
     // Currently there is no user permission prompt for camera access, but maybe there will be a D-Bus portal interface at some point.
     SDL_CameraDevicePermissionOutcome(device, SDL_TRUE);
 
@@ -702,7 +935,7 @@ static void MaybeAddDevice(const char *path)
     if (rc != 0) {
         close(fd);
         return;  // probably not a v4l2 device at all.
-    } else if ((vcap.device_caps & V4L2_CAP_VIDEO_CAPTURE) == 0) {
+    } else if (!GetCaptureBufferType(&vcap)) {
         close(fd);
         return;  // not a video capture device.
     } else if (SDL_FindPhysicalCameraDeviceByCallback(FindV4L2CameraDeviceByBusInfoCallback, vcap.bus_info)) {
@@ -719,7 +952,7 @@ static void MaybeAddDevice(const char *path)
 
     struct v4l2_fmtdesc fmtdesc;
     SDL_zero(fmtdesc);
-    fmtdesc.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    fmtdesc.type = GetCaptureBufferType(&vcap);
     while (ioctl(fd, VIDIOC_ENUM_FMT, &fmtdesc) == 0) {
         const Uint32 sdlfmt = format_v4l2_to_sdl(fmtdesc.pixelformat);
 
@@ -809,6 +1042,136 @@ static void V4L2_FreeDeviceHandle(SDL_CameraDevice *device)
     }
 }
 
+// Frames come in at the camera's frame rate, so a disconnected camera gets its blank frames at that rate too.
+static Uint64 GetZombieFrameIntervalNS(SDL_CameraDevice *device)
+{
+    const SDL_CameraSpec *spec = &device->actual_spec;
+    if ((spec->interval_numerator > 0) && (spec->interval_denominator > 0)) {
+        return ((Uint64) spec->interval_numerator * SDL_NS_PER_SECOND) / (Uint64) spec->interval_denominator;
+    }
+    return SDL_NS_PER_SECOND / 30;
+}
+
+// call this with camera_thread.lock held.
+static void FeedZombies(void)
+{
+    const Uint64 now = SDL_GetTicksNS();
+    int i = 0;
+    while (i < camera_thread.num_zombies) {
+        SDL_CameraDevice *device = camera_thread.zombies[i];
+        if (device->hidden->next_zombie_frameNS > now) {
+            i++;
+        } else if (SDL_CameraThreadIterate(device)) {
+            device->hidden->next_zombie_frameNS += GetZombieFrameIntervalNS(device);
+            i++;
+        } else {  // shutting down, stop feeding it.
+            device->hidden->zombie_listed = SDL_FALSE;
+            RemoveFromDeviceList(&camera_thread.zombies, &camera_thread.num_zombies, device);
+        }
+    }
+}
+
+// how long epoll_wait can sleep before a zombie needs its next frame, -1 to sleep until an event arrives.
+static int GetZombieTimeoutMS(void)
+{
+    if (camera_thread.num_zombies == 0) {
+        return -1;
+    }
+
+    Uint64 next = camera_thread.zombies[0]->hidden->next_zombie_frameNS;
+    for (int i = 1; i < camera_thread.num_zombies; i++) {
+        next = SDL_min(next, camera_thread.zombies[i]->hidden->next_zombie_frameNS);
+    }
+
+    const Uint64 now = SDL_GetTicksNS();
+    return (next <= now) ? 0 : (int) SDL_NS_TO_MS(next - now + (SDL_NS_PER_MS - 1));
+}
+
+// call this with camera_thread.lock held.
+static void AddZombie(SDL_CameraDevice *device)
+{
+    epoll_ctl(camera_thread.epollfd, EPOLL_CTL_DEL, device->hidden->fd, NULL);  // it's not going to give us anything else.
+
+    // if this fails, the app just doesn't get blank frames.
+    if (!device->hidden->zombie_listed && (AddToDeviceList(&camera_thread.zombies, &camera_thread.num_zombies, device) == 0)) {
+        device->hidden->zombie_listed = SDL_TRUE;
+        device->hidden->next_zombie_frameNS = SDL_GetTicksNS();
+    }
+}
+
+static int SDLCALL V4L2_CameraThread(void *unused)
+{
+    struct epoll_event events[16];
+
+    // The camera capture is always a high priority thread
+    SDL_SetThreadPriority(SDL_THREAD_PRIORITY_HIGH);
+
+    while (!SDL_AtomicGet(&camera_thread.quit)) {
+        SDL_LockMutex(camera_thread.lock);
+        const int timeout = GetZombieTimeoutMS();
+        SDL_UnlockMutex(camera_thread.lock);
+
+        const int count = epoll_wait(camera_thread.epollfd, events, SDL_arraysize(events), timeout);
+        if ((count == -1) && (errno != EINTR)) {
+            break;  // shouldn't happen unless something is seriously wrong.
+        }
+
+        SDL_LockMutex(camera_thread.lock);
+        for (int i = 0; i < count; i++) {
+            SDL_CameraDevice *device = (SDL_CameraDevice *) events[i].data.ptr;
+            if (!device) {  // just the wakefd, to get us to notice we're quitting.
+                Uint64 val;
+                (void) read(camera_thread.wakefd, &val, sizeof (val));
+                continue;
+            } else if (!FindInDeviceList(camera_thread.devices, camera_thread.num_devices, device)) {
+                continue;  // it closed while we were waiting. If it has been reopened since, this event is just early and harmless.
+            }
+
+            const int fd = device->hidden->fd;
+            if (!SDL_CameraThreadIterate(device)) {
+                epoll_ctl(camera_thread.epollfd, EPOLL_CTL_DEL, fd, NULL);  // shutting down.
+            } else if (SDL_AtomicGet(&device->zombie)) {
+                AddZombie(device);
+            } else if (events[i].events & EPOLLIN) {
+                ArmWaitDevice(device);
+            }
+            // otherwise, no buffers are queued because the app is holding them all; V4L2_ReleaseFrame will rearm us.
+        }
+        FeedZombies();
+        SDL_UnlockMutex(camera_thread.lock);
+    }
+
+    return 0;
+}
+
+static int StartWaitingOnDevice(SDL_CameraDevice *device)
+{
+    struct epoll_event event;
+    SDL_zero(event);
+    event.events = EPOLLIN | EPOLLONESHOT;
+    event.data.ptr = device;
+
+    // we're called with the device lock held, which is the opposite order from the camera thread, but the thread
+    //  never touches a device that isn't in camera_thread.devices yet, so it can't be waiting on this one.
+    SDL_LockMutex(camera_thread.lock);
+    if (!camera_thread.thread) {
+        camera_thread.thread = SDL_CreateThreadInternal(V4L2_CameraThread, "SDLV4L2Camera", 0, NULL);
+        if (!camera_thread.thread) {
+            SDL_UnlockMutex(camera_thread.lock);
+            return SDL_SetError("Couldn't create camera thread");
+        }
+    }
+
+    int rc = AddToDeviceList(&camera_thread.devices, &camera_thread.num_devices, device);
+    if ((rc == 0) && (epoll_ctl(camera_thread.epollfd, EPOLL_CTL_ADD, device->hidden->fd, &event) == -1)) {
+        RemoveFromDeviceList(&camera_thread.devices, &camera_thread.num_devices, device);
+        rc = SDL_SetError("epoll_ctl: %s", strerror(errno));
+    }
+    SDL_UnlockMutex(camera_thread.lock);
+
+    return rc;
+}
+
 #ifdef SDL_USE_LIBUDEV
 static SDL_bool FindV4L2CameraDeviceByPathCallback(SDL_CameraDevice *device, void *userdata)
 {
@@ -835,12 +1198,31 @@ static void CameraUdevCallback(SDL_UDEV_deviceevent udev_type, int udev_class, c
 }
 #endif // SDL_USE_LIBUDEV
 
+static void QuitCameraThread(void)
+{
+    if (camera_thread.thread) {
+        const Uint64 val = 1;
+        SDL_AtomicSet(&camera_thread.quit, 1);
+        (void) write(camera_thread.wakefd, &val, sizeof (val));
+        SDL_WaitThread(camera_thread.thread, NULL);
+    }
+
+    close(camera_thread.wakefd);
+    close(camera_thread.epollfd);
+    SDL_DestroyMutex(camera_thread.lock);
+    SDL_free(camera_thread.devices);
+    SDL_free(camera_thread.zombies);
+    SDL_zero(camera_thread);
+}
+
 static void V4L2_Deinitialize(void)
 {
 #ifdef SDL_USE_LIBUDEV
     SDL_UDEV_DelCallback(CameraUdevCallback);
     SDL_UDEV_Quit();
 #endif // SDL_USE_LIBUDEV
+
+    QuitCameraThread();
 }
 
 static void V4L2_DetectDevices(void)
@@ -870,6 +1252,24 @@ static void V4L2_DetectDevices(void)
 
 static SDL_bool V4L2_Init(SDL_CameraDriverImpl *impl)
 {
+    SDL_zero(camera_thread);
+    camera_thread.epollfd = epoll_create1(EPOLL_CLOEXEC);
+    camera_thread.wakefd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    camera_thread.lock = SDL_CreateMutex();
+    if ((camera_thread.epollfd == -1) || (camera_thread.wakefd == -1) || !camera_thread.lock) {
+        QuitCameraThread();
+        return SDL_FALSE;
+    }
+
+    struct epoll_event event;
+    SDL_zero(event);
+    event.events = EPOLLIN;
+    event.data.ptr = NULL;
+    if (epoll_ctl(camera_thread.epollfd, EPOLL_CTL_ADD, camera_thread.wakefd, &event) == -1) {
+        QuitCameraThread();
+        return SDL_FALSE;
+    }
+
     impl->DetectDevices = V4L2_DetectDevices;
     impl->OpenDevice = V4L2_OpenDevice;
     impl->CloseDevice = V4L2_CloseDevice;
@@ -879,6 +1279,8 @@ static SDL_bool V4L2_Init(SDL_CameraDriverImpl *impl)
     impl->FreeDeviceHandle = V4L2_FreeDeviceHandle;
     impl->Deinitialize = V4L2_Deinitialize;
 
+    impl->ProvidesOwnCallbackThread = SDL_TRUE;
+
     return SDL_TRUE;
 }
 
@@ -996,3 +996,30 @@
 #define SDL_CloseCamera SDL_CloseCamera_REAL
 #define SDL_GetCameraPermissionState SDL_GetCameraPermissionState_REAL
 #define SDL_GetCameraDevicePosition SDL_GetCameraDevicePosition_REAL
+#define SDL_GetPropertyAtom SDL_GetPropertyAtom_REAL
+#define SDL_GetPropertyByAtom SDL_GetPropertyByAtom_REAL
+#define SDL_GetStringPropertyByAtom SDL_GetStringPropertyByAtom_REAL
+#define SDL_GetNumberPropertyByAtom SDL_GetNumberPropertyByAtom_REAL
+#define SDL_GetFloatPropertyByAtom SDL_GetFloatPropertyByAtom_REAL
+#define SDL_GetBooleanPropertyByAtom SDL_GetBooleanPropertyByAtom_REAL
+#define SDL_UnpremultiplyAlpha SDL_UnpremultiplyAlpha_REAL
+#define SDL_RWFromMappedFile SDL_RWFromMappedFile_REAL
+#define SDL_SetRWBuffer SDL_SetRWBuffer_REAL
+#define SDL_FlushRW SDL_FlushRW_REAL
+#define SDL_CreateRWQueue SDL_CreateRWQueue_REAL
+#define SDL_DestroyRWQueue SDL_DestroyRWQueue_REAL
+#define SDL_ReadRWAsync SDL_ReadRWAsync_REAL
+#define SDL_WriteRWAsync SDL_WriteRWAsync_REAL
+#define SDL_CancelRWRequest SDL_CancelRWRequest_REAL
+#define SDL_GetRWCompletion SDL_GetRWCompletion_REAL
+#define SDL_OpenWAVReader SDL_OpenWAVReader_REAL
+#define SDL_GetWAVFrameCount SDL_GetWAVFrameCount_REAL
+#define SDL_ReadWAVFrames SDL_ReadWAVFrames_REAL
+#define SDL_SeekWAVFrame SDL_SeekWAVFrame_REAL
+#define SDL_TellWAVFrame SDL_TellWAVFrame_REAL
+#define SDL_CloseWAVReader SDL_CloseWAVReader_REAL
+#define SDL_GetMemoryStats SDL_GetMemoryStats_REAL
+#define SDL_qsort_r SDL_qsort_r_REAL
+#define SDL_bsearch_r SDL_bsearch_r_REAL
+#define SDL_ParallelSort SDL_ParallelSort_REAL
+#define SDL_RadixSort SDL_RadixSort_REAL
@@ -1021,3 +1021,30 @@ SDL_DYNAPI_PROC(int,SDL_ReleaseCameraFrame,(SDL_Camera *a, SDL_Surface *b),(a,b)
 SDL_DYNAPI_PROC(void,SDL_CloseCamera,(SDL_Camera *a),(a),)
 SDL_DYNAPI_PROC(int,SDL_GetCameraPermissionState,(SDL_Camera *a),(a),return)
 SDL_DYNAPI_PROC(SDL_CameraPosition,SDL_GetCameraDevicePosition,(SDL_CameraDeviceID a),(a),return)
+SDL_DYNAPI_PROC(SDL_PropertyAtom,SDL_GetPropertyAtom,(const char *a),(a),return)
+SDL_DYNAPI_PROC(void*,SDL_GetPropertyByAtom,(SDL_PropertiesID a, SDL_PropertyAtom b, void *c),(a,b,c),return)
+SDL_DYNAPI_PROC(const char*,SDL_GetStringPropertyByAtom,(SDL_PropertiesID a, SDL_PropertyAtom b, const char *c),(a,b,c),return)
+SDL_DYNAPI_PROC(Sint64,SDL_GetNumberPropertyByAtom,(SDL_PropertiesID a, SDL_PropertyAtom b, Sint64 c),(a,b,c),return)
+SDL_DYNAPI_PROC(float,SDL_GetFloatPropertyByAtom,(SDL_PropertiesID a, SDL_PropertyAtom b, float c),(a,b,c),return)
+SDL_DYNAPI_PROC(SDL_bool,SDL_GetBooleanPropertyByAtom,(SDL_PropertiesID a, SDL_PropertyAtom b, SDL_bool c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_UnpremultiplyAlpha,(int a, int b, Uint32 c, const void *d, int e, Uint32 f, void *g, int h),(a,b,c,d,e,f,g,h),return)
+SDL_DYNAPI_PROC(SDL_RWops*,SDL_RWFromMappedFile,(const char *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_SetRWBuffer,(SDL_RWops *a, size_t b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_FlushRW,(SDL_RWops *a),(a),return)
+SDL_DYNAPI_PROC(SDL_RWQueue*,SDL_CreateRWQueue,(int a),(a),return)
+SDL_DYNAPI_PROC(void,SDL_DestroyRWQueue,(SDL_RWQueue *a),(a),)
+SDL_DYNAPI_PROC(Uint64,SDL_ReadRWAsync,(SDL_RWQueue *a, SDL_RWops *b, Uint64 c, const SDL_RWSegment *d, int e, void *f),(a,b,c,d,e,f),return)
+SDL_DYNAPI_PROC(Uint64,SDL_WriteRWAsync,(SDL_RWQueue *a, SDL_RWops *b, Uint64 c, const SDL_RWSegment *d, int e, void *f),(a,b,c,d,e,f),return)
+SDL_DYNAPI_PROC(int,SDL_CancelRWRequest,(SDL_RWQueue *a, Uint64 b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_bool,SDL_GetRWCompletion,(SDL_RWQueue *a, SDL_RWCompletion *b, Sint32 c),(a,b,c),return)
+SDL_DYNAPI_PROC(SDL_WAVReader*,SDL_OpenWAVReader,(SDL_RWops *a, SDL_bool b, SDL_AudioSpec *c),(a,b,c),return)
+SDL_DYNAPI_PROC(Sint64,SDL_GetWAVFrameCount,(SDL_WAVReader *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_ReadWAVFrames,(SDL_WAVReader *a, SDL_AudioStream *b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_SeekWAVFrame,(SDL_WAVReader *a, Sint64 b),(a,b),return)
+SDL_DYNAPI_PROC(Sint64,SDL_TellWAVFrame,(SDL_WAVReader *a),(a),return)
+SDL_DYNAPI_PROC(void,SDL_CloseWAVReader,(SDL_WAVReader *a),(a),)
+SDL_DYNAPI_PROC(int,SDL_GetMemoryStats,(SDL_MemoryStats *a),(a),return)
+SDL_DYNAPI_PROC(void,SDL_qsort_r,(void *a, size_t b, size_t c, SDL_CompareCallback_r d, void *e),(a,b,c,d,e),)
+SDL_DYNAPI_PROC(void*,SDL_bsearch_r,(const void *a, const void *b, size_t c, size_t d, SDL_CompareCallback_r e, void *f),(a,b,c,d,e,f),return)
+SDL_DYNAPI_PROC(int,SDL_ParallelSort,(void *a, size_t b, size_t c, SDL_CompareCallback_r d, void *e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(int,SDL_RadixSort,(void *a, size_t b, size_t c, size_t d, SDL_SortKeyType e),(a,b,c,d,e),return)
@@ -23,6 +23,7 @@
 /* General keyboard handling code for SDL */
 
 #include "SDL_events_c.h"
+#include "../SDL_hints_c.h"
 #include "../video/SDL_sysvideo.h"
 #include "scancodes_ascii.h"
 
@@ -52,6 +53,7 @@ struct SDL_Keyboard
     SDL_Keycode keymap[SDL_NUM_SCANCODES];
     SDL_bool autorelease_pending;
     Uint64 hardware_timestamp;
+    SDL_CachedHintBoolean allow_alt_tab_while_grabbed;
 };
 
 static SDL_Keyboard SDL_keyboard;
@@ -961,7 +963,7 @@ static int SDL_SendKeyboardKeyInternal(Uint64 timestamp, SDL_KeyboardFlags flags
         keyboard->focus &&
         (keyboard->focus->flags & SDL_WINDOW_KEYBOARD_GRABBED) &&
         (keyboard->focus->flags & SDL_WINDOW_FULLSCREEN) &&
-        SDL_GetHintBoolean(SDL_HINT_ALLOW_ALT_TAB_WHILE_GRABBED, SDL_TRUE)) {
+        SDL_GetCachedHintBoolean(SDL_HINT_ALLOW_ALT_TAB_WHILE_GRABBED, SDL_TRUE, &keyboard->allow_alt_tab_while_grabbed)) {
         /* We will temporarily forfeit our grab by minimizing our window,
            allowing the user to escape the application */
         SDL_MinimizeWindow(keyboard->focus);
@@ -1073,12 +1073,14 @@ int SDL_WarpMouseGlobal(float x, float y)
 
 static SDL_bool SDL_ShouldUseRelativeModeWarp(SDL_Mouse *mouse)
 {
+    static SDL_CachedHintBoolean relative_mode_warp;
+
     if (!mouse->WarpMouse) {
         /* Need this functionality for relative mode warp implementation */
         return SDL_FALSE;
     }
 
-    return SDL_GetHintBoolean(SDL_HINT_MOUSE_RELATIVE_MODE_WARP, SDL_FALSE);
+    return SDL_GetCachedHintBoolean(SDL_HINT_MOUSE_RELATIVE_MODE_WARP, SDL_FALSE, &relative_mode_warp);
 }
 
 int SDL_SetRelativeMouseMode(SDL_bool enabled)
@@ -22,6 +22,7 @@
 
 /* Window event handling code for SDL */
 
+#include "../SDL_hints_c.h"
 #include "SDL_events_c.h"
 #include "SDL_mouse_c.h"
 
@@ -254,7 +255,9 @@ int SDL_SendWindowEvent(SDL_Window *window, SDL_EventType windowevent,
         }
 
         if (toplevel_count == 1) {
-            if (SDL_GetHintBoolean(SDL_HINT_QUIT_ON_LAST_WINDOW_CLOSE, SDL_TRUE)) {
+            static SDL_CachedHintBoolean quit_on_last_window_close;
+
+            if (SDL_GetCachedHintBoolean(SDL_HINT_QUIT_ON_LAST_WINDOW_CLOSE, SDL_TRUE, &quit_on_last_window_close)) {
                 SDL_SendQuit(); /* This is the last toplevel window in the list so send the SDL_EVENT_QUIT event */
             }
         }
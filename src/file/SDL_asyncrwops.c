@@ -0,0 +1,888 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#include "../thread/SDL_systhread.h"
+
+#ifdef HAVE_STDIO_H
+#include <stdio.h>
+#endif
+#if defined(HAVE_STDIO_H) && (defined(SDL_PLATFORM_UNIX) || defined(SDL_PLATFORM_APPLE)) && !defined(SDL_PLATFORM_EMSCRIPTEN)
+#include <errno.h>
+#include <unistd.h>
+#define SDL_ASYNC_RW_POSIX
+#endif
+#if defined(SDL_ASYNC_RW_POSIX) && defined(SDL_PLATFORM_LINUX) && defined(HAVE_LINUX_IO_URING_H)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#define SDL_ASYNC_RW_IO_URING
+#endif
+
+/* This file runs SDL_RWops reads and writes in the background.
+
+   Requests on files with a POSIX descriptor go to io_uring when the kernel
+   has it, so any number of them can be in flight without a thread each.
+   Everything else goes to a small pool of worker threads: files are read
+   with pread() and pwrite(), which don't move the stream position, and
+   other streams are seeked and read one request at a time.
+*/
+
+#define SDL_RWQUEUE_DEFAULT_DEPTH 64
+#define SDL_RWQUEUE_MAX_DEPTH     4096
+#define SDL_RWQUEUE_MAX_WORKERS   8
+
+typedef struct SDL_RWRequest
+{
+    Uint64 id;
+    SDL_RWRequestType type;
+    SDL_RWops *context;
+    int fd;
+    Uint64 offset;
+    size_t requested;
+    size_t transferred;
+    void *userdata;
+    SDL_RWSegment *segments;
+    int num_segments;
+    SDL_bool canceled;
+#ifdef SDL_ASYNC_RW_IO_URING
+    SDL_bool in_ring;
+    struct iovec *iov;
+#endif
+    struct SDL_RWRequest *next;         /* in the work, backlog or completed list */
+    struct SDL_RWRequest *prev_active;  /* in the list of requests in flight */
+    struct SDL_RWRequest *next_active;
+    SDL_RWRequestStatus status;
+} SDL_RWRequest;
+
+typedef struct SDL_RWRequestList
+{
+    SDL_RWRequest *head;
+    SDL_RWRequest *tail;
+    int count;
+} SDL_RWRequestList;
+
+#ifdef SDL_ASYNC_RW_IO_URING
+
+/* user_data values of ring entries that aren't requests */
+#define SDL_RWRING_WAKEUP 0
+#define SDL_RWRING_CANCEL 1
+
+typedef struct SDL_RWRing
+{
+    int fd;
+    unsigned entries;
+    unsigned in_flight;     /* entries submitted and not yet completed */
+    unsigned *sq_tail;
+    unsigned *sq_mask;
+    unsigned *sq_array;
+    unsigned *cq_head;
+    unsigned *cq_tail;
+    unsigned *cq_mask;
+    struct io_uring_sqe *sqes;
+    struct io_uring_cqe *cqes;
+    void *sq_ring;
+    size_t sq_ring_size;
+    void *cq_ring;
+    size_t cq_ring_size;
+    size_t sqes_size;
+    SDL_RWRequestList backlog;  /* requests waiting for room in the ring */
+    SDL_Thread *thread;
+} SDL_RWRing;
+
+#endif /* SDL_ASYNC_RW_IO_URING */
+
+struct SDL_RWQueue
+{
+    SDL_Mutex *lock;
+    SDL_Condition *work_ready;
+    SDL_Condition *completion_ready;
+    SDL_Mutex *stream_lock;     /* held while seeking and reading streams without a descriptor */
+    SDL_RWRequestList work;
+    SDL_RWRequestList completed;
+    SDL_RWRequest *active;
+    int num_active;
+    Uint64 next_id;
+    SDL_Thread *workers[SDL_RWQUEUE_MAX_WORKERS];
+    int num_workers;
+    int max_workers;
+    int num_idle;
+    SDL_bool quit;
+#ifdef SDL_ASYNC_RW_IO_URING
+    SDL_RWRing *ring;
+#endif
+};
+
+static void SDL_AppendRWRequest(SDL_RWRequestList *list, SDL_RWRequest *req)
+{
+    req->next = NULL;
+    if (list->tail) {
+        list->tail->next = req;
+    } else {
+        list->head = req;
+    }
+    list->tail = req;
+    ++list->count;
+}
+
+static SDL_RWRequest *SDL_PopRWRequest(SDL_RWRequestList *list)
+{
+    SDL_RWRequest *req = list->head;
+    if (req) {
+        list->head = req->next;
+        if (!list->head) {
+            list->tail = NULL;
+        }
+        --list->count;
+    }
+    return req;
+}
+
+static SDL_bool SDL_RemoveRWRequest(SDL_RWRequestList *list, SDL_RWRequest *req)
+{
+    SDL_RWRequest *prev = NULL;
+    SDL_RWRequest *i;
+
+    for (i = list->head; i; prev = i, i = i->next) {
+        if (i == req) {
+            if (prev) {
+                prev->next = req->next;
+            } else {
+                list->head = req->next;
+            }
+            if (list->tail == req) {
+                list->tail = prev;
+            }
+            --list->count;
+            return SDL_TRUE;
+        }
+    }
+    return SDL_FALSE;
+}
+
+/* Called with the queue locked */
+static void SDL_CompleteRWRequest(SDL_RWQueue *queue, SDL_RWRequest *req, SDL_RWRequestStatus status)
+{
+    if (req->prev_active) {
+        req->prev_active->next_active = req->next_active;
+    } else {
+        queue->active = req->next_active;
+    }
+    if (req->next_active) {
+        req->next_active->prev_active = req->prev_active;
+    }
+    --queue->num_active;
+
+    req->status = status;
+    SDL_AppendRWRequest(&queue->completed, req);
+    SDL_BroadcastCondition(queue->completion_ready);
+}
+
+#ifdef SDL_ASYNC_RW_POSIX
+
+static int SDL_GetRWDescriptor(SDL_RWops *context)
+{
+    FILE *fp;
+
+    if (context->type != SDL_RWOPS_STDFILE || !context->hidden.stdio.fp) {
+        return -1;
+    }
+
+    /* Data still in the stdio buffer has to reach the file before we go around it */
+    fp = (FILE *)context->hidden.stdio.fp;
+    if (fflush(fp) != 0) {
+        return -1;
+    }
+    return fileno(fp);
+}
+
+static SDL_RWRequestStatus SDL_RunFileRequest(SDL_RWRequest *req)
+{
+    int i;
+
+    for (i = 0; i < req->num_segments; ++i) {
+        Uint8 *data = (Uint8 *)req->segments[i].data;
+        size_t left = req->segments[i].size;
+
+        while (left > 0) {
+            off_t offset = (off_t)(req->offset + req->transferred);
+            ssize_t result;
+
+            if (req->type == SDL_RWREQUEST_READ) {
+                result = pread(req->fd, data, left, offset);
+            } else {
+                result = pwrite(req->fd, data, left, offset);
+            }
+            if (result < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return SDL_RWREQUEST_FAILED;
+            }
+            if (result == 0) {
+                /* End of file */
+                return SDL_RWREQUEST_COMPLETE;
+            }
+            data += result;
+            left -= result;
+            req->transferred += result;
+        }
+    }
+    return SDL_RWREQUEST_COMPLETE;
+}
+
+#endif /* SDL_ASYNC_RW_POSIX */
+
+/* The stream lock only orders the requests of this queue. The stream belongs to the queue
+   while it has requests in flight, so nobody else moves its position meanwhile. */
+static SDL_RWRequestStatus SDL_RunStreamRequest(SDL_RWQueue *queue, SDL_RWRequest *req)
+{
+    SDL_RWops *context = req->context;
+    SDL_RWRequestStatus status = SDL_RWREQUEST_COMPLETE;
+    Sint64 position;
+    int i;
+
+    SDL_LockMutex(queue->stream_lock);
+
+    position = SDL_RWtell(context);
+    if (SDL_RWseek(context, (Sint64)req->offset, SDL_RW_SEEK_SET) != (Sint64)req->offset) {
+        status = SDL_RWREQUEST_FAILED;
+    } else {
+        for (i = 0; i < req->num_segments; ++i) {
+            size_t size = req->segments[i].size;
+            size_t amount;
+
+            if (req->type == SDL_RWREQUEST_READ) {
+                amount = SDL_RWread(context, req->segments[i].data, size);
+            } else {
+                amount = SDL_RWwrite(context, req->segments[i].data, size);
+            }
+            req->transferred += amount;
+            if (amount < size) {
+                if (req->type == SDL_RWREQUEST_WRITE || context->status != SDL_RWOPS_STATUS_EOF) {
+                    status = SDL_RWREQUEST_FAILED;
+                }
+                break;
+            }
+        }
+    }
+
+    /* Asynchronous requests leave the stream position alone */
+    if (position >= 0 && SDL_RWseek(context, position, SDL_RW_SEEK_SET) < 0) {
+        status = SDL_RWREQUEST_FAILED;
+    }
+
+    SDL_UnlockMutex(queue->stream_lock);
+
+    return status;
+}
+
+static int SDLCALL SDL_RWWorkerThread(void *data)
+{
+    SDL_RWQueue *queue = (SDL_RWQueue *)data;
+    SDL_RWRequest *req;
+    SDL_RWRequestStatus status;
+
+    SDL_LockMutex(queue->lock);
+    for (;;) {
+        req = SDL_PopRWRequest(&queue->work);
+        if (!req) {
+            if (queue->quit) {
+                break;
+            }
+            ++queue->num_idle;
+            SDL_WaitCondition(queue->work_ready, queue->lock);
+            --queue->num_idle;
+            continue;
+        }
+        SDL_UnlockMutex(queue->lock);
+
+#ifdef SDL_ASYNC_RW_POSIX
+        if (req->fd >= 0) {
+            status = SDL_RunFileRequest(req);
+        } else
+#endif
+        {
+            status = SDL_RunStreamRequest(queue, req);
+        }
+
+        SDL_LockMutex(queue->lock);
+        SDL_CompleteRWRequest(queue, req, status);
+    }
+    SDL_UnlockMutex(queue->lock);
+
+    return 0;
+}
+
+/* Called with the queue locked */
+static int SDL_QueueRWWork(SDL_RWQueue *queue, SDL_RWRequest *req)
+{
+    SDL_AppendRWRequest(&queue->work, req);
+
+    /* Start another worker if there's more work than idle workers to take it */
+    if (queue->work.count > queue->num_idle && queue->num_workers < queue->max_workers) {
+        char name[64];
+        SDL_Thread *thread;
+
+        (void)SDL_snprintf(name, sizeof(name), "SDLRWWorker%d", queue->num_workers);
+        thread = SDL_CreateThreadInternal(SDL_RWWorkerThread, name, 0, queue);
+        if (thread) {
+            queue->workers[queue->num_workers++] = thread;
+        } else if (queue->num_workers == 0) {
+            SDL_RemoveRWRequest(&queue->work, req);
+            return -1;
+        }
+    }
+    SDL_SignalCondition(queue->work_ready);
+    return 0;
+}
+
+#ifdef SDL_ASYNC_RW_IO_URING
+
+static SDL_RWRing *SDL_CreateRWRing(unsigned entries)
+{
+    struct io_uring_params params;
+    SDL_RWRing *ring;
+    int fd;
+
+    SDL_zero(params);
+    fd = (int)syscall(__NR_io_uring_setup, entries, &params);
+    if (fd < 0) {
+        return NULL;
+    }
+
+    /* Without NODROP the kernel may lose completions, and it predates request cancellation */
+    if (!(params.features & IORING_FEAT_NODROP)) {
+        close(fd);
+        return NULL;
+    }
+
+    ring = (SDL_RWRing *)SDL_calloc(1, sizeof(*ring));
+    if (!ring) {
+        close(fd);
+        return NULL;
+    }
+    ring->fd = fd;
+    ring->entries = params.sq_entries;
+    ring->sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ring->cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    ring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        ring->sq_ring_size = ring->cq_ring_size = SDL_max(ring->sq_ring_size, ring->cq_ring_size);
+    }
+
+    ring->sq_ring = mmap(NULL, ring->sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if (ring->sq_ring == MAP_FAILED) {
+        close(fd);
+        SDL_free(ring);
+        return NULL;
+    }
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        ring->cq_ring = ring->sq_ring;
+    } else {
+        ring->cq_ring = mmap(NULL, ring->cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        if (ring->cq_ring == MAP_FAILED) {
+            munmap(ring->sq_ring, ring->sq_ring_size);
+            close(fd);
+            SDL_free(ring);
+            return NULL;
+        }
+    }
+    ring->sqes = (struct io_uring_sqe *)mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if (ring->sqes == MAP_FAILED) {
+        if (ring->cq_ring != ring->sq_ring) {
+            munmap(ring->cq_ring, ring->cq_ring_size);
+        }
+        munmap(ring->sq_ring, ring->sq_ring_size);
+        close(fd);
+        SDL_free(ring);
+        return NULL;
+    }
+
+    ring->sq_tail = (unsigned *)((Uint8 *)ring->sq_ring + params.sq_off.tail);
+    ring->sq_mask = (unsigned *)((Uint8 *)ring->sq_ring + params.sq_off.ring_mask);
+    ring->sq_array = (unsigned *)((Uint8 *)ring->sq_ring + params.sq_off.array);
+    ring->cq_head = (unsigned *)((Uint8 *)ring->cq_ring + params.cq_off.head);
+    ring->cq_tail = (unsigned *)((Uint8 *)ring->cq_ring + params.cq_off.tail);
+    ring->cq_mask = (unsigned *)((Uint8 *)ring->cq_ring + params.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe *)((Uint8 *)ring->cq_ring + params.cq_off.cqes);
+
+    return ring;
+}
+
+static void SDL_DestroyRWRing(SDL_RWRing *ring)
+{
+    munmap(ring->sqes, ring->sqes_size);
+    if (ring->cq_ring != ring->sq_ring) {
+        munmap(ring->cq_ring, ring->cq_ring_size);
+    }
+    munmap(ring->sq_ring, ring->sq_ring_size);
+    close(ring->fd);
+    SDL_free(ring);
+}
+
+/* Called with the queue locked, when ring->in_flight < ring->entries.
+   At most that many entries are in flight, so the completion ring, which is
+   at least twice as large, can't overflow. */
+static struct io_uring_sqe *SDL_GetRingEntry(SDL_RWRing *ring)
+{
+    unsigned index = *ring->sq_tail & *ring->sq_mask;
+    struct io_uring_sqe *sqe = &ring->sqes[index];
+
+    SDL_zerop(sqe);
+    ring->sq_array[index] = index;
+    ++ring->in_flight;
+    return sqe;
+}
+
+static void SDL_SubmitRingEntry(SDL_RWRing *ring)
+{
+    SDL_MemoryBarrierRelease();
+    *(volatile unsigned *)ring->sq_tail = *ring->sq_tail + 1;
+
+    while (syscall(__NR_io_uring_enter, ring->fd, 1, 0, 0, NULL, 0) < 0) {
+        if (errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+            break;
+        }
+    }
+}
+
+/* Called with the queue locked */
+static void SDL_SubmitRingRequest(SDL_RWRing *ring, SDL_RWRequest *req)
+{
+    struct io_uring_sqe *sqe;
+    size_t skip = req->transferred;
+    int count = 0;
+    int i;
+
+    if (ring->in_flight >= ring->entries) {
+        SDL_AppendRWRequest(&ring->backlog, req);
+        return;
+    }
+
+    /* Resubmissions after a short transfer pick up where the last one stopped */
+    for (i = 0; i < req->num_segments; ++i) {
+        size_t size = req->segments[i].size;
+        if (skip >= size) {
+            skip -= size;
+            continue;
+        }
+        req->iov[count].iov_base = (Uint8 *)req->segments[i].data + skip;
+        req->iov[count].iov_len = size - skip;
+        skip = 0;
+        ++count;
+    }
+
+    sqe = SDL_GetRingEntry(ring);
+    sqe->opcode = (req->type == SDL_RWREQUEST_READ) ? IORING_OP_READV : IORING_OP_WRITEV;
+    sqe->fd = req->fd;
+    sqe->off = req->offset + req->transferred;
+    sqe->addr = (uintptr_t)req->iov;
+    sqe->len = (Uint32)count;
+    sqe->user_data = (uintptr_t)req;
+    SDL_SubmitRingEntry(ring);
+}
+
+/* Called with the queue locked */
+static void SDL_CancelRingRequest(SDL_RWRing *ring, SDL_RWRequest *req)
+{
+    struct io_uring_sqe *sqe;
+
+    if (ring->in_flight >= ring->entries) {
+        /* No room, let it finish */
+        return;
+    }
+
+    sqe = SDL_GetRingEntry(ring);
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = -1;
+    sqe->addr = (uintptr_t)req;
+    sqe->user_data = SDL_RWRING_CANCEL;
+    SDL_SubmitRingEntry(ring);
+}
+
+/* Called with the queue locked */
+static void SDL_HandleRingCompletion(SDL_RWQueue *queue, SDL_RWRequest *req, int result)
+{
+    if (result < 0) {
+        if (result == -ECANCELED || (result == -EINTR && req->canceled)) {
+            SDL_CompleteRWRequest(queue, req, SDL_RWREQUEST_CANCELED);
+        } else {
+            SDL_CompleteRWRequest(queue, req, SDL_RWREQUEST_FAILED);
+        }
+        return;
+    }
+
+    req->transferred += result;
+    if (result == 0 || req->transferred == req->requested) {
+        SDL_CompleteRWRequest(queue, req, SDL_RWREQUEST_COMPLETE);
+    } else if (req->canceled) {
+        SDL_CompleteRWRequest(queue, req, SDL_RWREQUEST_CANCELED);
+    } else {
+        SDL_SubmitRingRequest(queue->ring, req);
+    }
+}
+
+static int SDLCALL SDL_RWRingThread(void *data)
+{
+    SDL_RWQueue *queue = (SDL_RWQueue *)data;
+    SDL_RWRing *ring = queue->ring;
+    SDL_bool done = SDL_FALSE;
+
+    while (!done) {
+        unsigned head, tail;
+
+        if (syscall(__NR_io_uring_enter, ring->fd, 0, 1, IORING_ENTER_GETEVENTS, NULL, 0) < 0 && errno != EINTR) {
+            SDL_Delay(1);
+        }
+
+        SDL_LockMutex(queue->lock);
+        head = *ring->cq_head;
+        tail = *(volatile unsigned *)ring->cq_tail;
+        SDL_MemoryBarrierAcquire();
+        while (head != tail) {
+            const struct io_uring_cqe *cqe = &ring->cqes[head & *ring->cq_mask];
+
+            --ring->in_flight;
+            if (cqe->user_data == SDL_RWRING_WAKEUP) {
+                done = SDL_TRUE;
+            } else if (cqe->user_data != SDL_RWRING_CANCEL) {
+                SDL_HandleRingCompletion(queue, (SDL_RWRequest *)(uintptr_t)cqe->user_data, cqe->res);
+            }
+            ++head;
+        }
+        SDL_MemoryBarrierRelease();
+        *(volatile unsigned *)ring->cq_head = head;
+
+        while (ring->backlog.head && ring->in_flight < ring->entries) {
+            SDL_SubmitRingRequest(ring, SDL_PopRWRequest(&ring->backlog));
+        }
+        SDL_UnlockMutex(queue->lock);
+    }
+    return 0;
+}
+
+#endif /* SDL_ASYNC_RW_IO_URING */
+
+SDL_RWQueue *SDL_CreateRWQueue(int depth)
+{
+    SDL_RWQueue *queue;
+
+    if (depth < 0) {
+        SDL_InvalidParamError("depth");
+        return NULL;
+    }
+    if (depth == 0) {
+        depth = SDL_RWQUEUE_DEFAULT_DEPTH;
+    }
+    depth = SDL_min(depth, SDL_RWQUEUE_MAX_DEPTH);
+
+    queue = (SDL_RWQueue *)SDL_calloc(1, sizeof(*queue));
+    if (!queue) {
+        return NULL;
+    }
+    queue->next_id = 1;
+    queue->max_workers = SDL_min(depth, SDL_RWQUEUE_MAX_WORKERS);
+    queue->lock = SDL_CreateMutex();
+    queue->stream_lock = SDL_CreateMutex();
+    queue->work_ready = SDL_CreateCondition();
+    queue->completion_ready = SDL_CreateCondition();
+    if (!queue->lock || !queue->stream_lock || !queue->work_ready || !queue->completion_ready) {
+        SDL_DestroyRWQueue(queue);
+        return NULL;
+    }
+
+#ifdef SDL_ASYNC_RW_IO_URING
+    if (SDL_GetHintBoolean(SDL_HINT_RWOPS_IO_URING, SDL_TRUE)) {
+        queue->ring = SDL_CreateRWRing((unsigned)depth);
+        if (queue->ring) {
+            queue->ring->thread = SDL_CreateThreadInternal(SDL_RWRingThread, "SDLRWRing", 0, queue);
+            if (!queue->ring->thread) {
+                SDL_DestroyRWRing(queue->ring);
+                queue->ring = NULL;
+            }
+        }
+    }
+#endif
+
+    return queue;
+}
+
+void SDL_DestroyRWQueue(SDL_RWQueue *queue)
+{
+    SDL_RWRequest *req;
+    int i;
+
+    if (!queue) {
+        return;
+    }
+
+    if (queue->lock) {
+        SDL_LockMutex(queue->lock);
+        queue->quit = SDL_TRUE;
+        while ((req = SDL_PopRWRequest(&queue->work)) != NULL) {
+            SDL_CompleteRWRequest(queue, req, SDL_RWREQUEST_CANCELED);
+        }
+#ifdef SDL_ASYNC_RW_IO_URING
+        if (queue->ring) {
+            while ((req = SDL_PopRWRequest(&queue->ring->backlog)) != NULL) {
+                SDL_CompleteRWRequest(queue, req, SDL_RWREQUEST_CANCELED);
+            }
+            for (req = queue->active; req; req = req->next_active) {
+                if (req->in_ring && !req->canceled) {
+                    req->canceled = SDL_TRUE;
+                    SDL_CancelRingRequest(queue->ring, req);
+                }
+            }
+        }
+#endif
+        while (queue->num_active > 0) {
+            SDL_WaitCondition(queue->completion_ready, queue->lock);
+        }
+        SDL_BroadcastCondition(queue->work_ready);
+        SDL_UnlockMutex(queue->lock);
+    }
+
+    for (i = 0; i < queue->num_workers; ++i) {
+        SDL_WaitThread(queue->workers[i], NULL);
+    }
+
+#ifdef SDL_ASYNC_RW_IO_URING
+    if (queue->ring) {
+        SDL_LockMutex(queue->lock);
+        while (queue->ring->in_flight >= queue->ring->entries) {
+            /* Wait for outstanding cancellations to make room */
+            SDL_UnlockMutex(queue->lock);
+            SDL_Delay(1);
+            SDL_LockMutex(queue->lock);
+        }
+        SDL_GetRingEntry(queue->ring)->opcode = IORING_OP_NOP;  /* user_data is SDL_RWRING_WAKEUP */
+        SDL_SubmitRingEntry(queue->ring);
+        SDL_UnlockMutex(queue->lock);
+
+        SDL_WaitThread(queue->ring->thread, NULL);
+        SDL_DestroyRWRing(queue->ring);
+    }
+#endif
+
+    while ((req = SDL_PopRWRequest(&queue->completed)) != NULL) {
+        SDL_free(req);
+    }
+    SDL_DestroyCondition(queue->completion_ready);
+    SDL_DestroyCondition(queue->work_ready);
+    SDL_DestroyMutex(queue->stream_lock);
+    SDL_DestroyMutex(queue->lock);
+    SDL_free(queue);
+}
+
+static Uint64 SDL_SubmitRWRequest(SDL_RWQueue *queue, SDL_RWRequestType type, SDL_RWops *context, Uint64 offset, const SDL_RWSegment *segments, int num_segments, void *userdata)
+{
+    SDL_RWRequest *req;
+    size_t size;
+    Uint64 id;
+    int i;
+
+    if (!queue) {
+        SDL_InvalidParamError("queue");
+        return 0;
+    }
+    if (!context) {
+        SDL_InvalidParamError("context");
+        return 0;
+    }
+    if (num_segments < 0 || (num_segments > 0 && !segments)) {
+        SDL_InvalidParamError("segments");
+        return 0;
+    }
+    if (offset > (Uint64)SDL_MAX_SINT64) {
+        SDL_InvalidParamError("offset");
+        return 0;
+    }
+
+    size = sizeof(*req) + num_segments * sizeof(SDL_RWSegment);
+#ifdef SDL_ASYNC_RW_IO_URING
+    size += num_segments * sizeof(struct iovec);
+#endif
+    req = (SDL_RWRequest *)SDL_calloc(1, size);
+    if (!req) {
+        return 0;
+    }
+    req->type = type;
+    req->context = context;
+    req->fd = -1;
+    req->offset = offset;
+    req->userdata = userdata;
+    req->segments = (SDL_RWSegment *)(req + 1);
+    req->num_segments = num_segments;
+    for (i = 0; i < num_segments; ++i) {
+        if (segments[i].size > 0 && !segments[i].data) {
+            SDL_free(req);
+            SDL_InvalidParamError("segments");
+            return 0;
+        }
+        if (req->requested + segments[i].size < req->requested) {
+            SDL_free(req);
+            SDL_SetError("Request is too large");
+            return 0;
+        }
+        req->segments[i] = segments[i];
+        req->requested += segments[i].size;
+    }
+#ifdef SDL_ASYNC_RW_IO_URING
+    req->iov = (struct iovec *)(req->segments + num_segments);
+#endif
+
+    if (SDL_FlushRW(context) < 0) {
+        SDL_free(req);
+        return 0;
+    }
+#ifdef SDL_ASYNC_RW_POSIX
+    req->fd = SDL_GetRWDescriptor(context);
+#endif
+
+    SDL_LockMutex(queue->lock);
+    if (queue->quit) {
+        SDL_UnlockMutex(queue->lock);
+        SDL_free(req);
+        SDL_SetError("Queue is being destroyed");
+        return 0;
+    }
+    id = queue->next_id++;
+    req->id = id;
+    req->next_active = queue->active;
+    if (queue->active) {
+        queue->active->prev_active = req;
+    }
+    queue->active = req;
+    ++queue->num_active;
+
+    if (req->requested == 0) {
+        SDL_CompleteRWRequest(queue, req, SDL_RWREQUEST_COMPLETE);
+#ifdef SDL_ASYNC_RW_IO_URING
+    } else if (queue->ring && req->fd >= 0) {
+        req->in_ring = SDL_TRUE;
+        SDL_SubmitRingRequest(queue->ring, req);
+#endif
+    } else if (SDL_QueueRWWork(queue, req) < 0) {
+        SDL_CompleteRWRequest(queue, req, SDL_RWREQUEST_FAILED);
+        SDL_RemoveRWRequest(&queue->completed, req);
+        SDL_free(req);
+        id = 0;
+    }
+    SDL_UnlockMutex(queue->lock);
+
+    return id;
+}
+
+Uint64 SDL_ReadRWAsync(SDL_RWQueue *queue, SDL_RWops *context, Uint64 offset, const SDL_RWSegment *segments, int num_segments, void *userdata)
+{
+    return SDL_SubmitRWRequest(queue, SDL_RWREQUEST_READ, context, offset, segments, num_segments, userdata);
+}
+
+Uint64 SDL_WriteRWAsync(SDL_RWQueue *queue, SDL_RWops *context, Uint64 offset, const SDL_RWSegment *segments, int num_segments, void *userdata)
+{
+    return SDL_SubmitRWRequest(queue, SDL_RWREQUEST_WRITE, context, offset, segments, num_segments, userdata);
+}
+
+int SDL_CancelRWRequest(SDL_RWQueue *queue, Uint64 request)
+{
+    SDL_RWRequest *req;
+
+    if (!queue) {
+        return SDL_InvalidParamError("queue");
+    }
+
+    SDL_LockMutex(queue->lock);
+    for (req = queue->active; req; req = req->next_active) {
+        if (req->id == request) {
+            break;
+        }
+    }
+    if (!req) {
+        SDL_UnlockMutex(queue->lock);
+        return SDL_SetError("Request %" SDL_PRIu64 " isn't in flight", request);
+    }
+
+    if (!req->canceled) {
+        req->canceled = SDL_TRUE;
+        if (SDL_RemoveRWRequest(&queue->work, req)) {
+            SDL_CompleteRWRequest(queue, req, SDL_RWREQUEST_CANCELED);
+#ifdef SDL_ASYNC_RW_IO_URING
+        } else if (req->in_ring) {
+            if (SDL_RemoveRWRequest(&queue->ring->backlog, req)) {
+                SDL_CompleteRWRequest(queue, req, SDL_RWREQUEST_CANCELED);
+            } else {
+                SDL_CancelRingRequest(queue->ring, req);
+            }
+#endif
+        }
+        /* Otherwise a worker is already carrying it out */
+    }
+    SDL_UnlockMutex(queue->lock);
+
+    return 0;
+}
+
+SDL_bool SDL_GetRWCompletion(SDL_RWQueue *queue, SDL_RWCompletion *completion, Sint32 timeoutMS)
+{
+    SDL_RWRequest *req;
+    Uint64 deadline = 0;
+
+    if (!queue || !completion) {
+        return SDL_FALSE;
+    }
+
+    if (timeoutMS > 0) {
+        deadline = SDL_GetTicks() + timeoutMS;
+    }
+
+    SDL_LockMutex(queue->lock);
+    while (!queue->completed.head && queue->num_active > 0 && timeoutMS != 0) {
+        if (timeoutMS < 0) {
+            SDL_WaitCondition(queue->completion_ready, queue->lock);
+        } else {
+            Uint64 now = SDL_GetTicks();
+            if (now >= deadline) {
+                break;
+            }
+            SDL_WaitConditionTimeout(queue->completion_ready, queue->lock, (Sint32)(deadline - now));
+        }
+    }
+    req = SDL_PopRWRequest(&queue->completed);
+    SDL_UnlockMutex(queue->lock);
+
+    if (!req) {
+        return SDL_FALSE;
+    }
+
+    completion->request = req->id;
+    completion->type = req->type;
+    completion->status = req->status;
+    completion->context = req->context;
+    completion->offset = req->offset;
+    completion->requested = req->requested;
+    completion->transferred = req->transferred;
+    completion->userdata = req->userdata;
+    SDL_free(req);
+
+    return SDL_TRUE;
+}
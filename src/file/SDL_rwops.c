@@ -28,6 +28,12 @@
 #include <stdio.h>
 #include <sys/stat.h>
 #endif
+#if defined(HAVE_STDIO_H) && (defined(SDL_PLATFORM_UNIX) || defined(SDL_PLATFORM_APPLE)) && !defined(SDL_PLATFORM_EMSCRIPTEN)
+#include <sys/mman.h>
+#define SDL_MAPPED_FILES_POSIX
+#elif defined(SDL_PLATFORM_WIN32) && !defined(SDL_PLATFORM_WINRT) && !defined(SDL_PLATFORM_XBOXONE) && !defined(SDL_PLATFORM_XBOXSERIES)
+#define SDL_MAPPED_FILES_WINDOWS
+#endif
 #ifdef HAVE_LIMITS_H
 #include <limits.h>
 #endif
@@ -458,6 +464,77 @@ static size_t SDLCALL mem_write(SDL_RWops *context, const void *ptr, size_t size
     return mem_io(context, context->hidden.mem.here, ptr, size);
 }
 
+/* Functions to read files mapped into memory, using the memory functions above */
+
+static int SDLCALL mapped_free_close(SDL_RWops *context)
+{
+    SDL_free(context->hidden.mem.base);
+    SDL_DestroyRW(context);
+    return 0;
+}
+
+#ifdef SDL_MAPPED_FILES_POSIX
+static int SDLCALL mapped_close(SDL_RWops *context)
+{
+    munmap(context->hidden.mem.base, (size_t)(context->hidden.mem.stop - context->hidden.mem.base));
+    SDL_DestroyRW(context);
+    return 0;
+}
+
+static void *SDL_MapFile(SDL_RWops *file, size_t *size)
+{
+    struct stat st;
+    void *data;
+    int fd;
+
+    if (file->type != SDL_RWOPS_STDFILE) {
+        return NULL;
+    }
+    fd = fileno((FILE *)file->hidden.stdio.fp);
+    if (fstat(fd, &st) < 0 || st.st_size <= 0 || (Uint64)st.st_size >= SDL_SIZE_MAX) {
+        return NULL;
+    }
+    data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+        return NULL;
+    }
+    *size = (size_t)st.st_size;
+    return data;
+}
+#elif defined(SDL_MAPPED_FILES_WINDOWS)
+static int SDLCALL mapped_close(SDL_RWops *context)
+{
+    UnmapViewOfFile(context->hidden.mem.base);
+    SDL_DestroyRW(context);
+    return 0;
+}
+
+static void *SDL_MapFile(SDL_RWops *file, size_t *size)
+{
+    LARGE_INTEGER file_size;
+    HANDLE mapping;
+    void *data;
+
+    if (file->type != SDL_RWOPS_WINFILE ||
+        !GetFileSizeEx(file->hidden.windowsio.h, &file_size) ||
+        file_size.QuadPart <= 0 || (Uint64)file_size.QuadPart >= SDL_SIZE_MAX) {
+        return NULL;
+    }
+    mapping = CreateFileMappingW(file->hidden.windowsio.h, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!mapping) {
+        return NULL;
+    }
+    /* The view keeps the mapping alive after its handle is closed */
+    data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!data) {
+        return NULL;
+    }
+    *size = (size_t)file_size.QuadPart;
+    return data;
+}
+#endif
+
 /* Functions to create SDL_RWops structures from various data sources */
 
 #if defined(HAVE_STDIO_H) && !defined(SDL_PLATFORM_WINDOWS)
@@ -637,6 +714,55 @@ SDL_RWops *SDL_RWFromConstMem(const void *mem, size_t size)
     return rwops;
 }
 
+SDL_RWops *SDL_RWFromMappedFile(const char *file)
+{
+    SDL_RWops *src, *rwops;
+    void *data = NULL;
+    size_t size = 0;
+
+    src = SDL_RWFromFile(file, "rb");
+    if (!src) {
+        return NULL;
+    }
+
+    rwops = SDL_CreateRW();
+    if (!rwops) {
+        SDL_RWclose(src);
+        return NULL;
+    }
+    rwops->close = mapped_free_close;
+
+#if defined(SDL_MAPPED_FILES_POSIX) || defined(SDL_MAPPED_FILES_WINDOWS)
+    data = SDL_MapFile(src, &size);
+    if (data) {
+        rwops->close = mapped_close;
+        SDL_RWclose(src);
+    }
+#endif
+    if (!data) {
+        /* Empty files, pipes and files from other sources are loaded instead */
+        data = SDL_LoadFile_RW(src, &size, SDL_TRUE);
+        if (!data) {
+            SDL_DestroyRW(rwops);
+            return NULL;
+        }
+    }
+
+    rwops->size = mem_size;
+    rwops->seek = mem_seek;
+    rwops->read = mem_read;
+    rwops->hidden.mem.base = (Uint8 *)data;
+    rwops->hidden.mem.here = rwops->hidden.mem.base;
+    rwops->hidden.mem.stop = rwops->hidden.mem.base + size;
+    rwops->type = SDL_RWOPS_MEMORY_RO;
+
+    if (SDL_SetProperty(SDL_GetRWProperties(rwops), SDL_PROP_RWOPS_DATA_POINTER, data) < 0) {
+        SDL_RWclose(rwops);
+        return NULL;
+    }
+    return rwops;
+}
+
 SDL_RWops *SDL_CreateRW(void)
 {
     SDL_RWops *context;
@@ -651,6 +777,7 @@ SDL_RWops *SDL_CreateRW(void)
 void SDL_DestroyRW(SDL_RWops *context)
 {
     SDL_DestroyProperties(context->props);
+    SDL_free(context->buffer.data);
     SDL_free(context);
 }
 
@@ -685,7 +812,8 @@ void *SDL_LoadFile_RW(SDL_RWops *src, size_t *datasize, SDL_bool freesrc)
     for (;;) {
         if (loading_chunks) {
             if ((size_total + FILE_CHUNK_SIZE) > size) {
-                size = (size_total + FILE_CHUNK_SIZE);
+                /* Grow the buffer geometrically, so large streams aren't copied over and over */
+                size = SDL_max(size * 2, size_total + FILE_CHUNK_SIZE);
                 if (size >= SDL_SIZE_MAX) {
                     newdata = NULL;
                 } else {
@@ -740,6 +868,155 @@ SDL_PropertiesID SDL_GetRWProperties(SDL_RWops *context)
     return context->props;
 }
 
+/* Buffered I/O
+ *
+ * When reading ahead, the backend is positioned at the end of the buffered
+ * data, and when writing behind, at the start of it. Either way, the buffer
+ * is synced before doing anything else with the backend.
+ */
+static int SDL_SyncRWBuffer(SDL_RWops *context)
+{
+    int result = 0;
+
+    if (context->buffer.writing) {
+        size_t written = 0;
+
+        while (written < context->buffer.len) {
+            size_t bytes;
+
+            SDL_ClearError();
+            bytes = context->write(context, context->buffer.data + written, context->buffer.len - written);
+            if (bytes == 0) {
+                context->status = SDL_RWOPS_STATUS_ERROR;
+                if (!*SDL_GetError()) {
+                    SDL_Error(SDL_EFWRITE);
+                }
+                result = -1;
+                break;
+            }
+            written += bytes;
+        }
+    } else if (context->buffer.pos < context->buffer.len) {
+        /* Move the backend back to the stream position */
+        if (!context->seek ||
+            context->seek(context, -(Sint64)(context->buffer.len - context->buffer.pos), SDL_RW_SEEK_CUR) < 0) {
+            result = SDL_SetError("Couldn't return unread data to the stream");
+        }
+    }
+    context->buffer.pos = 0;
+    context->buffer.len = 0;
+    context->buffer.writing = SDL_FALSE;
+    return result;
+}
+
+static size_t SDL_ReadRWBuffer(SDL_RWops *context, void *ptr, size_t size)
+{
+    size_t total = 0, bytes;
+
+    if (context->buffer.writing && SDL_SyncRWBuffer(context) < 0) {
+        return 0;
+    }
+
+    bytes = SDL_min(size, context->buffer.len - context->buffer.pos);
+    SDL_memcpy(ptr, context->buffer.data + context->buffer.pos, bytes);
+    context->buffer.pos += bytes;
+    total += bytes;
+
+    if (total < size) {
+        SDL_ClearError();
+        if (size - total >= context->buffer.size) {
+            /* Large reads go straight to the destination */
+            total += context->read(context, (Uint8 *)ptr + total, size - total);
+        } else {
+            context->buffer.pos = 0;
+            context->buffer.len = context->read(context, context->buffer.data, context->buffer.size);
+            bytes = SDL_min(size - total, context->buffer.len);
+            SDL_memcpy((Uint8 *)ptr + total, context->buffer.data, bytes);
+            context->buffer.pos = bytes;
+            total += bytes;
+        }
+    }
+    return total;
+}
+
+static size_t SDL_WriteRWBuffer(SDL_RWops *context, const void *ptr, size_t size)
+{
+    if (!context->buffer.writing || context->buffer.len + size > context->buffer.size) {
+        if (SDL_SyncRWBuffer(context) < 0) {
+            return 0;
+        }
+    }
+
+    if (size >= context->buffer.size) {
+        /* Large writes go straight to the backend */
+        SDL_ClearError();
+        return context->write(context, ptr, size);
+    }
+
+    SDL_memcpy(context->buffer.data + context->buffer.len, ptr, size);
+    context->buffer.len += size;
+    context->buffer.writing = SDL_TRUE;
+    return size;
+}
+
+/* Small reads and writes that fit in the buffer skip the general path entirely */
+static SDL_INLINE SDL_bool SDL_ReadRWExactly(SDL_RWops *context, void *ptr, size_t size)
+{
+    if (context && !context->buffer.writing && (context->buffer.len - context->buffer.pos) >= size) {
+        SDL_memcpy(ptr, context->buffer.data + context->buffer.pos, size);
+        context->buffer.pos += size;
+        context->status = SDL_RWOPS_STATUS_READY;
+        return SDL_TRUE;
+    }
+    return (SDL_RWread(context, ptr, size) == size);
+}
+
+static SDL_INLINE SDL_bool SDL_WriteRWExactly(SDL_RWops *context, const void *ptr, size_t size)
+{
+    if (context && context->buffer.writing && (context->buffer.size - context->buffer.len) >= size) {
+        SDL_memcpy(context->buffer.data + context->buffer.len, ptr, size);
+        context->buffer.len += size;
+        context->status = SDL_RWOPS_STATUS_READY;
+        return SDL_TRUE;
+    }
+    return (SDL_RWwrite(context, ptr, size) == size);
+}
+
+int SDL_SetRWBuffer(SDL_RWops *context, size_t size)
+{
+    Uint8 *data = NULL;
+
+    if (!context) {
+        return SDL_InvalidParamError("context");
+    }
+
+    if (context->buffer.data && SDL_SyncRWBuffer(context) < 0) {
+        return -1;
+    }
+
+    if (size > 0) {
+        data = (Uint8 *)SDL_malloc(size);
+        if (!data) {
+            return -1;
+        }
+    }
+    SDL_free(context->buffer.data);
+    context->buffer.data = data;
+    context->buffer.size = size;
+    return 0;
+}
+
+int SDL_FlushRW(SDL_RWops *context)
+{
+    if (!context) {
+        return SDL_InvalidParamError("context");
+    }
+    if (!context->buffer.writing) {
+        return 0;
+    }
+    return SDL_SyncRWBuffer(context);
+}
+
 Sint64 SDL_RWsize(SDL_RWops *context)
 {
     if (!context) {
@@ -757,6 +1034,9 @@ Sint64 SDL_RWsize(SDL_RWops *context)
         SDL_RWseek(context, pos, SDL_RW_SEEK_SET);
         return size;
     }
+    if (context->buffer.writing && SDL_SyncRWBuffer(context) < 0) {
+        return -1;
+    }
     return context->size(context);
 }
 
@@ -768,6 +1048,33 @@ Sint64 SDL_RWseek(SDL_RWops *context, Sint64 offset, int whence)
     if (!context->seek) {
         return SDL_Unsupported();
     }
+    if (context->buffer.data) {
+        if (!context->buffer.writing && whence == SDL_RW_SEEK_CUR) {
+            /* Seeking within the data read ahead just moves the buffer position */
+            const size_t ahead = context->buffer.len - context->buffer.pos;
+            if ((offset >= 0 && (Uint64)offset <= ahead) || (offset < 0 && (Uint64)-offset <= context->buffer.pos)) {
+                Sint64 pos;
+
+                context->buffer.pos = (size_t)((Sint64)context->buffer.pos + offset);
+                pos = context->seek(context, 0, SDL_RW_SEEK_CUR);
+                if (pos < 0) {
+                    return pos;
+                }
+                return pos - (Sint64)(context->buffer.len - context->buffer.pos);
+            }
+            offset -= (Sint64)ahead;
+            context->buffer.pos = 0;
+            context->buffer.len = 0;
+        } else if (context->buffer.writing) {
+            if (SDL_SyncRWBuffer(context) < 0) {
+                return -1;
+            }
+        } else {
+            /* The read-ahead data can simply be dropped */
+            context->buffer.pos = 0;
+            context->buffer.len = 0;
+        }
+    }
     return context->seek(context, offset, whence);
 }
 
@@ -791,13 +1098,21 @@ size_t SDL_RWread(SDL_RWops *context, void *ptr, size_t size)
     }
 
     context->status = SDL_RWOPS_STATUS_READY;
-    SDL_ClearError();
 
-    if (size == 0) {
-        return 0;
-    }
+    if (context->buffer.data) {
+        if (size == 0) {
+            return 0;
+        }
+        bytes = SDL_ReadRWBuffer(context, ptr, size);
+    } else {
+        SDL_ClearError();
+
+        if (size == 0) {
+            return 0;
+        }
 
-    bytes = context->read(context, ptr, size);
+        bytes = context->read(context, ptr, size);
+    }
     if (bytes == 0 && context->status == SDL_RWOPS_STATUS_READY) {
         if (*SDL_GetError()) {
             context->status = SDL_RWOPS_STATUS_ERROR;
@@ -823,13 +1138,21 @@ size_t SDL_RWwrite(SDL_RWops *context, const void *ptr, size_t size)
     }
 
     context->status = SDL_RWOPS_STATUS_READY;
-    SDL_ClearError();
 
-    if (size == 0) {
-        return 0;
-    }
+    if (context->buffer.data) {
+        if (size == 0) {
+            return 0;
+        }
+        bytes = SDL_WriteRWBuffer(context, ptr, size);
+    } else {
+        SDL_ClearError();
 
-    bytes = context->write(context, ptr, size);
+        if (size == 0) {
+            return 0;
+        }
+
+        bytes = context->write(context, ptr, size);
+    }
     if (bytes == 0 && context->status == SDL_RWOPS_STATUS_READY) {
         context->status = SDL_RWOPS_STATUS_ERROR;
     }
@@ -873,14 +1196,22 @@ size_t SDL_RWvprintf(SDL_RWops *context, SDL_PRINTF_FORMAT_STRING const char *fm
 
 int SDL_RWclose(SDL_RWops *context)
 {
+    int result = 0;
+
     if (!context) {
         return SDL_InvalidParamError("context");
     }
+    if (context->buffer.writing) {
+        result = SDL_SyncRWBuffer(context);
+    }
     if (!context->close) {
         SDL_DestroyRW(context);
-        return 0;
+        return result;
     }
-    return context->close(context);
+    if (context->close(context) < 0) {
+        result = -1;
+    }
+    return result;
 }
 
 /* Functions for dynamically reading and writing endian-specific values */
@@ -890,7 +1221,7 @@ SDL_bool SDL_ReadU8(SDL_RWops *src, Uint8 *value)
     Uint8 data = 0;
     SDL_bool result = SDL_FALSE;
 
-    if (SDL_RWread(src, &data, sizeof(data)) == sizeof(data)) {
+    if (SDL_ReadRWExactly(src, &data, sizeof(data))) {
         result = SDL_TRUE;
     }
     if (value) {
@@ -904,7 +1235,7 @@ SDL_bool SDL_ReadU16LE(SDL_RWops *src, Uint16 *value)
     Uint16 data = 0;
     SDL_bool result = SDL_FALSE;
 
-    if (SDL_RWread(src, &data, sizeof(data)) == sizeof(data)) {
+    if (SDL_ReadRWExactly(src, &data, sizeof(data))) {
         result = SDL_TRUE;
     }
     if (value) {
@@ -923,7 +1254,7 @@ SDL_bool SDL_ReadU16BE(SDL_RWops *src, Uint16 *value)
     Uint16 data = 0;
     SDL_bool result = SDL_FALSE;
 
-    if (SDL_RWread(src, &data, sizeof(data)) == sizeof(data)) {
+    if (SDL_ReadRWExactly(src, &data, sizeof(data))) {
         result = SDL_TRUE;
     }
     if (value) {
@@ -942,7 +1273,7 @@ SDL_bool SDL_ReadU32LE(SDL_RWops *src, Uint32 *value)
     Uint32 data = 0;
     SDL_bool result = SDL_FALSE;
 
-    if (SDL_RWread(src, &data, sizeof(data)) == sizeof(data)) {
+    if (SDL_ReadRWExactly(src, &data, sizeof(data))) {
         result = SDL_TRUE;
     }
     if (value) {
@@ -961,7 +1292,7 @@ SDL_bool SDL_ReadU32BE(SDL_RWops *src, Uint32 *value)
     Uint32 data = 0;
     SDL_bool result = SDL_FALSE;
 
-    if (SDL_RWread(src, &data, sizeof(data)) == sizeof(data)) {
+    if (SDL_ReadRWExactly(src, &data, sizeof(data))) {
         result = SDL_TRUE;
     }
     if (value) {
@@ -980,7 +1311,7 @@ SDL_bool SDL_ReadU64LE(SDL_RWops *src, Uint64 *value)
     Uint64 data = 0;
     SDL_bool result = SDL_FALSE;
 
-    if (SDL_RWread(src, &data, sizeof(data)) == sizeof(data)) {
+    if (SDL_ReadRWExactly(src, &data, sizeof(data))) {
         result = SDL_TRUE;
     }
     if (value) {
@@ -999,7 +1330,7 @@ SDL_bool SDL_ReadU64BE(SDL_RWops *src, Uint64 *value)
     Uint64 data = 0;
     SDL_bool result = SDL_FALSE;
 
-    if (SDL_RWread(src, &data, sizeof(data)) == sizeof(data)) {
+    if (SDL_ReadRWExactly(src, &data, sizeof(data))) {
         result = SDL_TRUE;
     }
     if (value) {
@@ -1015,13 +1346,13 @@ SDL_bool SDL_ReadS64BE(SDL_RWops *src, Sint64 *value)
 
 SDL_bool SDL_WriteU8(SDL_RWops *dst, Uint8 value)
 {
-    return (SDL_RWwrite(dst, &value, sizeof(value)) == sizeof(value));
+    return SDL_WriteRWExactly(dst, &value, sizeof(value));
 }
 
 SDL_bool SDL_WriteU16LE(SDL_RWops *dst, Uint16 value)
 {
     const Uint16 swapped = SDL_SwapLE16(value);
-    return (SDL_RWwrite(dst, &swapped, sizeof(swapped)) == sizeof(swapped));
+    return SDL_WriteRWExactly(dst, &swapped, sizeof(swapped));
 }
 
 SDL_bool SDL_WriteS16LE(SDL_RWops *dst, Sint16 value)
@@ -1032,7 +1363,7 @@ SDL_bool SDL_WriteS16LE(SDL_RWops *dst, Sint16 value)
 SDL_bool SDL_WriteU16BE(SDL_RWops *dst, Uint16 value)
 {
     const Uint16 swapped = SDL_SwapBE16(value);
-    return (SDL_RWwrite(dst, &swapped, sizeof(swapped)) == sizeof(swapped));
+    return SDL_WriteRWExactly(dst, &swapped, sizeof(swapped));
 }
 
 SDL_bool SDL_WriteS16BE(SDL_RWops *dst, Sint16 value)
@@ -1043,7 +1374,7 @@ SDL_bool SDL_WriteS16BE(SDL_RWops *dst, Sint16 value)
 SDL_bool SDL_WriteU32LE(SDL_RWops *dst, Uint32 value)
 {
     const Uint32 swapped = SDL_SwapLE32(value);
-    return (SDL_RWwrite(dst, &swapped, sizeof(swapped)) == sizeof(swapped));
+    return SDL_WriteRWExactly(dst, &swapped, sizeof(swapped));
 }
 
 SDL_bool SDL_WriteS32LE(SDL_RWops *dst, Sint32 value)
@@ -1054,7 +1385,7 @@ SDL_bool SDL_WriteS32LE(SDL_RWops *dst, Sint32 value)
 SDL_bool SDL_WriteU32BE(SDL_RWops *dst, Uint32 value)
 {
     const Uint32 swapped = SDL_SwapBE32(value);
-    return (SDL_RWwrite(dst, &swapped, sizeof(swapped)) == sizeof(swapped));
+    return SDL_WriteRWExactly(dst, &swapped, sizeof(swapped));
 }
 
 SDL_bool SDL_WriteS32BE(SDL_RWops *dst, Sint32 value)
@@ -1065,7 +1396,7 @@ SDL_bool SDL_WriteS32BE(SDL_RWops *dst, Sint32 value)
 SDL_bool SDL_WriteU64LE(SDL_RWops *dst, Uint64 value)
 {
     const Uint64 swapped = SDL_SwapLE64(value);
-    return (SDL_RWwrite(dst, &swapped, sizeof(swapped)) == sizeof(swapped));
+    return SDL_WriteRWExactly(dst, &swapped, sizeof(swapped));
 }
 
 SDL_bool SDL_WriteS64LE(SDL_RWops *dst, Sint64 value)
@@ -1076,7 +1407,7 @@ SDL_bool SDL_WriteS64LE(SDL_RWops *dst, Sint64 value)
 SDL_bool SDL_WriteU64BE(SDL_RWops *dst, Uint64 value)
 {
     const Uint64 swapped = SDL_SwapBE64(value);
-    return (SDL_RWwrite(dst, &swapped, sizeof(swapped)) == sizeof(swapped));
+    return SDL_WriteRWExactly(dst, &swapped, sizeof(swapped));
 }
 
 SDL_bool SDL_WriteS64BE(SDL_RWops *dst, Sint64 value)
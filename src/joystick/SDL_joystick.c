@@ -3077,6 +3077,7 @@ static SDL_JoystickType SDL_GetJoystickGUIDType(SDL_JoystickGUID guid)
 
 SDL_bool SDL_ShouldIgnoreJoystick(const char *name, SDL_JoystickGUID guid)
 {
+    static SDL_CachedHintBoolean rog_chakram_hint;
     Uint16 vendor;
     Uint16 product;
 
@@ -3086,7 +3087,7 @@ SDL_bool SDL_ShouldIgnoreJoystick(const char *name, SDL_JoystickGUID guid)
     if (SDL_VIDPIDInList(vendor, product, &blacklist_devices)) {
         return SDL_TRUE;
     }
-    if (!SDL_GetHintBoolean(SDL_HINT_JOYSTICK_ROG_CHAKRAM, SDL_FALSE)) {
+    if (!SDL_GetCachedHintBoolean(SDL_HINT_JOYSTICK_ROG_CHAKRAM, SDL_FALSE, &rog_chakram_hint)) {
         if (SDL_VIDPIDInList(vendor, product, &rog_gamepad_mice)) {
             return SDL_TRUE;
         }
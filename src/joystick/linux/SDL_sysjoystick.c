@@ -41,6 +41,7 @@
 #include <dirent.h>
 #include <linux/joystick.h>
 
+#include "../../SDL_hints_c.h"
 #include "../../SDL_utils_c.h"
 #include "../../events/SDL_events_c.h"
 #include "../../core/linux/SDL_evdev.h"
@@ -1169,6 +1170,8 @@ static int allocate_hatdata(SDL_Joystick *joystick)
 
 static SDL_bool GuessIfAxesAreDigitalHat(struct input_absinfo *absinfo_x, struct input_absinfo *absinfo_y)
 {
+    static SDL_CachedHintBoolean digital_hats_hint;
+
     /* A "hat" is assumed to be a digital input with at most 9 possible states
      * (3 per axis: negative/zero/positive), as opposed to a true "axis" which
      * can report a continuous range of possible values. Unfortunately the Linux
@@ -1181,7 +1184,7 @@ static SDL_bool GuessIfAxesAreDigitalHat(struct input_absinfo *absinfo_x, struct
     }
 
     /* If the hint says so, treat all hats as digital. */
-    if (SDL_GetHintBoolean(SDL_HINT_JOYSTICK_LINUX_DIGITAL_HATS, SDL_FALSE)) {
+    if (SDL_GetCachedHintBoolean(SDL_HINT_JOYSTICK_LINUX_DIGITAL_HATS, SDL_FALSE, &digital_hats_hint)) {
         return SDL_TRUE;
     }
 
@@ -1201,14 +1204,16 @@ static SDL_bool GuessIfAxesAreDigitalHat(struct input_absinfo *absinfo_x, struct
 
 static void ConfigJoystick(SDL_Joystick *joystick, int fd, int fd_sensor)
 {
+    static SDL_CachedHintBoolean deadzones_hint;
+    static SDL_CachedHintBoolean hat_deadzones_hint;
     int i, t;
     unsigned long keybit[NBITS(KEY_MAX)] = { 0 };
     unsigned long absbit[NBITS(ABS_MAX)] = { 0 };
     unsigned long relbit[NBITS(REL_MAX)] = { 0 };
     unsigned long ffbit[NBITS(FF_MAX)] = { 0 };
     Uint8 key_pam_size, abs_pam_size;
-    SDL_bool use_deadzones = SDL_GetHintBoolean(SDL_HINT_JOYSTICK_LINUX_DEADZONES, SDL_FALSE);
-    SDL_bool use_hat_deadzones = SDL_GetHintBoolean(SDL_HINT_JOYSTICK_LINUX_HAT_DEADZONES, SDL_TRUE);
+    SDL_bool use_deadzones = SDL_GetCachedHintBoolean(SDL_HINT_JOYSTICK_LINUX_DEADZONES, SDL_FALSE, &deadzones_hint);
+    SDL_bool use_hat_deadzones = SDL_GetCachedHintBoolean(SDL_HINT_JOYSTICK_LINUX_HAT_DEADZONES, SDL_TRUE, &hat_deadzones_hint);
 
     SDL_AssertJoysticksLocked();
 
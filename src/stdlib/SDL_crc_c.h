@@ -0,0 +1,58 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL_crc_c_h_
+#define SDL_crc_c_h_
+
+#include "SDL_internal.h"
+
+/* Folding a bit-reflected CRC with 64-bit carry-less multiplication, as in
+   "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction"
+   (Intel, 2009). A polynomial of degree less than 32 is folded as if it were
+   multiplied up to degree 32, the CRC then ends up in the low bits.
+ */
+#if defined(SDL_SSE4_1_INTRINSICS)
+#define SDL_CRC_FOLD_PCLMUL 1
+#endif
+#if defined(SDL_NEON_INTRINSICS) && defined(__aarch64__) && (defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_AES))
+#define SDL_CRC_FOLD_PMULL 1
+#endif
+
+#if defined(SDL_CRC_FOLD_PCLMUL) || defined(SDL_CRC_FOLD_PMULL)
+#define SDL_HAVE_CRC_FOLD 1
+
+/* Folding only pays off for longer input, and needs at least 64 bytes. */
+#define SDL_CRC_FOLD_MIN_LENGTH 256
+
+typedef struct SDL_CRCFoldConstants
+{
+    Uint64 k1k2[2]; /* x^(4*128+32) mod P, x^(4*128-32) mod P */
+    Uint64 k3k4[2]; /* x^(128+32) mod P, x^(128-32) mod P */
+    Uint64 k5k0[2]; /* x^64 mod P, 0 */
+    Uint64 poly[2]; /* P, x^64 / P */
+} SDL_CRCFoldConstants;
+
+/* Updates the CRC register with len bytes of data, len being a multiple of 16
+   and at least 64. Only call this if SDL_HasCLMUL() returns SDL_TRUE. */
+extern Uint32 SDL_CRCFold(const SDL_CRCFoldConstants *k, Uint32 crc, const Uint8 *data, size_t len);
+#endif
+
+#endif /* SDL_crc_c_h_ */
@@ -19,6 +19,7 @@
   3. This notice may not be removed or altered from any source distribution.
 */
 #include "SDL_internal.h"
+#include "../SDL_hints_c.h"
 
 #if defined(SDL_PLATFORM_WIN32) || defined(SDL_PLATFORM_WINGDK)
 #include "../core/windows/SDL_windows.h"
@@ -37,7 +38,7 @@ static size_t SDL_envmemlen = 0;
 /* Put a variable into the environment */
 /* Note: Name may not contain a '=' character. (Reference: http://www.unix.com/man-page/Linux/3/setenv/) */
 #ifdef HAVE_SETENV
-int SDL_setenv(const char *name, const char *value, int overwrite)
+static int SDL_setenv_impl(const char *name, const char *value, int overwrite)
 {
     /* Input validation */
     if (!name || *name == '\0' || SDL_strchr(name, '=') != NULL || !value) {
@@ -47,7 +48,7 @@ int SDL_setenv(const char *name, const char *value, int overwrite)
     return setenv(name, value, overwrite);
 }
 #elif defined(SDL_PLATFORM_WIN32) || defined(SDL_PLATFORM_WINGDK)
-int SDL_setenv(const char *name, const char *value, int overwrite)
+static int SDL_setenv_impl(const char *name, const char *value, int overwrite)
 {
     /* Input validation */
     if (!name || *name == '\0' || SDL_strchr(name, '=') != NULL || !value) {
@@ -66,7 +67,7 @@ int SDL_setenv(const char *name, const char *value, int overwrite)
 }
 /* We have a real environment table, but no real setenv? Fake it w/ putenv. */
 #elif (defined(HAVE_GETENV) && defined(HAVE_PUTENV) && !defined(HAVE_SETENV))
-int SDL_setenv(const char *name, const char *value, int overwrite)
+static int SDL_setenv_impl(const char *name, const char *value, int overwrite)
 {
     size_t len;
     char *new_variable;
@@ -96,7 +97,7 @@ int SDL_setenv(const char *name, const char *value, int overwrite)
 }
 #else /* roll our own */
 static char **SDL_env = (char **)0;
-int SDL_setenv(const char *name, const char *value, int overwrite)
+static int SDL_setenv_impl(const char *name, const char *value, int overwrite)
 {
     int added;
     size_t len, i;
@@ -159,6 +160,23 @@ int SDL_setenv(const char *name, const char *value, int overwrite)
 }
 #endif
 
+/* Bumped whenever the environment is changed, so cached lookups know to refresh */
+static SDL_AtomicInt SDL_env_generation;
+
+int SDL_setenv(const char *name, const char *value, int overwrite)
+{
+    const int result = SDL_setenv_impl(name, value, overwrite);
+    if (result == 0) {
+        SDL_AtomicIncRef(&SDL_env_generation);
+    }
+    return result;
+}
+
+int SDL_GetEnvironmentGeneration(void)
+{
+    return SDL_AtomicGet(&SDL_env_generation);
+}
+
 /* Retrieve a variable named "name" from the environment */
 #ifdef HAVE_GETENV
 char *SDL_getenv(const char *name)
@@ -225,6 +225,411 @@ SDL_iconv_t SDL_iconv_open(const char *tocode, const char *fromcode)
     return (SDL_iconv_t)-1;
 }
 
+/* Fast paths between UTF-8 and UTF-16 or UTF-32, the conversions SDL itself
+   does most. They convert well-formed text in bulk, runs of ASCII a block at
+   a time, and stop at anything that has to go through the generic code in
+   SDL_iconv(): malformed or incomplete input, characters that would be
+   replaced, and output that doesn't fit. So the results are the same as
+   converting one character at a time.
+*/
+static SDL_bool SDL_iconv_IsWideFormat(int format)
+{
+    switch (format) {
+    case ENCODING_UTF16BE:
+    case ENCODING_UTF16LE:
+    case ENCODING_UTF32BE:
+    case ENCODING_UTF32LE:
+    case ENCODING_UCS4BE:
+    case ENCODING_UCS4LE:
+        return SDL_TRUE;
+    default:
+        return SDL_FALSE;
+    }
+}
+
+#ifdef SDL_SSE2_INTRINSICS
+/* Widens ASCII to 16 or 32-bit units, 16 characters at a time, up to the first
+   block that has a non-ASCII byte. Returns the number of characters done. */
+static size_t SDL_TARGETING("sse2") SDL_iconv_WidenASCII_SSE2(const Uint8 *src, Uint8 *dst, size_t len, int unitsize, SDL_bool bigendian)
+{
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+
+    while (len - i >= 16) {
+        const __m128i x = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i lo, hi;
+
+        if (_mm_movemask_epi8(x) != 0) {
+            break;
+        }
+        if (bigendian) {
+            lo = _mm_unpacklo_epi8(zero, x);
+            hi = _mm_unpackhi_epi8(zero, x);
+        } else {
+            lo = _mm_unpacklo_epi8(x, zero);
+            hi = _mm_unpackhi_epi8(x, zero);
+        }
+        if (unitsize == 2) {
+            _mm_storeu_si128((__m128i *)(dst + i * 2), lo);
+            _mm_storeu_si128((__m128i *)(dst + i * 2 + 16), hi);
+        } else if (bigendian) {
+            _mm_storeu_si128((__m128i *)(dst + i * 4), _mm_unpacklo_epi16(zero, lo));
+            _mm_storeu_si128((__m128i *)(dst + i * 4 + 16), _mm_unpackhi_epi16(zero, lo));
+            _mm_storeu_si128((__m128i *)(dst + i * 4 + 32), _mm_unpacklo_epi16(zero, hi));
+            _mm_storeu_si128((__m128i *)(dst + i * 4 + 48), _mm_unpackhi_epi16(zero, hi));
+        } else {
+            _mm_storeu_si128((__m128i *)(dst + i * 4), _mm_unpacklo_epi16(lo, zero));
+            _mm_storeu_si128((__m128i *)(dst + i * 4 + 16), _mm_unpackhi_epi16(lo, zero));
+            _mm_storeu_si128((__m128i *)(dst + i * 4 + 32), _mm_unpacklo_epi16(hi, zero));
+            _mm_storeu_si128((__m128i *)(dst + i * 4 + 48), _mm_unpackhi_epi16(hi, zero));
+        }
+        i += 16;
+    }
+    return i;
+}
+
+/* Narrows 16 or 32-bit units to ASCII, 16 characters at a time, up to the
+   first block that has a non-ASCII character. Returns the number done. */
+static size_t SDL_TARGETING("sse2") SDL_iconv_NarrowASCII_SSE2(const Uint8 *src, Uint8 *dst, size_t len, int unitsize, SDL_bool bigendian)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i mask = (unitsize == 2) ? _mm_set1_epi16(bigendian ? (short)0x80FF : (short)0xFF80)
+                                         : _mm_set1_epi32(bigendian ? (int)0x80FFFFFF : (int)0xFFFFFF80);
+    size_t i = 0;
+
+    while (len - i >= 16) {
+        const __m128i *p = (const __m128i *)(src + i * unitsize);
+        __m128i x[4], bits;
+        int n;
+
+        bits = zero;
+        for (n = 0; n < unitsize; ++n) {
+            x[n] = _mm_loadu_si128(p + n);
+            bits = _mm_or_si128(bits, _mm_and_si128(x[n], mask));
+        }
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(bits, zero)) != 0xFFFF) {
+            break;
+        }
+        if (unitsize == 2) {
+            if (bigendian) {
+                x[0] = _mm_srli_epi16(x[0], 8);
+                x[1] = _mm_srli_epi16(x[1], 8);
+            }
+        } else {
+            if (bigendian) {
+                for (n = 0; n < 4; ++n) {
+                    x[n] = _mm_srli_epi32(x[n], 24);
+                }
+            }
+            x[0] = _mm_packs_epi32(x[0], x[1]);
+            x[1] = _mm_packs_epi32(x[2], x[3]);
+        }
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_packus_epi16(x[0], x[1]));
+        i += 16;
+    }
+    return i;
+}
+#endif /* SDL_SSE2_INTRINSICS */
+
+#ifdef SDL_NEON_INTRINSICS
+static SDL_bool SDL_iconv_IsZero_NEON(uint8x16_t x)
+{
+    const uint64x2_t v = vreinterpretq_u64_u8(x);
+    return (vgetq_lane_u64(v, 0) | vgetq_lane_u64(v, 1)) == 0;
+}
+
+/* Interleaves zero bytes with the ASCII using the structured stores. */
+static size_t SDL_iconv_WidenASCII_NEON(const Uint8 *src, Uint8 *dst, size_t len, int unitsize, SDL_bool bigendian)
+{
+    const uint8x16_t zero = vdupq_n_u8(0);
+    const uint8x16_t high = vdupq_n_u8(0x80);
+    size_t i = 0;
+
+    while (len - i >= 16) {
+        const uint8x16_t x = vld1q_u8(src + i);
+
+        if (!SDL_iconv_IsZero_NEON(vandq_u8(x, high))) {
+            break;
+        }
+        if (unitsize == 2) {
+            uint8x16x2_t out;
+            out.val[0] = bigendian ? zero : x;
+            out.val[1] = bigendian ? x : zero;
+            vst2q_u8(dst + i * 2, out);
+        } else {
+            uint8x16x4_t out;
+            out.val[0] = bigendian ? zero : x;
+            out.val[1] = zero;
+            out.val[2] = zero;
+            out.val[3] = bigendian ? x : zero;
+            vst4q_u8(dst + i * 4, out);
+        }
+        i += 16;
+    }
+    return i;
+}
+
+/* De-interleaves the units into byte planes, the ASCII is in one of them. */
+static size_t SDL_iconv_NarrowASCII_NEON(const Uint8 *src, Uint8 *dst, size_t len, int unitsize, SDL_bool bigendian)
+{
+    const uint8x16_t high = vdupq_n_u8(0x80);
+    size_t i = 0;
+
+    while (len - i >= 16) {
+        uint8x16_t x, bits;
+
+        if (unitsize == 2) {
+            const uint8x16x2_t in = vld2q_u8(src + i * 2);
+            x = in.val[bigendian ? 1 : 0];
+            bits = in.val[bigendian ? 0 : 1];
+        } else {
+            const uint8x16x4_t in = vld4q_u8(src + i * 4);
+            x = in.val[bigendian ? 3 : 0];
+            bits = vorrq_u8(vorrq_u8(in.val[1], in.val[2]), in.val[bigendian ? 0 : 3]);
+        }
+        if (!SDL_iconv_IsZero_NEON(vorrq_u8(bits, vandq_u8(x, high)))) {
+            break;
+        }
+        vst1q_u8(dst + i, x);
+        i += 16;
+    }
+    return i;
+}
+#endif /* SDL_NEON_INTRINSICS */
+
+static size_t SDL_iconv_WidenASCII(const Uint8 *src, Uint8 *dst, size_t len, int unitsize, SDL_bool bigendian)
+{
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        return SDL_iconv_WidenASCII_SSE2(src, dst, len, unitsize, bigendian);
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        return SDL_iconv_WidenASCII_NEON(src, dst, len, unitsize, bigendian);
+    }
+#endif
+    return 0;
+}
+
+static size_t SDL_iconv_NarrowASCII(const Uint8 *src, Uint8 *dst, size_t len, int unitsize, SDL_bool bigendian)
+{
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        return SDL_iconv_NarrowASCII_SSE2(src, dst, len, unitsize, bigendian);
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        return SDL_iconv_NarrowASCII_NEON(src, dst, len, unitsize, bigendian);
+    }
+#endif
+    return 0;
+}
+
+static Uint32 SDL_iconv_GetUnit(const Uint8 *p, int unitsize, SDL_bool bigendian)
+{
+    if (unitsize == 2) {
+        return bigendian ? (((Uint32)p[0] << 8) | p[1]) : (((Uint32)p[1] << 8) | p[0]);
+    }
+    if (bigendian) {
+        return ((Uint32)p[0] << 24) | ((Uint32)p[1] << 16) | ((Uint32)p[2] << 8) | p[3];
+    }
+    return ((Uint32)p[3] << 24) | ((Uint32)p[2] << 16) | ((Uint32)p[1] << 8) | p[0];
+}
+
+static void SDL_iconv_PutUnit(Uint8 *p, Uint32 unit, int unitsize, SDL_bool bigendian)
+{
+    int i;
+
+    for (i = 0; i < unitsize; ++i) {
+        p[bigendian ? (unitsize - 1 - i) : i] = (Uint8)(unit >> (i * 8));
+    }
+}
+
+static size_t SDL_iconv_UTF8ToWide(const char **inbuf, size_t *inbytesleft, char **outbuf, size_t *outbytesleft, int unitsize, SDL_bool bigendian)
+{
+    const Uint8 *src = (const Uint8 *)*inbuf;
+    Uint8 *dst = (Uint8 *)*outbuf;
+    size_t srclen = *inbytesleft;
+    size_t dstlen = *outbytesleft;
+    size_t total = 0;
+
+    while (srclen > 0) {
+        const Uint8 c = src[0];
+        Uint32 ch;
+        size_t len;
+
+        if (c < 0x80) {
+            /* Convert the ASCII this starts, if there's a block of it */
+            const size_t n = SDL_iconv_WidenASCII(src, dst, SDL_min(srclen, dstlen / unitsize), unitsize, bigendian);
+            if (n > 0) {
+                src += n;
+                srclen -= n;
+                dst += n * unitsize;
+                dstlen -= n * unitsize;
+                total += n;
+                continue;
+            }
+            ch = c;
+            len = 1;
+        } else if (c >= 0xC2 && c <= 0xDF) {
+            if (srclen < 2 || (src[1] & 0xC0) != 0x80) {
+                break;
+            }
+            ch = ((Uint32)(c & 0x1F) << 6) | (src[1] & 0x3F);
+            len = 2;
+        } else if (c >= 0xE0 && c <= 0xEF) {
+            if (srclen < 3 || (src[1] & 0xC0) != 0x80 || (src[2] & 0xC0) != 0x80) {
+                break;
+            }
+            ch = ((Uint32)(c & 0x0F) << 12) | ((Uint32)(src[1] & 0x3F) << 6) | (src[2] & 0x3F);
+            if (ch < 0x800 || (ch >= 0xD800 && ch <= 0xDFFF) || ch == 0xFFFE || ch == 0xFFFF) {
+                break;
+            }
+            len = 3;
+        } else if (c >= 0xF0 && c <= 0xF4) {
+            if (srclen < 4 || (src[1] & 0xC0) != 0x80 || (src[2] & 0xC0) != 0x80 || (src[3] & 0xC0) != 0x80) {
+                break;
+            }
+            ch = ((Uint32)(c & 0x07) << 18) | ((Uint32)(src[1] & 0x3F) << 12) | ((Uint32)(src[2] & 0x3F) << 6) | (src[3] & 0x3F);
+            if (ch < 0x10000 || ch > 0x10FFFF) {
+                break;
+            }
+            len = 4;
+        } else {
+            break;
+        }
+
+        if (unitsize == 2 && ch >= 0x10000) {
+            if (dstlen < 4) {
+                break;
+            }
+            ch -= 0x10000;
+            SDL_iconv_PutUnit(dst, 0xD800 | (ch >> 10), 2, bigendian);
+            SDL_iconv_PutUnit(dst + 2, 0xDC00 | (ch & 0x3FF), 2, bigendian);
+            dst += 4;
+            dstlen -= 4;
+        } else {
+            if (dstlen < (size_t)unitsize) {
+                break;
+            }
+            SDL_iconv_PutUnit(dst, ch, unitsize, bigendian);
+            dst += unitsize;
+            dstlen -= unitsize;
+        }
+        src += len;
+        srclen -= len;
+        ++total;
+    }
+
+    *inbuf = (const char *)src;
+    *inbytesleft = srclen;
+    *outbuf = (char *)dst;
+    *outbytesleft = dstlen;
+    return total;
+}
+
+static size_t SDL_iconv_WideToUTF8(const char **inbuf, size_t *inbytesleft, char **outbuf, size_t *outbytesleft, int unitsize, SDL_bool bigendian)
+{
+    const Uint8 *src = (const Uint8 *)*inbuf;
+    Uint8 *dst = (Uint8 *)*outbuf;
+    size_t srclen = *inbytesleft;
+    size_t dstlen = *outbytesleft;
+    size_t total = 0;
+
+    while (srclen >= (size_t)unitsize) {
+        Uint32 ch = SDL_iconv_GetUnit(src, unitsize, bigendian);
+        size_t len = unitsize;
+
+        if (ch < 0x80) {
+            /* Convert the ASCII this starts, if there's a block of it */
+            const size_t n = SDL_iconv_NarrowASCII(src, dst, SDL_min(srclen / unitsize, dstlen), unitsize, bigendian);
+            if (n > 0) {
+                src += n * unitsize;
+                srclen -= n * unitsize;
+                dst += n;
+                dstlen -= n;
+                total += n;
+                continue;
+            }
+        } else if (unitsize == 2 && ch >= 0xD800 && ch <= 0xDFFF) {
+            Uint32 W2;
+            if (ch > 0xDBFF || srclen < 4) {
+                break;
+            }
+            W2 = SDL_iconv_GetUnit(src + 2, 2, bigendian);
+            if (W2 < 0xDC00 || W2 > 0xDFFF) {
+                break;
+            }
+            ch = (((ch & 0x3FF) << 10) | (W2 & 0x3FF)) + 0x10000;
+            len = 4;
+        } else if (ch > 0x10FFFF) {
+            break;
+        }
+
+        if (ch <= 0x7F) {
+            if (dstlen < 1) {
+                break;
+            }
+            dst[0] = (Uint8)ch;
+            dst += 1;
+            dstlen -= 1;
+        } else if (ch <= 0x7FF) {
+            if (dstlen < 2) {
+                break;
+            }
+            dst[0] = 0xC0 | (Uint8)(ch >> 6);
+            dst[1] = 0x80 | (Uint8)(ch & 0x3F);
+            dst += 2;
+            dstlen -= 2;
+        } else if (ch <= 0xFFFF) {
+            if (dstlen < 3) {
+                break;
+            }
+            dst[0] = 0xE0 | (Uint8)(ch >> 12);
+            dst[1] = 0x80 | (Uint8)((ch >> 6) & 0x3F);
+            dst[2] = 0x80 | (Uint8)(ch & 0x3F);
+            dst += 3;
+            dstlen -= 3;
+        } else {
+            if (dstlen < 4) {
+                break;
+            }
+            dst[0] = 0xF0 | (Uint8)(ch >> 18);
+            dst[1] = 0x80 | (Uint8)((ch >> 12) & 0x3F);
+            dst[2] = 0x80 | (Uint8)((ch >> 6) & 0x3F);
+            dst[3] = 0x80 | (Uint8)(ch & 0x3F);
+            dst += 4;
+            dstlen -= 4;
+        }
+        src += len;
+        srclen -= len;
+        ++total;
+    }
+
+    *inbuf = (const char *)src;
+    *inbytesleft = srclen;
+    *outbuf = (char *)dst;
+    *outbytesleft = dstlen;
+    return total;
+}
+
+/* Returns the number of characters converted, 0 if the generic code has to
+   deal with the next one. */
+static size_t SDL_iconv_Fast(int src_fmt, int dst_fmt, const char **inbuf, size_t *inbytesleft, char **outbuf, size_t *outbytesleft)
+{
+    const int wide_fmt = (src_fmt == ENCODING_UTF8) ? dst_fmt : src_fmt;
+    const int unitsize = (wide_fmt == ENCODING_UTF16BE || wide_fmt == ENCODING_UTF16LE) ? 2 : 4;
+    const SDL_bool bigendian = (wide_fmt == ENCODING_UTF16BE || wide_fmt == ENCODING_UTF32BE || wide_fmt == ENCODING_UCS4BE);
+
+    if (src_fmt == ENCODING_UTF8) {
+        return SDL_iconv_UTF8ToWide(inbuf, inbytesleft, outbuf, outbytesleft, unitsize, bigendian);
+    } else {
+        return SDL_iconv_WideToUTF8(inbuf, inbytesleft, outbuf, outbytesleft, unitsize, bigendian);
+    }
+}
+
 size_t SDL_iconv(SDL_iconv_t cd,
           const char **inbuf, size_t *inbytesleft,
           char **outbuf, size_t *outbytesleft)
@@ -235,6 +640,7 @@ size_t SDL_iconv(SDL_iconv_t cd,
     size_t srclen, dstlen;
     Uint32 ch = 0;
     size_t total;
+    SDL_bool fastpath;
 
     if (!inbuf || !*inbuf) {
         /* Reset the context */
@@ -320,8 +726,23 @@ size_t SDL_iconv(SDL_iconv_t cd,
         break;
     }
 
+    fastpath = (cd->src_fmt == ENCODING_UTF8 && SDL_iconv_IsWideFormat(cd->dst_fmt)) ||
+               (cd->dst_fmt == ENCODING_UTF8 && SDL_iconv_IsWideFormat(cd->src_fmt));
+
     total = 0;
     while (srclen > 0) {
+        if (fastpath) {
+            const size_t count = SDL_iconv_Fast(cd->src_fmt, cd->dst_fmt, &src, &srclen, &dst, &dstlen);
+            if (count > 0) {
+                *inbuf = src;
+                *inbytesleft = srclen;
+                *outbuf = dst;
+                *outbytesleft = dstlen;
+                total += count;
+                continue;
+            }
+        }
+
         /* Decode a character */
         switch (cd->src_fmt) {
         case ENCODING_ASCII:
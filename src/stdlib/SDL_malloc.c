@@ -19,6 +19,7 @@
   3. This notice may not be removed or altered from any source distribution.
 */
 #include "SDL_internal.h"
+#include "../thread/SDL_thread_c.h"
 
 /* This file contains portable memory management functions for SDL */
 
@@ -5189,12 +5190,466 @@ static void* SDLCALL real_malloc(size_t s) { return malloc(s); }
 static void* SDLCALL real_calloc(size_t n, size_t s) { return calloc(n, s); }
 static void* SDLCALL real_realloc(void *p, size_t s) { return realloc(p,s); }
 static void  SDLCALL real_free(void *p) { free(p); }
+
+void SDL_EnableMallocThreadCache(void)
+{
+}
+#else
+/* dlmalloc takes a global lock for every call, so each thread keeps freed
+   blocks in a cache of size class free lists, and reuses them without
+   touching the heap. A thread's cache is returned to the heap when it
+   grows too large, when blocks sit unused for a while, and when the thread
+   exits. The statistics for SDL_GetMemoryStats() are gathered here too.
+
+   Nothing here may call back into SDL functions that can allocate or wait,
+   so the shared state is only updated with atomics, and the list of caches
+   only ever grows: a cache left behind by an exiting thread is adopted by
+   the next thread that needs one.
+ */
+
+#if !defined(SDL_THREADS_DISABLED) && !defined(SDL_DISABLE_MALLOC_THREAD_CACHE)
+#ifdef _MSC_VER
+#define SDL_MALLOC_THREAD_LOCAL __declspec(thread)
+#elif defined(__GNUC__)
+#define SDL_MALLOC_THREAD_LOCAL __thread
+#endif
+#endif
+
+/* Four size classes for every power of two, from 16 bytes up to 32K */
+#define SDL_MALLOC_CACHE_CLASSES     40
+#define SDL_MALLOC_CACHE_MIN_SIZE    16
+#define SDL_MALLOC_CACHE_MAX_SIZE    32768
+
+/* The most a thread will cache before giving half of it back */
+#define SDL_MALLOC_CACHE_LIMIT       (256 * 1024)
+
+/* How many frees between passes that give back blocks nobody asked for */
+#define SDL_MALLOC_CACHE_TRIM_PERIOD 4096
+
+typedef struct SDL_MallocCacheBin
+{
+    void *blocks;     /* free list, linked through the first word of each block */
+    Uint32 count;
+    Uint32 low_water; /* the fewest blocks in the list since the last trim */
+} SDL_MallocCacheBin;
+
+/* Only the owning thread writes to a cache, SDL_GetMemoryStats() just adds up the counts */
+typedef struct SDL_MallocCache
+{
+    SDL_MallocCacheBin bins[SDL_MALLOC_CACHE_CLASSES];
+    size_t cached_bytes;
+    Uint32 frees_until_trim;
+    Uint64 num_allocations;
+    Uint64 num_frees;
+    Uint64 num_cache_hits;
+    Uint64 allocations_by_size[SDL_NUM_MEMORY_SIZE_CLASSES];
+    SDL_AtomicInt owned;   /* 0 after its thread exited, until another thread adopts it */
+    struct SDL_MallocCache *next;
+} SDL_MallocCache;
+
+/* The heap totals, the counts from threads without a cache, and the list of
+   caches so their counts can be added up. The byte counts are size_t values
+   kept in pointers, so they can be updated with pointer compare-and-swap. */
+static struct
+{
+    void *heap_bytes;
+    void *peak_heap_bytes;
+    SDL_AtomicInt num_allocations;
+    SDL_AtomicInt num_frees;
+    SDL_AtomicInt allocations_by_size[SDL_NUM_MEMORY_SIZE_CLASSES];
+    SDL_MallocCache *caches;
+} s_heap;
+
+static int GetMemorySizeClass(size_t size)
+{
+    int index;
+
+    if (size <= 16) {
+        return 0;
+    }
+    if (size > ((size_t)16 << (SDL_NUM_MEMORY_SIZE_CLASSES - 2))) {
+        return SDL_NUM_MEMORY_SIZE_CLASSES - 1;
+    }
+    index = SDL_MostSignificantBitIndex32((Uint32)(size - 1)) - 3;
+    return index;
+}
+
+static void UpdateHeapBytes(size_t added, size_t removed)
+{
+    void *old_value;
+    size_t bytes;
+
+    do {
+        old_value = SDL_AtomicGetPtr(&s_heap.heap_bytes);
+        bytes = (size_t)old_value + added - removed;
+    } while (!SDL_AtomicCompareAndSwapPointer(&s_heap.heap_bytes, old_value, (void *)bytes));
+
+    if (added > removed) {
+        do {
+            old_value = SDL_AtomicGetPtr(&s_heap.peak_heap_bytes);
+            if ((size_t)old_value >= bytes) {
+                break;
+            }
+        } while (!SDL_AtomicCompareAndSwapPointer(&s_heap.peak_heap_bytes, old_value, (void *)bytes));
+    }
+}
+
+/* Adds a block just taken from the heap to the totals */
+static void *TrackHeapAlloc(void *mem)
+{
+    if (mem) {
+        UpdateHeapBytes(dlmalloc_usable_size(mem), 0);
+    }
+    return mem;
+}
+
+static void HeapFree(void *mem)
+{
+    const size_t usable = dlmalloc_usable_size(mem);
+    dlfree(mem);
+    UpdateHeapBytes(0, usable);
+}
+
+static void CountAllocation(SDL_MallocCache *cache, size_t size)
+{
+    const int size_class = GetMemorySizeClass(size);
+    if (cache) {
+        ++cache->num_allocations;
+        ++cache->allocations_by_size[size_class];
+    } else {
+        SDL_AtomicIncRef(&s_heap.num_allocations);
+        SDL_AtomicIncRef(&s_heap.allocations_by_size[size_class]);
+    }
+}
+
+static void CountFree(SDL_MallocCache *cache)
+{
+    if (cache) {
+        ++cache->num_frees;
+    } else {
+        SDL_AtomicIncRef(&s_heap.num_frees);
+    }
+}
+
+#ifdef SDL_MALLOC_THREAD_LOCAL
+typedef enum SDL_MallocCacheState
+{
+    SDL_MALLOC_CACHE_DISABLED, /* the thread may never clean up its TLS */
+    SDL_MALLOC_CACHE_ENABLED,
+    SDL_MALLOC_CACHE_EXITING   /* the cache was destroyed, don't make another one */
+} SDL_MallocCacheState;
+
+static SDL_MALLOC_THREAD_LOCAL SDL_MallocCache *thread_cache;
+static SDL_MALLOC_THREAD_LOCAL SDL_MallocCacheState thread_cache_state;
+static SDL_MALLOC_THREAD_LOCAL SDL_bool thread_cache_busy;
+
+/* Returns the smallest size class that fits size */
+static int GetCacheClass(size_t size)
+{
+    int bits;
+
+    if (size <= 64) {
+        return (size <= SDL_MALLOC_CACHE_MIN_SIZE) ? 0 : (int)((size - 1) / 16);
+    }
+    --size;
+    bits = SDL_MostSignificantBitIndex32((Uint32)size);
+    return 4 + (bits - 6) * 4 + (int)((size >> (bits - 2)) & 3);
+}
+
+static size_t GetCacheClassSize(int size_class)
+{
+    if (size_class < 4) {
+        return (size_t)16 * (size_class + 1);
+    }
+    size_class -= 4;
+    return (size_t)(5 + (size_class & 3)) << ((size_class >> 2) + 4);
+}
+
+/* Frees all but the first keep blocks in a bin */
+static void ReleaseCacheBlocks(SDL_MallocCache *cache, SDL_MallocCacheBin *bin, Uint32 keep)
+{
+    void **link = &bin->blocks;
+    void *block;
+    size_t released = 0;
+    Uint32 i;
+
+    for (i = 0; i < keep; ++i) {
+        link = (void **)*link;
+    }
+    block = *link;
+    *link = NULL;
+    bin->count = keep;
+    if (bin->low_water > keep) {
+        bin->low_water = keep;
+    }
+
+    while (block) {
+        void *next = *(void **)block;
+        const size_t usable = dlmalloc_usable_size(block);
+        dlfree(block);
+        released += usable;
+        block = next;
+    }
+
+    cache->cached_bytes -= released;
+    UpdateHeapBytes(0, released);
+}
+
+/* Gives back the blocks that weren't used since the last trim */
+static void TrimCache(SDL_MallocCache *cache)
+{
+    int i;
+
+    for (i = 0; i < SDL_MALLOC_CACHE_CLASSES; ++i) {
+        SDL_MallocCacheBin *bin = &cache->bins[i];
+        if (bin->low_water) {
+            ReleaseCacheBlocks(cache, bin, bin->count - bin->low_water);
+        }
+        bin->low_water = bin->count;
+    }
+    cache->frees_until_trim = SDL_MALLOC_CACHE_TRIM_PERIOD;
+}
+
+/* Gives back the largest blocks until the cache is at half its limit */
+static void ShrinkCache(SDL_MallocCache *cache)
+{
+    int i;
+
+    for (i = SDL_MALLOC_CACHE_CLASSES - 1; i >= 0 && cache->cached_bytes > SDL_MALLOC_CACHE_LIMIT / 2; --i) {
+        SDL_MallocCacheBin *bin = &cache->bins[i];
+        if (bin->count) {
+            const size_t excess = cache->cached_bytes - SDL_MALLOC_CACHE_LIMIT / 2;
+            const Uint32 release = (Uint32)SDL_min(bin->count, excess / GetCacheClassSize(i) + 1);
+            ReleaseCacheBlocks(cache, bin, bin->count - release);
+        }
+    }
+}
+
+static void SDLCALL DestroyThreadCache(void *data)
+{
+    SDL_MallocCache *cache = (SDL_MallocCache *)data;
+    int i;
+
+    /* TLS destructors that run after this one may still allocate, they
+       must not create a cache that nothing would ever clean up. */
+    if (cache == thread_cache) {
+        thread_cache = NULL;
+        thread_cache_state = SDL_MALLOC_CACHE_EXITING;
+    }
+
+    for (i = 0; i < SDL_MALLOC_CACHE_CLASSES; ++i) {
+        ReleaseCacheBlocks(cache, &cache->bins[i], 0);
+    }
+    cache->frees_until_trim = SDL_MALLOC_CACHE_TRIM_PERIOD;
+
+    /* The counts stay in the cache, so they are still part of the totals */
+    SDL_AtomicSet(&cache->owned, 0);
+}
+
+/* Takes over a cache left behind by a thread that exited, or makes a new one */
+static SDL_MallocCache *AcquireCache(void)
+{
+    SDL_MallocCache *cache;
+    SDL_MallocCache *head;
+
+    for (cache = (SDL_MallocCache *)SDL_AtomicGetPtr((void **)&s_heap.caches); cache; cache = cache->next) {
+        if (SDL_AtomicGet(&cache->owned) == 0 && SDL_AtomicCompareAndSwap(&cache->owned, 0, 1)) {
+            return cache;
+        }
+    }
+
+    cache = (SDL_MallocCache *)dlcalloc(1, sizeof(*cache));
+    if (!cache) {
+        return NULL;
+    }
+    cache->frees_until_trim = SDL_MALLOC_CACHE_TRIM_PERIOD;
+    SDL_AtomicSet(&cache->owned, 1);
+    do {
+        head = (SDL_MallocCache *)SDL_AtomicGetPtr((void **)&s_heap.caches);
+        cache->next = head;
+    } while (!SDL_AtomicCompareAndSwapPointer((void **)&s_heap.caches, head, cache));
+
+    return cache;
+}
+
+/* Returns the cache for this thread, creating it if needed */
+static SDL_MallocCache *GetThreadCache(void)
+{
+    static SDL_AtomicInt tls_id;
+    SDL_MallocCache *cache = thread_cache;
+    int id;
+
+    if (cache || thread_cache_busy || thread_cache_state != SDL_MALLOC_CACHE_ENABLED) {
+        return cache;
+    }
+
+    /* Setting up thread-local storage can allocate, which has to skip the cache */
+    thread_cache_busy = SDL_TRUE;
+
+    id = SDL_AtomicGet(&tls_id);
+    if (!id) {
+        SDL_AtomicCompareAndSwap(&tls_id, 0, (int)SDL_CreateTLS());
+        id = SDL_AtomicGet(&tls_id);
+    }
+
+    cache = AcquireCache();
+    if (cache) {
+        if (SDL_SetTLS((SDL_TLSID)id, cache, DestroyThreadCache) == 0) {
+            thread_cache = cache;
+        } else {
+            SDL_AtomicSet(&cache->owned, 0);
+            cache = NULL;
+        }
+    }
+
+    thread_cache_busy = SDL_FALSE;
+    return cache;
+}
+
+void SDL_EnableMallocThreadCache(void)
+{
+    if (thread_cache_state == SDL_MALLOC_CACHE_DISABLED) {
+        thread_cache_state = SDL_MALLOC_CACHE_ENABLED;
+    }
+}
+
+static void *CachedMalloc(SDL_MallocCache *cache, size_t size)
+{
+    const int size_class = GetCacheClass(size);
+    SDL_MallocCacheBin *bin = &cache->bins[size_class];
+    void *mem = bin->blocks;
+
+    if (mem) {
+        bin->blocks = *(void **)mem;
+        if (--bin->count < bin->low_water) {
+            bin->low_water = bin->count;
+        }
+        cache->cached_bytes -= dlmalloc_usable_size(mem);
+        ++cache->num_cache_hits;
+        return mem;
+    }
+
+    /* Allocate the whole size class, so the block can be reused for it */
+    return TrackHeapAlloc(dlmalloc(GetCacheClassSize(size_class)));
+}
+
+static SDL_bool CachedFree(SDL_MallocCache *cache, void *mem)
+{
+    const size_t usable = dlmalloc_usable_size(mem);
+    SDL_MallocCacheBin *bin;
+    int size_class;
+
+    /* Blocks go in the largest class they can hold, which is the class
+       they were allocated for if they came from the cache. */
+    if (usable < SDL_MALLOC_CACHE_MIN_SIZE || usable >= SDL_MALLOC_CACHE_MAX_SIZE + SDL_MALLOC_CACHE_MAX_SIZE / 4) {
+        return SDL_FALSE;
+    }
+    size_class = GetCacheClass(usable);
+    if (GetCacheClassSize(size_class) > usable) {
+        --size_class;
+    }
+
+    bin = &cache->bins[size_class];
+    *(void **)mem = bin->blocks;
+    bin->blocks = mem;
+    ++bin->count;
+    cache->cached_bytes += usable;
+
+    if (cache->cached_bytes > SDL_MALLOC_CACHE_LIMIT) {
+        ShrinkCache(cache);
+    }
+    if (--cache->frees_until_trim == 0) {
+        TrimCache(cache);
+    }
+    return SDL_TRUE;
+}
 #else
-#define real_malloc dlmalloc
-#define real_calloc dlcalloc
-#define real_realloc dlrealloc
-#define real_free dlfree
+
+void SDL_EnableMallocThreadCache(void)
+{
+}
+#endif /* SDL_MALLOC_THREAD_LOCAL */
+
+static void *SDLCALL builtin_malloc(size_t size)
+{
+    SDL_MallocCache *cache = NULL;
+
+#ifdef SDL_MALLOC_THREAD_LOCAL
+    cache = GetThreadCache();
+    if (cache && size <= SDL_MALLOC_CACHE_MAX_SIZE) {
+        CountAllocation(cache, size);
+        return CachedMalloc(cache, size);
+    }
 #endif
+    CountAllocation(cache, size);
+    return TrackHeapAlloc(dlmalloc(size));
+}
+
+static void *SDLCALL builtin_calloc(size_t n, size_t size)
+{
+    SDL_MallocCache *cache = NULL;
+    size_t total;
+
+    if (SDL_size_mul_overflow(n, size, &total) != 0) {
+        return NULL;
+    }
+
+#ifdef SDL_MALLOC_THREAD_LOCAL
+    cache = GetThreadCache();
+    if (cache && total <= SDL_MALLOC_CACHE_MAX_SIZE) {
+        void *mem;
+
+        CountAllocation(cache, total);
+        mem = CachedMalloc(cache, total);
+        if (mem) {
+            SDL_memset(mem, 0, total);
+        }
+        return mem;
+    }
+#endif
+    CountAllocation(cache, total);
+    return TrackHeapAlloc(dlcalloc(n, size));
+}
+
+static void *SDLCALL builtin_realloc(void *ptr, size_t size)
+{
+    size_t usable;
+    void *mem;
+
+    if (!ptr) {
+        return builtin_malloc(size);
+    }
+
+    usable = dlmalloc_usable_size(ptr);
+    mem = dlrealloc(ptr, size);
+    if (mem) {
+        UpdateHeapBytes(dlmalloc_usable_size(mem), usable);
+    }
+    return mem;
+}
+
+static void SDLCALL builtin_free(void *mem)
+{
+    SDL_MallocCache *cache = NULL;
+
+#ifdef SDL_MALLOC_THREAD_LOCAL
+    /* Freeing never creates a cache, so this is safe while a thread exits */
+    cache = thread_cache;
+#endif
+    CountFree(cache);
+#ifdef SDL_MALLOC_THREAD_LOCAL
+    if (cache && CachedFree(cache, mem)) {
+        return;
+    }
+#endif
+    HeapFree(mem);
+}
+
+#define real_malloc builtin_malloc
+#define real_calloc builtin_calloc
+#define real_realloc builtin_realloc
+#define real_free builtin_free
+#endif /* HAVE_MALLOC */
 
 /* Memory functions used by SDL that can be replaced by the application */
 static struct
@@ -5276,6 +5731,48 @@ int SDL_GetNumAllocations(void)
     return SDL_AtomicGet(&s_mem.num_allocations);
 }
 
+int SDL_GetMemoryStats(SDL_MemoryStats *stats)
+{
+#ifdef HAVE_MALLOC
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+    return SDL_Unsupported();
+#else
+    SDL_MallocCache *cache;
+    size_t heap_bytes;
+    int i;
+
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+
+    SDL_zerop(stats);
+
+    /* The counts of threads without a cache wrap around at 32 bits */
+    stats->num_allocations = (Uint32)SDL_AtomicGet(&s_heap.num_allocations);
+    stats->num_frees = (Uint32)SDL_AtomicGet(&s_heap.num_frees);
+    for (i = 0; i < SDL_NUM_MEMORY_SIZE_CLASSES; ++i) {
+        stats->allocations_by_size[i] = (Uint32)SDL_AtomicGet(&s_heap.allocations_by_size[i]);
+    }
+    for (cache = (SDL_MallocCache *)SDL_AtomicGetPtr((void **)&s_heap.caches); cache; cache = cache->next) {
+        stats->bytes_cached += cache->cached_bytes;
+        stats->num_allocations += cache->num_allocations;
+        stats->num_frees += cache->num_frees;
+        stats->num_cache_hits += cache->num_cache_hits;
+        for (i = 0; i < SDL_NUM_MEMORY_SIZE_CLASSES; ++i) {
+            stats->allocations_by_size[i] += cache->allocations_by_size[i];
+        }
+    }
+    heap_bytes = (size_t)SDL_AtomicGetPtr(&s_heap.heap_bytes);
+    stats->bytes_cached = SDL_min(stats->bytes_cached, heap_bytes);
+    stats->bytes_in_use = heap_bytes - stats->bytes_cached;
+    stats->peak_bytes = (size_t)SDL_AtomicGetPtr(&s_heap.peak_heap_bytes);
+
+    return 0;
+#endif
+}
+
 void *SDL_malloc(size_t size)
 {
     void *mem;
@@ -39,6 +39,60 @@ void *SDL_memcpy(SDL_OUT_BYTECAP(len) void *dst, SDL_IN_BYTECAP(len) const void
 #elif defined(HAVE_BCOPY)
     bcopy(src, dst, len);
     return dst;
+#elif defined(SDL_SSE2_INTRINSICS) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+    Uint8 *dstp = (Uint8 *)dst;
+    const Uint8 *srcp = (const Uint8 *)src;
+
+    while (len >= 64) {
+        const __m128i a = _mm_loadu_si128((const __m128i *)srcp);
+        const __m128i b = _mm_loadu_si128((const __m128i *)(srcp + 16));
+        const __m128i c = _mm_loadu_si128((const __m128i *)(srcp + 32));
+        const __m128i d = _mm_loadu_si128((const __m128i *)(srcp + 48));
+        _mm_storeu_si128((__m128i *)dstp, a);
+        _mm_storeu_si128((__m128i *)(dstp + 16), b);
+        _mm_storeu_si128((__m128i *)(dstp + 32), c);
+        _mm_storeu_si128((__m128i *)(dstp + 48), d);
+        srcp += 64;
+        dstp += 64;
+        len -= 64;
+    }
+    while (len >= 16) {
+        _mm_storeu_si128((__m128i *)dstp, _mm_loadu_si128((const __m128i *)srcp));
+        srcp += 16;
+        dstp += 16;
+        len -= 16;
+    }
+    while (len--) {
+        *dstp++ = *srcp++;
+    }
+    return dst;
+#elif defined(SDL_NEON_INTRINSICS)
+    Uint8 *dstp = (Uint8 *)dst;
+    const Uint8 *srcp = (const Uint8 *)src;
+
+    while (len >= 64) {
+        const uint8x16_t a = vld1q_u8(srcp);
+        const uint8x16_t b = vld1q_u8(srcp + 16);
+        const uint8x16_t c = vld1q_u8(srcp + 32);
+        const uint8x16_t d = vld1q_u8(srcp + 48);
+        vst1q_u8(dstp, a);
+        vst1q_u8(dstp + 16, b);
+        vst1q_u8(dstp + 32, c);
+        vst1q_u8(dstp + 48, d);
+        srcp += 64;
+        dstp += 64;
+        len -= 64;
+    }
+    while (len >= 16) {
+        vst1q_u8(dstp, vld1q_u8(srcp));
+        srcp += 16;
+        dstp += 16;
+        len -= 16;
+    }
+    while (len--) {
+        *dstp++ = *srcp++;
+    }
+    return dst;
 #else
     /* GCC 4.9.0 with -O3 will generate movaps instructions with the loop
        using Uint32* pointers, so we need to make sure the pointers are
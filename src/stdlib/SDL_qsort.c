@@ -20,17 +20,10 @@
 */
 #include "SDL_internal.h"
 
+#include "../thread/SDL_systhread.h"
 
-#ifdef HAVE_QSORT
-void SDL_qsort(void *base, size_t nmemb, size_t size, int (*compare) (const void *, const void *))
-{
-    if (!base) {
-        return;
-    }
-    qsort(base, nmemb, size, compare);
-}
-
-#else
+/* The sort below is always built, SDL_qsort_r() needs it even when the C
+   runtime has a qsort() for SDL_qsort() to use. */
 
 #ifdef assert
 #undef assert
@@ -55,13 +48,13 @@ void SDL_qsort(void *base, size_t nmemb, size_t size, int (*compare) (const void
 #ifdef qsortG
 #undef qsortG
 #endif
-#define qsortG SDL_qsort
+#define qsortG SDL_qsort_r
 
 /*
 This code came from Gareth McCaughan, under the zlib license.
 Specifically this: https://www.mccaughan.org.uk/software/qsort.c-1.15
 
-Everything below this comment until the HAVE_QSORT #endif was from Gareth
+Everything below this comment until the end of qsortG() was from Gareth
 (any minor changes will be noted inline).
 
 Thank you to Gareth for relicensing this code under the zlib license for our
@@ -274,19 +267,19 @@ typedef struct { char * first; char * last; } stack_entry;
 
 /* and so is the pivoting logic (note: last is inclusive): */
 #define Pivot(swapper,sz)			\
-  if ((size_t)(last-first)>PIVOT_THRESHOLD*sz) mid=pivot_big(first,mid,last,sz,compare);\
+  if ((size_t)(last-first)>PIVOT_THRESHOLD*sz) mid=pivot_big(first,mid,last,sz,compare,userdata);\
   else {	\
-    if (compare(first,mid)<0) {			\
-      if (compare(mid,last)>0) {		\
+    if (compare(userdata,first,mid)<0) {			\
+      if (compare(userdata,mid,last)>0) {		\
         swapper(mid,last);			\
-        if (compare(first,mid)>0) swapper(first,mid);\
+        if (compare(userdata,first,mid)>0) swapper(first,mid);\
       }						\
     }						\
     else {					\
-      if (compare(mid,last)>0) swapper(first,last)\
+      if (compare(userdata,mid,last)>0) swapper(first,last)\
       else {					\
         swapper(first,mid);			\
-        if (compare(mid,last)>0) swapper(mid,last);\
+        if (compare(userdata,mid,last)>0) swapper(mid,last);\
       }						\
     }						\
     first+=sz; last-=sz;			\
@@ -299,8 +292,8 @@ typedef struct { char * first; char * last; } stack_entry;
 /* and so is the partitioning logic: */
 #define Partition(swapper,sz) {			\
   do {						\
-    while (compare(first,pivot)<0) first+=sz;	\
-    while (compare(pivot,last)<0) last-=sz;	\
+    while (compare(userdata,first,pivot)<0) first+=sz;	\
+    while (compare(userdata,pivot,last)<0) last-=sz;	\
     if (first<last) {				\
       swapper(first,last);			\
       first+=sz; last-=sz; }			\
@@ -323,7 +316,7 @@ typedef struct { char * first; char * last; } stack_entry;
   first=base;					\
   last=first + ((nmemb>limit ? limit : nmemb)-1)*sz;\
   while (last!=base) {				\
-    if (compare(first,last)>0) first=last;	\
+    if (compare(userdata,first,last)>0) first=last;	\
     last-=sz; }					\
   if (first!=base) swapper(first,(char*)base);
 
@@ -334,7 +327,7 @@ typedef struct { char * first; char * last; } stack_entry;
     char *test;					\
     /* Find the right place for |first|.	\
      * My apologies for var reuse. */		\
-    for (test=first-size;compare(test,first)>0;test-=size) ;	\
+    for (test=first-size;compare(userdata,test,first)>0;test-=size) ;	\
     test+=size;					\
     if (test!=first) {				\
       /* Shift everything in [test,first)	\
@@ -362,7 +355,7 @@ typedef struct { char * first; char * last; } stack_entry;
 /* ---------------------------------------------------------------------- */
 
 static char * pivot_big(char *first, char *mid, char *last, size_t size,
-                        int compare(const void *, const void *)) {
+                        SDL_CompareCallback_r compare, void *userdata) {
   size_t d=(((last-first)/size)>>3)*size;
 #ifdef DEBUG_QSORT
 fprintf(stderr, "pivot_big: first=%p last=%p size=%lu n=%lu\n", first, (unsigned long)last, size, (unsigned long)((last-first+1)/size));
@@ -372,38 +365,38 @@ fprintf(stderr, "pivot_big: first=%p last=%p size=%lu n=%lu\n", first, (unsigned
 #ifdef DEBUG_QSORT
 fprintf(stderr,"< %d %d %d @ %p %p %p\n",*(int*)a,*(int*)b,*(int*)c, a,b,c);
 #endif
-    m1 = compare(a,b)<0 ?
-           (compare(b,c)<0 ? b : (compare(a,c)<0 ? c : a))
-         : (compare(a,c)<0 ? a : (compare(b,c)<0 ? c : b));
+    m1 = compare(userdata,a,b)<0 ?
+           (compare(userdata,b,c)<0 ? b : (compare(userdata,a,c)<0 ? c : a))
+         : (compare(userdata,a,c)<0 ? a : (compare(userdata,b,c)<0 ? c : b));
   }
   { char *a=mid-d, *b=mid, *c=mid+d;
 #ifdef DEBUG_QSORT
 fprintf(stderr,". %d %d %d @ %p %p %p\n",*(int*)a,*(int*)b,*(int*)c, a,b,c);
 #endif
-    m2 = compare(a,b)<0 ?
-           (compare(b,c)<0 ? b : (compare(a,c)<0 ? c : a))
-         : (compare(a,c)<0 ? a : (compare(b,c)<0 ? c : b));
+    m2 = compare(userdata,a,b)<0 ?
+           (compare(userdata,b,c)<0 ? b : (compare(userdata,a,c)<0 ? c : a))
+         : (compare(userdata,a,c)<0 ? a : (compare(userdata,b,c)<0 ? c : b));
   }
   { char *a=last-2*d, *b=last-d, *c=last;
 #ifdef DEBUG_QSORT
 fprintf(stderr,"> %d %d %d @ %p %p %p\n",*(int*)a,*(int*)b,*(int*)c, a,b,c);
 #endif
-    m3 = compare(a,b)<0 ?
-           (compare(b,c)<0 ? b : (compare(a,c)<0 ? c : a))
-         : (compare(a,c)<0 ? a : (compare(b,c)<0 ? c : b));
+    m3 = compare(userdata,a,b)<0 ?
+           (compare(userdata,b,c)<0 ? b : (compare(userdata,a,c)<0 ? c : a))
+         : (compare(userdata,a,c)<0 ? a : (compare(userdata,b,c)<0 ? c : b));
   }
 #ifdef DEBUG_QSORT
 fprintf(stderr,"-> %d %d %d @ %p %p %p\n",*(int*)m1,*(int*)m2,*(int*)m3, m1,m2,m3);
 #endif
-  return compare(m1,m2)<0 ?
-           (compare(m2,m3)<0 ? m2 : (compare(m1,m3)<0 ? m3 : m1))
-         : (compare(m1,m3)<0 ? m1 : (compare(m2,m3)<0 ? m3 : m2));
+  return compare(userdata,m1,m2)<0 ?
+           (compare(userdata,m2,m3)<0 ? m2 : (compare(userdata,m1,m3)<0 ? m3 : m1))
+         : (compare(userdata,m1,m3)<0 ? m1 : (compare(userdata,m2,m3)<0 ? m3 : m2));
 }
 
 /* ---------------------------------------------------------------------- */
 
 static void qsort_nonaligned(void *base, size_t nmemb, size_t size,
-           int (*compare)(const void *, const void *)) {
+           SDL_CompareCallback_r compare, void *userdata) {
 
   stack_entry stack[STACK_SIZE];
   int stacktop=0;
@@ -434,7 +427,7 @@ static void qsort_nonaligned(void *base, size_t nmemb, size_t size,
 }
 
 static void qsort_aligned(void *base, size_t nmemb, size_t size,
-           int (*compare)(const void *, const void *)) {
+           SDL_CompareCallback_r compare, void *userdata) {
 
   stack_entry stack[STACK_SIZE];
   int stacktop=0;
@@ -465,7 +458,7 @@ static void qsort_aligned(void *base, size_t nmemb, size_t size,
 }
 
 static void qsort_words(void *base, size_t nmemb,
-           int (*compare)(const void *, const void *)) {
+           SDL_CompareCallback_r compare, void *userdata) {
 
   stack_entry stack[STACK_SIZE];
   int stacktop=0;
@@ -507,7 +500,7 @@ fprintf(stderr, "after partitioning first=#%lu last=#%lu\n", (first-(char*)base)
     /* Find the right place for |first|. My apologies for var reuse */
     int *pl=(int*)(first-WORD_BYTES),*pr=(int*)first;
     *(int*)pivot=*(int*)first;
-    for (;compare(pl,pivot)>0;pr=pl,--pl) {
+    for (;compare(userdata,pl,pivot)>0;pr=pl,--pl) {
       *pr=*pl; }
     if (pr!=(int*)first) *pr=*(int*)pivot;
   }
@@ -517,24 +510,56 @@ fprintf(stderr, "after partitioning first=#%lu last=#%lu\n", (first-(char*)base)
 /* ---------------------------------------------------------------------- */
 
 extern void qsortG(void *base, size_t nmemb, size_t size,
-           int (*compare)(const void *, const void *)) {
+           SDL_CompareCallback_r compare, void *userdata) {
 
   if (nmemb<=1) return;
   if (((size_t)base|size)&(WORD_BYTES-1))
-    qsort_nonaligned(base,nmemb,size,compare);
+    qsort_nonaligned(base,nmemb,size,compare,userdata);
   else if (size!=WORD_BYTES)
-    qsort_aligned(base,nmemb,size,compare);
+    qsort_aligned(base,nmemb,size,compare,userdata);
   else
-    qsort_words(base,nmemb,compare);
+    qsort_words(base,nmemb,compare,userdata);
 }
 
-#endif /* HAVE_QSORT */
+/* The rest of this file uses the SDL names directly */
+#undef assert
+#undef malloc
+#undef free
+#undef memcpy
+#undef memmove
 
-void *SDL_bsearch(const void *key, const void *base, size_t nmemb, size_t size, int (*compare)(const void *, const void *))
+/* ---------------------------------------------------------------------- */
+
+#ifndef HAVE_QSORT
+#define SDL_NEED_COMPARE_BRIDGE
+#endif
+#ifndef HAVE_BSEARCH
+#define SDL_NEED_COMPARE_BRIDGE
+#endif
+
+#ifdef SDL_NEED_COMPARE_BRIDGE
+/* Calls a comparison function without userdata, which is passed as userdata */
+static int SDLCALL SDL_CompareBridge(void *userdata, const void *a, const void *b)
 {
-#ifdef HAVE_BSEARCH
-    return bsearch(key, base, nmemb, size, compare);
+    int (SDLCALL *compare)(const void *, const void *) = (int (SDLCALL *)(const void *, const void *))userdata;
+    return compare(a, b);
+}
+#endif
+
+void SDL_qsort(void *base, size_t nmemb, size_t size, int (*compare) (const void *, const void *))
+{
+    if (!base) {
+        return;
+    }
+#ifdef HAVE_QSORT
+    qsort(base, nmemb, size, compare);
 #else
+    SDL_qsort_r(base, nmemb, size, SDL_CompareBridge, (void *)compare);
+#endif
+}
+
+void *SDL_bsearch_r(const void *key, const void *base, size_t nmemb, size_t size, SDL_CompareCallback_r compare, void *userdata)
+{
 /* SDL's replacement:  Taken from the Public Domain C Library (PDCLib):
    Permission is granted to use, modify, and / or redistribute at will.
 */
@@ -547,7 +572,7 @@ void *SDL_bsearch(const void *key, const void *base, size_t nmemb, size_t size,
         corr = nmemb % 2;
         nmemb /= 2;
         pivot = (const char *)base + (nmemb * size);
-        rc = compare(key, pivot);
+        rc = compare(userdata, key, pivot);
 
         if (rc > 0) {
             base = (const char *)pivot + size;
@@ -559,5 +584,452 @@ void *SDL_bsearch(const void *key, const void *base, size_t nmemb, size_t size,
     }
 
     return NULL;
+}
+
+void *SDL_bsearch(const void *key, const void *base, size_t nmemb, size_t size, int (*compare)(const void *, const void *))
+{
+#ifdef HAVE_BSEARCH
+    return bsearch(key, base, nmemb, size, compare);
+#else
+    return SDL_bsearch_r(key, base, nmemb, size, SDL_CompareBridge, (void *)compare);
 #endif /* HAVE_BSEARCH */
 }
+
+/* ---------------------------------------------------------------------- */
+
+/* The merge sort behind SDL_ParallelSort(). Each thread sorts a slice of the
+   array with a bottom-up merge sort, then the sorted slices are merged in
+   rounds, pairwise. A merge is split between several threads by finding
+   where each thread's share of the output starts in both inputs with a
+   binary search, so the last rounds still keep every thread busy.
+ */
+
+#define SDL_SORT_INSERTION_RUN      16
+#define SDL_SORT_MIN_PER_THREAD     4096
+#define SDL_SORT_MAX_THREADS        16
+
+typedef struct
+{
+    SDL_CompareCallback_r compare;
+    void *userdata;
+    size_t size;
+} SDL_SortContext;
+
+typedef struct
+{
+    const SDL_SortContext *context;
+    char *a;        /* the slice to sort, or the first input of the merge */
+    size_t na;
+    char *b;        /* the second input of the merge, if any */
+    size_t nb;
+    char *dst;      /* where the merge goes, or scratch space for the sort */
+    SDL_bool merge;
+} SDL_SortJob;
+
+/* Sorts a short run in place, using one element of scratch space */
+static void SDL_InsertionSortRun(const SDL_SortContext *context, char *run, size_t count, char *scratch)
+{
+    const size_t size = context->size;
+    size_t i;
+
+    for (i = 1; i < count; ++i) {
+        char *element = run + i * size;
+        char *insert = element;
+
+        while (insert > run && context->compare(context->userdata, insert - size, element) > 0) {
+            insert -= size;
+        }
+        if (insert != element) {
+            SDL_memcpy(scratch, element, size);
+            SDL_memmove(insert + size, insert, (size_t)(element - insert));
+            SDL_memcpy(insert, scratch, size);
+        }
+    }
+}
+
+/* Merges two sorted runs, taking from the first one when elements are equivalent */
+static void SDL_MergeRuns(const SDL_SortContext *context, const char *a, size_t na, const char *b, size_t nb, char *dst)
+{
+    const size_t size = context->size;
+
+    while (na && nb) {
+        if (context->compare(context->userdata, b, a) < 0) {
+            SDL_memcpy(dst, b, size);
+            b += size;
+            --nb;
+        } else {
+            SDL_memcpy(dst, a, size);
+            a += size;
+            --na;
+        }
+        dst += size;
+    }
+    if (na) {
+        SDL_memcpy(dst, a, na * size);
+    } else if (nb) {
+        SDL_memcpy(dst, b, nb * size);
+    }
+}
+
+/* Sorts a slice in place, using the same amount of scratch space */
+static void SDL_MergeSortSlice(const SDL_SortContext *context, char *base, size_t count, char *scratch)
+{
+    const size_t size = context->size;
+    char *src = base;
+    char *dst = scratch;
+    size_t width, i;
+
+    for (i = 0; i < count; i += SDL_SORT_INSERTION_RUN) {
+        SDL_InsertionSortRun(context, base + i * size, SDL_min(SDL_SORT_INSERTION_RUN, count - i), scratch);
+    }
+
+    for (width = SDL_SORT_INSERTION_RUN; width < count; width *= 2) {
+        char *swap;
+
+        for (i = 0; i < count; i += 2 * width) {
+            const size_t na = SDL_min(width, count - i);
+            const size_t nb = SDL_min(width, count - i - na);
+            SDL_MergeRuns(context, src + i * size, na, src + (i + na) * size, nb, dst + i * size);
+        }
+        swap = src;
+        src = dst;
+        dst = swap;
+    }
+
+    if (src != base) {
+        SDL_memcpy(base, src, count * size);
+    }
+}
+
+static int SDLCALL SDL_SortJobThread(void *data)
+{
+    SDL_SortJob *job = (SDL_SortJob *)data;
+
+    if (job->merge) {
+        SDL_MergeRuns(job->context, job->a, job->na, job->b, job->nb, job->dst);
+    } else {
+        SDL_MergeSortSlice(job->context, job->a, job->na, job->dst);
+    }
+    return 0;
+}
+
+static void SDL_RunSortJobs(SDL_SortJob *jobs, int numjobs)
+{
+    SDL_Thread *threads[SDL_SORT_MAX_THREADS + 1];
+    int i;
+
+    /* Any job that doesn't get a thread runs on this one, like the first */
+    for (i = 1; i < numjobs; ++i) {
+        threads[i] = SDL_CreateThreadInternal(SDL_SortJobThread, "SDLSort", 0, &jobs[i]);
+    }
+    SDL_SortJobThread(&jobs[0]);
+    for (i = 1; i < numjobs; ++i) {
+        if (threads[i]) {
+            SDL_WaitThread(threads[i], NULL);
+        } else {
+            SDL_SortJobThread(&jobs[i]);
+        }
+    }
+}
+
+/* Returns how many of the first `split` elements of the merge of a and b come from a */
+static size_t SDL_FindMergeSplit(const SDL_SortContext *context, const char *a, size_t na, const char *b, size_t nb, size_t split)
+{
+    const size_t size = context->size;
+    size_t lo = (split > nb) ? (split - nb) : 0;
+    size_t hi = SDL_min(split, na);
+
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        if (context->compare(context->userdata, a + mid * size, b + (split - mid - 1) * size) <= 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+int SDL_ParallelSort(void *base, size_t nmemb, size_t size, SDL_CompareCallback_r compare, void *userdata)
+{
+    SDL_SortContext context;
+    SDL_SortJob jobs[SDL_SORT_MAX_THREADS + 1];
+    size_t runs[SDL_SORT_MAX_THREADS + 1];
+    size_t bytes;
+    char *scratch;
+    char *src;
+    char *dst;
+    int numthreads, numruns, numjobs, i;
+
+    if (!base && nmemb) {
+        return SDL_InvalidParamError("base");
+    }
+    if (!compare) {
+        return SDL_InvalidParamError("compare");
+    }
+    if (nmemb <= 1 || !size) {
+        return 0;
+    }
+    if (SDL_size_mul_overflow(nmemb, size, &bytes)) {
+        return SDL_OutOfMemory();
+    }
+
+    scratch = (char *)SDL_malloc(bytes);
+    if (!scratch) {
+        return -1;
+    }
+
+    context.compare = compare;
+    context.userdata = userdata;
+    context.size = size;
+
+    numthreads = SDL_min(SDL_GetCPUCount(), SDL_SORT_MAX_THREADS);
+    if ((size_t)numthreads > nmemb / SDL_SORT_MIN_PER_THREAD) {
+        numthreads = (int)(nmemb / SDL_SORT_MIN_PER_THREAD);
+    }
+    if (numthreads <= 1) {
+        SDL_MergeSortSlice(&context, (char *)base, nmemb, scratch);
+        SDL_free(scratch);
+        return 0;
+    }
+
+    /* Sort a slice on each thread */
+    for (i = 0; i <= numthreads; ++i) {
+        runs[i] = (nmemb * (size_t)i) / (size_t)numthreads;
+    }
+    for (i = 0; i < numthreads; ++i) {
+        jobs[i].context = &context;
+        jobs[i].a = (char *)base + runs[i] * size;
+        jobs[i].na = runs[i + 1] - runs[i];
+        jobs[i].b = NULL;
+        jobs[i].nb = 0;
+        jobs[i].dst = scratch + runs[i] * size;
+        jobs[i].merge = SDL_FALSE;
+    }
+    SDL_RunSortJobs(jobs, numthreads);
+
+    /* Merge the sorted runs pairwise, back and forth between the buffers */
+    numruns = numthreads;
+    src = (char *)base;
+    dst = scratch;
+    while (numruns > 1) {
+        const int numpairs = numruns / 2;
+        const int parts = SDL_max(numthreads / numpairs, 1);
+        char *swap;
+
+        numjobs = 0;
+        for (i = 0; i + 1 < numruns; i += 2) {
+            const char *a = src + runs[i] * size;
+            const char *b = src + runs[i + 1] * size;
+            const size_t na = runs[i + 1] - runs[i];
+            const size_t nb = runs[i + 2] - runs[i + 1];
+            size_t start = 0, start_a = 0;
+            int part;
+
+            for (part = 1; part <= parts; ++part) {
+                const size_t end = ((na + nb) * (size_t)part) / (size_t)parts;
+                const size_t end_a = (part == parts) ? na : SDL_FindMergeSplit(&context, a, na, b, nb, end);
+                SDL_SortJob *job = &jobs[numjobs++];
+
+                job->context = &context;
+                job->a = (char *)a + start_a * size;
+                job->na = end_a - start_a;
+                job->b = (char *)b + (start - start_a) * size;
+                job->nb = (end - end_a) - (start - start_a);
+                job->dst = dst + (runs[i] + start) * size;
+                job->merge = SDL_TRUE;
+                start = end;
+                start_a = end_a;
+            }
+        }
+        if (numruns & 1) {
+            /* The odd run out is copied over as it is */
+            SDL_SortJob *job = &jobs[numjobs++];
+
+            job->context = &context;
+            job->a = src + runs[numruns - 1] * size;
+            job->na = runs[numruns] - runs[numruns - 1];
+            job->b = NULL;
+            job->nb = 0;
+            job->dst = dst + runs[numruns - 1] * size;
+            job->merge = SDL_TRUE;
+        }
+        SDL_RunSortJobs(jobs, numjobs);
+
+        for (i = 0; i <= numruns; i += 2) {
+            runs[i / 2] = runs[i];
+        }
+        if (numruns & 1) {
+            runs[numruns / 2 + 1] = runs[numruns];
+        }
+        numruns = (numruns + 1) / 2;
+
+        swap = src;
+        src = dst;
+        dst = swap;
+    }
+
+    if (src != (char *)base) {
+        SDL_memcpy(base, src, bytes);
+    }
+    SDL_free(scratch);
+    return 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+/* The radix sort behind SDL_RadixSort(). Keys are mapped to unsigned
+   integers that sort in the same order, then sorted a byte at a time from
+   the least significant one, skipping bytes that are the same in every key.
+ */
+
+#define SDL_SIGN_BIT_32 0x80000000u
+#define SDL_SIGN_BIT_64 (((Uint64)1) << 63)
+
+SDL_FORCE_INLINE Uint64 SDL_GetRadixKey(const char *element, SDL_SortKeyType key_type)
+{
+    Uint32 key32;
+    Uint64 key64;
+
+    switch (key_type) {
+    case SDL_SORTKEY_UINT32:
+        SDL_memcpy(&key32, element, sizeof(key32));
+        return key32;
+    case SDL_SORTKEY_SINT32:
+        SDL_memcpy(&key32, element, sizeof(key32));
+        return key32 ^ SDL_SIGN_BIT_32;
+    case SDL_SORTKEY_FLOAT:
+        /* Negative values sort backwards, and before the positive ones */
+        SDL_memcpy(&key32, element, sizeof(key32));
+        return (key32 & SDL_SIGN_BIT_32) ? (Uint32)~key32 : (key32 | SDL_SIGN_BIT_32);
+    case SDL_SORTKEY_UINT64:
+        SDL_memcpy(&key64, element, sizeof(key64));
+        return key64;
+    case SDL_SORTKEY_SINT64:
+        SDL_memcpy(&key64, element, sizeof(key64));
+        return key64 ^ SDL_SIGN_BIT_64;
+    case SDL_SORTKEY_DOUBLE:
+        SDL_memcpy(&key64, element, sizeof(key64));
+        return (key64 & SDL_SIGN_BIT_64) ? ~key64 : (key64 | SDL_SIGN_BIT_64);
+    default:
+        return 0;
+    }
+}
+
+SDL_FORCE_INLINE void SDL_CopyElement(char *dst, const char *src, size_t size)
+{
+    /* Let the compiler inline the copy for the common sizes */
+    switch (size) {
+    case 4:
+        SDL_memcpy(dst, src, 4);
+        break;
+    case 8:
+        SDL_memcpy(dst, src, 8);
+        break;
+    case 16:
+        SDL_memcpy(dst, src, 16);
+        break;
+    default:
+        SDL_memcpy(dst, src, size);
+        break;
+    }
+}
+
+int SDL_RadixSort(void *base, size_t nmemb, size_t size, size_t key_offset, SDL_SortKeyType key_type)
+{
+    size_t (*counts)[256];
+    size_t key_size, bytes, i;
+    char *scratch;
+    char *src;
+    char *dst;
+    int key_byte;
+
+    switch (key_type) {
+    case SDL_SORTKEY_UINT32:
+    case SDL_SORTKEY_SINT32:
+    case SDL_SORTKEY_FLOAT:
+        key_size = 4;
+        break;
+    case SDL_SORTKEY_UINT64:
+    case SDL_SORTKEY_SINT64:
+    case SDL_SORTKEY_DOUBLE:
+        key_size = 8;
+        break;
+    default:
+        return SDL_InvalidParamError("key_type");
+    }
+    if (!base && nmemb) {
+        return SDL_InvalidParamError("base");
+    }
+    if (key_offset > size || size - key_offset < key_size) {
+        return SDL_InvalidParamError("key_offset");
+    }
+    if (nmemb <= 1) {
+        return 0;
+    }
+    if (SDL_size_mul_overflow(nmemb, size, &bytes) ||
+        SDL_size_add_overflow(bytes, key_size * sizeof(*counts), &bytes)) {
+        return SDL_OutOfMemory();
+    }
+
+    /* The counts go first so they're aligned, then the scratch array */
+    counts = (size_t (*)[256])SDL_malloc(bytes);
+    if (!counts) {
+        return -1;
+    }
+    SDL_memset(counts, 0, key_size * sizeof(*counts));
+    scratch = (char *)(counts + key_size);
+
+    /* Count every byte of every key in a single pass */
+    src = (char *)base + key_offset;
+    for (i = 0; i < nmemb; ++i, src += size) {
+        Uint64 key = SDL_GetRadixKey(src, key_type);
+        counts[0][key & 0xFF]++;
+        counts[1][(key >> 8) & 0xFF]++;
+        counts[2][(key >> 16) & 0xFF]++;
+        counts[3][(key >> 24) & 0xFF]++;
+        if (key_size == 8) {
+            counts[4][(key >> 32) & 0xFF]++;
+            counts[5][(key >> 40) & 0xFF]++;
+            counts[6][(key >> 48) & 0xFF]++;
+            counts[7][(key >> 56) & 0xFF]++;
+        }
+    }
+
+    src = (char *)base;
+    dst = scratch;
+    for (key_byte = 0; key_byte < (int)key_size; ++key_byte) {
+        const int shift = key_byte * 8;
+        size_t *offsets = counts[key_byte];
+        size_t offset = 0;
+        const char *element;
+        char *swap;
+
+        if (offsets[(SDL_GetRadixKey(src + key_offset, key_type) >> shift) & 0xFF] == nmemb) {
+            /* Every key has the same value here, nothing would move */
+            continue;
+        }
+
+        for (i = 0; i < 256; ++i) {
+            const size_t count = offsets[i];
+            offsets[i] = offset;
+            offset += count;
+        }
+
+        element = src;
+        for (i = 0; i < nmemb; ++i, element += size) {
+            const size_t bucket = (size_t)((SDL_GetRadixKey(element + key_offset, key_type) >> shift) & 0xFF);
+            SDL_CopyElement(dst + offsets[bucket]++ * size, element, size);
+        }
+
+        swap = src;
+        src = dst;
+        dst = swap;
+    }
+
+    if (src != (char *)base) {
+        SDL_memcpy(base, src, nmemb * size);
+    }
+    SDL_free(counts);
+    return 0;
+}
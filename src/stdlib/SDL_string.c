@@ -49,6 +49,134 @@ static size_t UTF8_GetTrailingBytes(unsigned char c)
     return 0;
 }
 
+/* The scanning functions below look at a whole block at a time. The SIMD
+   versions are only compiled in where the instruction set is guaranteed by
+   the target, so there's no CPU check on every call.
+
+   Without a C runtime to lean on, scans for the end of a string read aligned
+   blocks, which can run past the terminator but never across a page boundary.
+   Address sanitizers report those reads, so they're only done in builds that
+   have no C runtime and no sanitizer, everywhere else strings are measured
+   first and never read past their end. */
+#if defined(__SANITIZE_ADDRESS__)
+#define SDL_STRING_SANITIZED 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define SDL_STRING_SANITIZED 1
+#endif
+#endif
+
+#if !defined(HAVE_LIBC) && !defined(SDL_STRING_SANITIZED)
+#define SDL_STRING_OVERREAD 1
+#endif
+
+#if defined(SDL_SSE2_INTRINSICS) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#define SDL_STRING_SSE2 1
+#elif defined(SDL_NEON_INTRINSICS) && (defined(__aarch64__) || defined(_M_ARM64))
+#define SDL_STRING_NEON 1
+#endif
+
+#if defined(SDL_STRING_SSE2) || defined(SDL_STRING_NEON)
+#define SDL_STRING_BLOCK_SIZE 16
+#endif
+
+/* Without SIMD, bytes are read a machine word at a time */
+#define SDL_WORD_ONES  ((size_t)-1 / 0xFF)
+#define SDL_WORD_HIGHS (SDL_WORD_ONES * 0x80)
+#define SDL_WordHasZeroByte(w) ((((w) - SDL_WORD_ONES) & ~(w) & SDL_WORD_HIGHS) != 0)
+#define SDL_WordIsAligned(p) (((uintptr_t)(p) & (sizeof(size_t) - 1)) == 0)
+
+#ifdef SDL_STRING_BLOCK_SIZE
+SDL_FORCE_INLINE int SDL_LowestBitIndex32(Uint32 x)
+{
+#if defined(__GNUC__) && (__GNUC__ >= 4)
+    return __builtin_ctz(x);
+#else
+    return SDL_MostSignificantBitIndex32(x & (~x + 1));
+#endif
+}
+
+SDL_FORCE_INLINE int SDL_PopCount32(Uint32 x)
+{
+#if defined(__GNUC__) && (__GNUC__ >= 4)
+    return __builtin_popcount(x);
+#else
+    x = x - ((x >> 1) & 0x55555555);
+    x = (x & 0x33333333) + ((x >> 2) & 0x33333333);
+    return (int)((((x + (x >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24);
+#endif
+}
+
+#ifdef SDL_STRING_SSE2
+/* Bit i of the result is set if byte i of the aligned block at p is c */
+SDL_FORCE_INLINE Uint32 SDL_BlockMatches(const char *p, char c)
+{
+    const __m128i v = _mm_load_si128((const __m128i *)p);
+    return (Uint32)_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8(c)));
+}
+
+/* Same, but matching either c or the terminating zero */
+SDL_FORCE_INLINE Uint32 SDL_BlockMatchesOrZero(const char *p, char c)
+{
+    const __m128i v = _mm_load_si128((const __m128i *)p);
+    return (Uint32)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(c)),
+                                                  _mm_cmpeq_epi8(v, _mm_setzero_si128())));
+}
+
+/* Bit i is set if byte i doesn't start with the bits 10, i.e. it starts a code point.
+   The block at p doesn't need to be aligned. */
+SDL_FORCE_INLINE Uint32 SDL_BlockUTF8Starts(const char *p)
+{
+    const __m128i v = _mm_loadu_si128((const __m128i *)p);
+    return (Uint32)_mm_movemask_epi8(_mm_cmpgt_epi8(v, _mm_set1_epi8((char)0xBF)));
+}
+
+/* Bit i is set if byte i differs between the unaligned blocks at a and b */
+SDL_FORCE_INLINE Uint32 SDL_BlockDiffers(const Uint8 *a, const Uint8 *b)
+{
+    const __m128i va = _mm_loadu_si128((const __m128i *)a);
+    const __m128i vb = _mm_loadu_si128((const __m128i *)b);
+    return (Uint32)_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb)) ^ 0xFFFF;
+}
+#endif /* SDL_STRING_SSE2 */
+
+#ifdef SDL_STRING_NEON
+/* NEON has no movemask, so weight each lane by its bit and add across halves */
+SDL_FORCE_INLINE Uint32 SDL_BlockMask(uint8x16_t lanes)
+{
+    static const Uint8 weights[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+    const uint8x16_t bits = vandq_u8(lanes, vld1q_u8(weights));
+    return (Uint32)vaddv_u8(vget_low_u8(bits)) | ((Uint32)vaddv_u8(vget_high_u8(bits)) << 8);
+}
+
+SDL_FORCE_INLINE Uint32 SDL_BlockMatches(const char *p, char c)
+{
+    const uint8x16_t v = vld1q_u8((const Uint8 *)p);
+    return SDL_BlockMask(vceqq_u8(v, vdupq_n_u8((Uint8)c)));
+}
+
+SDL_FORCE_INLINE Uint32 SDL_BlockMatchesOrZero(const char *p, char c)
+{
+    const uint8x16_t v = vld1q_u8((const Uint8 *)p);
+    return SDL_BlockMask(vorrq_u8(vceqq_u8(v, vdupq_n_u8((Uint8)c)), vceqzq_u8(v)));
+}
+
+SDL_FORCE_INLINE Uint32 SDL_BlockUTF8Starts(const char *p)
+{
+    const int8x16_t v = vld1q_s8((const Sint8 *)p);
+    return SDL_BlockMask(vcgtq_s8(v, vdupq_n_s8((Sint8)0xBF)));
+}
+
+SDL_FORCE_INLINE Uint32 SDL_BlockDiffers(const Uint8 *a, const Uint8 *b)
+{
+    return SDL_BlockMask(vceqq_u8(vld1q_u8(a), vld1q_u8(b))) ^ 0xFFFF;
+}
+#endif /* SDL_STRING_NEON */
+
+/* Returns the address of the aligned block containing p */
+#define SDL_BlockAlign(p) ((const char *)((uintptr_t)(p) & ~(uintptr_t)(SDL_STRING_BLOCK_SIZE - 1)))
+#endif /* SDL_STRING_BLOCK_SIZE */
+
 #if !defined(HAVE_VSSCANF) || !defined(HAVE_STRTOL) || !defined(HAVE_STRTOUL) || !defined(HAVE_STRTOD)
 static size_t SDL_ScanLong(const char *text, int count, int radix, long *valuep)
 {
@@ -341,11 +469,39 @@ int SDL_memcmp(const void *s1, const void *s2, size_t len)
 #elif defined(HAVE_MEMCMP)
     return memcmp(s1, s2, len);
 #else
-    char *s1p = (char *)s1;
-    char *s2p = (char *)s2;
+    const Uint8 *s1p = (const Uint8 *)s1;
+    const Uint8 *s2p = (const Uint8 *)s2;
+#ifdef SDL_STRING_BLOCK_SIZE
+    while (len >= SDL_STRING_BLOCK_SIZE) {
+        const Uint32 mask = SDL_BlockDiffers(s1p, s2p);
+        if (mask) {
+            const int i = SDL_LowestBitIndex32(mask);
+            return (int)s1p[i] - (int)s2p[i];
+        }
+        s1p += SDL_STRING_BLOCK_SIZE;
+        s2p += SDL_STRING_BLOCK_SIZE;
+        len -= SDL_STRING_BLOCK_SIZE;
+    }
+#else
+    /* Words can only be compared if both sides can be aligned together */
+    if (SDL_WordIsAligned((uintptr_t)s1p - (uintptr_t)s2p)) {
+        while (len && !SDL_WordIsAligned(s1p) && *s1p == *s2p) {
+            ++s1p;
+            ++s2p;
+            --len;
+        }
+        if (SDL_WordIsAligned(s1p)) {
+            while (len >= sizeof(size_t) && *(const size_t *)s1p == *(const size_t *)s2p) {
+                s1p += sizeof(size_t);
+                s2p += sizeof(size_t);
+                len -= sizeof(size_t);
+            }
+        }
+    }
+#endif /* SDL_STRING_BLOCK_SIZE */
     while (len--) {
         if (*s1p != *s2p) {
-            return *s1p - *s2p;
+            return (int)*s1p - (int)*s2p;
         }
         ++s1p;
         ++s2p;
@@ -358,12 +514,40 @@ size_t SDL_strlen(const char *string)
 {
 #ifdef HAVE_STRLEN
     return strlen(string);
+#elif defined(SDL_STRING_OVERREAD) && defined(SDL_STRING_BLOCK_SIZE)
+    const int offset = (int)(string - SDL_BlockAlign(string));
+    const char *p = string - offset;
+    Uint32 mask = SDL_BlockMatches(p, '\0') >> offset;
+
+    if (mask) {
+        return SDL_LowestBitIndex32(mask);
+    }
+    do {
+        p += SDL_STRING_BLOCK_SIZE;
+        mask = SDL_BlockMatches(p, '\0');
+    } while (!mask);
+    return (size_t)(p - string) + SDL_LowestBitIndex32(mask);
+#elif defined(SDL_STRING_OVERREAD)
+    const char *p = string;
+    while (!SDL_WordIsAligned(p)) {
+        if (!*p) {
+            return (size_t)(p - string);
+        }
+        ++p;
+    }
+    while (!SDL_WordHasZeroByte(*(const size_t *)p)) {
+        p += sizeof(size_t);
+    }
+    while (*p) {
+        ++p;
+    }
+    return (size_t)(p - string);
 #else
-    size_t len = 0;
-    while (*string++) {
-        ++len;
+    const char *p = string;
+    while (*p) {
+        ++p;
     }
-    return len;
+    return (size_t)(p - string);
 #endif /* HAVE_STRLEN */
 }
 
@@ -659,9 +843,66 @@ size_t SDL_utf8strlcpy(SDL_OUT_Z_CAP(dst_bytes) char *dst, const char *src, size
 size_t SDL_utf8strlen(const char *str)
 {
     size_t retval = 0;
+#ifndef SDL_STRING_OVERREAD
+    /* Count the code points in whole blocks up to the terminator */
+    const char *p = str;
+    size_t len = SDL_strlen(str);
+
+#ifdef SDL_STRING_BLOCK_SIZE
+    while (len >= SDL_STRING_BLOCK_SIZE) {
+        retval += SDL_PopCount32(SDL_BlockUTF8Starts(p));
+        p += SDL_STRING_BLOCK_SIZE;
+        len -= SDL_STRING_BLOCK_SIZE;
+    }
+#endif
+    while (len--) {
+        /* if top two bits are 1 and 0, it's a continuation byte. */
+        if ((*(p++) & 0xc0) != 0x80) {
+            retval++;
+        }
+    }
+
+    return retval;
+#elif defined(SDL_STRING_BLOCK_SIZE)
+    const int offset = (int)(str - SDL_BlockAlign(str));
+    const char *p = str - offset;
+    Uint32 zeros = (SDL_BlockMatches(p, '\0') >> offset) << offset;
+    Uint32 starts = (SDL_BlockUTF8Starts(p) >> offset) << offset;
+
+    while (!zeros) {
+        retval += SDL_PopCount32(starts);
+        p += SDL_STRING_BLOCK_SIZE;
+        zeros = SDL_BlockMatches(p, '\0');
+        starts = SDL_BlockUTF8Starts(p);
+    }
+
+    /* Only count what comes before the terminator */
+    return retval + SDL_PopCount32(starts & ((zeros & (~zeros + 1)) - 1));
+#else
     const char *p = str;
     unsigned char ch;
 
+    while (!SDL_WordIsAligned(p)) {
+        ch = *(p++);
+        if (!ch) {
+            return retval;
+        }
+        if ((ch & 0xc0) != 0x80) {
+            retval++;
+        }
+    }
+
+    for (;;) {
+        const size_t w = *(const size_t *)p;
+        if (SDL_WordHasZeroByte(w)) {
+            break;
+        }
+        /* A continuation byte has its top bit set and the next one clear,
+           the sum of those bits across the word ends up in its top byte. */
+        retval += sizeof(size_t) - (size_t)(((((w & ~(w << 1)) & SDL_WORD_HIGHS) >> 7) * SDL_WORD_ONES) >> ((sizeof(size_t) - 1) * 8));
+        p += sizeof(size_t);
+    }
+
     while ((ch = *(p++)) != 0) {
         /* if top two bits are 1 and 0, it's a continuation byte. */
         if ((ch & 0xc0) != 0x80) {
@@ -670,6 +911,7 @@ size_t SDL_utf8strlen(const char *str)
     }
 
     return retval;
+#endif /* SDL_STRING_OVERREAD */
 }
 
 size_t SDL_utf8strnlen(const char *str, size_t bytes)
@@ -775,17 +1017,61 @@ char *SDL_strchr(const char *string, int c)
     return SDL_const_cast(char *, strchr(string, c));
 #elif defined(HAVE_INDEX)
     return SDL_const_cast(char *, index(string, c));
-#else
-    while (*string) {
-        if (*string == c) {
-            return (char *)string;
+#elif defined(SDL_STRING_OVERREAD) && defined(SDL_STRING_BLOCK_SIZE)
+    const char ch = (char)c;
+    const int offset = (int)(string - SDL_BlockAlign(string));
+    const char *p = string - offset;
+    Uint32 mask = (SDL_BlockMatchesOrZero(p, ch) >> offset) << offset;
+
+    while (!mask) {
+        p += SDL_STRING_BLOCK_SIZE;
+        mask = SDL_BlockMatchesOrZero(p, ch);
+    }
+    p += SDL_LowestBitIndex32(mask);
+    return (*p == ch) ? (char *)p : NULL;
+#elif defined(SDL_STRING_OVERREAD)
+    const char ch = (char)c;
+    const size_t pattern = SDL_WORD_ONES * (unsigned char)ch;
+    const char *p = string;
+
+    while (!SDL_WordIsAligned(p)) {
+        if (*p == ch) {
+            return (char *)p;
+        }
+        if (!*p) {
+            return NULL;
+        }
+        ++p;
+    }
+    for (;;) {
+        const size_t w = *(const size_t *)p;
+        if (SDL_WordHasZeroByte(w) || SDL_WordHasZeroByte(w ^ pattern)) {
+            break;
         }
-        ++string;
+        p += sizeof(size_t);
     }
-    if (c == '\0') {
-        return (char *)string;
+    for (;;) {
+        if (*p == ch) {
+            return (char *)p;
+        }
+        if (!*p) {
+            return NULL;
+        }
+        ++p;
+    }
+#else
+    const char ch = (char)c;
+    const char *p = string;
+
+    for (;;) {
+        if (*p == ch) {
+            return (char *)p;
+        }
+        if (!*p) {
+            return NULL;
+        }
+        ++p;
     }
-    return NULL;
 #endif /* HAVE_STRCHR */
 }
 
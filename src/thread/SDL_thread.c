@@ -290,6 +290,9 @@ void SDL_RunThread(SDL_Thread *thread)
     /* Get the thread id */
     thread->threadid = SDL_GetCurrentThreadID();
 
+    /* This thread cleans up its TLS before it exits, so it can cache allocations */
+    SDL_EnableMallocThreadCache();
+
     /* Run the function */
     *statusloc = userfunc(userdata);
 
@@ -101,4 +101,9 @@ extern SDL_TLSData *SDL_Generic_GetTLSData(void);
  */
 extern int SDL_Generic_SetTLSData(SDL_TLSData *data);
 
+/* Let the calling thread keep a cache of freed blocks in the built-in allocator.
+   Only threads that call SDL_CleanupTLS() before they exit may do this, or the cache leaks.
+ */
+extern void SDL_EnableMallocThreadCache(void);
+
 #endif /* SDL_thread_c_h_ */
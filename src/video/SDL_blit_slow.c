@@ -86,7 +86,7 @@ void SDL_Blit_Slow(SDL_BlitInfo *info)
         srcy = posy >> 16;
         while (n--) {
             srcx = posx >> 16;
-            src = (info->src + (srcy * info->src_pitch) + (srcx * srcbpp));
+            src = (info->src + ((int)srcy * info->src_pitch) + (srcx * srcbpp));
 
             switch (src_access) {
             case SlowBlitPixelAccess_RGB:
@@ -666,6 +666,647 @@ static void WriteFloatPixel(Uint8 *pixels, SlowBlitPixelAccess access, SDL_Pixel
     }
 }
 
+/* Row based float blitting
+ *
+ * Pixels are converted a chunk at a time. The common HDR layouts (8888, 2101010 and the
+ * 16-bit and 32-bit array formats) are decoded without a per-pixel format switch, and the
+ * sRGB and PQ transfer functions for 8-bit and 10-bit pixels use lookup tables that give
+ * the same results as SDL_sRGBtoLinear(), SDL_PQtoNits() and their inverses. The only
+ * exception is a one code difference where SDL_PQfromNits() rounding isn't monotonic.
+ */
+#define FLOAT_BLIT_CHUNK    256
+
+/* Inverse of a monotonic float to integer encoding, used to quantize without calling powf()
+ * thresholds[k] is the smallest input that encodes to a value greater than k, and each
+ * bucket holds the encoded value at the start of a 1/64 octave range of inputs, which is
+ * at most a couple of thresholds away from the final value.
+ */
+#define FLOAT_ENCODE_BUCKET_BITS    6
+#define FLOAT_ENCODE_MAX_EXPONENTS  48
+
+typedef struct
+{
+    int max_code;
+    int min_exponent;
+    int num_buckets;
+    int steps;
+    float thresholds[1024];
+    Uint16 buckets[FLOAT_ENCODE_MAX_EXPONENTS << FLOAT_ENCODE_BUCKET_BITS];
+} SDL_FloatEncodeTable;
+
+typedef int (*SDL_FloatEncodeFunc)(float v);
+
+typedef struct
+{
+    float sRGB_to_linear[256];
+    float PQ_to_nits[1024];
+} SDL_FloatDecodeTables;
+
+/* Each table is built by the first thread that claims it, without holding a lock,
+   and published by setting its pointer. Until then, other threads get NULL and
+   convert pixels one at a time, which gives the same results.
+ */
+typedef struct
+{
+    SDL_AtomicInt claimed;
+    SDL_FloatDecodeTables *published;
+    SDL_FloatDecodeTables storage;
+} SDL_FloatDecodeTablesSlot;
+
+typedef struct
+{
+    SDL_AtomicInt claimed;
+    SDL_FloatEncodeTable *published;
+    SDL_FloatEncodeTable storage;
+} SDL_FloatEncodeTableSlot;
+
+static SDL_FloatDecodeTablesSlot float_decode_tables;
+static SDL_FloatEncodeTableSlot linear_to_sRGB_table;
+static SDL_FloatEncodeTableSlot nits_to_PQ_table;
+
+static int EncodeSRGB8(float v)
+{
+    return (int)SDL_roundf(SDL_clamp(SDL_sRGBfromLinear(v), 0.0f, 1.0f) * 255.0f);
+}
+
+static int EncodePQ10(float v)
+{
+    return (int)SDL_roundf(SDL_clamp(SDL_PQfromNits(v), 0.0f, 1.0f) * 1023.0f);
+}
+
+static float FloatFromBits(Uint32 bits)
+{
+    float f;
+    SDL_memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+static Uint32 BitsFromFloat(float f)
+{
+    Uint32 bits;
+    SDL_memcpy(&bits, &f, sizeof(bits));
+    return bits;
+}
+
+static void BuildFloatEncodeTable(SDL_FloatEncodeTable *table, SDL_FloatEncodeFunc encode, int max_code, float max_value)
+{
+    Uint32 lo = 0, hi;
+    int code, num_exponents, i;
+
+    /* Non-negative floats sort the same way as their bit patterns, so bisect on those */
+    for (code = 0; code < max_code; ++code) {
+        hi = BitsFromFloat(max_value);
+        while (lo + 1 < hi) {
+            Uint32 mid = lo + (hi - lo) / 2;
+            if (encode(FloatFromBits(mid)) > code) {
+                hi = mid;
+            } else {
+                lo = mid;
+            }
+        }
+        table->thresholds[code] = FloatFromBits(hi);
+        lo = hi - 1;
+    }
+    table->thresholds[max_code] = FloatFromBits(0x7F800000); /* infinity, the search never passes max_code */
+
+    table->min_exponent = (int)(BitsFromFloat(table->thresholds[0]) >> 23) - 127;
+    num_exponents = (int)(BitsFromFloat(table->thresholds[max_code - 1]) >> 23) - 127 - table->min_exponent + 1;
+    SDL_assert(num_exponents <= FLOAT_ENCODE_MAX_EXPONENTS);
+    num_exponents = SDL_min(num_exponents, FLOAT_ENCODE_MAX_EXPONENTS);
+    table->num_buckets = (num_exponents << FLOAT_ENCODE_BUCKET_BITS);
+
+    code = 0;
+    for (i = 0; i < table->num_buckets; ++i) {
+        const float start = FloatFromBits(((Uint32)(table->min_exponent + 127) << 23) + ((Uint32)i << (23 - FLOAT_ENCODE_BUCKET_BITS)));
+        while (code < max_code && start >= table->thresholds[code]) {
+            ++code;
+        }
+        table->buckets[i] = (Uint16)code;
+    }
+
+    table->steps = 0;
+    for (i = 0; i < table->num_buckets; ++i) {
+        const int next = (i + 1 < table->num_buckets) ? table->buckets[i + 1] : max_code;
+        table->steps = SDL_max(table->steps, next - table->buckets[i]);
+    }
+
+    table->max_code = max_code;
+}
+
+static SDL_INLINE int EncodeFloat(const SDL_FloatEncodeTable *table, float v)
+{
+    const float max_value = table->thresholds[table->max_code - 1];
+    Uint32 bits;
+    int bucket, code, i;
+
+    /* Written to compile to min/max and conditional moves, pixel data is too noisy for branches */
+    v = (v > 0.0f) ? v : 0.0f;
+    v = (v < max_value) ? v : max_value;
+    bits = BitsFromFloat(v);
+    bucket = ((int)(bits >> (23 - FLOAT_ENCODE_BUCKET_BITS))) - ((table->min_exponent + 127) << FLOAT_ENCODE_BUCKET_BITS);
+    bucket = (bucket > 0) ? bucket : 0;
+    code = table->buckets[bucket];
+    for (i = 0; i < table->steps; ++i) {
+        code += (v >= table->thresholds[code]);
+    }
+    return code;
+}
+
+/* Same as SDL_roundf() for values in [0, 2^31), without the function call */
+static SDL_INLINE Uint32 RoundPositive(float v)
+{
+    const Uint32 whole = (Uint32)v;
+    return whole + ((v - (float)whole) >= 0.5f);
+}
+
+static const SDL_FloatDecodeTables *GetFloatDecodeTables(void)
+{
+    SDL_FloatDecodeTables *tables = (SDL_FloatDecodeTables *)SDL_AtomicGetPtr((void **)&float_decode_tables.published);
+    int i;
+
+    if (!tables && SDL_AtomicCompareAndSwap(&float_decode_tables.claimed, 0, 1)) {
+        tables = &float_decode_tables.storage;
+        for (i = 0; i < SDL_arraysize(tables->sRGB_to_linear); ++i) {
+            tables->sRGB_to_linear[i] = SDL_sRGBtoLinear((float)i / 255.0f);
+        }
+        for (i = 0; i < SDL_arraysize(tables->PQ_to_nits); ++i) {
+            tables->PQ_to_nits[i] = SDL_PQtoNits((float)i / 1023.0f);
+        }
+        SDL_AtomicSetPtr((void **)&float_decode_tables.published, tables);
+    }
+    return tables;
+}
+
+/* The encode tables take a while to build, so they're only created when a destination needs them */
+static const SDL_FloatEncodeTable *GetFloatEncodeTable(SDL_TransferCharacteristics transfer)
+{
+    SDL_FloatEncodeTableSlot *slot = (transfer == SDL_TRANSFER_CHARACTERISTICS_SRGB) ? &linear_to_sRGB_table : &nits_to_PQ_table;
+    SDL_FloatEncodeTable *table = (SDL_FloatEncodeTable *)SDL_AtomicGetPtr((void **)&slot->published);
+
+    if (!table && SDL_AtomicCompareAndSwap(&slot->claimed, 0, 1)) {
+        table = &slot->storage;
+        if (transfer == SDL_TRANSFER_CHARACTERISTICS_SRGB) {
+            BuildFloatEncodeTable(table, EncodeSRGB8, 255, 2.0f);
+        } else {
+            BuildFloatEncodeTable(table, EncodePQ10, 1023, 20000.0f);
+        }
+        SDL_AtomicSetPtr((void **)&slot->published, table);
+    }
+    return table;
+}
+
+#ifdef SDL_SSE2_INTRINSICS
+/* Vectorized versions of half_to_float() and float_to_half(), from the same public domain sources */
+static void SDL_TARGETING("sse2") HalfToFloat_SSE2(const Uint16 *src, float *dst, int count)
+{
+    const __m128i mask_nosign = _mm_set1_epi32(0x7fff);
+    const __m128 magic = _mm_castsi128_ps(_mm_set1_epi32((254 - 15) << 23));
+    const __m128i was_infnan = _mm_set1_epi32(0x7bff);
+    const __m128i exp_infnan = _mm_set1_epi32(255 << 23);
+    const __m128i zero = _mm_setzero_si128();
+    int i;
+
+    for (i = 0; i + 4 <= count; i += 4) {
+        __m128i h = _mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i *)&src[i]), zero);
+        __m128i expmant = _mm_and_si128(mask_nosign, h);
+        __m128i justsign = _mm_xor_si128(h, expmant);
+        __m128 scaled = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(expmant, 13)), magic);
+        __m128i infnanexp = _mm_and_si128(_mm_cmpgt_epi32(expmant, was_infnan), exp_infnan);
+        __m128i sign_inf = _mm_or_si128(_mm_slli_epi32(justsign, 16), infnanexp);
+        _mm_storeu_ps(&dst[i], _mm_or_ps(scaled, _mm_castsi128_ps(sign_inf)));
+    }
+    for (; i < count; ++i) {
+        dst[i] = half_to_float(src[i]);
+    }
+}
+
+static void SDL_TARGETING("sse2") FloatToHalf_SSE2(const float *src, Uint16 *dst, int count)
+{
+    const __m128i mask_sign = _mm_set1_epi32(0x80000000u);
+    const __m128i f16max = _mm_set1_epi32((127 + 16) << 23);
+    const __m128i nanbit = _mm_set1_epi32(0x200);
+    const __m128i infty = _mm_set1_epi32(0x7c00);
+    const __m128i min_normal = _mm_set1_epi32((127 - 14) << 23);
+    const __m128i subnorm_magic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+    const __m128i normal_bias = _mm_set1_epi32(0xfff - ((127 - 15) << 23));
+    int i;
+
+    for (i = 0; i + 4 <= count; i += 4) {
+        __m128 f = _mm_loadu_ps(&src[i]);
+        __m128 justsign = _mm_and_ps(_mm_castsi128_ps(mask_sign), f);
+        __m128 absf = _mm_xor_ps(f, justsign);
+        __m128i absf_int = _mm_castps_si128(absf);
+        __m128i is_regular = _mm_cmpgt_epi32(f16max, absf_int);
+        __m128i inf_or_nan = _mm_or_si128(_mm_and_si128(_mm_castps_si128(_mm_cmpunord_ps(absf, absf)), nanbit), infty);
+        __m128i is_subnormal = _mm_cmpgt_epi32(min_normal, absf_int);
+        __m128i subnormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(absf, _mm_castsi128_ps(subnorm_magic))), subnorm_magic);
+        __m128i mant_odd = _mm_srai_epi32(_mm_slli_epi32(absf_int, 31 - 13), 31);
+        __m128i normal = _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(absf_int, normal_bias), mant_odd), 13);
+        __m128i nonspecial = _mm_or_si128(_mm_and_si128(subnormal, is_subnormal), _mm_andnot_si128(is_subnormal, normal));
+        __m128i joined = _mm_or_si128(_mm_and_si128(nonspecial, is_regular), _mm_andnot_si128(is_regular, inf_or_nan));
+        __m128i result = _mm_or_si128(joined, _mm_srai_epi32(_mm_castps_si128(justsign), 16));
+        /* The sign is extended into the upper half, so signed saturation keeps the low 16 bits */
+        _mm_storel_epi64((__m128i *)&dst[i], _mm_packs_epi32(result, result));
+    }
+    for (; i < count; ++i) {
+        dst[i] = float_to_half(src[i]);
+    }
+}
+#endif /* SDL_SSE2_INTRINSICS */
+
+static void HalfToFloat(const Uint16 *src, float *dst, int count)
+{
+    int i;
+
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        HalfToFloat_SSE2(src, dst, count);
+        return;
+    }
+#endif
+    for (i = 0; i < count; ++i) {
+        dst[i] = half_to_float(src[i]);
+    }
+}
+
+static void FloatToHalf(const float *src, Uint16 *dst, int count)
+{
+    int i;
+
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        FloatToHalf_SSE2(src, dst, count);
+        return;
+    }
+#endif
+    for (i = 0; i < count; ++i) {
+        dst[i] = float_to_half(src[i]);
+    }
+}
+
+typedef enum
+{
+    FloatPixelLayout_Generic,
+    FloatPixelLayout_8888,
+    FloatPixelLayout_2101010,
+    FloatPixelLayout_Large
+} FloatPixelLayout;
+
+typedef struct
+{
+    SlowBlitPixelAccess access;
+    FloatPixelLayout layout;
+    SDL_PixelFormat *fmt;
+    SDL_Colorspace colorspace;
+    SDL_TransferCharacteristics transfer;
+    float SDR_white_point;
+    int bpp;
+    Uint32 shift[4];    /* R, G, B, A shifts for 8888 and 2101010 pixels */
+    SDL_bool has_alpha;
+    int channels;       /* array elements per pixel for large pixels */
+    int component[4];   /* array element holding R, G, B, A, or -1 if not present */
+    int element[4];     /* component stored in each array element, or -1 for opaque alpha */
+    const float *to_linear;
+    const SDL_FloatEncodeTable *from_linear;
+} FloatPixelIO;
+
+static void InitFloatPixelIO(FloatPixelIO *io, const SDL_FloatDecodeTables *decode_tables, SDL_PixelFormat *fmt, SDL_Colorspace colorspace, float SDR_white_point, SDL_bool writing)
+{
+    /* The array element holding R, G, B and A for each array order */
+    static const int array_orders[][4] = {
+        { -1, -1, -1, -1 }, /* SDL_ARRAYORDER_NONE */
+        { 0, 1, 2, -1 },    /* SDL_ARRAYORDER_RGB */
+        { 0, 1, 2, 3 },     /* SDL_ARRAYORDER_RGBA */
+        { 1, 2, 3, 0 },     /* SDL_ARRAYORDER_ARGB */
+        { 2, 1, 0, -1 },    /* SDL_ARRAYORDER_BGR */
+        { 2, 1, 0, 3 },     /* SDL_ARRAYORDER_BGRA */
+        { 3, 2, 1, 0 },     /* SDL_ARRAYORDER_ABGR */
+    };
+    int i;
+
+    SDL_zerop(io);
+    io->access = GetPixelAccessMethod(fmt);
+    io->layout = FloatPixelLayout_Generic;
+    io->fmt = fmt;
+    io->colorspace = colorspace;
+    io->transfer = SDL_COLORSPACETRANSFER(colorspace);
+    io->SDR_white_point = SDR_white_point;
+    io->bpp = fmt->bytes_per_pixel;
+
+    switch (io->access) {
+    case SlowBlitPixelAccess_RGB:
+    case SlowBlitPixelAccess_RGBA:
+        if (io->bpp == 4 && fmt->Rloss == 0 && fmt->Gloss == 0 && fmt->Bloss == 0 &&
+            (!fmt->Amask || fmt->Aloss == 0)) {
+            io->layout = FloatPixelLayout_8888;
+            io->shift[0] = fmt->Rshift;
+            io->shift[1] = fmt->Gshift;
+            io->shift[2] = fmt->Bshift;
+            io->shift[3] = fmt->Ashift;
+            io->has_alpha = (io->access == SlowBlitPixelAccess_RGBA);
+            if (io->transfer == SDL_TRANSFER_CHARACTERISTICS_SRGB) {
+                io->to_linear = decode_tables ? decode_tables->sRGB_to_linear : NULL;
+                if (writing) {
+                    io->from_linear = GetFloatEncodeTable(io->transfer);
+                }
+            }
+        }
+        break;
+    case SlowBlitPixelAccess_10Bit:
+        switch (fmt->format) {
+        case SDL_PIXELFORMAT_XRGB2101010:
+        case SDL_PIXELFORMAT_ARGB2101010:
+            io->layout = FloatPixelLayout_2101010;
+            io->shift[0] = 20;
+            io->shift[2] = 0;
+            break;
+        case SDL_PIXELFORMAT_XBGR2101010:
+        case SDL_PIXELFORMAT_ABGR2101010:
+            io->layout = FloatPixelLayout_2101010;
+            io->shift[0] = 0;
+            io->shift[2] = 20;
+            break;
+        default:
+            break;
+        }
+        io->shift[1] = 10;
+        io->shift[3] = 30;
+        io->has_alpha = (fmt->format == SDL_PIXELFORMAT_ARGB2101010 || fmt->format == SDL_PIXELFORMAT_ABGR2101010);
+        if (io->layout == FloatPixelLayout_2101010 && io->transfer == SDL_TRANSFER_CHARACTERISTICS_PQ) {
+            io->to_linear = decode_tables ? decode_tables->PQ_to_nits : NULL;
+            if (writing) {
+                io->from_linear = GetFloatEncodeTable(io->transfer);
+            }
+        }
+        break;
+    case SlowBlitPixelAccess_Large:
+        switch (SDL_PIXELTYPE(fmt->format)) {
+        case SDL_PIXELTYPE_ARRAYU16:
+        case SDL_PIXELTYPE_ARRAYF16:
+            io->channels = io->bpp / 2;
+            break;
+        case SDL_PIXELTYPE_ARRAYF32:
+            io->channels = io->bpp / 4;
+            break;
+        default:
+            break;
+        }
+        if ((io->channels == 3 || io->channels == 4) &&
+            SDL_PIXELORDER(fmt->format) > SDL_ARRAYORDER_NONE &&
+            SDL_PIXELORDER(fmt->format) < SDL_arraysize(array_orders)) {
+            const int *order = array_orders[SDL_PIXELORDER(fmt->format)];
+
+            io->layout = FloatPixelLayout_Large;
+            for (i = 0; i < 4; ++i) {
+                io->element[i] = -1;
+            }
+            for (i = 0; i < 4; ++i) {
+                if (order[i] >= 0 && order[i] < io->channels) {
+                    io->component[i] = order[i];
+                    io->element[order[i]] = i;
+                } else {
+                    io->component[i] = -1;
+                }
+            }
+        }
+        break;
+    }
+}
+
+static void ToLinear(float *rgba, int count, SDL_TransferCharacteristics transfer, float SDR_white_point)
+{
+    int i;
+
+    switch (transfer) {
+    case SDL_TRANSFER_CHARACTERISTICS_SRGB:
+        for (i = 0; i < count; ++i, rgba += 4) {
+            rgba[0] = SDL_sRGBtoLinear(rgba[0]);
+            rgba[1] = SDL_sRGBtoLinear(rgba[1]);
+            rgba[2] = SDL_sRGBtoLinear(rgba[2]);
+        }
+        break;
+    case SDL_TRANSFER_CHARACTERISTICS_PQ:
+        for (i = 0; i < count; ++i, rgba += 4) {
+            rgba[0] = SDL_PQtoNits(rgba[0]) / SDR_white_point;
+            rgba[1] = SDL_PQtoNits(rgba[1]) / SDR_white_point;
+            rgba[2] = SDL_PQtoNits(rgba[2]) / SDR_white_point;
+        }
+        break;
+    case SDL_TRANSFER_CHARACTERISTICS_LINEAR:
+        for (i = 0; i < count; ++i, rgba += 4) {
+            rgba[0] /= SDR_white_point;
+            rgba[1] /= SDR_white_point;
+            rgba[2] /= SDR_white_point;
+        }
+        break;
+    default:
+        /* Unknown, leave it alone */
+        break;
+    }
+}
+
+static void FromLinear(float *rgba, int count, SDL_TransferCharacteristics transfer, float SDR_white_point)
+{
+    int i;
+
+    switch (transfer) {
+    case SDL_TRANSFER_CHARACTERISTICS_SRGB:
+        for (i = 0; i < count; ++i, rgba += 4) {
+            rgba[0] = SDL_sRGBfromLinear(rgba[0]);
+            rgba[1] = SDL_sRGBfromLinear(rgba[1]);
+            rgba[2] = SDL_sRGBfromLinear(rgba[2]);
+        }
+        break;
+    case SDL_TRANSFER_CHARACTERISTICS_PQ:
+        for (i = 0; i < count; ++i, rgba += 4) {
+            rgba[0] = SDL_PQfromNits(rgba[0] * SDR_white_point);
+            rgba[1] = SDL_PQfromNits(rgba[1] * SDR_white_point);
+            rgba[2] = SDL_PQfromNits(rgba[2] * SDR_white_point);
+        }
+        break;
+    case SDL_TRANSFER_CHARACTERISTICS_LINEAR:
+        for (i = 0; i < count; ++i, rgba += 4) {
+            rgba[0] *= SDR_white_point;
+            rgba[1] *= SDR_white_point;
+            rgba[2] *= SDR_white_point;
+        }
+        break;
+    default:
+        /* Unknown, leave it alone */
+        break;
+    }
+}
+
+/* Read count pixels stepping through the row at 16.16 fixed point positions, converted to linear RGBA */
+static void ReadFloatPixels(const FloatPixelIO *io, const Uint8 *row, Uint64 posx, Uint64 incx, int count, float *rgba)
+{
+    Uint16 halves[FLOAT_BLIT_CHUNK * 4];
+    float values[FLOAT_BLIT_CHUNK * 4];
+    float *out = rgba;
+    int i, c;
+
+    switch (io->layout) {
+    case FloatPixelLayout_8888:
+        for (i = 0; i < count; ++i, posx += incx, out += 4) {
+            const Uint32 pixel = *(const Uint32 *)(row + (posx >> 16) * 4);
+            const Uint32 R = (pixel >> io->shift[0]) & 0xFF;
+            const Uint32 G = (pixel >> io->shift[1]) & 0xFF;
+            const Uint32 B = (pixel >> io->shift[2]) & 0xFF;
+            if (io->to_linear) {
+                out[0] = io->to_linear[R];
+                out[1] = io->to_linear[G];
+                out[2] = io->to_linear[B];
+            } else {
+                out[0] = (float)R / 255.0f;
+                out[1] = (float)G / 255.0f;
+                out[2] = (float)B / 255.0f;
+            }
+            out[3] = io->has_alpha ? (float)((pixel >> io->shift[3]) & 0xFF) / 255.0f : 1.0f;
+        }
+        break;
+    case FloatPixelLayout_2101010:
+        for (i = 0; i < count; ++i, posx += incx, out += 4) {
+            const Uint32 pixel = *(const Uint32 *)(row + (posx >> 16) * 4);
+            const Uint32 R = (pixel >> io->shift[0]) & 0x3FF;
+            const Uint32 G = (pixel >> io->shift[1]) & 0x3FF;
+            const Uint32 B = (pixel >> io->shift[2]) & 0x3FF;
+            if (io->to_linear) {
+                out[0] = io->to_linear[R] / io->SDR_white_point;
+                out[1] = io->to_linear[G] / io->SDR_white_point;
+                out[2] = io->to_linear[B] / io->SDR_white_point;
+            } else {
+                out[0] = (float)R / 1023.0f;
+                out[1] = (float)G / 1023.0f;
+                out[2] = (float)B / 1023.0f;
+            }
+            out[3] = io->has_alpha ? (float)SDL_expand_byte[6][pixel >> 30] / 255.0f : 1.0f;
+        }
+        break;
+    case FloatPixelLayout_Large:
+        switch (SDL_PIXELTYPE(io->fmt->format)) {
+        case SDL_PIXELTYPE_ARRAYU16:
+        case SDL_PIXELTYPE_ARRAYF16:
+            for (i = 0; i < count; ++i, posx += incx) {
+                SDL_memcpy(&halves[i * io->channels], row + (posx >> 16) * io->bpp, io->bpp);
+            }
+            if (SDL_PIXELTYPE(io->fmt->format) == SDL_PIXELTYPE_ARRAYF16) {
+                HalfToFloat(halves, values, count * io->channels);
+            } else {
+                for (i = 0; i < count * io->channels; ++i) {
+                    values[i] = (float)halves[i] / SDL_MAX_UINT16;
+                }
+            }
+            break;
+        default:
+            for (i = 0; i < count; ++i, posx += incx) {
+                SDL_memcpy(&values[i * io->channels], row + (posx >> 16) * io->bpp, io->bpp);
+            }
+            break;
+        }
+        for (i = 0; i < count; ++i, out += 4) {
+            const float *v = &values[i * io->channels];
+            for (c = 0; c < 4; ++c) {
+                out[c] = (io->component[c] >= 0) ? v[io->component[c]] : 1.0f;
+            }
+        }
+        break;
+    default:
+        for (i = 0; i < count; ++i, posx += incx, out += 4) {
+            ReadFloatPixel((Uint8 *)row + (posx >> 16) * io->bpp, io->access, io->fmt, io->colorspace, io->SDR_white_point, &out[0], &out[1], &out[2], &out[3]);
+        }
+        return;
+    }
+
+    if (!io->to_linear) {
+        ToLinear(rgba, count, io->transfer, io->SDR_white_point);
+    }
+}
+
+/* Write count linear RGBA pixels to consecutive positions in a row, the input is modified */
+static void WriteFloatPixels(const FloatPixelIO *io, Uint8 *row, int count, float *rgba)
+{
+    Uint16 halves[FLOAT_BLIT_CHUNK * 4];
+    float values[FLOAT_BLIT_CHUNK * 4];
+    float *in = rgba;
+    int i, c;
+
+    if (io->layout == FloatPixelLayout_Generic) {
+        for (i = 0; i < count; ++i, in += 4) {
+            WriteFloatPixel(row + i * io->bpp, io->access, io->fmt, io->colorspace, io->SDR_white_point, in[0], in[1], in[2], in[3]);
+        }
+        return;
+    }
+
+    if (!io->from_linear) {
+        FromLinear(rgba, count, io->transfer, io->SDR_white_point);
+    }
+
+    switch (io->layout) {
+    case FloatPixelLayout_8888:
+        for (i = 0; i < count; ++i, in += 4) {
+            Uint32 R, G, B, pixel;
+            if (io->from_linear) {
+                R = (Uint32)EncodeFloat(io->from_linear, in[0]);
+                G = (Uint32)EncodeFloat(io->from_linear, in[1]);
+                B = (Uint32)EncodeFloat(io->from_linear, in[2]);
+            } else {
+                R = (Uint8)RoundPositive(SDL_clamp(in[0], 0.0f, 1.0f) * 255.0f);
+                G = (Uint8)RoundPositive(SDL_clamp(in[1], 0.0f, 1.0f) * 255.0f);
+                B = (Uint8)RoundPositive(SDL_clamp(in[2], 0.0f, 1.0f) * 255.0f);
+            }
+            pixel = (R << io->shift[0]) | (G << io->shift[1]) | (B << io->shift[2]);
+            if (io->has_alpha) {
+                pixel |= RoundPositive(SDL_clamp(in[3], 0.0f, 1.0f) * 255.0f) << io->shift[3];
+            } else {
+                pixel |= io->fmt->Amask;
+            }
+            *(Uint32 *)(row + i * 4) = pixel;
+        }
+        break;
+    case FloatPixelLayout_2101010:
+        for (i = 0; i < count; ++i, in += 4) {
+            Uint32 R, G, B, A;
+            if (io->from_linear) {
+                R = (Uint32)EncodeFloat(io->from_linear, in[0] * io->SDR_white_point);
+                G = (Uint32)EncodeFloat(io->from_linear, in[1] * io->SDR_white_point);
+                B = (Uint32)EncodeFloat(io->from_linear, in[2] * io->SDR_white_point);
+            } else {
+                R = RoundPositive(SDL_clamp(in[0], 0.0f, 1.0f) * 1023.0f);
+                G = RoundPositive(SDL_clamp(in[1], 0.0f, 1.0f) * 1023.0f);
+                B = RoundPositive(SDL_clamp(in[2], 0.0f, 1.0f) * 1023.0f);
+            }
+            A = io->has_alpha ? RoundPositive(SDL_clamp(in[3], 0.0f, 1.0f) * 3.0f) : 3;
+            *(Uint32 *)(row + i * 4) = (A << io->shift[3]) | (R << io->shift[0]) | (G << io->shift[1]) | (B << io->shift[2]);
+        }
+        break;
+    case FloatPixelLayout_Large:
+        for (i = 0; i < count; ++i, in += 4) {
+            float *v = &values[i * io->channels];
+            for (c = 0; c < io->channels; ++c) {
+                v[c] = (io->element[c] >= 0) ? in[io->element[c]] : 1.0f;
+            }
+        }
+        switch (SDL_PIXELTYPE(io->fmt->format)) {
+        case SDL_PIXELTYPE_ARRAYU16:
+            for (i = 0; i < count * io->channels; ++i) {
+                halves[i] = (Uint16)RoundPositive(SDL_clamp(values[i], 0.0f, 1.0f) * SDL_MAX_UINT16);
+            }
+            SDL_memcpy(row, halves, count * io->bpp);
+            break;
+        case SDL_PIXELTYPE_ARRAYF16:
+            FloatToHalf(values, halves, count * io->channels);
+            SDL_memcpy(row, halves, count * io->bpp);
+            break;
+        default:
+            SDL_memcpy(row, values, count * io->bpp);
+            break;
+        }
+        break;
+    default:
+        break;
+    }
+}
+
 typedef enum
 {
     SDL_TONEMAP_NONE,
@@ -739,17 +1380,15 @@ void SDL_Blit_Slow_Float(SDL_BlitInfo *info)
     const Uint32 modulateG = info->g;
     const Uint32 modulateB = info->b;
     const Uint32 modulateA = info->a;
-    float srcR, srcG, srcB, srcA;
-    float dstR, dstG, dstB, dstA;
-    Uint64 srcy, srcx;
+    const SDL_bool read_dst = (flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL)) ? SDL_TRUE : SDL_FALSE;
+    float src_pixels[FLOAT_BLIT_CHUNK * 4];
+    float dst_pixels[FLOAT_BLIT_CHUNK * 4];
+    Uint64 srcy;
     Uint64 posy, posx;
     Uint64 incy, incx;
-    SDL_PixelFormat *src_fmt = info->src_fmt;
-    SDL_PixelFormat *dst_fmt = info->dst_fmt;
-    int srcbpp = src_fmt->bytes_per_pixel;
-    int dstbpp = dst_fmt->bytes_per_pixel;
-    SlowBlitPixelAccess src_access;
-    SlowBlitPixelAccess dst_access;
+    const SDL_FloatDecodeTables *decode_tables;
+    FloatPixelIO src_io;
+    FloatPixelIO dst_io;
     SDL_Colorspace src_colorspace;
     SDL_Colorspace dst_colorspace;
     SDL_ColorPrimaries src_primaries;
@@ -810,96 +1449,120 @@ void SDL_Blit_Slow_Float(SDL_BlitInfo *info)
         color_primaries_matrix = SDL_GetColorPrimariesConversionMatrix(src_primaries, dst_primaries);
     }
 
-    src_access = GetPixelAccessMethod(src_fmt);
-    dst_access = GetPixelAccessMethod(dst_fmt);
+    if (!read_dst) {
+        /* don't care */
+        SDL_zeroa(dst_pixels);
+    }
+
+    decode_tables = GetFloatDecodeTables();
+    InitFloatPixelIO(&src_io, decode_tables, info->src_fmt, src_colorspace, src_white_point, SDL_FALSE);
+    InitFloatPixelIO(&dst_io, decode_tables, info->dst_fmt, dst_colorspace, dst_white_point, SDL_TRUE);
 
     incy = ((Uint64)info->src_h << 16) / info->dst_h;
     incx = ((Uint64)info->src_w << 16) / info->dst_w;
     posy = incy / 2; /* start at the middle of pixel */
 
     while (info->dst_h--) {
-        Uint8 *src = 0;
+        const Uint8 *src_row;
         Uint8 *dst = info->dst;
-        int n = info->dst_w;
+        int x = 0;
         posx = incx / 2; /* start at the middle of pixel */
         srcy = posy >> 16;
-        while (n--) {
-            srcx = posx >> 16;
-            src = (info->src + (srcy * info->src_pitch) + (srcx * srcbpp));
+        src_row = info->src + (int)srcy * info->src_pitch;
+        while (x < info->dst_w) {
+            const int count = SDL_min(info->dst_w - x, FLOAT_BLIT_CHUNK);
+            float *srcpx = src_pixels;
+            float *dstpx = dst_pixels;
+            int i;
 
-            ReadFloatPixel(src, src_access, src_fmt, src_colorspace, src_white_point, &srcR, &srcG, &srcB, &srcA);
+            ReadFloatPixels(&src_io, src_row, posx, incx, count, src_pixels);
+            posx += incx * count;
 
             if (tonemap.op) {
-                ApplyTonemap(&tonemap, &srcR, &srcG, &srcB);
+                for (i = 0; i < count; ++i) {
+                    ApplyTonemap(&tonemap, &src_pixels[i * 4 + 0], &src_pixels[i * 4 + 1], &src_pixels[i * 4 + 2]);
+                }
             }
 
             if (color_primaries_matrix) {
-                SDL_ConvertColorPrimaries(&srcR, &srcG, &srcB, color_primaries_matrix);
+                const float *m = color_primaries_matrix;
+                for (i = 0; i < count; ++i, srcpx += 4) {
+                    const float r = srcpx[0], g = srcpx[1], b = srcpx[2];
+                    srcpx[0] = m[0 * 3 + 0] * r + m[0 * 3 + 1] * g + m[0 * 3 + 2] * b;
+                    srcpx[1] = m[1 * 3 + 0] * r + m[1 * 3 + 1] * g + m[1 * 3 + 2] * b;
+                    srcpx[2] = m[2 * 3 + 0] * r + m[2 * 3 + 1] * g + m[2 * 3 + 2] * b;
+                }
+                srcpx = src_pixels;
             }
 
             if (flags & SDL_COPY_COLORKEY) {
                 /* colorkey isn't supported */
             }
-            if ((flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL))) {
-                ReadFloatPixel(dst, dst_access, dst_fmt, dst_colorspace, dst_white_point, &dstR, &dstG, &dstB, &dstA);
-            } else {
-                /* don't care */
-                dstR = dstG = dstB = dstA = 0.0f;
+            if (read_dst) {
+                ReadFloatPixels(&dst_io, dst, 0x8000, 0x10000, count, dst_pixels);
             }
 
-            if (flags & SDL_COPY_MODULATE_COLOR) {
-                srcR = (srcR * modulateR) / 255;
-                srcG = (srcG * modulateG) / 255;
-                srcB = (srcB * modulateB) / 255;
-            }
-            if (flags & SDL_COPY_MODULATE_ALPHA) {
-                srcA = (srcA * modulateA) / 255;
-            }
-            if (flags & (SDL_COPY_BLEND | SDL_COPY_ADD)) {
-                /* This goes away if we ever use premultiplied alpha */
-                if (srcA < 1.0f) {
-                    srcR = (srcR * srcA);
-                    srcG = (srcG * srcA);
-                    srcB = (srcB * srcA);
+            for (i = 0; i < count; ++i, srcpx += 4, dstpx += 4) {
+                float srcR = srcpx[0], srcG = srcpx[1], srcB = srcpx[2], srcA = srcpx[3];
+                float dstR = dstpx[0], dstG = dstpx[1], dstB = dstpx[2], dstA = dstpx[3];
+
+                if (flags & SDL_COPY_MODULATE_COLOR) {
+                    srcR = (srcR * modulateR) / 255;
+                    srcG = (srcG * modulateG) / 255;
+                    srcB = (srcB * modulateB) / 255;
                 }
-            }
-            switch (flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL)) {
-            case 0:
-                dstR = srcR;
-                dstG = srcG;
-                dstB = srcB;
-                dstA = srcA;
-                break;
-            case SDL_COPY_BLEND:
-                dstR = srcR + ((1.0f - srcA) * dstR);
-                dstG = srcG + ((1.0f - srcA) * dstG);
-                dstB = srcB + ((1.0f - srcA) * dstB);
-                dstA = srcA + ((1.0f - srcA) * dstA);
-                break;
-            case SDL_COPY_ADD:
-                dstR = srcR + dstR;
-                dstG = srcG + dstG;
-                dstB = srcB + dstB;
-                break;
-            case SDL_COPY_MOD:
-                dstR = (srcR * dstR);
-                dstG = (srcG * dstG);
-                dstB = (srcB * dstB);
-                break;
-            case SDL_COPY_MUL:
-                dstR = ((srcR * dstR) + (dstR * (1.0f - srcA)));
-                dstG = ((srcG * dstG) + (dstG * (1.0f - srcA)));
-                dstB = ((srcB * dstB) + (dstB * (1.0f - srcA)));
-                break;
+                if (flags & SDL_COPY_MODULATE_ALPHA) {
+                    srcA = (srcA * modulateA) / 255;
+                }
+                if (flags & (SDL_COPY_BLEND | SDL_COPY_ADD)) {
+                    /* This goes away if we ever use premultiplied alpha */
+                    if (srcA < 1.0f) {
+                        srcR = (srcR * srcA);
+                        srcG = (srcG * srcA);
+                        srcB = (srcB * srcA);
+                    }
+                }
+                switch (flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL)) {
+                case 0:
+                    dstR = srcR;
+                    dstG = srcG;
+                    dstB = srcB;
+                    dstA = srcA;
+                    break;
+                case SDL_COPY_BLEND:
+                    dstR = srcR + ((1.0f - srcA) * dstR);
+                    dstG = srcG + ((1.0f - srcA) * dstG);
+                    dstB = srcB + ((1.0f - srcA) * dstB);
+                    dstA = srcA + ((1.0f - srcA) * dstA);
+                    break;
+                case SDL_COPY_ADD:
+                    dstR = srcR + dstR;
+                    dstG = srcG + dstG;
+                    dstB = srcB + dstB;
+                    break;
+                case SDL_COPY_MOD:
+                    dstR = (srcR * dstR);
+                    dstG = (srcG * dstG);
+                    dstB = (srcB * dstB);
+                    break;
+                case SDL_COPY_MUL:
+                    dstR = ((srcR * dstR) + (dstR * (1.0f - srcA)));
+                    dstG = ((srcG * dstG) + (dstG * (1.0f - srcA)));
+                    dstB = ((srcB * dstB) + (dstB * (1.0f - srcA)));
+                    break;
+                }
+                dstpx[0] = dstR;
+                dstpx[1] = dstG;
+                dstpx[2] = dstB;
+                dstpx[3] = dstA;
             }
 
-            WriteFloatPixel(dst, dst_access, dst_fmt, dst_colorspace, dst_white_point, dstR, dstG, dstB, dstA);
+            WriteFloatPixels(&dst_io, dst, count, dst_pixels);
 
-            posx += incx;
-            dst += dstbpp;
+            dst += count * dst_io.bpp;
+            x += count;
         }
         posy += incy;
         info->dst += info->dst_pitch;
     }
 }
-
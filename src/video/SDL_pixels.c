@@ -27,6 +27,7 @@
 #include "SDL_pixels_c.h"
 #include "SDL_RLEaccel_c.h"
 #include "../SDL_list.h"
+#include "../SDL_hashtable.h"
 
 /* Lookup tables to expand partial bytes to the full 0..255 range */
 
@@ -1030,6 +1031,121 @@ void SDL_ConvertColorPrimaries(float *fR, float *fG, float *fB, const float *mat
     *fB = matrix[2 * 3 + 0] * v[0] + matrix[2 * 3 + 1] * v[1] + matrix[2 * 3 + 2] * v[2];
 }
 
+/* Nearest color search acceleration
+
+   Palettes created by SDL_CreatePalette() are registered here so that opaque
+   lookups can use a lazily built cell grid: RGB space is split into 16x16x16
+   cells, and each cell keeps only the palette entries that could possibly be
+   the nearest color for some point inside it. The grid is exact, it returns
+   the same index as a full scan, and it is rebuilt when the palette version
+   changes.
+
+   The global lock only covers finding a palette's cache. Each cache has its
+   own read/write lock, so lookups in cells that are already built run in
+   parallel, and building a cell only blocks lookups on the same palette.
+ */
+#define PALETTE_CELL_BITS   4
+#define PALETTE_CELL_SIZE   (1 << (8 - PALETTE_CELL_BITS))
+#define PALETTE_NUM_CELLS   (1 << (3 * PALETTE_CELL_BITS))
+#define PALETTE_CACHE_MIN_COLORS    16
+
+typedef struct SDL_PaletteCell
+{
+    Uint32 offset;
+    Uint16 count;
+    Uint16 built;
+} SDL_PaletteCell;
+
+typedef struct SDL_PaletteCache
+{
+    SDL_RWLock *lock;
+    Uint32 version;
+    int ncolors;
+    const SDL_Color *colors;
+    Uint8 *candidates;
+    Uint32 num_candidates;
+    Uint32 max_candidates;
+    SDL_PaletteCell cells[PALETTE_NUM_CELLS];
+} SDL_PaletteCache;
+
+static SDL_SpinLock SDL_palette_cache_lock;
+static SDL_HashTable *SDL_palette_caches;
+
+static SDL_PaletteCache *SDL_CreatePaletteCache(void)
+{
+    SDL_PaletteCache *cache = (SDL_PaletteCache *)SDL_calloc(1, sizeof(*cache));
+
+    if (cache) {
+        cache->lock = SDL_CreateRWLock();
+        if (!cache->lock) {
+            SDL_free(cache);
+            return NULL;
+        }
+    }
+    return cache;
+}
+
+static void SDL_DestroyPaletteCache(SDL_PaletteCache *cache)
+{
+    if (cache) {
+        SDL_DestroyRWLock(cache->lock);
+        SDL_free(cache->candidates);
+        SDL_free(cache);
+    }
+}
+
+static void SDL_NukePaletteCache(const void *key, const void *value, void *unused)
+{
+    /* The caches are freed by their owners, outside of SDL_palette_cache_lock */
+}
+
+static void SDL_RegisterPalette(SDL_Palette *palette)
+{
+    SDL_HashTable *caches = NULL;
+    SDL_bool need_table;
+
+    SDL_LockSpinlock(&SDL_palette_cache_lock);
+    need_table = SDL_palette_caches ? SDL_FALSE : SDL_TRUE;
+    SDL_UnlockSpinlock(&SDL_palette_cache_lock);
+
+    if (need_table) {
+        caches = SDL_CreateHashTable(NULL, 16, SDL_HashID, SDL_KeyMatchID, SDL_NukePaletteCache, SDL_FALSE);
+    }
+
+    SDL_LockSpinlock(&SDL_palette_cache_lock);
+    if (!SDL_palette_caches) {
+        SDL_palette_caches = caches;
+        caches = NULL;
+    }
+    if (SDL_palette_caches) {
+        /* If this fails the palette simply won't be accelerated */
+        SDL_InsertIntoHashTable(SDL_palette_caches, palette, NULL);
+    }
+    SDL_UnlockSpinlock(&SDL_palette_cache_lock);
+
+    SDL_DestroyHashTable(caches);
+}
+
+static void SDL_UnregisterPalette(SDL_Palette *palette)
+{
+    SDL_HashTable *caches = NULL;
+    const void *value = NULL;
+
+    SDL_LockSpinlock(&SDL_palette_cache_lock);
+    if (SDL_palette_caches) {
+        SDL_FindInHashTable(SDL_palette_caches, palette, &value);
+        SDL_RemoveFromHashTable(SDL_palette_caches, palette);
+        if (SDL_HashTableEmpty(SDL_palette_caches)) {
+            caches = SDL_palette_caches;
+            SDL_palette_caches = NULL;
+        }
+    }
+    SDL_UnlockSpinlock(&SDL_palette_cache_lock);
+
+    SDL_DestroyPaletteCache((SDL_PaletteCache *)value);
+    SDL_DestroyHashTable(caches);
+}
+
 SDL_Palette *SDL_CreatePalette(int ncolors)
 {
     SDL_Palette *palette;
@@ -1056,6 +1172,8 @@ SDL_Palette *SDL_CreatePalette(int ncolors)
 
     SDL_memset(palette->colors, 0xFF, ncolors * sizeof(*palette->colors));
 
+    SDL_RegisterPalette(palette);
+
     return palette;
 }
 
@@ -1120,6 +1238,7 @@ void SDL_DestroyPalette(SDL_Palette *palette)
     if (--palette->refcount > 0) {
         return;
     }
+    SDL_UnregisterPalette(palette);
     SDL_free(palette->colors);
     SDL_free(palette);
 }
@@ -1152,28 +1271,267 @@ void SDL_DitherColors(SDL_Color *colors, int bpp)
     }
 }
 
-/*
- * Match an RGB value to a particular palette index
+/* Find the first palette entry with the smallest squared RGBA distance */
+static int SDL_FindColorScan_std(int i, const SDL_Color *colors, int ncolors, int r, int g, int b, int a, int pixel, unsigned int smallest)
+{
+    unsigned int distance;
+    int rd, gd, bd, ad;
+
+    for (; i < ncolors; ++i) {
+        rd = colors[i].r - r;
+        gd = colors[i].g - g;
+        bd = colors[i].b - b;
+        ad = colors[i].a - a;
+        distance = (rd * rd) + (gd * gd) + (bd * bd) + (ad * ad);
+        if (distance < smallest) {
+            pixel = i;
+            if (distance == 0) { /* Perfect match! */
+                break;
+            }
+            smallest = distance;
+        }
+    }
+    return pixel;
+}
+
+/* Reduce the per-lane winners, preferring the lowest index on ties */
+static int SDL_FindColorReduce(const Uint32 *distances, const Uint32 *indices, unsigned int *smallest)
+{
+    int lane, best = 0;
+
+    for (lane = 1; lane < 4; ++lane) {
+        if (distances[lane] < distances[best] ||
+            (distances[lane] == distances[best] && indices[lane] < indices[best])) {
+            best = lane;
+        }
+    }
+    *smallest = distances[best];
+    return (int)indices[best];
+}
+
+#ifdef SDL_SSE2_INTRINSICS
+static int SDL_TARGETING("sse2") SDL_FindColorScan_SSE2(const SDL_Color *colors, int ncolors, int r, int g, int b, int a)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i four = _mm_set1_epi32(4);
+    const __m128i target = _mm_set_epi16(a, b, g, r, a, b, g, r);
+    __m128i smallest = _mm_set1_epi32(0x7FFFFFFF);
+    __m128i pixels = _mm_setzero_si128();
+    __m128i index = _mm_set_epi32(3, 2, 1, 0);
+    Uint32 distances[4], indices[4];
+    unsigned int best;
+    int i, pixel;
+
+    if (ncolors < 4) {
+        return SDL_FindColorScan_std(0, colors, ncolors, r, g, b, a, 0, ~0U);
+    }
+
+    for (i = 0; i + 4 <= ncolors; i += 4) {
+        __m128i c = _mm_loadu_si128((const __m128i *)&colors[i]);
+        __m128i lo = _mm_sub_epi16(_mm_unpacklo_epi8(c, zero), target);
+        __m128i hi = _mm_sub_epi16(_mm_unpackhi_epi8(c, zero), target);
+        __m128 sums_lo = _mm_castsi128_ps(_mm_madd_epi16(lo, lo));
+        __m128 sums_hi = _mm_castsi128_ps(_mm_madd_epi16(hi, hi));
+        __m128i distance = _mm_add_epi32(_mm_castps_si128(_mm_shuffle_ps(sums_lo, sums_hi, _MM_SHUFFLE(2, 0, 2, 0))),
+                                         _mm_castps_si128(_mm_shuffle_ps(sums_lo, sums_hi, _MM_SHUFFLE(3, 1, 3, 1))));
+        __m128i closer = _mm_cmplt_epi32(distance, smallest);
+
+        smallest = _mm_or_si128(_mm_and_si128(closer, distance), _mm_andnot_si128(closer, smallest));
+        pixels = _mm_or_si128(_mm_and_si128(closer, index), _mm_andnot_si128(closer, pixels));
+        index = _mm_add_epi32(index, four);
+    }
+    _mm_storeu_si128((__m128i *)distances, smallest);
+    _mm_storeu_si128((__m128i *)indices, pixels);
+    pixel = SDL_FindColorReduce(distances, indices, &best);
+    if (best == 0) {
+        return pixel;
+    }
+    return SDL_FindColorScan_std(i, colors, ncolors, r, g, b, a, pixel, best);
+}
+#endif /* SDL_SSE2_INTRINSICS */
+
+#ifdef SDL_NEON_INTRINSICS
+static int SDL_FindColorScan_NEON(const SDL_Color *colors, int ncolors, int r, int g, int b, int a)
+{
+    const uint8x16_t target = vreinterpretq_u8_u32(vdupq_n_u32((Uint32)r | ((Uint32)g << 8) | ((Uint32)b << 16) | ((Uint32)a << 24)));
+    const uint32x4_t four = vdupq_n_u32(4);
+    static const Uint32 first_index[4] = { 0, 1, 2, 3 };
+    uint32x4_t smallest = vdupq_n_u32(0xFFFFFFFF);
+    uint32x4_t pixels = vdupq_n_u32(0);
+    uint32x4_t index = vld1q_u32(first_index);
+    Uint32 distances[4], indices[4];
+    unsigned int best;
+    int i, pixel;
+
+    if (ncolors < 4) {
+        return SDL_FindColorScan_std(0, colors, ncolors, r, g, b, a, 0, ~0U);
+    }
+
+    for (i = 0; i + 4 <= ncolors; i += 4) {
+        uint8x16_t diff = vabdq_u8(vld1q_u8((const Uint8 *)&colors[i]), target);
+        uint32x4_t sums_lo = vpaddlq_u16(vmull_u8(vget_low_u8(diff), vget_low_u8(diff)));
+        uint32x4_t sums_hi = vpaddlq_u16(vmull_u8(vget_high_u8(diff), vget_high_u8(diff)));
+        uint32x4_t distance = vcombine_u32(vpadd_u32(vget_low_u32(sums_lo), vget_high_u32(sums_lo)),
+                                           vpadd_u32(vget_low_u32(sums_hi), vget_high_u32(sums_hi)));
+        uint32x4_t closer = vcltq_u32(distance, smallest);
+
+        smallest = vbslq_u32(closer, distance, smallest);
+        pixels = vbslq_u32(closer, index, pixels);
+        index = vaddq_u32(index, four);
+    }
+    vst1q_u32(distances, smallest);
+    vst1q_u32(indices, pixels);
+    pixel = SDL_FindColorReduce(distances, indices, &best);
+    if (best == 0) {
+        return pixel;
+    }
+    return SDL_FindColorScan_std(i, colors, ncolors, r, g, b, a, pixel, best);
+}
+#endif /* SDL_NEON_INTRINSICS */
+
+static int SDL_FindColorScan(const SDL_Color *colors, int ncolors, int r, int g, int b, int a)
+{
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        return SDL_FindColorScan_SSE2(colors, ncolors, r, g, b, a);
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        return SDL_FindColorScan_NEON(colors, ncolors, r, g, b, a);
+    }
+#endif
+    return SDL_FindColorScan_std(0, colors, ncolors, r, g, b, a, 0, ~0U);
+}
+
+/* Collect the palette entries that can be nearest to some color in a cell.
+   An entry whose closest possible distance to the cell is farther than the
+   best guaranteed distance of another entry can never win, so it's dropped.
+   The survivors stay in palette order so ties resolve as in a full scan.
  */
-Uint8 SDL_FindColor(SDL_Palette *pal, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+static SDL_bool SDL_BuildPaletteCell(SDL_PaletteCache *cache, SDL_PaletteCell *cell, int cell_index)
+{
+    const SDL_Color *colors = cache->colors;
+    const int ncolors = cache->ncolors;
+    int lo[3], hi[3];
+    Uint32 mindist[256];
+    Uint32 bound = ~0U;
+    Uint32 count = 0;
+    int i, c;
+
+    lo[0] = ((cell_index >> (2 * PALETTE_CELL_BITS)) & (PALETTE_CELL_SIZE - 1)) * PALETTE_CELL_SIZE;
+    lo[1] = ((cell_index >> PALETTE_CELL_BITS) & (PALETTE_CELL_SIZE - 1)) * PALETTE_CELL_SIZE;
+    lo[2] = (cell_index & (PALETTE_CELL_SIZE - 1)) * PALETTE_CELL_SIZE;
+    for (c = 0; c < 3; ++c) {
+        hi[c] = lo[c] + PALETTE_CELL_SIZE - 1;
+    }
+
+    for (i = 0; i < ncolors; ++i) {
+        const int v[3] = { colors[i].r, colors[i].g, colors[i].b };
+        const int ad = colors[i].a - SDL_ALPHA_OPAQUE;
+        Uint32 near_dist = (Uint32)(ad * ad);
+        Uint32 far_dist = near_dist;
+
+        for (c = 0; c < 3; ++c) {
+            int near_d = 0, far_d;
+
+            if (v[c] < lo[c]) {
+                near_d = lo[c] - v[c];
+            } else if (v[c] > hi[c]) {
+                near_d = v[c] - hi[c];
+            }
+            far_d = SDL_max(SDL_abs(v[c] - lo[c]), SDL_abs(v[c] - hi[c]));
+            near_dist += (Uint32)(near_d * near_d);
+            far_dist += (Uint32)(far_d * far_d);
+        }
+        mindist[i] = near_dist;
+        if (far_dist < bound) {
+            bound = far_dist;
+        }
+    }
+
+    for (i = 0; i < ncolors; ++i) {
+        if (mindist[i] <= bound) {
+            ++count;
+        }
+    }
+
+    if (cache->num_candidates + count > cache->max_candidates) {
+        Uint32 max_candidates = SDL_max(cache->max_candidates * 2, cache->num_candidates + count);
+        Uint8 *candidates = (Uint8 *)SDL_realloc(cache->candidates, max_candidates);
+        if (!candidates) {
+            return SDL_FALSE;
+        }
+        cache->candidates = candidates;
+        cache->max_candidates = max_candidates;
+    }
+
+    cell->offset = cache->num_candidates;
+    cell->count = (Uint16)count;
+    for (i = 0; i < ncolors; ++i) {
+        if (mindist[i] <= bound) {
+            cache->candidates[cache->num_candidates++] = (Uint8)i;
+        }
+    }
+    cell->built = 1;
+    return SDL_TRUE;
+}
+
+/* Find the cache of a registered palette, creating it on first use. Returns NULL if the palette isn't registered. */
+static SDL_PaletteCache *SDL_GetPaletteCache(SDL_Palette *pal)
 {
-    /* Do colorspace distance matching */
-    unsigned int smallest;
+    SDL_PaletteCache *cache;
+    const void *value = NULL;
+    SDL_bool registered;
+
+    SDL_LockSpinlock(&SDL_palette_cache_lock);
+    registered = (SDL_palette_caches && SDL_FindInHashTable(SDL_palette_caches, pal, &value)) ? SDL_TRUE : SDL_FALSE;
+    SDL_UnlockSpinlock(&SDL_palette_cache_lock);
+
+    if (!registered || value) {
+        return (SDL_PaletteCache *)value;
+    }
+
+    /* Create the cache without the lock held, another thread may beat us to it */
+    cache = SDL_CreatePaletteCache();
+    if (!cache) {
+        return NULL;
+    }
+
+    SDL_LockSpinlock(&SDL_palette_cache_lock);
+    value = NULL;
+    if (SDL_palette_caches && SDL_FindInHashTable(SDL_palette_caches, pal, &value) && !value) {
+        SDL_RemoveFromHashTable(SDL_palette_caches, pal);
+        if (SDL_InsertIntoHashTable(SDL_palette_caches, pal, cache)) {
+            value = cache;
+            cache = NULL;
+        }
+    }
+    SDL_UnlockSpinlock(&SDL_palette_cache_lock);
+
+    SDL_DestroyPaletteCache(cache);
+    return (SDL_PaletteCache *)value;
+}
+
+static int SDL_FindColorInCell(const SDL_Palette *pal, const SDL_PaletteCache *cache, const SDL_PaletteCell *cell, Uint8 r, Uint8 g, Uint8 b)
+{
+    const Uint8 *candidates = &cache->candidates[cell->offset];
+    unsigned int smallest = ~0U;
     unsigned int distance;
     int rd, gd, bd, ad;
+    int pixel = -1;
     int i;
-    Uint8 pixel = 0;
 
-    smallest = ~0U;
-    for (i = 0; i < pal->ncolors; ++i) {
-        rd = pal->colors[i].r - r;
-        gd = pal->colors[i].g - g;
-        bd = pal->colors[i].b - b;
-        ad = pal->colors[i].a - a;
+    for (i = 0; i < cell->count; ++i) {
+        const SDL_Color *color = &pal->colors[candidates[i]];
+        rd = color->r - r;
+        gd = color->g - g;
+        bd = color->b - b;
+        ad = color->a - SDL_ALPHA_OPAQUE;
         distance = (rd * rd) + (gd * gd) + (bd * bd) + (ad * ad);
         if (distance < smallest) {
-            pixel = (Uint8)i;
-            if (distance == 0) { /* Perfect match! */
+            pixel = candidates[i];
+            if (distance == 0) {
                 break;
             }
             smallest = distance;
@@ -1182,6 +1540,60 @@ Uint8 SDL_FindColor(SDL_Palette *pal, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
     return pixel;
 }
 
+/* Look up an opaque color through the palette cache, returns -1 if the palette isn't cached */
+static int SDL_FindColorCached(SDL_Palette *pal, Uint8 r, Uint8 g, Uint8 b)
+{
+    SDL_PaletteCache *cache = SDL_GetPaletteCache(pal);
+    SDL_PaletteCell *cell;
+    const int cell_index = ((r >> (8 - PALETTE_CELL_BITS)) << (2 * PALETTE_CELL_BITS)) |
+                           ((g >> (8 - PALETTE_CELL_BITS)) << PALETTE_CELL_BITS) |
+                           (b >> (8 - PALETTE_CELL_BITS));
+    int pixel = -1;
+
+    if (!cache) {
+        return -1;
+    }
+    cell = &cache->cells[cell_index];
+
+    /* The common case: the cell is already built for this version of the palette */
+    SDL_LockRWLockForReading(cache->lock);
+    if (cache->version == pal->version && cache->ncolors == pal->ncolors && cache->colors == pal->colors && cell->built) {
+        pixel = SDL_FindColorInCell(pal, cache, cell, r, g, b);
+        SDL_UnlockRWLock(cache->lock);
+        return pixel;
+    }
+    SDL_UnlockRWLock(cache->lock);
+
+    SDL_LockRWLockForWriting(cache->lock);
+    if (cache->version != pal->version || cache->ncolors != pal->ncolors || cache->colors != pal->colors) {
+        cache->version = pal->version;
+        cache->ncolors = pal->ncolors;
+        cache->colors = pal->colors;
+        cache->num_candidates = 0;
+        SDL_zeroa(cache->cells);
+    }
+    if (cell->built || SDL_BuildPaletteCell(cache, cell, cell_index)) {
+        pixel = SDL_FindColorInCell(pal, cache, cell, r, g, b);
+    }
+    SDL_UnlockRWLock(cache->lock);
+
+    return pixel;
+}
+
+/*
+ * Match an RGB value to a particular palette index
+ */
+Uint8 SDL_FindColor(SDL_Palette *pal, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+    if (a == SDL_ALPHA_OPAQUE && pal->ncolors > PALETTE_CACHE_MIN_COLORS && pal->ncolors <= 256) {
+        int pixel = SDL_FindColorCached(pal, r, g, b);
+        if (pixel >= 0) {
+            return (Uint8)pixel;
+        }
+    }
+    return (Uint8)SDL_FindColorScan(pal->colors, pal->ncolors, r, g, b, a);
+}
+
 /* Tell whether palette is opaque, and if it has an alpha_channel */
 void SDL_DetectPalette(SDL_Palette *pal, SDL_bool *is_opaque, SDL_bool *has_alpha_channel)
 {
@@ -1174,11 +1174,175 @@ void SDL_UnlockSurface(SDL_Surface *surface)
 #endif
 }
 
+/*
+ * Horizontal flipping
+ *
+ * The SIMD versions swap a block of pixels from each end of the row at a time,
+ * reversing the order of the pixels in each block, and return how many pixels
+ * from each end they handled. The remaining pixels in the middle of the row are
+ * swapped one at a time.
+ */
+#ifdef SDL_SSE4_1_INTRINSICS
+/* Each block is the whole pixels that fit in 16 bytes. When that's less than 16
+   bytes, the left block starts at the beginning of a load and the right block
+   ends at the end of one, and the bytes past the block are stored unchanged. */
+static int SDL_TARGETING("sse4.1") SDL_FlipRowHorizontal_SSE41(Uint8 *row, int width, int bpp)
+{
+    const int npixels = 16 / bpp;
+    const int length = npixels * bpp;
+    const int offset = 16 - length;
+    Uint8 left_from_right[16], left_from_left[16], right_from_left[16], right_from_right[16];
+    __m128i mask_lr, mask_ll, mask_rl, mask_rr, left, right;
+    Uint8 *a, *b;
+    int i, x;
+
+    for (i = 0; i < 16; ++i) {
+        const int pixel = i / bpp;
+        const int byte = i % bpp;
+
+        left_from_right[i] = (i < length) ? (Uint8)(offset + (npixels - 1 - pixel) * bpp + byte) : 0x80;
+        left_from_left[i] = (i < length) ? 0x80 : (Uint8)i;
+        right_from_left[i] = (i < offset) ? 0x80 : (Uint8)((npixels - 1 - (i - offset) / bpp) * bpp + (i - offset) % bpp);
+        right_from_right[i] = (i < offset) ? (Uint8)i : 0x80;
+    }
+    mask_lr = _mm_loadu_si128((const __m128i *)left_from_right);
+    mask_ll = _mm_loadu_si128((const __m128i *)left_from_left);
+    mask_rl = _mm_loadu_si128((const __m128i *)right_from_left);
+    mask_rr = _mm_loadu_si128((const __m128i *)right_from_right);
+
+    a = row;
+    b = row + width * bpp - 16;
+    for (x = 0; a + 16 <= b; x += npixels) {
+        left = _mm_loadu_si128((const __m128i *)a);
+        right = _mm_loadu_si128((const __m128i *)b);
+        _mm_storeu_si128((__m128i *)a, _mm_or_si128(_mm_shuffle_epi8(right, mask_lr), _mm_shuffle_epi8(left, mask_ll)));
+        _mm_storeu_si128((__m128i *)b, _mm_or_si128(_mm_shuffle_epi8(left, mask_rl), _mm_shuffle_epi8(right, mask_rr)));
+        a += length;
+        b -= length;
+    }
+    return x;
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#ifdef SDL_NEON_INTRINSICS
+static uint8x16_t SDL_ReverseBytes_NEON(uint8x16_t v)
+{
+    v = vrev64q_u8(v);
+    return vcombine_u8(vget_high_u8(v), vget_low_u8(v));
+}
+
+static int SDL_FlipRowHorizontal_NEON(Uint8 *row, int width, int bpp)
+{
+    Uint8 *a, *b;
+    int x = 0;
+
+    if (bpp == 3) {
+        uint8x16x3_t left, right;
+        int i;
+
+        a = row;
+        b = row + width * 3 - 48;
+        for (; a + 48 <= b; x += 16) {
+            left = vld3q_u8(a);
+            right = vld3q_u8(b);
+            for (i = 0; i < 3; ++i) {
+                left.val[i] = SDL_ReverseBytes_NEON(left.val[i]);
+                right.val[i] = SDL_ReverseBytes_NEON(right.val[i]);
+            }
+            vst3q_u8(a, right);
+            vst3q_u8(b, left);
+            a += 48;
+            b -= 48;
+        }
+    } else if (bpp == 1 || bpp == 2 || bpp == 4 || bpp == 8) {
+        uint8x16_t left, right;
+
+        a = row;
+        b = row + width * bpp - 16;
+        for (; a + 16 <= b; x += 16 / bpp) {
+            left = vld1q_u8(a);
+            right = vld1q_u8(b);
+            switch (bpp) {
+            case 1:
+                left = vrev64q_u8(left);
+                right = vrev64q_u8(right);
+                break;
+            case 2:
+                left = vreinterpretq_u8_u16(vrev64q_u16(vreinterpretq_u16_u8(left)));
+                right = vreinterpretq_u8_u16(vrev64q_u16(vreinterpretq_u16_u8(right)));
+                break;
+            case 4:
+                left = vreinterpretq_u8_u32(vrev64q_u32(vreinterpretq_u32_u8(left)));
+                right = vreinterpretq_u8_u32(vrev64q_u32(vreinterpretq_u32_u8(right)));
+                break;
+            default:
+                break;
+            }
+            vst1q_u8(a, vcombine_u8(vget_high_u8(right), vget_low_u8(right)));
+            vst1q_u8(b, vcombine_u8(vget_high_u8(left), vget_low_u8(left)));
+            a += 16;
+            b -= 16;
+        }
+    }
+    return x;
+}
+#endif /* SDL_NEON_INTRINSICS */
+
+#define FLIP_PIXELS(type, units)                                  \
+    {                                                             \
+        type *a = (type *)row + x * (units);                      \
+        type *b = (type *)row + (width - 1 - x) * (units);        \
+        type t;                                                   \
+        int k;                                                    \
+        for (; x < width / 2; ++x) {                              \
+            for (k = 0; k < (units); ++k) {                       \
+                t = a[k];                                         \
+                a[k] = b[k];                                      \
+                b[k] = t;                                         \
+            }                                                     \
+            a += (units);                                         \
+            b -= (units);                                         \
+        }                                                         \
+    }
+
+/* Swap the pixels from x up to the middle of the row with their mirror images */
+static void SDL_FlipRowHorizontal(Uint8 *row, int width, int bpp, int x)
+{
+    switch (bpp) {
+    case 1:
+        FLIP_PIXELS(Uint8, 1);
+        break;
+    case 2:
+        FLIP_PIXELS(Uint16, 1);
+        break;
+    case 3:
+        FLIP_PIXELS(Uint8, 3);
+        break;
+    case 4:
+        FLIP_PIXELS(Uint32, 1);
+        break;
+    case 8:
+        FLIP_PIXELS(Uint32, 2);
+        break;
+    default:
+        if ((bpp % 4) == 0) {
+            FLIP_PIXELS(Uint32, bpp / 4);
+        } else if ((bpp % 2) == 0) {
+            FLIP_PIXELS(Uint16, bpp / 2);
+        } else {
+            FLIP_PIXELS(Uint8, bpp);
+        }
+        break;
+    }
+}
+
+#undef FLIP_PIXELS
+
 static int SDL_FlipSurfaceHorizontal(SDL_Surface *surface)
 {
-    SDL_bool isstack;
-    Uint8 *row, *a, *b, *tmp;
-    int i, j, bpp;
+    int (*flip_simd)(Uint8 *row, int width, int bpp) = NULL;
+    Uint8 *row;
+    int i, x, bpp;
 
     if (surface->format->bits_per_pixel < 8) {
         /* We could implement this if needed, but we'd have to flip sets of bits within a byte */
@@ -1194,21 +1358,23 @@ static int SDL_FlipSurfaceHorizontal(SDL_Surface *surface)
     }
 
     bpp = surface->format->bytes_per_pixel;
+#ifdef SDL_SSE4_1_INTRINSICS
+    if (bpp <= 8 && SDL_HasSSE41()) {
+        flip_simd = SDL_FlipRowHorizontal_SSE41;
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (!flip_simd && bpp <= 8 && SDL_HasNEON()) {
+        flip_simd = SDL_FlipRowHorizontal_NEON;
+    }
+#endif
+
     row = (Uint8 *)surface->pixels;
-    tmp = SDL_small_alloc(Uint8, surface->pitch, &isstack);
     for (i = surface->h; i--; ) {
-        a = row;
-        b = a + (surface->w - 1) * bpp;
-        for (j = surface->w / 2; j--; ) {
-            SDL_memcpy(tmp, a, bpp);
-            SDL_memcpy(a, b, bpp);
-            SDL_memcpy(b, tmp, bpp);
-            a += bpp;
-            b -= bpp;
-        }
+        x = flip_simd ? flip_simd(row, surface->w, bpp) : 0;
+        SDL_FlipRowHorizontal(row, surface->w, bpp, x);
         row += surface->pitch;
     }
-    SDL_small_free(tmp, isstack);
     return 0;
 }
 
@@ -1659,6 +1825,162 @@ SDL_Surface *SDL_DuplicatePixels(int width, int height, Uint32 format, SDL_Color
     return surface;
 }
 
+/*
+ * Conversion plans
+ *
+ * Setting up the surfaces and blit mapping for a conversion can cost more than
+ * the conversion itself when small rectangles are converted, e.g. when a
+ * streaming texture is updated in tiles. Conversions without extra properties
+ * keep their surfaces and blit mapping around in a small cache, keyed on the
+ * formats and colorspaces, so repeated conversions only need to run the blit.
+ *
+ * A plan is taken out of the cache while it's in use, so threads converting
+ * the same formats at the same time will each get their own plan.
+ */
+#define SDL_MAX_CONVERSION_PLANS 8
+
+typedef struct SDL_ConversionPlan
+{
+    Uint32 src_format;
+    SDL_Colorspace src_colorspace;
+    Uint32 dst_format;
+    SDL_Colorspace dst_colorspace;
+    SDL_Surface src_surface, dst_surface;
+    SDL_PixelFormat src_fmt, dst_fmt;
+    SDL_BlitMap src_blitmap, dst_blitmap;
+    struct SDL_ConversionPlan *next;
+} SDL_ConversionPlan;
+
+static SDL_SpinLock SDL_conversion_plans_lock;
+static SDL_ConversionPlan *SDL_conversion_plans; /* most recently used first */
+
+static void SDL_DestroyConversionPlan(SDL_ConversionPlan *plan)
+{
+    SDL_DestroySurfaceOnStack(&plan->src_surface);
+    SDL_DestroySurfaceOnStack(&plan->dst_surface);
+    SDL_free(plan);
+}
+
+static SDL_ConversionPlan *SDL_CreateConversionPlan(Uint32 src_format, SDL_Colorspace src_colorspace, Uint32 dst_format, SDL_Colorspace dst_colorspace)
+{
+    SDL_ConversionPlan *plan = (SDL_ConversionPlan *)SDL_calloc(1, sizeof(*plan));
+    if (!plan) {
+        return NULL;
+    }
+    plan->src_format = src_format;
+    plan->src_colorspace = src_colorspace;
+    plan->dst_format = dst_format;
+    plan->dst_colorspace = dst_colorspace;
+
+    if (!SDL_CreateSurfaceOnStack(0, 0, src_format, src_colorspace, 0, NULL, 0, &plan->src_surface, &plan->src_fmt, &plan->src_blitmap) ||
+        !SDL_CreateSurfaceOnStack(0, 0, dst_format, dst_colorspace, 0, NULL, 0, &plan->dst_surface, &plan->dst_fmt, &plan->dst_blitmap) ||
+        SDL_MapSurface(&plan->src_surface, &plan->dst_surface) < 0) {
+        SDL_DestroyConversionPlan(plan);
+        return NULL;
+    }
+    return plan;
+}
+
+static SDL_ConversionPlan *SDL_AcquireConversionPlan(Uint32 src_format, SDL_Colorspace src_colorspace, Uint32 dst_format, SDL_Colorspace dst_colorspace)
+{
+    SDL_ConversionPlan *plan, *prev = NULL;
+
+    SDL_LockSpinlock(&SDL_conversion_plans_lock);
+    for (plan = SDL_conversion_plans; plan; prev = plan, plan = plan->next) {
+        if (plan->src_format == src_format && plan->src_colorspace == src_colorspace &&
+            plan->dst_format == dst_format && plan->dst_colorspace == dst_colorspace) {
+            if (prev) {
+                prev->next = plan->next;
+            } else {
+                SDL_conversion_plans = plan->next;
+            }
+            break;
+        }
+    }
+    SDL_UnlockSpinlock(&SDL_conversion_plans_lock);
+
+    if (plan) {
+        plan->next = NULL;
+        return plan;
+    }
+    return SDL_CreateConversionPlan(src_format, src_colorspace, dst_format, dst_colorspace);
+}
+
+static void SDL_ReleaseConversionPlan(SDL_ConversionPlan *plan)
+{
+    SDL_ConversionPlan *evicted, *last;
+    int count;
+
+    SDL_LockSpinlock(&SDL_conversion_plans_lock);
+    plan->next = SDL_conversion_plans;
+    SDL_conversion_plans = plan;
+    last = plan;
+    for (count = 1; count < SDL_MAX_CONVERSION_PLANS && last->next; ++count) {
+        last = last->next;
+    }
+    evicted = last->next;
+    last->next = NULL;
+    SDL_UnlockSpinlock(&SDL_conversion_plans_lock);
+
+    while (evicted) {
+        plan = evicted;
+        evicted = evicted->next;
+        SDL_DestroyConversionPlan(plan);
+    }
+}
+
+void SDL_QuitPixelConversion(void)
+{
+    SDL_ConversionPlan *plan;
+
+    SDL_LockSpinlock(&SDL_conversion_plans_lock);
+    plan = SDL_conversion_plans;
+    SDL_conversion_plans = NULL;
+    SDL_UnlockSpinlock(&SDL_conversion_plans_lock);
+
+    while (plan) {
+        SDL_ConversionPlan *next = plan->next;
+        SDL_DestroyConversionPlan(plan);
+        plan = next;
+    }
+}
+
+static int SDL_ConvertPixelsWithPlan(int width, int height,
+                      Uint32 src_format, SDL_Colorspace src_colorspace, const void *src, int src_pitch,
+                      Uint32 dst_format, SDL_Colorspace dst_colorspace, void *dst, int dst_pitch)
+{
+    SDL_ConversionPlan *plan;
+    SDL_Rect rect;
+    int ret;
+
+    plan = SDL_AcquireConversionPlan(src_format, src_colorspace, dst_format, dst_colorspace);
+    if (!plan) {
+        return -1;
+    }
+
+    plan->src_surface.pixels = (void *)src;
+    plan->src_surface.w = width;
+    plan->src_surface.h = height;
+    plan->src_surface.pitch = src_pitch;
+    plan->dst_surface.pixels = dst;
+    plan->dst_surface.w = width;
+    plan->dst_surface.h = height;
+    plan->dst_surface.pitch = dst_pitch;
+
+    /* Set up the rect and go! */
+    rect.x = 0;
+    rect.y = 0;
+    rect.w = width;
+    rect.h = height;
+    ret = SDL_BlitSurfaceUnchecked(&plan->src_surface, &rect, &plan->dst_surface, &rect);
+
+    plan->src_surface.pixels = NULL;
+    plan->dst_surface.pixels = NULL;
+    SDL_ReleaseConversionPlan(plan);
+
+    return ret;
+}
+
 int SDL_ConvertPixelsAndColorspace(int width, int height,
                       Uint32 src_format, SDL_Colorspace src_colorspace, SDL_PropertiesID src_properties, const void *src, int src_pitch,
                       Uint32 dst_format, SDL_Colorspace dst_colorspace, SDL_PropertiesID dst_properties, void *dst, int dst_pitch)
@@ -1691,6 +2013,9 @@ int SDL_ConvertPixelsAndColorspace(int width, int height,
     }
 
 #if SDL_HAVE_YUV
+    if ((SDL_ISPIXELFORMAT_FOURCC(src_format) || SDL_ISPIXELFORMAT_FOURCC(dst_format)) && src_pitch < 0) {
+        return SDL_InvalidParamError("src_pitch");
+    }
     if (SDL_ISPIXELFORMAT_FOURCC(src_format) && SDL_ISPIXELFORMAT_FOURCC(dst_format)) {
         return SDL_ConvertPixels_YUV_to_YUV(width, height, src_format, src_colorspace, src_properties, src, src_pitch, dst_format, dst_colorspace, dst_properties, dst, dst_pitch);
     } else if (SDL_ISPIXELFORMAT_FOURCC(src_format)) {
@@ -1717,6 +2042,10 @@ int SDL_ConvertPixelsAndColorspace(int width, int height,
         return 0;
     }
 
+    if (!src_properties && !dst_properties) {
+        return SDL_ConvertPixelsWithPlan(width, height, src_format, src_colorspace, src, src_pitch, dst_format, dst_colorspace, dst, dst_pitch);
+    }
+
     if (!SDL_CreateSurfaceOnStack(width, height, src_format, src_colorspace, src_properties, nonconst_src, src_pitch, &src_surface, &src_fmt, &src_blitmap)) {
         return -1;
     }
@@ -1748,23 +2077,267 @@ int SDL_ConvertPixels(int width, int height,
 }
 
 /*
- * Premultiply the alpha on a block of pixels
+ * Premultiplied alpha
  *
- * This is currently only implemented for SDL_PIXELFORMAT_ARGB8888
+ * Both directions work on the four 32-bit layouts with an alpha channel. The
+ * color channels are processed the same way no matter where they are, so the
+ * row functions only need to know which byte holds the alpha.
  *
- * Here are some ideas for optimization:
- * https://github.com/Wizermil/premultiply_alpha/tree/master/premultiply_alpha
- * https://developer.arm.com/documentation/101964/0201/Pre-multiplied-alpha-channel-data
+ * Premultiplication uses exact rounding, (x * a + 127) / 255, computed with
+ * the usual multiply and shift trick: t = x * a + 128, (t + (t >> 8)) >> 8.
  */
-int SDL_PremultiplyAlpha(int width, int height,
-                         Uint32 src_format, const void *src, int src_pitch,
-                         Uint32 dst_format, void *dst, int dst_pitch)
+typedef int (*SDL_AlphaRowFunc)(int width, const Uint32 *src, Uint32 *dst, int ashift);
+
+static int GetAlphaShift8888(Uint32 format)
+{
+    switch (format) {
+    case SDL_PIXELFORMAT_ARGB8888:
+    case SDL_PIXELFORMAT_ABGR8888:
+        return 24;
+    case SDL_PIXELFORMAT_RGBA8888:
+    case SDL_PIXELFORMAT_BGRA8888:
+        return 0;
+    default:
+        return -1;
+    }
+}
+
+static void PremultiplyAlphaRow_std(int x, int width, const Uint32 *src, Uint32 *dst, int ashift)
+{
+    const Uint32 amask = (Uint32)0xFF << ashift;
+
+    for (; x < width; ++x) {
+        const Uint32 pixel = src[x];
+        const Uint32 a = (pixel >> ashift) & 0xFF;
+        Uint32 t0, t1;
+
+        /* Two channels at a time, every product fits in its own 16 bits */
+        t0 = (pixel & 0x00FF00FF) * a + 0x00800080;
+        t0 = ((t0 + ((t0 >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF;
+        t1 = ((pixel >> 8) & 0x00FF00FF) * a + 0x00800080;
+        t1 = (t1 + ((t1 >> 8) & 0x00FF00FF)) & 0xFF00FF00;
+
+        dst[x] = ((t0 | t1) & ~amask) | (pixel & amask);
+    }
+}
+
+static void UnpremultiplyAlphaRow_std(int x, int width, const Uint32 *src, Uint32 *dst, int ashift)
+{
+    const Uint32 amask = (Uint32)0xFF << ashift;
+    int i;
+
+    for (; x < width; ++x) {
+        const Uint32 pixel = src[x];
+        const Uint32 a = (pixel >> ashift) & 0xFF;
+        Uint32 result;
+
+        if (a == 0xFF) {
+            result = pixel;
+        } else if (a == 0) {
+            result = 0;
+        } else {
+            result = pixel & amask;
+            for (i = 0; i < 32; i += 8) {
+                if (i != ashift) {
+                    const Uint32 c = (((pixel >> i) & 0xFF) * 255 + (a >> 1)) / a;
+                    result |= SDL_min(c, 255) << i;
+                }
+            }
+        }
+        dst[x] = result;
+    }
+}
+
+#ifdef SDL_SSE2_INTRINSICS
+static int SDL_TARGETING("sse2") PremultiplyAlphaRow_SSE2(int width, const Uint32 *src, Uint32 *dst, int ashift)
+{
+    const __m128i amask = _mm_set1_epi32((int)((Uint32)0xFF << ashift));
+    const __m128i bias = _mm_set1_epi16(128);
+    const __m128i zero = _mm_setzero_si128();
+    __m128i px, lo, hi, alo, ahi;
+    int x;
+
+    for (x = 0; x + 4 <= width; x += 4) {
+        px = _mm_loadu_si128((const __m128i *)(src + x));
+        lo = _mm_unpacklo_epi8(px, zero);
+        hi = _mm_unpackhi_epi8(px, zero);
+        if (ashift) {
+            alo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+            ahi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+        } else {
+            alo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, _MM_SHUFFLE(0, 0, 0, 0)), _MM_SHUFFLE(0, 0, 0, 0));
+            ahi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, _MM_SHUFFLE(0, 0, 0, 0)), _MM_SHUFFLE(0, 0, 0, 0));
+        }
+        lo = _mm_add_epi16(_mm_mullo_epi16(lo, alo), bias);
+        hi = _mm_add_epi16(_mm_mullo_epi16(hi, ahi), bias);
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+        lo = _mm_packus_epi16(lo, hi);
+        _mm_storeu_si128((__m128i *)(dst + x), _mm_or_si128(_mm_andnot_si128(amask, lo), _mm_and_si128(amask, px)));
+    }
+    return x;
+}
+
+/* The float quotient can be off by one after truncation, but every product involved
+   is exact in a float, so it can be corrected without any integer division */
+static int SDL_TARGETING("sse2") UnpremultiplyAlphaRow_SSE2(int width, const Uint32 *src, Uint32 *dst, int ashift)
+{
+    const __m128i amask = _mm_set1_epi32((int)((Uint32)0xFF << ashift));
+    const __m128i zero = _mm_setzero_si128();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 f255 = _mm_set1_ps(255.0f);
+    __m128i px, a8, px16, c, ai, result[4];
+    __m128 a, n, q;
+    int x, i;
+
+    for (x = 0; x + 4 <= width; x += 4) {
+        px = _mm_loadu_si128((const __m128i *)(src + x));
+        a8 = _mm_and_si128(px, amask);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(a8, amask)) == 0xFFFF) {
+            _mm_storeu_si128((__m128i *)(dst + x), px);  /* all opaque */
+            continue;
+        }
+
+        /* One pixel per register, its four channels in 32-bit lanes */
+        for (i = 0; i < 4; ++i) {
+            px16 = (i < 2) ? _mm_unpacklo_epi8(px, zero) : _mm_unpackhi_epi8(px, zero);
+            c = (i & 1) ? _mm_unpackhi_epi16(px16, zero) : _mm_unpacklo_epi16(px16, zero);
+            ai = ashift ? _mm_shuffle_epi32(c, _MM_SHUFFLE(3, 3, 3, 3)) : _mm_shuffle_epi32(c, _MM_SHUFFLE(0, 0, 0, 0));
+            a = _mm_cvtepi32_ps(ai);
+            n = _mm_cvtepi32_ps(_mm_add_epi32(_mm_sub_epi32(_mm_slli_epi32(c, 8), c), _mm_srli_epi32(ai, 1)));
+            q = _mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_div_ps(n, _mm_max_ps(a, one))));
+            q = _mm_sub_ps(q, _mm_and_ps(_mm_cmpgt_ps(_mm_mul_ps(q, a), n), one));
+            q = _mm_add_ps(q, _mm_and_ps(_mm_cmple_ps(_mm_mul_ps(_mm_add_ps(q, one), a), n), one));
+            q = _mm_and_ps(_mm_min_ps(q, f255), _mm_cmpgt_ps(a, _mm_setzero_ps()));
+            result[i] = _mm_cvttps_epi32(q);
+        }
+        px16 = _mm_packus_epi16(_mm_packs_epi32(result[0], result[1]), _mm_packs_epi32(result[2], result[3]));
+        _mm_storeu_si128((__m128i *)(dst + x), _mm_or_si128(_mm_andnot_si128(amask, px16), a8));
+    }
+    return x;
+}
+#endif /* SDL_SSE2_INTRINSICS */
+
+#ifdef SDL_AVX2_INTRINSICS
+static int SDL_TARGETING("avx2") PremultiplyAlphaRow_AVX2(int width, const Uint32 *src, Uint32 *dst, int ashift)
 {
-    int c;
-    Uint32 srcpixel;
-    Uint32 srcR, srcG, srcB, srcA;
-    Uint32 dstpixel;
-    Uint32 dstR, dstG, dstB, dstA;
+    const __m256i amask = _mm256_set1_epi32((int)((Uint32)0xFF << ashift));
+    const __m256i bias = _mm256_set1_epi16(128);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ashuffle = ashift ? _mm256_setr_epi8(6, 7, 6, 7, 6, 7, 6, 7, 14, 15, 14, 15, 14, 15, 14, 15, 6, 7, 6, 7, 6, 7, 6, 7, 14, 15, 14, 15, 14, 15, 14, 15)
+                                    : _mm256_setr_epi8(0, 1, 0, 1, 0, 1, 0, 1, 8, 9, 8, 9, 8, 9, 8, 9, 0, 1, 0, 1, 0, 1, 0, 1, 8, 9, 8, 9, 8, 9, 8, 9);
+    __m256i px, lo, hi;
+    int x;
+
+    for (x = 0; x + 8 <= width; x += 8) {
+        px = _mm256_loadu_si256((const __m256i *)(src + x));
+        lo = _mm256_unpacklo_epi8(px, zero);
+        hi = _mm256_unpackhi_epi8(px, zero);
+        lo = _mm256_add_epi16(_mm256_mullo_epi16(lo, _mm256_shuffle_epi8(lo, ashuffle)), bias);
+        hi = _mm256_add_epi16(_mm256_mullo_epi16(hi, _mm256_shuffle_epi8(hi, ashuffle)), bias);
+        lo = _mm256_srli_epi16(_mm256_add_epi16(lo, _mm256_srli_epi16(lo, 8)), 8);
+        hi = _mm256_srli_epi16(_mm256_add_epi16(hi, _mm256_srli_epi16(hi, 8)), 8);
+        lo = _mm256_packus_epi16(lo, hi);
+        _mm256_storeu_si256((__m256i *)(dst + x), _mm256_or_si256(_mm256_andnot_si256(amask, lo), _mm256_and_si256(amask, px)));
+    }
+    return x;
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#ifdef SDL_NEON_INTRINSICS
+static int PremultiplyAlphaRow_NEON(int width, const Uint32 *src, Uint32 *dst, int ashift)
+{
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+    const int aindex = ashift / 8;
+#else
+    const int aindex = 3 - ashift / 8;
+#endif
+    uint8x8x4_t px;
+    uint8x8_t a;
+    uint16x8_t t;
+    int x, i;
+
+    for (x = 0; x + 8 <= width; x += 8) {
+        px = vld4_u8((const Uint8 *)(src + x));
+        a = px.val[aindex];
+        for (i = 0; i < 4; ++i) {
+            if (i != aindex) {
+                t = vmull_u8(px.val[i], a);
+                px.val[i] = vraddhn_u16(t, vrshrq_n_u16(t, 8));
+            }
+        }
+        vst4_u8((Uint8 *)(dst + x), px);
+    }
+    return x;
+}
+
+SDL_FORCE_INLINE uint16x8_t UnpremultiplyAlpha_NEON(uint8x8_t c, float32x4_t alo, float32x4_t ahi, float32x4_t rlo, float32x4_t rhi, uint8x8_t half)
+{
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    const uint16x8_t n16 = vaddw_u8(vmull_u8(c, vdup_n_u8(255)), half);
+    const float32x4_t nlo = vcvtq_f32_u32(vmovl_u16(vget_low_u16(n16)));
+    const float32x4_t nhi = vcvtq_f32_u32(vmovl_u16(vget_high_u16(n16)));
+    float32x4_t qlo = vcvtq_f32_u32(vcvtq_u32_f32(vmulq_f32(nlo, rlo)));
+    float32x4_t qhi = vcvtq_f32_u32(vcvtq_u32_f32(vmulq_f32(nhi, rhi)));
+
+    /* Same correction as the SSE2 version, the estimate can be off by one */
+    qlo = vsubq_f32(qlo, vreinterpretq_f32_u32(vandq_u32(vcgtq_f32(vmulq_f32(qlo, alo), nlo), vreinterpretq_u32_f32(one))));
+    qhi = vsubq_f32(qhi, vreinterpretq_f32_u32(vandq_u32(vcgtq_f32(vmulq_f32(qhi, ahi), nhi), vreinterpretq_u32_f32(one))));
+    qlo = vaddq_f32(qlo, vreinterpretq_f32_u32(vandq_u32(vcleq_f32(vmulq_f32(vaddq_f32(qlo, one), alo), nlo), vreinterpretq_u32_f32(one))));
+    qhi = vaddq_f32(qhi, vreinterpretq_f32_u32(vandq_u32(vcleq_f32(vmulq_f32(vaddq_f32(qhi, one), ahi), nhi), vreinterpretq_u32_f32(one))));
+    return vcombine_u16(vmovn_u32(vcvtq_u32_f32(qlo)), vmovn_u32(vcvtq_u32_f32(qhi)));
+}
+
+static int UnpremultiplyAlphaRow_NEON(int width, const Uint32 *src, Uint32 *dst, int ashift)
+{
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+    const int aindex = ashift / 8;
+#else
+    const int aindex = 3 - ashift / 8;
+#endif
+    uint8x8x4_t px;
+    uint8x8_t a, nonzero;
+    uint16x8_t a16;
+    float32x4_t alo, ahi, rlo, rhi;
+    int x, i;
+
+    for (x = 0; x + 8 <= width; x += 8) {
+        px = vld4_u8((const Uint8 *)(src + x));
+        a = px.val[aindex];
+        if (vget_lane_u64(vreinterpret_u64_u8(vmvn_u8(a)), 0) == 0) {
+            vst4_u8((Uint8 *)(dst + x), px);  /* all opaque */
+            continue;
+        }
+
+        a16 = vmovl_u8(vmax_u8(a, vdup_n_u8(1)));
+        alo = vcvtq_f32_u32(vmovl_u16(vget_low_u16(a16)));
+        ahi = vcvtq_f32_u32(vmovl_u16(vget_high_u16(a16)));
+        rlo = vrecpeq_f32(alo);
+        rlo = vmulq_f32(vrecpsq_f32(alo, rlo), rlo);
+        rlo = vmulq_f32(vrecpsq_f32(alo, rlo), rlo);
+        rhi = vrecpeq_f32(ahi);
+        rhi = vmulq_f32(vrecpsq_f32(ahi, rhi), rhi);
+        rhi = vmulq_f32(vrecpsq_f32(ahi, rhi), rhi);
+        nonzero = vtst_u8(a, a);
+        for (i = 0; i < 4; ++i) {
+            if (i != aindex) {
+                px.val[i] = vand_u8(vqmovn_u16(UnpremultiplyAlpha_NEON(px.val[i], alo, ahi, rlo, rhi, vshr_n_u8(a, 1))), nonzero);
+            }
+        }
+        vst4_u8((Uint8 *)(dst + x), px);
+    }
+    return x;
+}
+#endif /* SDL_NEON_INTRINSICS */
+
+static int SDL_ProcessAlpha(int width, int height,
+                            Uint32 src_format, const void *src, int src_pitch,
+                            Uint32 dst_format, void *dst, int dst_pitch,
+                            SDL_bool premultiply)
+{
+    SDL_AlphaRowFunc row_func = NULL;
+    const int ashift = GetAlphaShift8888(dst_format);
+    int x;
 
     if (!src) {
         return SDL_InvalidParamError("src");
@@ -1778,30 +2351,63 @@ int SDL_PremultiplyAlpha(int width, int height,
     if (!dst_pitch) {
         return SDL_InvalidParamError("dst_pitch");
     }
-    if (src_format != SDL_PIXELFORMAT_ARGB8888) {
+    if (GetAlphaShift8888(src_format) < 0) {
         return SDL_InvalidParamError("src_format");
     }
-    if (dst_format != SDL_PIXELFORMAT_ARGB8888) {
+    if (ashift < 0) {
         return SDL_InvalidParamError("dst_format");
     }
 
+    /* Reorder the channels first, then work on the destination in place */
+    if (src_format != dst_format) {
+        if (SDL_ConvertPixels(width, height, src_format, src, src_pitch, dst_format, dst, dst_pitch) < 0) {
+            return -1;
+        }
+        src = dst;
+        src_pitch = dst_pitch;
+    }
+
+    if (premultiply) {
+#ifdef SDL_AVX2_INTRINSICS
+        if (!row_func && SDL_HasAVX2()) {
+            row_func = PremultiplyAlphaRow_AVX2;
+        }
+#endif
+#ifdef SDL_SSE2_INTRINSICS
+        if (!row_func && SDL_HasSSE2()) {
+            row_func = PremultiplyAlphaRow_SSE2;
+        }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+        if (!row_func && SDL_HasNEON()) {
+            row_func = PremultiplyAlphaRow_NEON;
+        }
+#endif
+    } else {
+#ifdef SDL_SSE2_INTRINSICS
+        if (!row_func && SDL_HasSSE2()) {
+            row_func = UnpremultiplyAlphaRow_SSE2;
+        }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+        if (!row_func && SDL_HasNEON()) {
+            row_func = UnpremultiplyAlphaRow_NEON;
+        }
+#endif
+    }
+
     while (height--) {
         const Uint32 *src_px = (const Uint32 *)src;
         Uint32 *dst_px = (Uint32 *)dst;
-        for (c = width; c; --c) {
-            /* Component bytes extraction. */
-            srcpixel = *src_px++;
-            RGBA_FROM_ARGB8888(srcpixel, srcR, srcG, srcB, srcA);
-
-            /* Alpha pre-multiplication of each component. */
-            dstA = srcA;
-            dstR = (srcA * srcR) / 255;
-            dstG = (srcA * srcG) / 255;
-            dstB = (srcA * srcB) / 255;
-
-            /* ARGB8888 pixel recomposition. */
-            ARGB8888_FROM_RGBA(dstpixel, dstR, dstG, dstB, dstA);
-            *dst_px++ = dstpixel;
+
+        x = 0;
+        if (row_func) {
+            x = row_func(width, src_px, dst_px, ashift);
+        }
+        if (premultiply) {
+            PremultiplyAlphaRow_std(x, width, src_px, dst_px, ashift);
+        } else {
+            UnpremultiplyAlphaRow_std(x, width, src_px, dst_px, ashift);
         }
         src = (const Uint8 *)src + src_pitch;
         dst = (Uint8 *)dst + dst_pitch;
@@ -1809,6 +2415,20 @@ int SDL_PremultiplyAlpha(int width, int height,
     return 0;
 }
 
+int SDL_PremultiplyAlpha(int width, int height,
+                         Uint32 src_format, const void *src, int src_pitch,
+                         Uint32 dst_format, void *dst, int dst_pitch)
+{
+    return SDL_ProcessAlpha(width, height, src_format, src, src_pitch, dst_format, dst, dst_pitch, SDL_TRUE);
+}
+
+int SDL_UnpremultiplyAlpha(int width, int height,
+                           Uint32 src_format, const void *src, int src_pitch,
+                           Uint32 dst_format, void *dst, int dst_pitch)
+{
+    return SDL_ProcessAlpha(width, height, src_format, src, src_pitch, dst_format, dst, dst_pitch, SDL_FALSE);
+}
+
 /* This function Copyright 2023 Collabora Ltd., contributed to SDL under the ZLib license */
 int SDL_ReadSurfacePixel(SDL_Surface *surface, int x, int y, Uint8 *r, Uint8 *g, Uint8 *b, Uint8 *a)
 {
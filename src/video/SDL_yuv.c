@@ -28,6 +28,7 @@
 
 #if SDL_HAVE_YUV
 static SDL_bool IsPlanar2x2Format(Uint32 format);
+static SDL_bool IsP0xxFormat(Uint32 format);
 #endif
 
 /*
@@ -41,7 +42,7 @@ int SDL_CalculateYUVSize(Uint32 format, int w, int h, size_t *size, size_t *pitc
 #if SDL_HAVE_YUV
     int sz_plane = 0, sz_plane_chroma = 0, sz_plane_packed = 0;
 
-    if (IsPlanar2x2Format(format) == SDL_TRUE) {
+    if (IsPlanar2x2Format(format) == SDL_TRUE || IsP0xxFormat(format) == SDL_TRUE) {
         {
             /* sz_plane == w * h; */
             size_t s1;
@@ -147,6 +148,33 @@ int SDL_CalculateYUVSize(Uint32 format, int w, int h, size_t *size, size_t *pitc
         }
         break;
 
+    case SDL_PIXELFORMAT_P010: /**< Planar mode: Y + U/V interleaved  (2 planes) */
+    case SDL_PIXELFORMAT_P016: /**< Planar mode: Y + U/V interleaved  (2 planes) */
+        if (pitch) {
+            /* pitch == w * 2; */
+            size_t p1;
+            if (SDL_size_mul_overflow(w, 2, &p1) < 0) {
+                return SDL_SetError("width * 2 would overflow");
+            }
+            *pitch = p1;
+        }
+
+        if (size) {
+            /* dst_size == (sz_plane + sz_plane_chroma + sz_plane_chroma) * 2; */
+            size_t s1, s2, s3;
+            if (SDL_size_add_overflow(sz_plane, sz_plane_chroma, &s1) < 0) {
+                return SDL_SetError("Y + U would overflow");
+            }
+            if (SDL_size_add_overflow(s1, sz_plane_chroma, &s2) < 0) {
+                return SDL_SetError("Y + U + V would overflow");
+            }
+            if (SDL_size_mul_overflow(s2, 2, &s3) < 0) {
+                return SDL_SetError("(Y + U + V) * 2 would overflow");
+            }
+            *size = (int) s3;
+        }
+        break;
+
     default:
         return SDL_Unsupported();
     }
@@ -190,6 +218,11 @@ static SDL_bool IsPacked4Format(Uint32 format)
     return format == SDL_PIXELFORMAT_YUY2 || format == SDL_PIXELFORMAT_UYVY || format == SDL_PIXELFORMAT_YVYU;
 }
 
+static SDL_bool IsP0xxFormat(Uint32 format)
+{
+    return format == SDL_PIXELFORMAT_P010 || format == SDL_PIXELFORMAT_P016;
+}
+
 static int GetYUVPlanes(int width, int height, Uint32 format, const void *yuv, int yuv_pitch,
                         const Uint8 **y, const Uint8 **u, const Uint8 **v, Uint32 *y_stride, Uint32 *uv_stride)
 {
@@ -219,6 +252,14 @@ static int GetYUVPlanes(int width, int height, Uint32 format, const void *yuv, i
         planes[0] = (const Uint8 *)yuv;
         planes[1] = planes[0] + pitches[0] * height;
         break;
+    case SDL_PIXELFORMAT_P010:
+    case SDL_PIXELFORMAT_P016:
+        /* Like NV12 with 16-bit samples */
+        pitches[0] = yuv_pitch;
+        pitches[1] = 4 * ((pitches[0] / 2 + 1) / 2);
+        planes[0] = (const Uint8 *)yuv;
+        planes[1] = planes[0] + pitches[0] * height;
+        break;
     default:
         return SDL_SetError("GetYUVPlanes(): Unsupported YUV format: %s", SDL_GetPixelFormatName(format));
     }
@@ -266,6 +307,14 @@ static int GetYUVPlanes(int width, int height, Uint32 format, const void *yuv, i
         *v = *u + 1;
         *uv_stride = pitches[1];
         break;
+    case SDL_PIXELFORMAT_P010:
+    case SDL_PIXELFORMAT_P016:
+        *y = planes[0];
+        *y_stride = pitches[0];
+        *u = planes[1];
+        *v = *u + 2;
+        *uv_stride = pitches[1];
+        break;
     case SDL_PIXELFORMAT_NV21:
         *y = planes[0];
         *y_stride = pitches[0];
@@ -399,6 +448,244 @@ static SDL_bool yuv_rgb_sse(
 }
 #endif
 
+#ifdef SDL_AVX2_INTRINSICS
+static SDL_bool yuv_rgb_avx2(
+    Uint32 src_format, Uint32 dst_format,
+    Uint32 width, Uint32 height,
+    const Uint8 *y, const Uint8 *u, const Uint8 *v, Uint32 y_stride, Uint32 uv_stride,
+    Uint8 *rgb, Uint32 rgb_stride,
+    YCbCrType yuv_type)
+{
+    if (!SDL_HasAVX2()) {
+        return SDL_FALSE;
+    }
+
+    if (src_format == SDL_PIXELFORMAT_YV12 ||
+        src_format == SDL_PIXELFORMAT_IYUV) {
+
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_RGB565:
+            yuv420_rgb565_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGB24:
+            yuv420_rgb24_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGBX8888:
+        case SDL_PIXELFORMAT_RGBA8888:
+            yuv420_rgba_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_BGRX8888:
+        case SDL_PIXELFORMAT_BGRA8888:
+            yuv420_bgra_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_XRGB8888:
+        case SDL_PIXELFORMAT_ARGB8888:
+            yuv420_argb_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_XBGR8888:
+        case SDL_PIXELFORMAT_ABGR8888:
+            yuv420_abgr_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        default:
+            break;
+        }
+    }
+
+    if (src_format == SDL_PIXELFORMAT_YUY2 ||
+        src_format == SDL_PIXELFORMAT_UYVY ||
+        src_format == SDL_PIXELFORMAT_YVYU) {
+
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_RGB565:
+            yuv422_rgb565_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGB24:
+            yuv422_rgb24_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGBX8888:
+        case SDL_PIXELFORMAT_RGBA8888:
+            yuv422_rgba_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_BGRX8888:
+        case SDL_PIXELFORMAT_BGRA8888:
+            yuv422_bgra_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_XRGB8888:
+        case SDL_PIXELFORMAT_ARGB8888:
+            yuv422_argb_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_XBGR8888:
+        case SDL_PIXELFORMAT_ABGR8888:
+            yuv422_abgr_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        default:
+            break;
+        }
+    }
+
+    if (src_format == SDL_PIXELFORMAT_NV12 ||
+        src_format == SDL_PIXELFORMAT_NV21) {
+
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_RGB565:
+            yuvnv12_rgb565_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGB24:
+            yuvnv12_rgb24_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGBX8888:
+        case SDL_PIXELFORMAT_RGBA8888:
+            yuvnv12_rgba_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_BGRX8888:
+        case SDL_PIXELFORMAT_BGRA8888:
+            yuvnv12_bgra_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_XRGB8888:
+        case SDL_PIXELFORMAT_ARGB8888:
+            yuvnv12_argb_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_XBGR8888:
+        case SDL_PIXELFORMAT_ABGR8888:
+            yuvnv12_abgr_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        default:
+            break;
+        }
+    }
+    return SDL_FALSE;
+}
+#else
+static SDL_bool yuv_rgb_avx2(
+    Uint32 src_format, Uint32 dst_format,
+    Uint32 width, Uint32 height,
+    const Uint8 *y, const Uint8 *u, const Uint8 *v, Uint32 y_stride, Uint32 uv_stride,
+    Uint8 *rgb, Uint32 rgb_stride,
+    YCbCrType yuv_type)
+{
+    return SDL_FALSE;
+}
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+static SDL_bool yuv_rgb_neon(
+    Uint32 src_format, Uint32 dst_format,
+    Uint32 width, Uint32 height,
+    const Uint8 *y, const Uint8 *u, const Uint8 *v, Uint32 y_stride, Uint32 uv_stride,
+    Uint8 *rgb, Uint32 rgb_stride,
+    YCbCrType yuv_type)
+{
+    if (!SDL_HasNEON()) {
+        return SDL_FALSE;
+    }
+
+    if (src_format == SDL_PIXELFORMAT_YV12 ||
+        src_format == SDL_PIXELFORMAT_IYUV) {
+
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_RGB565:
+            yuv420_rgb565_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGB24:
+            yuv420_rgb24_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGBX8888:
+        case SDL_PIXELFORMAT_RGBA8888:
+            yuv420_rgba_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_BGRX8888:
+        case SDL_PIXELFORMAT_BGRA8888:
+            yuv420_bgra_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_XRGB8888:
+        case SDL_PIXELFORMAT_ARGB8888:
+            yuv420_argb_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_XBGR8888:
+        case SDL_PIXELFORMAT_ABGR8888:
+            yuv420_abgr_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        default:
+            break;
+        }
+    }
+
+    if (src_format == SDL_PIXELFORMAT_YUY2 ||
+        src_format == SDL_PIXELFORMAT_UYVY ||
+        src_format == SDL_PIXELFORMAT_YVYU) {
+
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_RGB565:
+            yuv422_rgb565_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGB24:
+            yuv422_rgb24_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGBX8888:
+        case SDL_PIXELFORMAT_RGBA8888:
+            yuv422_rgba_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_BGRX8888:
+        case SDL_PIXELFORMAT_BGRA8888:
+            yuv422_bgra_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_XRGB8888:
+        case SDL_PIXELFORMAT_ARGB8888:
+            yuv422_argb_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_XBGR8888:
+        case SDL_PIXELFORMAT_ABGR8888:
+            yuv422_abgr_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        default:
+            break;
+        }
+    }
+
+    if (src_format == SDL_PIXELFORMAT_NV12 ||
+        src_format == SDL_PIXELFORMAT_NV21) {
+
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_RGB565:
+            yuvnv12_rgb565_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGB24:
+            yuvnv12_rgb24_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGBX8888:
+        case SDL_PIXELFORMAT_RGBA8888:
+            yuvnv12_rgba_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_BGRX8888:
+        case SDL_PIXELFORMAT_BGRA8888:
+            yuvnv12_bgra_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_XRGB8888:
+        case SDL_PIXELFORMAT_ARGB8888:
+            yuvnv12_argb_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_XBGR8888:
+        case SDL_PIXELFORMAT_ABGR8888:
+            yuvnv12_abgr_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        default:
+            break;
+        }
+    }
+    return SDL_FALSE;
+}
+#else
+static SDL_bool yuv_rgb_neon(
+    Uint32 src_format, Uint32 dst_format,
+    Uint32 width, Uint32 height,
+    const Uint8 *y, const Uint8 *u, const Uint8 *v, Uint32 y_stride, Uint32 uv_stride,
+    Uint8 *rgb, Uint32 rgb_stride,
+    YCbCrType yuv_type)
+{
+    return SDL_FALSE;
+}
+#endif
+
 #ifdef SDL_LSX_INTRINSICS
 static SDL_bool yuv_rgb_lsx(
     Uint32 src_format, Uint32 dst_format,
@@ -551,7 +838,417 @@ static SDL_bool yuv_rgb_std(
             break;
         }
     }
-    return SDL_FALSE;
+    return SDL_FALSE;
+}
+
+/* P010 and P016 hold 16-bit samples with the significant bits at the top.
+   Both are converted at 10 bits, the precision of the 2101010 formats they're usually displayed with. */
+#define P0XX_SHIFT 6
+
+/* YCbCr to RGB factors for 10-bit samples, in fixed point with P0XX2RGB_FACTOR_BITS fractional bits.
+   The offset samples are scaled up by 5 bits so they fill 16 bits, and the high half of the product keeps 2 bits below the 10-bit result. */
+#define P0XX2RGB_FACTOR_BITS 13
+#define P0XX2RGB_MULHI(a, b) (((a) * (b)) >> 16)
+
+typedef struct P0XX2RGBFactors
+{
+    Sint16 y_offset;
+    Sint16 uv_offset;
+    Sint16 y[3]; /* Rfactor, Gfactor, Bfactor */
+    Sint16 u[3]; /* Rfactor, Gfactor, Bfactor */
+    Sint16 v[3]; /* Rfactor, Gfactor, Bfactor */
+} P0XX2RGBFactors;
+
+/* The byte offsets of the channels of 8-bit per channel formats, or the bit offsets of the channels of 2101010 formats */
+typedef struct P0XX2RGBLayout
+{
+    SDL_bool is_10bit;
+    int r, g, b, a;
+} P0XX2RGBLayout;
+
+static int GetP0XX2RGBFactors(SDL_Colorspace colorspace, int width, int height, P0XX2RGBFactors *factors)
+{
+    const float *matrix;
+    int i;
+
+    if (SDL_COLORSPACETYPE(colorspace) != SDL_COLOR_TYPE_YCBCR) {
+        /* P010 defaults to HDR10, which doesn't have a YCbCr matrix */
+        colorspace = SDL_COLORSPACE_BT2020_LIMITED;
+    }
+
+    matrix = SDL_GetYCbCRtoRGBConversionMatrix(colorspace, width, height, 10);
+    if (!matrix) {
+        return SDL_SetError("Unsupported YUV colorspace");
+    }
+
+    /* Round the offsets at 8 bits, so they're exact for both the 8-bit and the 10-bit matrices */
+    factors->y_offset = (Sint16)(SDL_lroundf(-matrix[0] * 255.0f) << 2);
+    factors->uv_offset = (Sint16)(SDL_lroundf(-matrix[1] * 255.0f) << 2);
+    for (i = 0; i < 3; ++i) {
+        factors->y[i] = (Sint16)SDL_lroundf(matrix[4 + i * 4 + 0] * (1 << P0XX2RGB_FACTOR_BITS));
+        factors->u[i] = (Sint16)SDL_lroundf(matrix[4 + i * 4 + 1] * (1 << P0XX2RGB_FACTOR_BITS));
+        factors->v[i] = (Sint16)SDL_lroundf(matrix[4 + i * 4 + 2] * (1 << P0XX2RGB_FACTOR_BITS));
+    }
+    return 0;
+}
+
+static SDL_bool GetP0XX2RGBLayout(Uint32 format, P0XX2RGBLayout *layout)
+{
+    switch (format) {
+    case SDL_PIXELFORMAT_RGBA32:
+    case SDL_PIXELFORMAT_RGBX32:
+        layout->is_10bit = SDL_FALSE;
+        layout->r = 0;
+        layout->g = 1;
+        layout->b = 2;
+        layout->a = 3;
+        return SDL_TRUE;
+    case SDL_PIXELFORMAT_ARGB32:
+    case SDL_PIXELFORMAT_XRGB32:
+        layout->is_10bit = SDL_FALSE;
+        layout->a = 0;
+        layout->r = 1;
+        layout->g = 2;
+        layout->b = 3;
+        return SDL_TRUE;
+    case SDL_PIXELFORMAT_BGRA32:
+    case SDL_PIXELFORMAT_BGRX32:
+        layout->is_10bit = SDL_FALSE;
+        layout->b = 0;
+        layout->g = 1;
+        layout->r = 2;
+        layout->a = 3;
+        return SDL_TRUE;
+    case SDL_PIXELFORMAT_ABGR32:
+    case SDL_PIXELFORMAT_XBGR32:
+        layout->is_10bit = SDL_FALSE;
+        layout->a = 0;
+        layout->b = 1;
+        layout->g = 2;
+        layout->r = 3;
+        return SDL_TRUE;
+    case SDL_PIXELFORMAT_XRGB2101010:
+    case SDL_PIXELFORMAT_ARGB2101010:
+        layout->is_10bit = SDL_TRUE;
+        layout->b = 0;
+        layout->g = 10;
+        layout->r = 20;
+        layout->a = 30;
+        return SDL_TRUE;
+    case SDL_PIXELFORMAT_XBGR2101010:
+    case SDL_PIXELFORMAT_ABGR2101010:
+        layout->is_10bit = SDL_TRUE;
+        layout->r = 0;
+        layout->g = 10;
+        layout->b = 20;
+        layout->a = 30;
+        return SDL_TRUE;
+    default:
+        return SDL_FALSE;
+    }
+}
+
+/* Convert columns [x, width) of a row, each pair of pixels shares the interleaved U and V samples of the chroma row */
+static void P0XX2RGB_Row_std(int x, int width, const Uint16 *y_row, const Uint16 *uv_row, Uint8 *dst, const P0XX2RGBFactors *factors, const P0XX2RGBLayout *layout)
+{
+    for (; x < width; ++x) {
+        const int Y = ((y_row[x] >> P0XX_SHIFT) - factors->y_offset) * 32;
+        const int U = ((uv_row[x & ~1] >> P0XX_SHIFT) - factors->uv_offset) * 32;
+        const int V = ((uv_row[x | 1] >> P0XX_SHIFT) - factors->uv_offset) * 32;
+        const int R = P0XX2RGB_MULHI(Y, factors->y[0]) + P0XX2RGB_MULHI(U, factors->u[0]) + P0XX2RGB_MULHI(V, factors->v[0]);
+        const int G = P0XX2RGB_MULHI(Y, factors->y[1]) + P0XX2RGB_MULHI(U, factors->u[1]) + P0XX2RGB_MULHI(V, factors->v[1]);
+        const int B = P0XX2RGB_MULHI(Y, factors->y[2]) + P0XX2RGB_MULHI(U, factors->u[2]) + P0XX2RGB_MULHI(V, factors->v[2]);
+
+        if (layout->is_10bit) {
+            const Uint32 r = (Uint32)SDL_clamp((R + 2) >> 2, 0, 1023);
+            const Uint32 g = (Uint32)SDL_clamp((G + 2) >> 2, 0, 1023);
+            const Uint32 b = (Uint32)SDL_clamp((B + 2) >> 2, 0, 1023);
+            *(Uint32 *)(dst + x * 4) = (r << layout->r) | (g << layout->g) | (b << layout->b) | (3u << layout->a);
+        } else {
+            Uint8 *p = dst + x * 4;
+            p[layout->r] = (Uint8)SDL_clamp((R + 8) >> 4, 0, 255);
+            p[layout->g] = (Uint8)SDL_clamp((G + 8) >> 4, 0, 255);
+            p[layout->b] = (Uint8)SDL_clamp((B + 8) >> 4, 0, 255);
+            p[layout->a] = 255;
+        }
+    }
+}
+
+typedef int (*P0XX2RGBRowFunc)(int width, const Uint16 *y_row, const Uint16 *uv_row, Uint8 *dst, const P0XX2RGBFactors *factors, const P0XX2RGBLayout *layout);
+
+#ifdef SDL_SSE2_INTRINSICS
+static int SDL_TARGETING("sse2") P0XX2RGB_Row_SSE2(int width, const Uint16 *y_row, const Uint16 *uv_row, Uint8 *dst, const P0XX2RGBFactors *factors, const P0XX2RGBLayout *layout)
+{
+    const __m128i y_offset = _mm_set1_epi16(factors->y_offset);
+    const __m128i uv_offset = _mm_set1_epi16(factors->uv_offset);
+    const __m128i alpha8 = _mm_set1_epi8((char)0xFF);
+    const __m128i alpha10 = _mm_set1_epi16((short)0xC000);
+    const __m128i max10 = _mm_set1_epi16(1023);
+    const __m128i zero = _mm_setzero_si128();
+    __m128i Y, UV, U, V, rgb[3], ch[4], lo, hi;
+    int x, i;
+
+    for (x = 0; x + 8 <= width; x += 8) {
+        Y = _mm_loadu_si128((const __m128i *)(y_row + x));
+        UV = _mm_loadu_si128((const __m128i *)(uv_row + x));
+        Y = _mm_slli_epi16(_mm_sub_epi16(_mm_srli_epi16(Y, P0XX_SHIFT), y_offset), 5);
+        UV = _mm_slli_epi16(_mm_sub_epi16(_mm_srli_epi16(UV, P0XX_SHIFT), uv_offset), 5);
+
+        /* Repeat the chroma of each pair of pixels */
+        U = _mm_shufflehi_epi16(_mm_shufflelo_epi16(UV, _MM_SHUFFLE(2, 2, 0, 0)), _MM_SHUFFLE(2, 2, 0, 0));
+        V = _mm_shufflehi_epi16(_mm_shufflelo_epi16(UV, _MM_SHUFFLE(3, 3, 1, 1)), _MM_SHUFFLE(3, 3, 1, 1));
+
+        for (i = 0; i < 3; ++i) {
+            rgb[i] = _mm_add_epi16(_mm_add_epi16(_mm_mulhi_epi16(Y, _mm_set1_epi16(factors->y[i])),
+                                                 _mm_mulhi_epi16(U, _mm_set1_epi16(factors->u[i]))),
+                                   _mm_mulhi_epi16(V, _mm_set1_epi16(factors->v[i])));
+        }
+
+        if (layout->is_10bit) {
+            for (i = 0; i < 3; ++i) {
+                rgb[i] = _mm_min_epi16(_mm_max_epi16(_mm_srai_epi16(_mm_add_epi16(rgb[i], _mm_set1_epi16(2)), 2), zero), max10);
+            }
+            ch[layout->r / 10] = rgb[0];
+            ch[layout->g / 10] = rgb[1];
+            ch[layout->b / 10] = rgb[2];
+            lo = _mm_or_si128(ch[0], _mm_slli_epi16(ch[1], 10));
+            hi = _mm_or_si128(_mm_or_si128(_mm_srli_epi16(ch[1], 6), _mm_slli_epi16(ch[2], 4)), alpha10);
+        } else {
+            for (i = 0; i < 3; ++i) {
+                rgb[i] = _mm_srai_epi16(_mm_add_epi16(rgb[i], _mm_set1_epi16(8)), 4);
+                rgb[i] = _mm_packus_epi16(rgb[i], rgb[i]);
+            }
+            ch[layout->r] = rgb[0];
+            ch[layout->g] = rgb[1];
+            ch[layout->b] = rgb[2];
+            ch[layout->a] = alpha8;
+            lo = _mm_unpacklo_epi8(ch[0], ch[1]);
+            hi = _mm_unpacklo_epi8(ch[2], ch[3]);
+        }
+        _mm_storeu_si128((__m128i *)(dst + x * 4), _mm_unpacklo_epi16(lo, hi));
+        _mm_storeu_si128((__m128i *)(dst + x * 4 + 16), _mm_unpackhi_epi16(lo, hi));
+    }
+    return x;
+}
+#endif /* SDL_SSE2_INTRINSICS */
+
+#ifdef SDL_AVX2_INTRINSICS
+static int SDL_TARGETING("avx2") P0XX2RGB_Row_AVX2(int width, const Uint16 *y_row, const Uint16 *uv_row, Uint8 *dst, const P0XX2RGBFactors *factors, const P0XX2RGBLayout *layout)
+{
+    const __m256i y_offset = _mm256_set1_epi16(factors->y_offset);
+    const __m256i uv_offset = _mm256_set1_epi16(factors->uv_offset);
+    const __m256i alpha8 = _mm256_set1_epi8((char)0xFF);
+    const __m256i alpha10 = _mm256_set1_epi16((short)0xC000);
+    const __m256i max10 = _mm256_set1_epi16(1023);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i Y, UV, U, V, rgb[3], ch[4], lo, hi, px_lo, px_hi;
+    int x, i;
+
+    for (x = 0; x + 16 <= width; x += 16) {
+        Y = _mm256_loadu_si256((const __m256i *)(y_row + x));
+        UV = _mm256_loadu_si256((const __m256i *)(uv_row + x));
+        Y = _mm256_slli_epi16(_mm256_sub_epi16(_mm256_srli_epi16(Y, P0XX_SHIFT), y_offset), 5);
+        UV = _mm256_slli_epi16(_mm256_sub_epi16(_mm256_srli_epi16(UV, P0XX_SHIFT), uv_offset), 5);
+
+        /* Each lane holds the chroma for its own 8 pixels, so the in-lane shuffles line up */
+        U = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(UV, _MM_SHUFFLE(2, 2, 0, 0)), _MM_SHUFFLE(2, 2, 0, 0));
+        V = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(UV, _MM_SHUFFLE(3, 3, 1, 1)), _MM_SHUFFLE(3, 3, 1, 1));
+
+        for (i = 0; i < 3; ++i) {
+            rgb[i] = _mm256_add_epi16(_mm256_add_epi16(_mm256_mulhi_epi16(Y, _mm256_set1_epi16(factors->y[i])),
+                                                       _mm256_mulhi_epi16(U, _mm256_set1_epi16(factors->u[i]))),
+                                      _mm256_mulhi_epi16(V, _mm256_set1_epi16(factors->v[i])));
+        }
+
+        if (layout->is_10bit) {
+            for (i = 0; i < 3; ++i) {
+                rgb[i] = _mm256_min_epi16(_mm256_max_epi16(_mm256_srai_epi16(_mm256_add_epi16(rgb[i], _mm256_set1_epi16(2)), 2), zero), max10);
+            }
+            ch[layout->r / 10] = rgb[0];
+            ch[layout->g / 10] = rgb[1];
+            ch[layout->b / 10] = rgb[2];
+            lo = _mm256_or_si256(ch[0], _mm256_slli_epi16(ch[1], 10));
+            hi = _mm256_or_si256(_mm256_or_si256(_mm256_srli_epi16(ch[1], 6), _mm256_slli_epi16(ch[2], 4)), alpha10);
+        } else {
+            for (i = 0; i < 3; ++i) {
+                rgb[i] = _mm256_srai_epi16(_mm256_add_epi16(rgb[i], _mm256_set1_epi16(8)), 4);
+                rgb[i] = _mm256_packus_epi16(rgb[i], rgb[i]);
+            }
+            ch[layout->r] = rgb[0];
+            ch[layout->g] = rgb[1];
+            ch[layout->b] = rgb[2];
+            ch[layout->a] = alpha8;
+            lo = _mm256_unpacklo_epi8(ch[0], ch[1]);
+            hi = _mm256_unpacklo_epi8(ch[2], ch[3]);
+        }
+        /* Pixels 0-3 | 8-11 and 4-7 | 12-15 */
+        px_lo = _mm256_unpacklo_epi16(lo, hi);
+        px_hi = _mm256_unpackhi_epi16(lo, hi);
+        _mm256_storeu_si256((__m256i *)(dst + x * 4), _mm256_permute2x128_si256(px_lo, px_hi, 0x20));
+        _mm256_storeu_si256((__m256i *)(dst + x * 4 + 32), _mm256_permute2x128_si256(px_lo, px_hi, 0x31));
+    }
+    return x;
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#ifdef SDL_NEON_INTRINSICS
+SDL_FORCE_INLINE int16x8_t P0XX2RGB_MulHi_NEON(int16x8_t a, Sint16 factor)
+{
+    return vcombine_s16(vshrn_n_s32(vmull_n_s16(vget_low_s16(a), factor), 16), vshrn_n_s32(vmull_n_s16(vget_high_s16(a), factor), 16));
+}
+
+static int P0XX2RGB_Row_NEON(int width, const Uint16 *y_row, const Uint16 *uv_row, Uint8 *dst, const P0XX2RGBFactors *factors, const P0XX2RGBLayout *layout)
+{
+    const int16x8_t y_offset = vdupq_n_s16(factors->y_offset);
+    const int16x4_t uv_offset = vdup_n_s16(factors->uv_offset);
+    int16x8_t Y, U, V, rgb[3];
+    uint16x8_t ch[3];
+    uint16x8x2_t px10;
+    uint8x8x4_t px8;
+    uint16x4x2_t UV;
+    int16x4x2_t UU, VV;
+    int x, i;
+
+    for (x = 0; x + 8 <= width; x += 8) {
+        Y = vreinterpretq_s16_u16(vshrq_n_u16(vld1q_u16(y_row + x), P0XX_SHIFT));
+        Y = vshlq_n_s16(vsubq_s16(Y, y_offset), 5);
+
+        /* Repeat the chroma of each pair of pixels */
+        UV = vld2_u16(uv_row + x);
+        UU.val[0] = vshl_n_s16(vsub_s16(vreinterpret_s16_u16(vshr_n_u16(UV.val[0], P0XX_SHIFT)), uv_offset), 5);
+        VV.val[0] = vshl_n_s16(vsub_s16(vreinterpret_s16_u16(vshr_n_u16(UV.val[1], P0XX_SHIFT)), uv_offset), 5);
+        UU = vzip_s16(UU.val[0], UU.val[0]);
+        VV = vzip_s16(VV.val[0], VV.val[0]);
+        U = vcombine_s16(UU.val[0], UU.val[1]);
+        V = vcombine_s16(VV.val[0], VV.val[1]);
+
+        for (i = 0; i < 3; ++i) {
+            rgb[i] = vaddq_s16(vaddq_s16(P0XX2RGB_MulHi_NEON(Y, factors->y[i]), P0XX2RGB_MulHi_NEON(U, factors->u[i])), P0XX2RGB_MulHi_NEON(V, factors->v[i]));
+        }
+
+        if (layout->is_10bit) {
+            for (i = 0; i < 3; ++i) {
+                rgb[i] = vminq_s16(vmaxq_s16(vrshrq_n_s16(rgb[i], 2), vdupq_n_s16(0)), vdupq_n_s16(1023));
+            }
+            ch[layout->r / 10] = vreinterpretq_u16_s16(rgb[0]);
+            ch[layout->g / 10] = vreinterpretq_u16_s16(rgb[1]);
+            ch[layout->b / 10] = vreinterpretq_u16_s16(rgb[2]);
+            px10.val[0] = vorrq_u16(ch[0], vshlq_n_u16(ch[1], 10));
+            px10.val[1] = vorrq_u16(vorrq_u16(vshrq_n_u16(ch[1], 6), vshlq_n_u16(ch[2], 4)), vdupq_n_u16(0xC000));
+            vst2q_u16((Uint16 *)(dst + x * 4), px10);
+        } else {
+            px8.val[layout->r] = vqrshrun_n_s16(rgb[0], 4);
+            px8.val[layout->g] = vqrshrun_n_s16(rgb[1], 4);
+            px8.val[layout->b] = vqrshrun_n_s16(rgb[2], 4);
+            px8.val[layout->a] = vdup_n_u8(0xFF);
+            vst4_u8(dst + x * 4, px8);
+        }
+    }
+    return x;
+}
+#endif /* SDL_NEON_INTRINSICS */
+
+static int P0XX2RGB_Direct(int width, int height, Uint32 src_format, const void *src, int src_pitch, Uint8 *dst, int dst_pitch, const P0XX2RGBFactors *factors, const P0XX2RGBLayout *layout)
+{
+    P0XX2RGBRowFunc row_func = NULL;
+    const Uint8 *y;
+    const Uint8 *u;
+    const Uint8 *v;
+    Uint32 y_stride, uv_stride;
+    int j, x;
+
+    if (GetYUVPlanes(width, height, src_format, src, src_pitch, &y, &u, &v, &y_stride, &uv_stride) < 0) {
+        return -1;
+    }
+
+#ifdef SDL_AVX2_INTRINSICS
+    if (!row_func && SDL_HasAVX2()) {
+        row_func = P0XX2RGB_Row_AVX2;
+    }
+#endif
+#ifdef SDL_SSE2_INTRINSICS
+    if (!row_func && SDL_HasSSE2()) {
+        row_func = P0XX2RGB_Row_SSE2;
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (!row_func && SDL_HasNEON()) {
+        row_func = P0XX2RGB_Row_NEON;
+    }
+#endif
+
+    for (j = 0; j < height; ++j) {
+        const Uint16 *y_row = (const Uint16 *)(y + j * y_stride);
+        const Uint16 *uv_row = (const Uint16 *)(u + (j / 2) * uv_stride);
+
+        x = 0;
+        if (row_func) {
+            x = row_func(width, y_row, uv_row, dst, factors, layout);
+        }
+        P0XX2RGB_Row_std(x, width, y_row, uv_row, dst, factors, layout);
+
+        dst += dst_pitch;
+    }
+    return 0;
+}
+
+/* The SDR paths pass the transfer characteristics and primaries through as-is, like the 8-bit YUV formats.
+   HDR content goes through the blitter so it's tone mapped and linearized as needed. */
+static SDL_bool P0XX2RGB_NeedsColorspaceConversion(SDL_Colorspace src_colorspace, SDL_Colorspace dst_colorspace)
+{
+    const SDL_TransferCharacteristics src_transfer = SDL_COLORSPACETRANSFER(src_colorspace);
+    const SDL_TransferCharacteristics dst_transfer = SDL_COLORSPACETRANSFER(dst_colorspace);
+
+    if (src_transfer == dst_transfer &&
+        SDL_COLORSPACEPRIMARIES(src_colorspace) == SDL_COLORSPACEPRIMARIES(dst_colorspace)) {
+        return SDL_FALSE;
+    }
+    if (src_transfer == SDL_TRANSFER_CHARACTERISTICS_PQ || src_transfer == SDL_TRANSFER_CHARACTERISTICS_LINEAR ||
+        dst_transfer == SDL_TRANSFER_CHARACTERISTICS_PQ || dst_transfer == SDL_TRANSFER_CHARACTERISTICS_LINEAR) {
+        return SDL_TRUE;
+    }
+    return SDL_FALSE;
+}
+
+static int SDL_ConvertPixels_P0xx_to_RGB(int width, int height,
+                                         Uint32 src_format, SDL_Colorspace src_colorspace, SDL_PropertiesID src_properties, const void *src, int src_pitch,
+                                         Uint32 dst_format, SDL_Colorspace dst_colorspace, SDL_PropertiesID dst_properties, void *dst, int dst_pitch)
+{
+    /* The RGB values keep the primaries and transfer characteristics of the YUV data */
+    const SDL_Colorspace rgb_colorspace = SDL_DEFINE_COLORSPACE(SDL_COLOR_TYPE_RGB,
+                                                                SDL_COLOR_RANGE_FULL,
+                                                                SDL_COLORSPACEPRIMARIES(src_colorspace),
+                                                                SDL_COLORSPACETRANSFER(src_colorspace),
+                                                                SDL_MATRIX_COEFFICIENTS_IDENTITY,
+                                                                SDL_CHROMA_LOCATION_NONE);
+    const SDL_bool convert_colorspace = P0XX2RGB_NeedsColorspaceConversion(rgb_colorspace, dst_colorspace);
+    P0XX2RGBFactors factors;
+    P0XX2RGBLayout layout;
+    int ret;
+    void *tmp;
+    int tmp_pitch = (width * sizeof(Uint32));
+
+    if (GetP0XX2RGBFactors(src_colorspace, width, height, &factors) < 0) {
+        return -1;
+    }
+
+    if (GetP0XX2RGBLayout(dst_format, &layout) && !convert_colorspace) {
+        return P0XX2RGB_Direct(width, height, src_format, src, src_pitch, (Uint8 *)dst, dst_pitch, &factors, &layout);
+    }
+
+    /* Convert to 10-bit RGB and let the blitter handle the destination format, and the colorspace if needed */
+    tmp = SDL_malloc((size_t)tmp_pitch * height);
+    if (!tmp) {
+        return -1;
+    }
+
+    GetP0XX2RGBLayout(SDL_PIXELFORMAT_XBGR2101010, &layout);
+    ret = P0XX2RGB_Direct(width, height, src_format, src, src_pitch, (Uint8 *)tmp, tmp_pitch, &factors, &layout);
+    if (ret == 0) {
+        ret = SDL_ConvertPixelsAndColorspace(width, height, SDL_PIXELFORMAT_XBGR2101010, convert_colorspace ? rgb_colorspace : dst_colorspace, src_properties, tmp, tmp_pitch, dst_format, dst_colorspace, dst_properties, dst, dst_pitch);
+    }
+    SDL_free(tmp);
+    return ret;
 }
 
 int SDL_ConvertPixels_YUV_to_RGB(int width, int height,
@@ -565,6 +1262,10 @@ int SDL_ConvertPixels_YUV_to_RGB(int width, int height,
     Uint32 uv_stride = 0;
     YCbCrType yuv_type = YCBCR_601;
 
+    if (IsP0xxFormat(src_format)) {
+        return SDL_ConvertPixels_P0xx_to_RGB(width, height, src_format, src_colorspace, src_properties, src, src_pitch, dst_format, dst_colorspace, dst_properties, dst, dst_pitch);
+    }
+
     if (GetYUVPlanes(width, height, src_format, src, src_pitch, &y, &u, &v, &y_stride, &uv_stride) < 0) {
         return -1;
     }
@@ -573,10 +1274,18 @@ int SDL_ConvertPixels_YUV_to_RGB(int width, int height,
         return -1;
     }
 
+    if (yuv_rgb_avx2(src_format, dst_format, width, height, y, u, v, y_stride, uv_stride, (Uint8 *)dst, dst_pitch, yuv_type)) {
+        return 0;
+    }
+
     if (yuv_rgb_sse(src_format, dst_format, width, height, y, u, v, y_stride, uv_stride, (Uint8 *)dst, dst_pitch, yuv_type)) {
         return 0;
     }
 
+    if (yuv_rgb_neon(src_format, dst_format, width, height, y, u, v, y_stride, uv_stride, (Uint8 *)dst, dst_pitch, yuv_type)) {
+        return 0;
+    }
+
     if (yuv_rgb_lsx(src_format, dst_format, width, height, y, u, v, y_stride, uv_stride, (Uint8 *)dst, dst_pitch, yuv_type)) {
         return 0;
     }
@@ -612,95 +1321,635 @@ int SDL_ConvertPixels_YUV_to_RGB(int width, int height,
     return SDL_SetError("Unsupported YUV conversion");
 }
 
+/* RGB to YUV factors, in fixed point with RGB2YUV_SHIFT fractional bits.
+   The scalar and vectorized converters use the same integer math, so they produce identical results. */
+#define RGB2YUV_SHIFT     14
+#define RGB2YUV_ROUND     (1 << (RGB2YUV_SHIFT - 1))
+#define RGB2YUV_FACTOR(x) (Sint16)((x) * (1 << RGB2YUV_SHIFT) + ((x) < 0.0f ? -0.5f : 0.5f))
+
 struct RGB2YUVFactors
 {
     int y_offset;
-    float y[3]; /* Rfactor, Gfactor, Bfactor */
-    float u[3]; /* Rfactor, Gfactor, Bfactor */
-    float v[3]; /* Rfactor, Gfactor, Bfactor */
+    Sint16 y[3]; /* Rfactor, Gfactor, Bfactor */
+    Sint16 u[3]; /* Rfactor, Gfactor, Bfactor */
+    Sint16 v[3]; /* Rfactor, Gfactor, Bfactor */
+};
+
+static const struct RGB2YUVFactors RGB2YUVFactorTables[] = {
+    /* ITU-T T.871 (JPEG) */
+    {
+        0,
+        { RGB2YUV_FACTOR(0.2990f), RGB2YUV_FACTOR(0.5870f), RGB2YUV_FACTOR(0.1140f) },
+        { RGB2YUV_FACTOR(-0.1687f), RGB2YUV_FACTOR(-0.3313f), RGB2YUV_FACTOR(0.5000f) },
+        { RGB2YUV_FACTOR(0.5000f), RGB2YUV_FACTOR(-0.4187f), RGB2YUV_FACTOR(-0.0813f) },
+    },
+    /* ITU-R BT.601-7 */
+    {
+        16,
+        { RGB2YUV_FACTOR(0.2568f), RGB2YUV_FACTOR(0.5041f), RGB2YUV_FACTOR(0.0979f) },
+        { RGB2YUV_FACTOR(-0.1482f), RGB2YUV_FACTOR(-0.2910f), RGB2YUV_FACTOR(0.4392f) },
+        { RGB2YUV_FACTOR(0.4392f), RGB2YUV_FACTOR(-0.3678f), RGB2YUV_FACTOR(-0.0714f) },
+    },
+    /* ITU-R BT.709-6 */
+    {
+        16,
+        { RGB2YUV_FACTOR(0.1826f), RGB2YUV_FACTOR(0.6142f), RGB2YUV_FACTOR(0.0620f) },
+        { RGB2YUV_FACTOR(-0.1006f), RGB2YUV_FACTOR(-0.3386f), RGB2YUV_FACTOR(0.4392f) },
+        { RGB2YUV_FACTOR(0.4392f), RGB2YUV_FACTOR(-0.3989f), RGB2YUV_FACTOR(-0.0403f) },
+    },
 };
 
-static int SDL_ConvertPixels_ARGB8888_to_YUV(int width, int height, const void *src, int src_pitch, Uint32 dst_format, void *dst, int dst_pitch, YCbCrType yuv_type)
+/* The byte offsets of the color channels in an 8-bit per channel RGB pixel */
+typedef struct RGB2YUVLayout
 {
-    const int src_pitch_x_2 = src_pitch * 2;
-    const int height_half = height / 2;
-    const int height_remainder = (height & 0x1);
-    const int width_half = width / 2;
-    const int width_remainder = (width & 0x1);
-    int i, j;
+    int bpp;
+    int r, g, b;
+} RGB2YUVLayout;
 
-    static struct RGB2YUVFactors RGB2YUVFactorTables[] = {
-        /* ITU-T T.871 (JPEG) */
-        {
-            0,
-            { 0.2990f, 0.5870f, 0.1140f },
-            { -0.1687f, -0.3313f, 0.5000f },
-            { 0.5000f, -0.4187f, -0.0813f },
-        },
-        /* ITU-R BT.601-7 */
-        {
-            16,
-            { 0.2568f, 0.5041f, 0.0979f },
-            { -0.1482f, -0.2910f, 0.4392f },
-            { 0.4392f, -0.3678f, -0.0714f },
-        },
-        /* ITU-R BT.709-6 */
-        {
-            16,
-            { 0.1826f, 0.6142f, 0.0620f },
-            { -0.1006f, -0.3386f, 0.4392f },
-            { 0.4392f, -0.3989f, -0.0403f },
-        },
-    };
-    const struct RGB2YUVFactors *cvt = &RGB2YUVFactorTables[yuv_type];
-
-#define MAKE_Y(r, g, b) (Uint8)((int)(cvt->y[0] * (r) + cvt->y[1] * (g) + cvt->y[2] * (b) + 0.5f) + cvt->y_offset)
-#define MAKE_U(r, g, b) (Uint8)((int)(cvt->u[0] * (r) + cvt->u[1] * (g) + cvt->u[2] * (b) + 0.5f) + 128)
-#define MAKE_V(r, g, b) (Uint8)((int)(cvt->v[0] * (r) + cvt->v[1] * (g) + cvt->v[2] * (b) + 0.5f) + 128)
-
-#define READ_2x2_PIXELS                                                                                     \
-    const Uint32 p1 = ((const Uint32 *)curr_row)[2 * i];                                                    \
-    const Uint32 p2 = ((const Uint32 *)curr_row)[2 * i + 1];                                                \
-    const Uint32 p3 = ((const Uint32 *)next_row)[2 * i];                                                    \
-    const Uint32 p4 = ((const Uint32 *)next_row)[2 * i + 1];                                                \
-    const Uint32 r = ((p1 & 0x00ff0000) + (p2 & 0x00ff0000) + (p3 & 0x00ff0000) + (p4 & 0x00ff0000)) >> 18; \
-    const Uint32 g = ((p1 & 0x0000ff00) + (p2 & 0x0000ff00) + (p3 & 0x0000ff00) + (p4 & 0x0000ff00)) >> 10; \
-    const Uint32 b = ((p1 & 0x000000ff) + (p2 & 0x000000ff) + (p3 & 0x000000ff) + (p4 & 0x000000ff)) >> 2;
-
-#define READ_2x1_PIXELS                                             \
-    const Uint32 p1 = ((const Uint32 *)curr_row)[2 * i];            \
-    const Uint32 p2 = ((const Uint32 *)next_row)[2 * i];            \
-    const Uint32 r = ((p1 & 0x00ff0000) + (p2 & 0x00ff0000)) >> 17; \
-    const Uint32 g = ((p1 & 0x0000ff00) + (p2 & 0x0000ff00)) >> 9;  \
-    const Uint32 b = ((p1 & 0x000000ff) + (p2 & 0x000000ff)) >> 1;
-
-#define READ_1x2_PIXELS                                             \
-    const Uint32 p1 = ((const Uint32 *)curr_row)[2 * i];            \
-    const Uint32 p2 = ((const Uint32 *)curr_row)[2 * i + 1];        \
-    const Uint32 r = ((p1 & 0x00ff0000) + (p2 & 0x00ff0000)) >> 17; \
-    const Uint32 g = ((p1 & 0x0000ff00) + (p2 & 0x0000ff00)) >> 9;  \
-    const Uint32 b = ((p1 & 0x000000ff) + (p2 & 0x000000ff)) >> 1;
-
-#define READ_1x1_PIXEL                                  \
-    const Uint32 p = ((const Uint32 *)curr_row)[2 * i]; \
-    const Uint32 r = (p & 0x00ff0000) >> 16;            \
-    const Uint32 g = (p & 0x0000ff00) >> 8;             \
-    const Uint32 b = (p & 0x000000ff);
-
-#define READ_TWO_RGB_PIXELS                                  \
-    const Uint32 p = ((const Uint32 *)curr_row)[2 * i];      \
-    const Uint32 r = (p & 0x00ff0000) >> 16;                 \
-    const Uint32 g = (p & 0x0000ff00) >> 8;                  \
-    const Uint32 b = (p & 0x000000ff);                       \
-    const Uint32 p1 = ((const Uint32 *)curr_row)[2 * i + 1]; \
-    const Uint32 r1 = (p1 & 0x00ff0000) >> 16;               \
-    const Uint32 g1 = (p1 & 0x0000ff00) >> 8;                \
-    const Uint32 b1 = (p1 & 0x000000ff);                     \
-    const Uint32 R = (r + r1) / 2;                           \
-    const Uint32 G = (g + g1) / 2;                           \
-    const Uint32 B = (b + b1) / 2;
-
-#define READ_ONE_RGB_PIXEL READ_1x1_PIXEL
+/* The factors arranged by byte offset within a 32-bit pixel, for the vectorized converters */
+typedef struct RGB2YUVPixelFactors
+{
+    Sint16 y[4];
+    Sint16 u[4];
+    Sint16 v[4];
+    int y_bias;
+    int uv_bias;
+} RGB2YUVPixelFactors;
+
+static SDL_bool GetRGB2YUVLayout(Uint32 format, RGB2YUVLayout *layout)
+{
+    switch (format) {
+    case SDL_PIXELFORMAT_RGB24:
+        layout->bpp = 3;
+        layout->r = 0;
+        layout->g = 1;
+        layout->b = 2;
+        return SDL_TRUE;
+    case SDL_PIXELFORMAT_BGR24:
+        layout->bpp = 3;
+        layout->r = 2;
+        layout->g = 1;
+        layout->b = 0;
+        return SDL_TRUE;
+    case SDL_PIXELFORMAT_RGBA32:
+    case SDL_PIXELFORMAT_RGBX32:
+        layout->bpp = 4;
+        layout->r = 0;
+        layout->g = 1;
+        layout->b = 2;
+        return SDL_TRUE;
+    case SDL_PIXELFORMAT_ARGB32:
+    case SDL_PIXELFORMAT_XRGB32:
+        layout->bpp = 4;
+        layout->r = 1;
+        layout->g = 2;
+        layout->b = 3;
+        return SDL_TRUE;
+    case SDL_PIXELFORMAT_BGRA32:
+    case SDL_PIXELFORMAT_BGRX32:
+        layout->bpp = 4;
+        layout->r = 2;
+        layout->g = 1;
+        layout->b = 0;
+        return SDL_TRUE;
+    case SDL_PIXELFORMAT_ABGR32:
+    case SDL_PIXELFORMAT_XBGR32:
+        layout->bpp = 4;
+        layout->r = 3;
+        layout->g = 2;
+        layout->b = 1;
+        return SDL_TRUE;
+    default:
+        return SDL_FALSE;
+    }
+}
+
+static Uint8 RGB2YUV_Clamp(int value)
+{
+    return (Uint8)SDL_min(value, 255);
+}
+
+/* Copy the factors to locals, the compiler can't tell that writing the output doesn't change them */
+#define RGB2YUV_LOAD_FACTORS(cvt)                                          \
+    const int yr = cvt->y[0], yg = cvt->y[1], yb = cvt->y[2];              \
+    const int ur = cvt->u[0], ug = cvt->u[1], ub = cvt->u[2];              \
+    const int vr = cvt->v[0], vg = cvt->v[1], vb = cvt->v[2];              \
+    const int y_bias = (cvt->y_offset << RGB2YUV_SHIFT) + RGB2YUV_ROUND;   \
+    const int uv_bias = (128 << RGB2YUV_SHIFT) + RGB2YUV_ROUND
+
+#define RGB2YUV_Y(r, g, b) RGB2YUV_Clamp((yr * (r) + yg * (g) + yb * (b) + y_bias) >> RGB2YUV_SHIFT)
+#define RGB2YUV_U(r, g, b) RGB2YUV_Clamp((ur * (r) + ug * (g) + ub * (b) + uv_bias) >> RGB2YUV_SHIFT)
+#define RGB2YUV_V(r, g, b) RGB2YUV_Clamp((vr * (r) + vg * (g) + vb * (b) + uv_bias) >> RGB2YUV_SHIFT)
+
+/* Convert columns [x, width) of a pair of rows to 2x2 subsampled YUV.
+   The chroma of each 2x2 block is computed from the average color of the block, edge pixels are repeated for odd sizes. */
+SDL_FORCE_INLINE void RGB2YUV_Planar_Layout(int x, int width, const Uint8 *row0, const Uint8 *row1, Uint8 *y0, Uint8 *y1, Uint8 *u, Uint8 *v, int uv_step, const int bpp, const int R, const int G, const int B, const struct RGB2YUVFactors *cvt)
+{
+    RGB2YUV_LOAD_FACTORS(cvt);
+    int i;
+
+    for (i = x; i < width; ++i) {
+        const Uint8 *p = row0 + i * bpp;
+        y0[i] = RGB2YUV_Y(p[R], p[G], p[B]);
+    }
+    for (i = x; i < width; ++i) {
+        const Uint8 *p = row1 + i * bpp;
+        y1[i] = RGB2YUV_Y(p[R], p[G], p[B]);
+    }
+
+    for (i = x; i < width; i += 2) {
+        const int next = (i + 1 < width) ? bpp : 0;
+        const Uint8 *p0 = row0 + i * bpp;
+        const Uint8 *p1 = row1 + i * bpp;
+        const int r = (p0[R] + p0[next + R] + p1[R] + p1[next + R]) >> 2;
+        const int g = (p0[G] + p0[next + G] + p1[G] + p1[next + G]) >> 2;
+        const int b = (p0[B] + p0[next + B] + p1[B] + p1[next + B]) >> 2;
+
+        u[(i / 2) * uv_step] = RGB2YUV_U(r, g, b);
+        v[(i / 2) * uv_step] = RGB2YUV_V(r, g, b);
+    }
+}
+
+/* Convert columns [x, width) of a row to packed 4:2:2 YUV, either Y U Y V or U Y V Y */
+SDL_FORCE_INLINE void RGB2YUV_Packed_Layout(int x, int width, const Uint8 *row, Uint8 *dst, SDL_bool chroma_first, const int bpp, const int R, const int G, const int B, const struct RGB2YUVFactors *cvt)
+{
+    RGB2YUV_LOAD_FACTORS(cvt);
+    const int y_offset = chroma_first ? 1 : 0;
+    const int uv_offset = chroma_first ? 0 : 1;
+
+    dst += 2 * x;
+    for (; x < width; x += 2) {
+        const Uint8 *p0 = row + x * bpp;
+        const Uint8 *p1 = (x + 1 < width) ? p0 + bpp : p0;
+        const int r = (p0[R] + p1[R]) >> 1;
+        const int g = (p0[G] + p1[G]) >> 1;
+        const int b = (p0[B] + p1[B]) >> 1;
+
+        dst[y_offset] = RGB2YUV_Y(p0[R], p0[G], p0[B]);
+        dst[y_offset + 2] = RGB2YUV_Y(p1[R], p1[G], p1[B]);
+        dst[uv_offset] = RGB2YUV_U(r, g, b);
+        dst[uv_offset + 2] = RGB2YUV_V(r, g, b);
+        dst += 4;
+    }
+}
+
+/* Expand the converters for each layout, so the channel offsets are constants.
+   The position of red is enough to tell the supported layouts apart. */
+#define RGB2YUV_DISPATCH_LAYOUT(layout, FUNC, ...)              \
+    if (layout->bpp == 4) {                                      \
+        switch (layout->r) {                                     \
+        case 0:                                                  \
+            FUNC(__VA_ARGS__, 4, 0, 1, 2, cvt);                  \
+            break;                                               \
+        case 1:                                                  \
+            FUNC(__VA_ARGS__, 4, 1, 2, 3, cvt);                  \
+            break;                                               \
+        case 2:                                                  \
+            FUNC(__VA_ARGS__, 4, 2, 1, 0, cvt);                  \
+            break;                                               \
+        default:                                                 \
+            FUNC(__VA_ARGS__, 4, 3, 2, 1, cvt);                  \
+            break;                                               \
+        }                                                        \
+    } else if (layout->r == 0) {                                 \
+        FUNC(__VA_ARGS__, 3, 0, 1, 2, cvt);                      \
+    } else {                                                     \
+        FUNC(__VA_ARGS__, 3, 2, 1, 0, cvt);                      \
+    }
+
+static void RGB2YUV_Planar_std(int x, int width, const Uint8 *row0, const Uint8 *row1, Uint8 *y0, Uint8 *y1, Uint8 *u, Uint8 *v, int uv_step, const RGB2YUVLayout *layout, const struct RGB2YUVFactors *cvt)
+{
+    RGB2YUV_DISPATCH_LAYOUT(layout, RGB2YUV_Planar_Layout, x, width, row0, row1, y0, y1, u, v, uv_step)
+}
+
+static void RGB2YUV_Packed_std(int x, int width, const Uint8 *row, Uint8 *dst, SDL_bool chroma_first, const RGB2YUVLayout *layout, const struct RGB2YUVFactors *cvt)
+{
+    RGB2YUV_DISPATCH_LAYOUT(layout, RGB2YUV_Packed_Layout, x, width, row, dst, chroma_first)
+}
+
+#undef RGB2YUV_DISPATCH_LAYOUT
+#undef RGB2YUV_LOAD_FACTORS
+#undef RGB2YUV_Y
+#undef RGB2YUV_U
+#undef RGB2YUV_V
+
+/* The vectorized converters handle the start of each row in blocks of pixels and return
+   the number of columns converted, leaving the rest of the row to the scalar code. */
+typedef int (*RGB2YUVPlanarFunc)(int width, const Uint8 *row0, const Uint8 *row1, Uint8 *y0, Uint8 *y1, Uint8 *u, Uint8 *v, SDL_bool interleaved, const RGB2YUVPixelFactors *factors);
+typedef int (*RGB2YUVPackedFunc)(int width, const Uint8 *row, Uint8 *dst, SDL_bool chroma_first, const RGB2YUVPixelFactors *factors);
+
+#ifdef SDL_SSE2_INTRINSICS
+typedef struct RGB2YUVVectors_SSE2
+{
+    __m128i y, u, v;
+    __m128i y_bias, uv_bias;
+} RGB2YUVVectors_SSE2;
+
+static void SDL_TARGETING("sse2") RGB2YUV_Setup_SSE2(const RGB2YUVPixelFactors *factors, RGB2YUVVectors_SSE2 *vectors)
+{
+    vectors->y = _mm_set_epi16(factors->y[3], factors->y[2], factors->y[1], factors->y[0], factors->y[3], factors->y[2], factors->y[1], factors->y[0]);
+    vectors->u = _mm_set_epi16(factors->u[3], factors->u[2], factors->u[1], factors->u[0], factors->u[3], factors->u[2], factors->u[1], factors->u[0]);
+    vectors->v = _mm_set_epi16(factors->v[3], factors->v[2], factors->v[1], factors->v[0], factors->v[3], factors->v[2], factors->v[1], factors->v[0]);
+    vectors->y_bias = _mm_set1_epi32(factors->y_bias);
+    vectors->uv_bias = _mm_set1_epi32(factors->uv_bias);
+}
+
+/* Apply factors to four pixels widened to 16 bits, two in each of lo and hi, returning four 32-bit results */
+SDL_FORCE_INLINE __m128i SDL_TARGETING("sse2") RGB2YUV_Dot4_SSE2(__m128i lo, __m128i hi, __m128i factors, __m128i bias)
+{
+    const __m128 a = _mm_castsi128_ps(_mm_madd_epi16(lo, factors));
+    const __m128 b = _mm_castsi128_ps(_mm_madd_epi16(hi, factors));
+    const __m128i sum = _mm_add_epi32(_mm_castps_si128(_mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0))),
+                                      _mm_castps_si128(_mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1))));
+    return _mm_srai_epi32(_mm_add_epi32(sum, bias), RGB2YUV_SHIFT);
+}
+
+/* Convert 16 pixels from each of two rows, returning 16 Y values per row and 8 U and V values for the 2x2 blocks */
+SDL_FORCE_INLINE void SDL_TARGETING("sse2") RGB2YUV_Convert16_SSE2(const Uint8 *row0, const Uint8 *row1, const RGB2YUVVectors_SSE2 *vectors, __m128i *y0, __m128i *y1, __m128i *u, __m128i *v)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i Y0[4], Y1[4], blocks[4], U[2], V[2];
+    int i;
+
+    for (i = 0; i < 4; ++i) {
+        const __m128i a = _mm_loadu_si128((const __m128i *)(row0 + i * 16));
+        const __m128i b = _mm_loadu_si128((const __m128i *)(row1 + i * 16));
+        const __m128i a_lo = _mm_unpacklo_epi8(a, zero);
+        const __m128i a_hi = _mm_unpackhi_epi8(a, zero);
+        const __m128i b_lo = _mm_unpacklo_epi8(b, zero);
+        const __m128i b_hi = _mm_unpackhi_epi8(b, zero);
+        __m128i lo, hi;
+
+        Y0[i] = RGB2YUV_Dot4_SSE2(a_lo, a_hi, vectors->y, vectors->y_bias);
+        if (y1) {
+            Y1[i] = RGB2YUV_Dot4_SSE2(b_lo, b_hi, vectors->y, vectors->y_bias);
+        }
+
+        /* Sum each 2x2 block, first vertically and then horizontally */
+        lo = _mm_add_epi16(a_lo, b_lo);
+        hi = _mm_add_epi16(a_hi, b_hi);
+        lo = _mm_add_epi16(lo, _mm_srli_si128(lo, 8));
+        hi = _mm_add_epi16(hi, _mm_srli_si128(hi, 8));
+        blocks[i] = _mm_srli_epi16(_mm_unpacklo_epi64(lo, hi), 2);
+    }
+
+    *y0 = _mm_packus_epi16(_mm_packs_epi32(Y0[0], Y0[1]), _mm_packs_epi32(Y0[2], Y0[3]));
+    if (y1) {
+        *y1 = _mm_packus_epi16(_mm_packs_epi32(Y1[0], Y1[1]), _mm_packs_epi32(Y1[2], Y1[3]));
+    }
+
+    for (i = 0; i < 2; ++i) {
+        U[i] = RGB2YUV_Dot4_SSE2(blocks[i * 2], blocks[i * 2 + 1], vectors->u, vectors->uv_bias);
+        V[i] = RGB2YUV_Dot4_SSE2(blocks[i * 2], blocks[i * 2 + 1], vectors->v, vectors->uv_bias);
+    }
+    *u = _mm_packus_epi16(_mm_packs_epi32(U[0], U[1]), zero);
+    *v = _mm_packus_epi16(_mm_packs_epi32(V[0], V[1]), zero);
+}
+
+static int SDL_TARGETING("sse2") RGB2YUV_Planar_SSE2(int width, const Uint8 *row0, const Uint8 *row1, Uint8 *y0, Uint8 *y1, Uint8 *u, Uint8 *v, SDL_bool interleaved, const RGB2YUVPixelFactors *factors)
+{
+    RGB2YUVVectors_SSE2 vectors;
+    __m128i Y0, Y1, U, V;
+    int x;
+
+    RGB2YUV_Setup_SSE2(factors, &vectors);
+
+    for (x = 0; x + 16 <= width; x += 16) {
+        RGB2YUV_Convert16_SSE2(row0 + x * 4, row1 + x * 4, &vectors, &Y0, &Y1, &U, &V);
+        _mm_storeu_si128((__m128i *)(y0 + x), Y0);
+        _mm_storeu_si128((__m128i *)(y1 + x), Y1);
+        if (interleaved) {
+            _mm_storeu_si128((__m128i *)(u + x), _mm_unpacklo_epi8(U, V));
+        } else {
+            _mm_storel_epi64((__m128i *)(u + x / 2), U);
+            _mm_storel_epi64((__m128i *)(v + x / 2), V);
+        }
+    }
+    return x;
+}
+
+static int SDL_TARGETING("sse2") RGB2YUV_Packed_SSE2(int width, const Uint8 *row, Uint8 *dst, SDL_bool chroma_first, const RGB2YUVPixelFactors *factors)
+{
+    RGB2YUVVectors_SSE2 vectors;
+    __m128i Y, U, V, UV;
+    int x;
+
+    RGB2YUV_Setup_SSE2(factors, &vectors);
+
+    for (x = 0; x + 16 <= width; x += 16) {
+        RGB2YUV_Convert16_SSE2(row + x * 4, row + x * 4, &vectors, &Y, NULL, &U, &V);
+        UV = _mm_unpacklo_epi8(U, V);
+        if (chroma_first) {
+            _mm_storeu_si128((__m128i *)(dst + x * 2), _mm_unpacklo_epi8(UV, Y));
+            _mm_storeu_si128((__m128i *)(dst + x * 2 + 16), _mm_unpackhi_epi8(UV, Y));
+        } else {
+            _mm_storeu_si128((__m128i *)(dst + x * 2), _mm_unpacklo_epi8(Y, UV));
+            _mm_storeu_si128((__m128i *)(dst + x * 2 + 16), _mm_unpackhi_epi8(Y, UV));
+        }
+    }
+    return x;
+}
+#endif /* SDL_SSE2_INTRINSICS */
+
+#ifdef SDL_AVX2_INTRINSICS
+typedef struct RGB2YUVVectors_AVX2
+{
+    __m256i y, u, v;
+    __m256i y_bias, uv_bias;
+} RGB2YUVVectors_AVX2;
+
+static void SDL_TARGETING("avx2") RGB2YUV_Setup_AVX2(const RGB2YUVPixelFactors *factors, RGB2YUVVectors_AVX2 *vectors)
+{
+    vectors->y = _mm256_set1_epi64x((Sint64)((Uint64)(Uint16)factors->y[0] | ((Uint64)(Uint16)factors->y[1] << 16) | ((Uint64)(Uint16)factors->y[2] << 32) | ((Uint64)(Uint16)factors->y[3] << 48)));
+    vectors->u = _mm256_set1_epi64x((Sint64)((Uint64)(Uint16)factors->u[0] | ((Uint64)(Uint16)factors->u[1] << 16) | ((Uint64)(Uint16)factors->u[2] << 32) | ((Uint64)(Uint16)factors->u[3] << 48)));
+    vectors->v = _mm256_set1_epi64x((Sint64)((Uint64)(Uint16)factors->v[0] | ((Uint64)(Uint16)factors->v[1] << 16) | ((Uint64)(Uint16)factors->v[2] << 32) | ((Uint64)(Uint16)factors->v[3] << 48)));
+    vectors->y_bias = _mm256_set1_epi32(factors->y_bias);
+    vectors->uv_bias = _mm256_set1_epi32(factors->uv_bias);
+}
+
+/* Like RGB2YUV_Dot4_SSE2(), in each 128-bit lane: with lo holding pixels 0,1 | 4,5 and hi holding 2,3 | 6,7 the results are in pixel order */
+SDL_FORCE_INLINE __m256i SDL_TARGETING("avx2") RGB2YUV_Dot8_AVX2(__m256i lo, __m256i hi, __m256i factors, __m256i bias)
+{
+    const __m256 a = _mm256_castsi256_ps(_mm256_madd_epi16(lo, factors));
+    const __m256 b = _mm256_castsi256_ps(_mm256_madd_epi16(hi, factors));
+    const __m256i sum = _mm256_add_epi32(_mm256_castps_si256(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0))),
+                                         _mm256_castps_si256(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1))));
+    return _mm256_srai_epi32(_mm256_add_epi32(sum, bias), RGB2YUV_SHIFT);
+}
+
+/* Convert 32 pixels from each of two rows, returning 32 Y values per row and 16 U and V values for the 2x2 blocks */
+SDL_FORCE_INLINE void SDL_TARGETING("avx2") RGB2YUV_Convert32_AVX2(const Uint8 *row0, const Uint8 *row1, const RGB2YUVVectors_AVX2 *vectors, __m256i *y0, __m256i *y1, __m128i *u, __m128i *v)
+{
+    /* The in-lane packs leave groups of four results interleaved between the lanes */
+    const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i Y0[4], Y1[4], blocks[4], U[2], V[2], UV;
+    int i;
+
+    for (i = 0; i < 4; ++i) {
+        const __m256i a = _mm256_loadu_si256((const __m256i *)(row0 + i * 32));
+        const __m256i b = _mm256_loadu_si256((const __m256i *)(row1 + i * 32));
+        const __m256i a_lo = _mm256_unpacklo_epi8(a, zero);
+        const __m256i a_hi = _mm256_unpackhi_epi8(a, zero);
+        const __m256i b_lo = _mm256_unpacklo_epi8(b, zero);
+        const __m256i b_hi = _mm256_unpackhi_epi8(b, zero);
+        __m256i lo, hi;
+
+        Y0[i] = RGB2YUV_Dot8_AVX2(a_lo, a_hi, vectors->y, vectors->y_bias);
+        if (y1) {
+            Y1[i] = RGB2YUV_Dot8_AVX2(b_lo, b_hi, vectors->y, vectors->y_bias);
+        }
+
+        /* Sum each 2x2 block, giving blocks 0,1 | 2,3 of these 8 pixels */
+        lo = _mm256_add_epi16(a_lo, b_lo);
+        hi = _mm256_add_epi16(a_hi, b_hi);
+        lo = _mm256_add_epi16(lo, _mm256_srli_si256(lo, 8));
+        hi = _mm256_add_epi16(hi, _mm256_srli_si256(hi, 8));
+        blocks[i] = _mm256_srli_epi16(_mm256_unpacklo_epi64(lo, hi), 2);
+    }
+
+    *y0 = _mm256_permutevar8x32_epi32(_mm256_packus_epi16(_mm256_packs_epi32(Y0[0], Y0[1]), _mm256_packs_epi32(Y0[2], Y0[3])), order);
+    if (y1) {
+        *y1 = _mm256_permutevar8x32_epi32(_mm256_packus_epi16(_mm256_packs_epi32(Y1[0], Y1[1]), _mm256_packs_epi32(Y1[2], Y1[3])), order);
+    }
+
+    for (i = 0; i < 2; ++i) {
+        /* Rearrange the blocks into 0,1 | 4,5 and 2,3 | 6,7 for RGB2YUV_Dot8_AVX2() */
+        const __m256i lo = _mm256_permute2x128_si256(blocks[i * 2], blocks[i * 2 + 1], 0x20);
+        const __m256i hi = _mm256_permute2x128_si256(blocks[i * 2], blocks[i * 2 + 1], 0x31);
+        U[i] = RGB2YUV_Dot8_AVX2(lo, hi, vectors->u, vectors->uv_bias);
+        V[i] = RGB2YUV_Dot8_AVX2(lo, hi, vectors->v, vectors->uv_bias);
+    }
+    UV = _mm256_permutevar8x32_epi32(_mm256_packus_epi16(_mm256_packs_epi32(U[0], U[1]), _mm256_packs_epi32(V[0], V[1])), order);
+    *u = _mm256_castsi256_si128(UV);
+    *v = _mm256_extracti128_si256(UV, 1);
+}
+
+static int SDL_TARGETING("avx2") RGB2YUV_Planar_AVX2(int width, const Uint8 *row0, const Uint8 *row1, Uint8 *y0, Uint8 *y1, Uint8 *u, Uint8 *v, SDL_bool interleaved, const RGB2YUVPixelFactors *factors)
+{
+    RGB2YUVVectors_AVX2 vectors;
+    __m256i Y0, Y1;
+    __m128i U, V;
+    int x;
+
+    RGB2YUV_Setup_AVX2(factors, &vectors);
+
+    for (x = 0; x + 32 <= width; x += 32) {
+        RGB2YUV_Convert32_AVX2(row0 + x * 4, row1 + x * 4, &vectors, &Y0, &Y1, &U, &V);
+        _mm256_storeu_si256((__m256i *)(y0 + x), Y0);
+        _mm256_storeu_si256((__m256i *)(y1 + x), Y1);
+        if (interleaved) {
+            _mm_storeu_si128((__m128i *)(u + x), _mm_unpacklo_epi8(U, V));
+            _mm_storeu_si128((__m128i *)(u + x + 16), _mm_unpackhi_epi8(U, V));
+        } else {
+            _mm_storeu_si128((__m128i *)(u + x / 2), U);
+            _mm_storeu_si128((__m128i *)(v + x / 2), V);
+        }
+    }
+    return x;
+}
+
+static int SDL_TARGETING("avx2") RGB2YUV_Packed_AVX2(int width, const Uint8 *row, Uint8 *dst, SDL_bool chroma_first, const RGB2YUVPixelFactors *factors)
+{
+    RGB2YUVVectors_AVX2 vectors;
+    __m256i Y;
+    __m128i U, V, Y_lo, Y_hi, UV_lo, UV_hi;
+    int x;
+
+    RGB2YUV_Setup_AVX2(factors, &vectors);
+
+    for (x = 0; x + 32 <= width; x += 32) {
+        RGB2YUV_Convert32_AVX2(row + x * 4, row + x * 4, &vectors, &Y, NULL, &U, &V);
+        Y_lo = _mm256_castsi256_si128(Y);
+        Y_hi = _mm256_extracti128_si256(Y, 1);
+        UV_lo = _mm_unpacklo_epi8(U, V);
+        UV_hi = _mm_unpackhi_epi8(U, V);
+        if (chroma_first) {
+            _mm_storeu_si128((__m128i *)(dst + x * 2), _mm_unpacklo_epi8(UV_lo, Y_lo));
+            _mm_storeu_si128((__m128i *)(dst + x * 2 + 16), _mm_unpackhi_epi8(UV_lo, Y_lo));
+            _mm_storeu_si128((__m128i *)(dst + x * 2 + 32), _mm_unpacklo_epi8(UV_hi, Y_hi));
+            _mm_storeu_si128((__m128i *)(dst + x * 2 + 48), _mm_unpackhi_epi8(UV_hi, Y_hi));
+        } else {
+            _mm_storeu_si128((__m128i *)(dst + x * 2), _mm_unpacklo_epi8(Y_lo, UV_lo));
+            _mm_storeu_si128((__m128i *)(dst + x * 2 + 16), _mm_unpackhi_epi8(Y_lo, UV_lo));
+            _mm_storeu_si128((__m128i *)(dst + x * 2 + 32), _mm_unpacklo_epi8(Y_hi, UV_hi));
+            _mm_storeu_si128((__m128i *)(dst + x * 2 + 48), _mm_unpackhi_epi8(Y_hi, UV_hi));
+        }
+    }
+    return x;
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#ifdef SDL_NEON_INTRINSICS
+/* Apply factors to 8 pixels split into 16-bit channels, returning 8 results */
+SDL_FORCE_INLINE uint16x8_t RGB2YUV_Dot8_NEON(const int16x8_t channels[4], const Sint16 factors[4], int bias)
+{
+    int32x4_t lo = vdupq_n_s32(bias);
+    int32x4_t hi = vdupq_n_s32(bias);
+    int i;
+
+    for (i = 0; i < 4; ++i) {
+        lo = vmlal_n_s16(lo, vget_low_s16(channels[i]), factors[i]);
+        hi = vmlal_n_s16(hi, vget_high_s16(channels[i]), factors[i]);
+    }
+    return vcombine_u16(vqshrun_n_s32(lo, RGB2YUV_SHIFT), vqshrun_n_s32(hi, RGB2YUV_SHIFT));
+}
+
+/* Convert 16 pixels from each of two rows, returning 16 Y values per row and 8 U and V values for the 2x2 blocks */
+SDL_FORCE_INLINE void RGB2YUV_Convert16_NEON(const Uint8 *row0, const Uint8 *row1, const RGB2YUVPixelFactors *factors, uint8x16_t *y0, uint8x16_t *y1, uint8x8_t *u, uint8x8_t *v)
+{
+    const uint8x16x4_t a = vld4q_u8(row0);
+    const uint8x16x4_t b = vld4q_u8(row1);
+    int16x8_t lo[4], hi[4], blocks[4];
+    int i;
+
+    for (i = 0; i < 4; ++i) {
+        lo[i] = vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(a.val[i])));
+        hi[i] = vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(a.val[i])));
+    }
+    *y0 = vcombine_u8(vqmovn_u16(RGB2YUV_Dot8_NEON(lo, factors->y, factors->y_bias)), vqmovn_u16(RGB2YUV_Dot8_NEON(hi, factors->y, factors->y_bias)));
+
+    if (y1) {
+        for (i = 0; i < 4; ++i) {
+            lo[i] = vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(b.val[i])));
+            hi[i] = vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(b.val[i])));
+        }
+        *y1 = vcombine_u8(vqmovn_u16(RGB2YUV_Dot8_NEON(lo, factors->y, factors->y_bias)), vqmovn_u16(RGB2YUV_Dot8_NEON(hi, factors->y, factors->y_bias)));
+    }
+
+    /* Sum each 2x2 block, horizontal pairs of the first row and then the second row */
+    for (i = 0; i < 4; ++i) {
+        blocks[i] = vreinterpretq_s16_u16(vshrq_n_u16(vpadalq_u8(vpaddlq_u8(a.val[i]), b.val[i]), 2));
+    }
+    *u = vqmovn_u16(RGB2YUV_Dot8_NEON(blocks, factors->u, factors->uv_bias));
+    *v = vqmovn_u16(RGB2YUV_Dot8_NEON(blocks, factors->v, factors->uv_bias));
+}
+
+static int RGB2YUV_Planar_NEON(int width, const Uint8 *row0, const Uint8 *row1, Uint8 *y0, Uint8 *y1, Uint8 *u, Uint8 *v, SDL_bool interleaved, const RGB2YUVPixelFactors *factors)
+{
+    uint8x16_t Y0, Y1;
+    uint8x8x2_t UV;
+    int x;
+
+    for (x = 0; x + 16 <= width; x += 16) {
+        RGB2YUV_Convert16_NEON(row0 + x * 4, row1 + x * 4, factors, &Y0, &Y1, &UV.val[0], &UV.val[1]);
+        vst1q_u8(y0 + x, Y0);
+        vst1q_u8(y1 + x, Y1);
+        if (interleaved) {
+            vst2_u8(u + x, UV);
+        } else {
+            vst1_u8(u + x / 2, UV.val[0]);
+            vst1_u8(v + x / 2, UV.val[1]);
+        }
+    }
+    return x;
+}
+
+static int RGB2YUV_Packed_NEON(int width, const Uint8 *row, Uint8 *dst, SDL_bool chroma_first, const RGB2YUVPixelFactors *factors)
+{
+    uint8x16_t Y;
+    uint8x8_t U, V;
+    uint8x8x2_t YY;
+    uint8x8x4_t out;
+    int x;
+
+    for (x = 0; x + 16 <= width; x += 16) {
+        RGB2YUV_Convert16_NEON(row + x * 4, row + x * 4, factors, &Y, NULL, &U, &V);
+        YY = vuzp_u8(vget_low_u8(Y), vget_high_u8(Y));
+        if (chroma_first) {
+            out.val[0] = U;
+            out.val[1] = YY.val[0];
+            out.val[2] = V;
+            out.val[3] = YY.val[1];
+        } else {
+            out.val[0] = YY.val[0];
+            out.val[1] = U;
+            out.val[2] = YY.val[1];
+            out.val[3] = V;
+        }
+        vst4_u8(dst + x * 2, out);
+    }
+    return x;
+}
+#endif /* SDL_NEON_INTRINSICS */
+
+/* Widen a row of 24-bit pixels to 32 bits so the vector kernels can process it */
+static void RGB2YUV_ExpandRow(const Uint8 *src, Uint8 *dst, int width)
+{
+    int i;
+
+    for (i = 0; i < width; ++i) {
+        dst[0] = src[0];
+        dst[1] = src[1];
+        dst[2] = src[2];
+        dst[3] = 0;
+        src += 3;
+        dst += 4;
+    }
+}
+
+static int SDL_ConvertPixels_RGB_to_YUV_Direct(int width, int height, const RGB2YUVLayout *layout, const void *src, int src_pitch, Uint32 dst_format, void *dst, int dst_pitch, YCbCrType yuv_type)
+{
+    struct RGB2YUVFactors cvt = RGB2YUVFactorTables[yuv_type];
+    RGB2YUVPixelFactors factors;
+    RGB2YUVPlanarFunc planar_func = NULL;
+    RGB2YUVPackedFunc packed_func = NULL;
+    const Uint8 *row0, *row1;
+    Uint8 *expanded = NULL;
+    int i, j, x;
+
+    /* NV21 and YVYU are NV12 and YUY2 with U and V swapped */
+    if (dst_format == SDL_PIXELFORMAT_NV21 || dst_format == SDL_PIXELFORMAT_YVYU) {
+        for (i = 0; i < 3; ++i) {
+            const Sint16 tmp = cvt.u[i];
+            cvt.u[i] = cvt.v[i];
+            cvt.v[i] = tmp;
+        }
+    }
+
+    {
+        /* 24-bit pixels are expanded to 32 bits per row, so the same offsets apply */
+        SDL_zero(factors);
+        factors.y[layout->r] = cvt.y[0];
+        factors.y[layout->g] = cvt.y[1];
+        factors.y[layout->b] = cvt.y[2];
+        factors.u[layout->r] = cvt.u[0];
+        factors.u[layout->g] = cvt.u[1];
+        factors.u[layout->b] = cvt.u[2];
+        factors.v[layout->r] = cvt.v[0];
+        factors.v[layout->g] = cvt.v[1];
+        factors.v[layout->b] = cvt.v[2];
+        factors.y_bias = (cvt.y_offset << RGB2YUV_SHIFT) + RGB2YUV_ROUND;
+        factors.uv_bias = (128 << RGB2YUV_SHIFT) + RGB2YUV_ROUND;
+
+#ifdef SDL_AVX2_INTRINSICS
+        if (!planar_func && SDL_HasAVX2()) {
+            planar_func = RGB2YUV_Planar_AVX2;
+            packed_func = RGB2YUV_Packed_AVX2;
+        }
+#endif
+#ifdef SDL_SSE2_INTRINSICS
+        if (!planar_func && SDL_HasSSE2()) {
+            planar_func = RGB2YUV_Planar_SSE2;
+            packed_func = RGB2YUV_Packed_SSE2;
+        }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+        if (!planar_func && SDL_HasNEON()) {
+            planar_func = RGB2YUV_Planar_NEON;
+            packed_func = RGB2YUV_Packed_NEON;
+        }
+#endif
+    }
+
+    if (planar_func && layout->bpp == 3) {
+        expanded = (Uint8 *)SDL_malloc((size_t)width * 4 * 2);
+        if (!expanded) {
+            /* Fall back to the scalar path */
+            planar_func = NULL;
+            packed_func = NULL;
+        }
+    }
 
     switch (dst_format) {
     case SDL_PIXELFORMAT_YV12:
@@ -708,133 +1957,48 @@ static int SDL_ConvertPixels_ARGB8888_to_YUV(int width, int height, const void *
     case SDL_PIXELFORMAT_NV12:
     case SDL_PIXELFORMAT_NV21:
     {
-        const Uint8 *curr_row, *next_row;
-
+        const SDL_bool interleaved = (dst_format == SDL_PIXELFORMAT_NV12 || dst_format == SDL_PIXELFORMAT_NV21);
         Uint8 *plane_y;
         Uint8 *plane_u;
         Uint8 *plane_v;
-        Uint8 *plane_interleaved_uv;
-        Uint32 y_stride, uv_stride, y_skip, uv_skip;
+        Uint32 y_stride, uv_stride;
 
         if (GetYUVPlanes(width, height, dst_format, dst, dst_pitch,
                          (const Uint8 **)&plane_y, (const Uint8 **)&plane_u, (const Uint8 **)&plane_v,
                          &y_stride, &uv_stride) != 0) {
+            SDL_free(expanded);
             return -1;
         }
+        if (interleaved) {
+            /* U and V have been swapped for NV21 */
+            plane_u = plane_y + height * y_stride;
+            plane_v = plane_u + 1;
+        }
 
-        plane_interleaved_uv = (plane_y + height * y_stride);
-        y_skip = (y_stride - width);
-
-        curr_row = (const Uint8 *)src;
+        for (j = 0; j < height; j += 2) {
+            Uint8 *y0 = plane_y + j * y_stride;
+            Uint8 *y1 = y0;
 
-        /* Write Y plane */
-        for (j = 0; j < height; j++) {
-            for (i = 0; i < width; i++) {
-                const Uint32 p1 = ((const Uint32 *)curr_row)[i];
-                const Uint32 r = (p1 & 0x00ff0000) >> 16;
-                const Uint32 g = (p1 & 0x0000ff00) >> 8;
-                const Uint32 b = (p1 & 0x000000ff);
-                *plane_y++ = MAKE_Y(r, g, b);
-            }
-            plane_y += y_skip;
-            curr_row += src_pitch;
-        }
-
-        curr_row = (const Uint8 *)src;
-        next_row = (const Uint8 *)src;
-        next_row += src_pitch;
-
-        if (dst_format == SDL_PIXELFORMAT_YV12 || dst_format == SDL_PIXELFORMAT_IYUV) {
-            /* Write UV planes, not interleaved */
-            uv_skip = (uv_stride - (width + 1) / 2);
-            for (j = 0; j < height_half; j++) {
-                for (i = 0; i < width_half; i++) {
-                    READ_2x2_PIXELS;
-                    *plane_u++ = MAKE_U(r, g, b);
-                    *plane_v++ = MAKE_V(r, g, b);
-                }
-                if (width_remainder) {
-                    READ_2x1_PIXELS;
-                    *plane_u++ = MAKE_U(r, g, b);
-                    *plane_v++ = MAKE_V(r, g, b);
-                }
-                plane_u += uv_skip;
-                plane_v += uv_skip;
-                curr_row += src_pitch_x_2;
-                next_row += src_pitch_x_2;
-            }
-            if (height_remainder) {
-                for (i = 0; i < width_half; i++) {
-                    READ_1x2_PIXELS;
-                    *plane_u++ = MAKE_U(r, g, b);
-                    *plane_v++ = MAKE_V(r, g, b);
-                }
-                if (width_remainder) {
-                    READ_1x1_PIXEL;
-                    *plane_u++ = MAKE_U(r, g, b);
-                    *plane_v++ = MAKE_V(r, g, b);
-                }
-                plane_u += uv_skip;
-                plane_v += uv_skip;
+            /* The last row of an odd height image is its own 2x2 block partner */
+            row0 = (const Uint8 *)src + j * src_pitch;
+            row1 = row0;
+            if (j + 1 < height) {
+                row1 += src_pitch;
+                y1 += y_stride;
             }
-        } else if (dst_format == SDL_PIXELFORMAT_NV12) {
-            uv_skip = (uv_stride - ((width + 1) / 2) * 2);
-            for (j = 0; j < height_half; j++) {
-                for (i = 0; i < width_half; i++) {
-                    READ_2x2_PIXELS;
-                    *plane_interleaved_uv++ = MAKE_U(r, g, b);
-                    *plane_interleaved_uv++ = MAKE_V(r, g, b);
-                }
-                if (width_remainder) {
-                    READ_2x1_PIXELS;
-                    *plane_interleaved_uv++ = MAKE_U(r, g, b);
-                    *plane_interleaved_uv++ = MAKE_V(r, g, b);
-                }
-                plane_interleaved_uv += uv_skip;
-                curr_row += src_pitch_x_2;
-                next_row += src_pitch_x_2;
-            }
-            if (height_remainder) {
-                for (i = 0; i < width_half; i++) {
-                    READ_1x2_PIXELS;
-                    *plane_interleaved_uv++ = MAKE_U(r, g, b);
-                    *plane_interleaved_uv++ = MAKE_V(r, g, b);
-                }
-                if (width_remainder) {
-                    READ_1x1_PIXEL;
-                    *plane_interleaved_uv++ = MAKE_U(r, g, b);
-                    *plane_interleaved_uv++ = MAKE_V(r, g, b);
-                }
-            }
-        } else /* dst_format == SDL_PIXELFORMAT_NV21 */ {
-            uv_skip = (uv_stride - ((width + 1) / 2) * 2);
-            for (j = 0; j < height_half; j++) {
-                for (i = 0; i < width_half; i++) {
-                    READ_2x2_PIXELS;
-                    *plane_interleaved_uv++ = MAKE_V(r, g, b);
-                    *plane_interleaved_uv++ = MAKE_U(r, g, b);
-                }
-                if (width_remainder) {
-                    READ_2x1_PIXELS;
-                    *plane_interleaved_uv++ = MAKE_V(r, g, b);
-                    *plane_interleaved_uv++ = MAKE_U(r, g, b);
-                }
-                plane_interleaved_uv += uv_skip;
-                curr_row += src_pitch_x_2;
-                next_row += src_pitch_x_2;
-            }
-            if (height_remainder) {
-                for (i = 0; i < width_half; i++) {
-                    READ_1x2_PIXELS;
-                    *plane_interleaved_uv++ = MAKE_V(r, g, b);
-                    *plane_interleaved_uv++ = MAKE_U(r, g, b);
-                }
-                if (width_remainder) {
-                    READ_1x1_PIXEL;
-                    *plane_interleaved_uv++ = MAKE_V(r, g, b);
-                    *plane_interleaved_uv++ = MAKE_U(r, g, b);
-                }
+
+            x = 0;
+            if (expanded) {
+                RGB2YUV_ExpandRow(row0, expanded, width);
+                RGB2YUV_ExpandRow(row1, expanded + width * 4, width);
+                x = planar_func(width, expanded, expanded + width * 4, y0, y1, plane_u, plane_v, interleaved, &factors);
+            } else if (planar_func) {
+                x = planar_func(width, row0, row1, y0, y1, plane_u, plane_v, interleaved, &factors);
             }
+            RGB2YUV_Planar_std(x, width, row0, row1, y0, y1, plane_u, plane_v, interleaved ? 2 : 1, layout, &cvt);
+
+            plane_u += uv_stride;
+            plane_v += uv_stride;
         }
     } break;
 
@@ -842,95 +2006,37 @@ static int SDL_ConvertPixels_ARGB8888_to_YUV(int width, int height, const void *
     case SDL_PIXELFORMAT_UYVY:
     case SDL_PIXELFORMAT_YVYU:
     {
-        const Uint8 *curr_row = (const Uint8 *)src;
+        const SDL_bool chroma_first = (dst_format == SDL_PIXELFORMAT_UYVY);
         Uint8 *plane = (Uint8 *)dst;
         const int row_size = (4 * ((width + 1) / 2));
-        int plane_skip;
 
         if (dst_pitch < row_size) {
+            SDL_free(expanded);
             return SDL_SetError("Destination pitch is too small, expected at least %d\n", row_size);
         }
-        plane_skip = (dst_pitch - row_size);
 
         /* Write YUV plane, packed */
-        if (dst_format == SDL_PIXELFORMAT_YUY2) {
-            for (j = 0; j < height; j++) {
-                for (i = 0; i < width_half; i++) {
-                    READ_TWO_RGB_PIXELS;
-                    /* Y U Y1 V */
-                    *plane++ = MAKE_Y(r, g, b);
-                    *plane++ = MAKE_U(R, G, B);
-                    *plane++ = MAKE_Y(r1, g1, b1);
-                    *plane++ = MAKE_V(R, G, B);
-                }
-                if (width_remainder) {
-                    READ_ONE_RGB_PIXEL;
-                    /* Y U Y V */
-                    *plane++ = MAKE_Y(r, g, b);
-                    *plane++ = MAKE_U(r, g, b);
-                    *plane++ = MAKE_Y(r, g, b);
-                    *plane++ = MAKE_V(r, g, b);
-                }
-                plane += plane_skip;
-                curr_row += src_pitch;
-            }
-        } else if (dst_format == SDL_PIXELFORMAT_UYVY) {
-            for (j = 0; j < height; j++) {
-                for (i = 0; i < width_half; i++) {
-                    READ_TWO_RGB_PIXELS;
-                    /* U Y V Y1 */
-                    *plane++ = MAKE_U(R, G, B);
-                    *plane++ = MAKE_Y(r, g, b);
-                    *plane++ = MAKE_V(R, G, B);
-                    *plane++ = MAKE_Y(r1, g1, b1);
-                }
-                if (width_remainder) {
-                    READ_ONE_RGB_PIXEL;
-                    /* U Y V Y */
-                    *plane++ = MAKE_U(r, g, b);
-                    *plane++ = MAKE_Y(r, g, b);
-                    *plane++ = MAKE_V(r, g, b);
-                    *plane++ = MAKE_Y(r, g, b);
-                }
-                plane += plane_skip;
-                curr_row += src_pitch;
-            }
-        } else if (dst_format == SDL_PIXELFORMAT_YVYU) {
-            for (j = 0; j < height; j++) {
-                for (i = 0; i < width_half; i++) {
-                    READ_TWO_RGB_PIXELS;
-                    /* Y V Y1 U */
-                    *plane++ = MAKE_Y(r, g, b);
-                    *plane++ = MAKE_V(R, G, B);
-                    *plane++ = MAKE_Y(r1, g1, b1);
-                    *plane++ = MAKE_U(R, G, B);
-                }
-                if (width_remainder) {
-                    READ_ONE_RGB_PIXEL;
-                    /* Y V Y U */
-                    *plane++ = MAKE_Y(r, g, b);
-                    *plane++ = MAKE_V(r, g, b);
-                    *plane++ = MAKE_Y(r, g, b);
-                    *plane++ = MAKE_U(r, g, b);
-                }
-                plane += plane_skip;
-                curr_row += src_pitch;
+        for (j = 0; j < height; j++) {
+            row0 = (const Uint8 *)src + j * src_pitch;
+
+            x = 0;
+            if (expanded) {
+                RGB2YUV_ExpandRow(row0, expanded, width);
+                x = packed_func(width, expanded, plane, chroma_first, &factors);
+            } else if (packed_func) {
+                x = packed_func(width, row0, plane, chroma_first, &factors);
             }
+            RGB2YUV_Packed_std(x, width, row0, plane, chroma_first, layout, &cvt);
+
+            plane += dst_pitch;
         }
     } break;
 
     default:
+        SDL_free(expanded);
         return SDL_SetError("Unsupported YUV destination format: %s", SDL_GetPixelFormatName(dst_format));
     }
-#undef MAKE_Y
-#undef MAKE_U
-#undef MAKE_V
-#undef READ_2x2_PIXELS
-#undef READ_2x1_PIXELS
-#undef READ_1x2_PIXELS
-#undef READ_1x1_PIXEL
-#undef READ_TWO_RGB_PIXELS
-#undef READ_ONE_RGB_PIXEL
+    SDL_free(expanded);
     return 0;
 }
 
@@ -939,35 +2045,18 @@ int SDL_ConvertPixels_RGB_to_YUV(int width, int height,
                                  Uint32 dst_format, SDL_Colorspace dst_colorspace, SDL_PropertiesID dst_properties, void *dst, int dst_pitch)
 {
     YCbCrType yuv_type = YCBCR_601;
+    RGB2YUVLayout layout;
 
     if (GetYUVConversionType(dst_colorspace, &yuv_type) < 0) {
         return -1;
     }
 
-#if 0 /* Doesn't handle odd widths */
-    /* RGB24 to FOURCC */
-    if (src_format == SDL_PIXELFORMAT_RGB24) {
-        Uint8 *y;
-        Uint8 *u;
-        Uint8 *v;
-        Uint32 y_stride;
-        Uint32 uv_stride;
-
-        if (GetYUVPlanes(width, height, dst_format, dst, dst_pitch, (const Uint8 **)&y, (const Uint8 **)&u, (const Uint8 **)&v, &y_stride, &uv_stride) < 0) {
-            return -1;
-        }
-
-        rgb24_yuv420_std(width, height, src, src_pitch, y, u, v, y_stride, uv_stride, yuv_type);
-        return 0;
-    }
-#endif
-
-    /* ARGB8888 to FOURCC */
-    if (src_format == SDL_PIXELFORMAT_ARGB8888) {
-        return SDL_ConvertPixels_ARGB8888_to_YUV(width, height, src, src_pitch, dst_format, dst, dst_pitch, yuv_type);
+    /* 8-bit per channel RGB to FOURCC, read directly */
+    if (GetRGB2YUVLayout(src_format, &layout)) {
+        return SDL_ConvertPixels_RGB_to_YUV_Direct(width, height, &layout, src, src_pitch, dst_format, dst, dst_pitch, yuv_type);
     }
 
-    /* not ARGB8888 to FOURCC : need an intermediate conversion */
+    /* any other RGB format to FOURCC : need an intermediate conversion */
     {
         int ret;
         void *tmp;
@@ -986,7 +2075,8 @@ int SDL_ConvertPixels_RGB_to_YUV(int width, int height,
         }
 
         /* convert tmp/ARGB8888 to dst/FOURCC */
-        ret = SDL_ConvertPixels_ARGB8888_to_YUV(width, height, tmp, tmp_pitch, dst_format, dst, dst_pitch, yuv_type);
+        GetRGB2YUVLayout(SDL_PIXELFORMAT_ARGB8888, &layout);
+        ret = SDL_ConvertPixels_RGB_to_YUV_Direct(width, height, &layout, tmp, tmp_pitch, dst_format, dst, dst_pitch, yuv_type);
         SDL_free(tmp);
         return ret;
     }
@@ -1031,6 +2121,28 @@ static int SDL_ConvertPixels_YUV_to_YUV_Copy(int width, int height, Uint32 forma
         return 0;
     }
 
+    if (IsP0xxFormat(format)) {
+        const Uint8 *src_y, *src_u, *src_v;
+        Uint8 *dst_y, *dst_u, *dst_v;
+        Uint32 src_y_stride, src_uv_stride, dst_y_stride, dst_uv_stride;
+
+        if (GetYUVPlanes(width, height, format, src, src_pitch, &src_y, &src_u, &src_v, &src_y_stride, &src_uv_stride) < 0 ||
+            GetYUVPlanes(width, height, format, dst, dst_pitch, (const Uint8 **)&dst_y, (const Uint8 **)&dst_u, (const Uint8 **)&dst_v, &dst_y_stride, &dst_uv_stride) < 0) {
+            return -1;
+        }
+
+        /* Y plane, then the U/V plane which is half the height of the Y plane, rounded up */
+        for (i = 0; i < height; ++i) {
+            SDL_memcpy(dst_y + i * dst_y_stride, src_y + i * src_y_stride, width * sizeof(Uint16));
+        }
+        width = ((width + 1) / 2) * 2;
+        height = (height + 1) / 2;
+        for (i = 0; i < height; ++i) {
+            SDL_memcpy(dst_u + i * dst_uv_stride, src_u + i * src_uv_stride, width * sizeof(Uint16));
+        }
+        return 0;
+    }
+
     if (IsPacked4Format(format)) {
         /* Packed planes */
         width = 4 * ((width + 1) / 2);
@@ -2320,6 +3432,119 @@ static int SDL_ConvertPixels_Packed4_to_Planar2x2(int width, int height,
     return 0;
 }
 
+/* Narrow count samples to 8 bits, starting at sample x */
+static void SDL_ConvertPixels_P0xx_to_NV12_Row_std(int x, int count, const Uint16 *src, Uint8 *dst)
+{
+    for (; x < count; ++x) {
+        dst[x] = (Uint8)SDL_min((src[x] + 0x80) >> 8, 255);
+    }
+}
+
+#ifdef SDL_SSE2_INTRINSICS
+static int SDL_TARGETING("sse2") SDL_ConvertPixels_P0xx_to_NV12_Row_SSE2(int count, const Uint16 *src, Uint8 *dst)
+{
+    const __m128i round = _mm_set1_epi16(0x80);
+    int x;
+
+    for (x = 0; x + 16 <= count; x += 16) {
+        const __m128i lo = _mm_srli_epi16(_mm_adds_epu16(_mm_loadu_si128((const __m128i *)(src + x)), round), 8);
+        const __m128i hi = _mm_srli_epi16(_mm_adds_epu16(_mm_loadu_si128((const __m128i *)(src + x + 8)), round), 8);
+        _mm_storeu_si128((__m128i *)(dst + x), _mm_packus_epi16(lo, hi));
+    }
+    return x;
+}
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+static int SDL_ConvertPixels_P0xx_to_NV12_Row_NEON(int count, const Uint16 *src, Uint8 *dst)
+{
+    int x;
+
+    for (x = 0; x + 16 <= count; x += 16) {
+        vst1q_u8(dst + x, vcombine_u8(vqrshrn_n_u16(vld1q_u16(src + x), 8), vqrshrn_n_u16(vld1q_u16(src + x + 8), 8)));
+    }
+    return x;
+}
+#endif
+
+/* P010 and P016 have the same layout as NV12, only the samples are rounded to 8 bits */
+static int SDL_ConvertPixels_P0xx_to_NV12(int width, int height, Uint32 src_format, const void *src, int src_pitch, void *dst, int dst_pitch)
+{
+    int (*row_func)(int count, const Uint16 *src, Uint8 *dst) = NULL;
+    const Uint8 *src_y, *src_u, *src_v;
+    Uint8 *dst_y, *dst_u, *dst_v;
+    Uint32 src_y_stride, src_uv_stride, dst_y_stride, dst_uv_stride;
+    const int UVheight = (height + 1) / 2;
+    const int UVcount = ((width + 1) / 2) * 2;
+    int y, x;
+
+    if (GetYUVPlanes(width, height, src_format, src, src_pitch, &src_y, &src_u, &src_v, &src_y_stride, &src_uv_stride) < 0) {
+        return -1;
+    }
+    if (GetYUVPlanes(width, height, SDL_PIXELFORMAT_NV12, dst, dst_pitch, (const Uint8 **)&dst_y, (const Uint8 **)&dst_u, (const Uint8 **)&dst_v, &dst_y_stride, &dst_uv_stride) < 0) {
+        return -1;
+    }
+
+#ifdef SDL_SSE2_INTRINSICS
+    if (!row_func && SDL_HasSSE2()) {
+        row_func = SDL_ConvertPixels_P0xx_to_NV12_Row_SSE2;
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (!row_func && SDL_HasNEON()) {
+        row_func = SDL_ConvertPixels_P0xx_to_NV12_Row_NEON;
+    }
+#endif
+
+    for (y = 0; y < height; ++y) {
+        const Uint16 *row = (const Uint16 *)(src_y + y * src_y_stride);
+        x = row_func ? row_func(width, row, dst_y) : 0;
+        SDL_ConvertPixels_P0xx_to_NV12_Row_std(x, width, row, dst_y);
+        dst_y += dst_y_stride;
+    }
+    for (y = 0; y < UVheight; ++y) {
+        const Uint16 *row = (const Uint16 *)(src_u + y * src_uv_stride);
+        x = row_func ? row_func(UVcount, row, dst_u) : 0;
+        SDL_ConvertPixels_P0xx_to_NV12_Row_std(x, UVcount, row, dst_u);
+        dst_u += dst_uv_stride;
+    }
+    return 0;
+}
+
+static int SDL_ConvertPixels_P0xx_to_YUV(int width, int height,
+                                         Uint32 src_format, SDL_Colorspace src_colorspace, SDL_PropertiesID src_properties, const void *src, int src_pitch,
+                                         Uint32 dst_format, SDL_Colorspace dst_colorspace, SDL_PropertiesID dst_properties, void *dst, int dst_pitch)
+{
+    int ret;
+    void *tmp;
+    size_t tmp_size, tmp_pitch;
+
+    if (dst_format == SDL_PIXELFORMAT_NV12) {
+        return SDL_ConvertPixels_P0xx_to_NV12(width, height, src_format, src, src_pitch, dst, dst_pitch);
+    }
+
+    if (IsP0xxFormat(dst_format)) {
+        return SDL_SetError("SDL_ConvertPixels_YUV_to_YUV: Unsupported YUV conversion: %s -> %s", SDL_GetPixelFormatName(src_format),
+                            SDL_GetPixelFormatName(dst_format));
+    }
+
+    /* Go through NV12 for the other 8-bit formats */
+    if (SDL_CalculateYUVSize(SDL_PIXELFORMAT_NV12, width, height, &tmp_size, &tmp_pitch) < 0) {
+        return -1;
+    }
+    tmp = SDL_malloc(tmp_size);
+    if (!tmp) {
+        return -1;
+    }
+
+    ret = SDL_ConvertPixels_P0xx_to_NV12(width, height, src_format, src, src_pitch, tmp, (int)tmp_pitch);
+    if (ret == 0) {
+        ret = SDL_ConvertPixels_YUV_to_YUV(width, height, SDL_PIXELFORMAT_NV12, dst_colorspace, src_properties, tmp, (int)tmp_pitch, dst_format, dst_colorspace, dst_properties, dst, dst_pitch);
+    }
+    SDL_free(tmp);
+    return ret;
+}
+
 #endif /* SDL_HAVE_YUV */
 
 int SDL_ConvertPixels_YUV_to_YUV(int width, int height,
@@ -2327,6 +3552,11 @@ int SDL_ConvertPixels_YUV_to_YUV(int width, int height,
                                  Uint32 dst_format, SDL_Colorspace dst_colorspace, SDL_PropertiesID dst_properties, void *dst, int dst_pitch)
 {
 #if SDL_HAVE_YUV
+    if (IsP0xxFormat(src_format) && src_format != dst_format) {
+        /* Reducing the precision doesn't change how the samples are encoded, the colorspace is carried over as-is */
+        return SDL_ConvertPixels_P0xx_to_YUV(width, height, src_format, src_colorspace, src_properties, src, src_pitch, dst_format, dst_colorspace, dst_properties, dst, dst_pitch);
+    }
+
     if (src_colorspace != dst_colorspace) {
         return SDL_SetError("SDL_ConvertPixels_YUV_to_YUV: colorspace conversion not supported");
     }
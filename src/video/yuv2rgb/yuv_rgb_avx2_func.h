@@ -0,0 +1,396 @@
+// Copyright 2016 Adrien Descamps
+// Distributed under BSD 3-Clause License
+
+/* You need to define the following macros before including this file:
+	AVX2_FUNCTION_NAME
+	STD_FUNCTION_NAME
+	YUV_FORMAT
+	RGB_FORMAT
+*/
+
+/* Same arithmetic as the SSE2 version, on 32 pixels per line and iteration.
+ * The 256-bit unpack and pack instructions work on each 128-bit lane separately,
+ * the comments below give the resulting pixel order as "lane 0 | lane 1".
+ */
+
+#define LOAD_SI256 _mm256_loadu_si256
+#define SAVE_SI256 _mm256_storeu_si256
+
+/* R1, G1, B1: pixels 0-7 | 16-23, R2, G2, B2: pixels 8-15 | 24-31 */
+#define UV2RGB_32(U,V,R1,G1,B1,R2,G2,B2) \
+	r_tmp = _mm256_mullo_epi16(V, _mm256_set1_epi16(param->v_r_factor)); \
+	g_tmp = _mm256_add_epi16( \
+		_mm256_mullo_epi16(U, _mm256_set1_epi16(param->u_g_factor)), \
+		_mm256_mullo_epi16(V, _mm256_set1_epi16(param->v_g_factor))); \
+	b_tmp = _mm256_mullo_epi16(U, _mm256_set1_epi16(param->u_b_factor)); \
+	R1 = _mm256_unpacklo_epi16(r_tmp, r_tmp); \
+	G1 = _mm256_unpacklo_epi16(g_tmp, g_tmp); \
+	B1 = _mm256_unpacklo_epi16(b_tmp, b_tmp); \
+	R2 = _mm256_unpackhi_epi16(r_tmp, r_tmp); \
+	G2 = _mm256_unpackhi_epi16(g_tmp, g_tmp); \
+	B2 = _mm256_unpackhi_epi16(b_tmp, b_tmp); \
+
+/* The additions saturate, so very bright pixels don't wrap around to black */
+#define ADD_Y2RGB_32(Y1,Y2,R1,G1,B1,R2,G2,B2) \
+	Y1 = _mm256_mullo_epi16(_mm256_sub_epi16(Y1, _mm256_set1_epi16(param->y_shift)), _mm256_set1_epi16(param->y_factor)); \
+	Y2 = _mm256_mullo_epi16(_mm256_sub_epi16(Y2, _mm256_set1_epi16(param->y_shift)), _mm256_set1_epi16(param->y_factor)); \
+	\
+	R1 = _mm256_srai_epi16(_mm256_adds_epi16(R1, Y1), PRECISION); \
+	G1 = _mm256_srai_epi16(_mm256_adds_epi16(G1, Y1), PRECISION); \
+	B1 = _mm256_srai_epi16(_mm256_adds_epi16(B1, Y1), PRECISION); \
+	R2 = _mm256_srai_epi16(_mm256_adds_epi16(R2, Y2), PRECISION); \
+	G2 = _mm256_srai_epi16(_mm256_adds_epi16(G2, Y2), PRECISION); \
+	B2 = _mm256_srai_epi16(_mm256_adds_epi16(B2, Y2), PRECISION); \
+
+/* R, G, B: pixels 0-31 in order, RGB1: pixels 0-15, RGB2: pixels 16-31 */
+#define PACK_RGB565_32(R, G, B, RGB1, RGB2) \
+{ \
+	__m256i lo, hi; \
+\
+	lo = _mm256_and_si256(_mm256_unpacklo_epi8(_mm256_setzero_si256(), R), _mm256_set1_epi16((short)0xF800)); \
+	hi = _mm256_and_si256(_mm256_unpackhi_epi8(_mm256_setzero_si256(), R), _mm256_set1_epi16((short)0xF800)); \
+	lo = _mm256_or_si256(lo, _mm256_slli_epi16(_mm256_srli_epi16(_mm256_unpacklo_epi8(G, _mm256_setzero_si256()), 2), 5)); \
+	hi = _mm256_or_si256(hi, _mm256_slli_epi16(_mm256_srli_epi16(_mm256_unpackhi_epi8(G, _mm256_setzero_si256()), 2), 5)); \
+	lo = _mm256_or_si256(lo, _mm256_srli_epi16(_mm256_unpacklo_epi8(B, _mm256_setzero_si256()), 3)); \
+	hi = _mm256_or_si256(hi, _mm256_srli_epi16(_mm256_unpackhi_epi8(B, _mm256_setzero_si256()), 3)); \
+	RGB1 = _mm256_permute2x128_si256(lo, hi, 0x20); \
+	RGB2 = _mm256_permute2x128_si256(lo, hi, 0x31); \
+}
+
+/* Writes the bytes A, B, G, R for each pixel, RGB1-RGB4: pixels 0-7, 8-15, 16-23, 24-31 */
+#define PACK_RGBA_32(R, G, B, A, RGB1, RGB2, RGB3, RGB4) \
+{ \
+	__m256i lo_ab, hi_ab, lo_gr, hi_gr, tmp1, tmp2, tmp3, tmp4; \
+\
+	lo_ab = _mm256_unpacklo_epi8(A, B); \
+	hi_ab = _mm256_unpackhi_epi8(A, B); \
+	lo_gr = _mm256_unpacklo_epi8(G, R); \
+	hi_gr = _mm256_unpackhi_epi8(G, R); \
+	tmp1 = _mm256_unpacklo_epi16(lo_ab, lo_gr); \
+	tmp2 = _mm256_unpackhi_epi16(lo_ab, lo_gr); \
+	tmp3 = _mm256_unpacklo_epi16(hi_ab, hi_gr); \
+	tmp4 = _mm256_unpackhi_epi16(hi_ab, hi_gr); \
+	RGB1 = _mm256_permute2x128_si256(tmp1, tmp2, 0x20); \
+	RGB2 = _mm256_permute2x128_si256(tmp3, tmp4, 0x20); \
+	RGB3 = _mm256_permute2x128_si256(tmp1, tmp2, 0x31); \
+	RGB4 = _mm256_permute2x128_si256(tmp3, tmp4, 0x31); \
+}
+
+/* Drop the fourth byte of each pixel, leaving 12 bytes in the low part of each lane */
+#define PACK_RGB24_32(R, G, B, RGB1, RGB2, RGB3, RGB4) \
+{ \
+	const __m256i rgb24_mask = _mm256_setr_epi8( \
+		0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1, \
+		0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1); \
+\
+	PACK_RGBA_32(_mm256_setzero_si256(), B, G, R, RGB1, RGB2, RGB3, RGB4) \
+	RGB1 = _mm256_shuffle_epi8(RGB1, rgb24_mask); \
+	RGB2 = _mm256_shuffle_epi8(RGB2, rgb24_mask); \
+	RGB3 = _mm256_shuffle_epi8(RGB3, rgb24_mask); \
+	RGB4 = _mm256_shuffle_epi8(RGB4, rgb24_mask); \
+}
+
+#if RGB_FORMAT == RGB_FORMAT_RGB565
+
+#define PACK_PIXEL(R, G, B) \
+	__m256i rgb_1, rgb_2; \
+	\
+	PACK_RGB565_32(R, G, B, rgb_1, rgb_2) \
+
+#elif RGB_FORMAT == RGB_FORMAT_RGB24
+
+#define PACK_PIXEL(R, G, B) \
+	__m256i rgb_1, rgb_2, rgb_3, rgb_4; \
+	\
+	PACK_RGB24_32(R, G, B, rgb_1, rgb_2, rgb_3, rgb_4) \
+
+#elif RGB_FORMAT == RGB_FORMAT_RGBA
+
+#define PACK_PIXEL(R, G, B) \
+	__m256i rgb_1, rgb_2, rgb_3, rgb_4; \
+	__m256i a = _mm256_set1_epi8((char)0xFF); \
+	\
+	PACK_RGBA_32(R, G, B, a, rgb_1, rgb_2, rgb_3, rgb_4) \
+
+#elif RGB_FORMAT == RGB_FORMAT_BGRA
+
+#define PACK_PIXEL(R, G, B) \
+	__m256i rgb_1, rgb_2, rgb_3, rgb_4; \
+	__m256i a = _mm256_set1_epi8((char)0xFF); \
+	\
+	PACK_RGBA_32(B, G, R, a, rgb_1, rgb_2, rgb_3, rgb_4) \
+
+#elif RGB_FORMAT == RGB_FORMAT_ARGB
+
+#define PACK_PIXEL(R, G, B) \
+	__m256i rgb_1, rgb_2, rgb_3, rgb_4; \
+	__m256i a = _mm256_set1_epi8((char)0xFF); \
+	\
+	PACK_RGBA_32(a, R, G, B, rgb_1, rgb_2, rgb_3, rgb_4) \
+
+#elif RGB_FORMAT == RGB_FORMAT_ABGR
+
+#define PACK_PIXEL(R, G, B) \
+	__m256i rgb_1, rgb_2, rgb_3, rgb_4; \
+	__m256i a = _mm256_set1_epi8((char)0xFF); \
+	\
+	PACK_RGBA_32(a, B, G, R, rgb_1, rgb_2, rgb_3, rgb_4) \
+
+#else
+#error PACK_PIXEL unimplemented
+#endif
+
+#if RGB_FORMAT == RGB_FORMAT_RGB565
+
+#define SAVE_LINE(rgb_ptr) \
+	SAVE_SI256((__m256i*)(rgb_ptr), rgb_1); \
+	SAVE_SI256((__m256i*)(rgb_ptr+32), rgb_2); \
+
+#elif RGB_FORMAT == RGB_FORMAT_RGB24
+
+/* Each 16 byte store overlaps the next one by 4 bytes, the last one only writes 12 bytes
+   so we don't write past the 32 pixels we converted. */
+#define SAVE_LINE(rgb_ptr) \
+	_mm_storeu_si128((__m128i*)(rgb_ptr), _mm256_castsi256_si128(rgb_1)); \
+	_mm_storeu_si128((__m128i*)(rgb_ptr+12), _mm256_extracti128_si256(rgb_1, 1)); \
+	_mm_storeu_si128((__m128i*)(rgb_ptr+24), _mm256_castsi256_si128(rgb_2)); \
+	_mm_storeu_si128((__m128i*)(rgb_ptr+36), _mm256_extracti128_si256(rgb_2, 1)); \
+	_mm_storeu_si128((__m128i*)(rgb_ptr+48), _mm256_castsi256_si128(rgb_3)); \
+	_mm_storeu_si128((__m128i*)(rgb_ptr+60), _mm256_extracti128_si256(rgb_3, 1)); \
+	_mm_storeu_si128((__m128i*)(rgb_ptr+72), _mm256_castsi256_si128(rgb_4)); \
+	{ \
+		const __m128i last = _mm256_extracti128_si256(rgb_4, 1); \
+		_mm_storel_epi64((__m128i*)(rgb_ptr+84), last); \
+		*(Uint32 *)(rgb_ptr+92) = (Uint32)_mm_cvtsi128_si32(_mm_srli_si128(last, 8)); \
+	} \
+
+#elif RGB_FORMAT == RGB_FORMAT_RGBA || RGB_FORMAT == RGB_FORMAT_BGRA || \
+      RGB_FORMAT == RGB_FORMAT_ARGB || RGB_FORMAT == RGB_FORMAT_ABGR
+
+#define SAVE_LINE(rgb_ptr) \
+	SAVE_SI256((__m256i*)(rgb_ptr), rgb_1); \
+	SAVE_SI256((__m256i*)(rgb_ptr+32), rgb_2); \
+	SAVE_SI256((__m256i*)(rgb_ptr+64), rgb_3); \
+	SAVE_SI256((__m256i*)(rgb_ptr+96), rgb_4); \
+
+#else
+#error SAVE_LINE unimplemented
+#endif
+
+/* READ_Y loads 32 pixels in order, READ_UV loads the 16 chroma samples as 16-bit values */
+#if YUV_FORMAT == YUV_FORMAT_420
+
+#define READ_Y(y_ptr) \
+	y = LOAD_SI256((const __m256i*)(y_ptr)); \
+
+#define READ_UV	\
+	u_16 = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(u_ptr))); \
+	v_16 = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(v_ptr))); \
+
+#elif YUV_FORMAT == YUV_FORMAT_422
+
+#define READ_Y(y_ptr) \
+{ \
+	__m256i y1, y2; \
+	y1 = _mm256_and_si256(LOAD_SI256((const __m256i*)(y_ptr)), _mm256_set1_epi16(0xFF)); \
+	y2 = _mm256_and_si256(LOAD_SI256((const __m256i*)(y_ptr+32)), _mm256_set1_epi16(0xFF)); \
+	y = _mm256_permute4x64_epi64(_mm256_packus_epi16(y1, y2), 0xD8); \
+}
+
+#define READ_UV	\
+{ \
+	__m256i u1, u2, v1, v2; \
+	u1 = _mm256_and_si256(LOAD_SI256((const __m256i*)(u_ptr)), _mm256_set1_epi32(0xFF)); \
+	u2 = _mm256_and_si256(LOAD_SI256((const __m256i*)(u_ptr+32)), _mm256_set1_epi32(0xFF)); \
+	u_16 = _mm256_permute4x64_epi64(_mm256_packs_epi32(u1, u2), 0xD8); \
+	v1 = _mm256_and_si256(LOAD_SI256((const __m256i*)(v_ptr)), _mm256_set1_epi32(0xFF)); \
+	v2 = _mm256_and_si256(LOAD_SI256((const __m256i*)(v_ptr+32)), _mm256_set1_epi32(0xFF)); \
+	v_16 = _mm256_permute4x64_epi64(_mm256_packs_epi32(v1, v2), 0xD8); \
+}
+
+#elif YUV_FORMAT == YUV_FORMAT_NV12
+
+#define READ_Y(y_ptr) \
+	y = LOAD_SI256((const __m256i*)(y_ptr)); \
+
+#define READ_UV	\
+	u_16 = _mm256_and_si256(LOAD_SI256((const __m256i*)(u_ptr)), _mm256_set1_epi16(0xFF)); \
+	v_16 = _mm256_and_si256(LOAD_SI256((const __m256i*)(v_ptr)), _mm256_set1_epi16(0xFF)); \
+
+#else
+#error READ_UV unimplemented
+#endif
+
+#define YUV2RGB_LINE(y_ptr, rgb_ptr) \
+{ \
+	__m256i r_16_1, g_16_1, b_16_1, r_16_2, g_16_2, b_16_2; \
+	__m256i y_16_1, y_16_2, y, r_8, g_8, b_8; \
+	\
+	r_16_1=r_uv_16_1; g_16_1=g_uv_16_1; b_16_1=b_uv_16_1; \
+	r_16_2=r_uv_16_2; g_16_2=g_uv_16_2; b_16_2=b_uv_16_2; \
+	\
+	READ_Y(y_ptr) \
+	y_16_1 = _mm256_unpacklo_epi8(y, _mm256_setzero_si256()); \
+	y_16_2 = _mm256_unpackhi_epi8(y, _mm256_setzero_si256()); \
+	\
+	ADD_Y2RGB_32(y_16_1, y_16_2, r_16_1, g_16_1, b_16_1, r_16_2, g_16_2, b_16_2) \
+	\
+	r_8 = _mm256_packus_epi16(r_16_1, r_16_2); \
+	g_8 = _mm256_packus_epi16(g_16_1, g_16_2); \
+	b_8 = _mm256_packus_epi16(b_16_1, b_16_2); \
+	{ \
+		PACK_PIXEL(r_8, g_8, b_8) \
+		SAVE_LINE(rgb_ptr) \
+	} \
+}
+
+#define YUV2RGB_32 \
+	__m256i r_tmp, g_tmp, b_tmp; \
+	__m256i r_uv_16_1, g_uv_16_1, b_uv_16_1, r_uv_16_2, g_uv_16_2, b_uv_16_2; \
+	__m256i u_16, v_16; \
+	\
+	READ_UV \
+	\
+	u_16 = _mm256_add_epi16(u_16, _mm256_set1_epi16(-128)); \
+	v_16 = _mm256_add_epi16(v_16, _mm256_set1_epi16(-128)); \
+	\
+	UV2RGB_32(u_16, v_16, r_uv_16_1, g_uv_16_1, b_uv_16_1, r_uv_16_2, g_uv_16_2, b_uv_16_2) \
+	\
+	YUV2RGB_LINE(y_ptr1, rgb_ptr1) \
+	if (uv_y_sample_interval > 1) \
+	{ \
+		YUV2RGB_LINE(y_ptr2, rgb_ptr2) \
+	} \
+
+
+void SDL_TARGETING("avx2") AVX2_FUNCTION_NAME(uint32_t width, uint32_t height,
+	const uint8_t *Y, const uint8_t *U, const uint8_t *V, uint32_t Y_stride, uint32_t UV_stride,
+	uint8_t *RGB, uint32_t RGB_stride,
+	YCbCrType yuv_type)
+{
+	const YUV2RGBParam *const param = &(YUV2RGB[yuv_type]);
+#if YUV_FORMAT == YUV_FORMAT_420
+	const int y_pixel_stride = 1;
+	const int uv_pixel_stride = 1;
+	const int uv_x_sample_interval = 2;
+	const int uv_y_sample_interval = 2;
+#elif YUV_FORMAT == YUV_FORMAT_422
+	const int y_pixel_stride = 2;
+	const int uv_pixel_stride = 4;
+	const int uv_x_sample_interval = 2;
+	const int uv_y_sample_interval = 1;
+#elif YUV_FORMAT == YUV_FORMAT_NV12
+	const int y_pixel_stride = 1;
+	const int uv_pixel_stride = 2;
+	const int uv_x_sample_interval = 2;
+	const int uv_y_sample_interval = 2;
+#endif
+#if RGB_FORMAT == RGB_FORMAT_RGB565
+	const int rgb_pixel_stride = 2;
+#elif RGB_FORMAT == RGB_FORMAT_RGB24
+	const int rgb_pixel_stride = 3;
+#elif RGB_FORMAT == RGB_FORMAT_RGBA || RGB_FORMAT == RGB_FORMAT_BGRA || \
+      RGB_FORMAT == RGB_FORMAT_ARGB || RGB_FORMAT == RGB_FORMAT_ABGR
+	const int rgb_pixel_stride = 4;
+#else
+#error Unknown RGB pixel size
+#endif
+
+#if YUV_FORMAT == YUV_FORMAT_NV12
+	/* READ_UV reads one byte past the chroma of the last pixel, see the SSE version */
+	const int fix_read_nv12 = ((width & 31) == 0);
+#else
+	const int fix_read_nv12 = 0;
+#endif
+
+#if YUV_FORMAT == YUV_FORMAT_422
+	/* Avoid invalid read on last line */
+	const int fix_read_422 = 1;
+#else
+	const int fix_read_422 = 0;
+#endif
+
+
+	if (width >= 32) {
+		uint32_t xpos, ypos;
+		for(ypos=0; ypos<(height-(uv_y_sample_interval-1)) - fix_read_422; ypos+=uv_y_sample_interval)
+		{
+			const uint8_t *y_ptr1=Y+ypos*Y_stride,
+				*y_ptr2=Y+(ypos+1)*Y_stride,
+				*u_ptr=U+(ypos/uv_y_sample_interval)*UV_stride,
+				*v_ptr=V+(ypos/uv_y_sample_interval)*UV_stride;
+
+			uint8_t *rgb_ptr1=RGB+ypos*RGB_stride,
+				*rgb_ptr2=RGB+(ypos+1)*RGB_stride;
+
+			for(xpos=0; xpos<(width-31) - fix_read_nv12; xpos+=32)
+			{
+				YUV2RGB_32
+
+				y_ptr1+=32*y_pixel_stride;
+				y_ptr2+=32*y_pixel_stride;
+				u_ptr+=32*uv_pixel_stride/uv_x_sample_interval;
+				v_ptr+=32*uv_pixel_stride/uv_x_sample_interval;
+				rgb_ptr1+=32*rgb_pixel_stride;
+				rgb_ptr2+=32*rgb_pixel_stride;
+			}
+		}
+
+		if (fix_read_422) {
+			const uint8_t *y_ptr=Y+ypos*Y_stride,
+				*u_ptr=U+(ypos/uv_y_sample_interval)*UV_stride,
+				*v_ptr=V+(ypos/uv_y_sample_interval)*UV_stride;
+			uint8_t *rgb_ptr=RGB+ypos*RGB_stride;
+			STD_FUNCTION_NAME(width, 1, y_ptr, u_ptr, v_ptr, Y_stride, UV_stride, rgb_ptr, RGB_stride, yuv_type);
+			ypos += uv_y_sample_interval;
+		}
+
+		/* Catch the last line, if needed */
+		if (uv_y_sample_interval == 2 && ypos == (height-1))
+		{
+			const uint8_t *y_ptr=Y+ypos*Y_stride,
+				*u_ptr=U+(ypos/uv_y_sample_interval)*UV_stride,
+				*v_ptr=V+(ypos/uv_y_sample_interval)*UV_stride;
+
+			uint8_t *rgb_ptr=RGB+ypos*RGB_stride;
+
+			STD_FUNCTION_NAME(width, 1, y_ptr, u_ptr, v_ptr, Y_stride, UV_stride, rgb_ptr, RGB_stride, yuv_type);
+		}
+	}
+
+	/* Catch the right column, if needed */
+	{
+		uint32_t converted = (width & ~31);
+		if (fix_read_nv12) {
+			converted -= 32;
+		}
+		if (converted != width)
+		{
+			const uint8_t *y_ptr=Y+converted*y_pixel_stride,
+				*u_ptr=U+converted*uv_pixel_stride/uv_x_sample_interval,
+				*v_ptr=V+converted*uv_pixel_stride/uv_x_sample_interval;
+
+			uint8_t *rgb_ptr=RGB+converted*rgb_pixel_stride;
+
+			STD_FUNCTION_NAME(width-converted, height, y_ptr, u_ptr, v_ptr, Y_stride, UV_stride, rgb_ptr, RGB_stride, yuv_type);
+		}
+	}
+}
+
+#undef AVX2_FUNCTION_NAME
+#undef STD_FUNCTION_NAME
+#undef YUV_FORMAT
+#undef RGB_FORMAT
+#undef LOAD_SI256
+#undef SAVE_SI256
+#undef UV2RGB_32
+#undef ADD_Y2RGB_32
+#undef PACK_RGB565_32
+#undef PACK_RGBA_32
+#undef PACK_RGB24_32
+#undef PACK_PIXEL
+#undef SAVE_LINE
+#undef READ_Y
+#undef READ_UV
+#undef YUV2RGB_LINE
+#undef YUV2RGB_32
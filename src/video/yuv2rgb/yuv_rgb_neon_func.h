@@ -0,0 +1,289 @@
+// Copyright 2016 Adrien Descamps
+// Distributed under BSD 3-Clause License
+
+/* You need to define the following macros before including this file:
+	NEON_FUNCTION_NAME
+	STD_FUNCTION_NAME
+	YUV_FORMAT
+	RGB_FORMAT
+*/
+
+/* Same arithmetic as the SSE2 version, on 32 pixels per line and iteration,
+ * converted in two halves of 16 pixels.
+ */
+
+#if YUV_FORMAT == YUV_FORMAT_420
+
+#define READ_Y(y_ptr) \
+	y = vld1q_u8(y_ptr); \
+
+#define READ_UV	\
+	u = vld1q_u8(u_ptr); \
+	v = vld1q_u8(v_ptr); \
+
+#elif YUV_FORMAT == YUV_FORMAT_422
+
+#define READ_Y(y_ptr) \
+	y = vld2q_u8(y_ptr).val[0]; \
+
+#define READ_UV	\
+	u = vld4q_u8(u_ptr).val[0]; \
+	v = vld4q_u8(v_ptr).val[0]; \
+
+#elif YUV_FORMAT == YUV_FORMAT_NV12
+
+#define READ_Y(y_ptr) \
+	y = vld1q_u8(y_ptr); \
+
+#define READ_UV	\
+	u = vld2q_u8(u_ptr).val[0]; \
+	v = vld2q_u8(v_ptr).val[0]; \
+
+#else
+#error READ_UV unimplemented
+#endif
+
+/* R1, G1, B1: pixels 0-7, R2, G2, B2: pixels 8-15 */
+#define UV2RGB_16(U,V,R1,G1,B1,R2,G2,B2) \
+{ \
+	int16x8_t u_16, v_16, r_tmp, g_tmp, b_tmp; \
+	int16x8x2_t r_dup, g_dup, b_dup; \
+	\
+	u_16 = vreinterpretq_s16_u16(vsubl_u8(U, vdup_n_u8(128))); \
+	v_16 = vreinterpretq_s16_u16(vsubl_u8(V, vdup_n_u8(128))); \
+	r_tmp = vmulq_n_s16(v_16, param->v_r_factor); \
+	g_tmp = vmlaq_n_s16(vmulq_n_s16(u_16, param->u_g_factor), v_16, param->v_g_factor); \
+	b_tmp = vmulq_n_s16(u_16, param->u_b_factor); \
+	r_dup = vzipq_s16(r_tmp, r_tmp); \
+	g_dup = vzipq_s16(g_tmp, g_tmp); \
+	b_dup = vzipq_s16(b_tmp, b_tmp); \
+	R1 = r_dup.val[0]; G1 = g_dup.val[0]; B1 = b_dup.val[0]; \
+	R2 = r_dup.val[1]; G2 = g_dup.val[1]; B2 = b_dup.val[1]; \
+}
+
+/* The additions saturate, so very bright pixels don't wrap around to black */
+#define ADD_Y2RGB_16(Y1,Y2,R,G,B) \
+	Y1 = vmulq_n_s16(vsubq_s16(Y1, vdupq_n_s16(param->y_shift)), param->y_factor); \
+	Y2 = vmulq_n_s16(vsubq_s16(Y2, vdupq_n_s16(param->y_shift)), param->y_factor); \
+	\
+	R = vcombine_u8(vqshrun_n_s16(vqaddq_s16(r_uv_16_1, Y1), PRECISION), vqshrun_n_s16(vqaddq_s16(r_uv_16_2, Y2), PRECISION)); \
+	G = vcombine_u8(vqshrun_n_s16(vqaddq_s16(g_uv_16_1, Y1), PRECISION), vqshrun_n_s16(vqaddq_s16(g_uv_16_2, Y2), PRECISION)); \
+	B = vcombine_u8(vqshrun_n_s16(vqaddq_s16(b_uv_16_1, Y1), PRECISION), vqshrun_n_s16(vqaddq_s16(b_uv_16_2, Y2), PRECISION)); \
+
+#define PACK_RGB565_8(R, G, B) \
+	vorrq_u16(vorrq_u16( \
+		vandq_u16(vshll_n_u8(R, 8), vdupq_n_u16(0xF800)), \
+		vshlq_n_u16(vshrq_n_u16(vmovl_u8(G), 2), 5)), \
+		vshrq_n_u16(vmovl_u8(B), 3))
+
+#if RGB_FORMAT == RGB_FORMAT_RGB565
+
+#define SAVE_PIXELS(rgb_ptr, R, G, B) \
+	vst1q_u16((uint16_t *)(rgb_ptr), PACK_RGB565_8(vget_low_u8(R), vget_low_u8(G), vget_low_u8(B))); \
+	vst1q_u16((uint16_t *)(rgb_ptr+16), PACK_RGB565_8(vget_high_u8(R), vget_high_u8(G), vget_high_u8(B))); \
+
+#elif RGB_FORMAT == RGB_FORMAT_RGB24
+
+#define SAVE_PIXELS(rgb_ptr, R, G, B) \
+{ \
+	uint8x16x3_t rgb; \
+	rgb.val[0] = R; \
+	rgb.val[1] = G; \
+	rgb.val[2] = B; \
+	vst3q_u8(rgb_ptr, rgb); \
+}
+
+#elif RGB_FORMAT == RGB_FORMAT_RGBA || RGB_FORMAT == RGB_FORMAT_BGRA || \
+      RGB_FORMAT == RGB_FORMAT_ARGB || RGB_FORMAT == RGB_FORMAT_ABGR
+
+/* The channels in memory order, for a little endian 32-bit pixel */
+#if RGB_FORMAT == RGB_FORMAT_RGBA
+#define SET_PIXEL_BYTES(rgba, R, G, B, A) \
+	rgba.val[0] = A; rgba.val[1] = B; rgba.val[2] = G; rgba.val[3] = R;
+#elif RGB_FORMAT == RGB_FORMAT_BGRA
+#define SET_PIXEL_BYTES(rgba, R, G, B, A) \
+	rgba.val[0] = A; rgba.val[1] = R; rgba.val[2] = G; rgba.val[3] = B;
+#elif RGB_FORMAT == RGB_FORMAT_ARGB
+#define SET_PIXEL_BYTES(rgba, R, G, B, A) \
+	rgba.val[0] = B; rgba.val[1] = G; rgba.val[2] = R; rgba.val[3] = A;
+#elif RGB_FORMAT == RGB_FORMAT_ABGR
+#define SET_PIXEL_BYTES(rgba, R, G, B, A) \
+	rgba.val[0] = R; rgba.val[1] = G; rgba.val[2] = B; rgba.val[3] = A;
+#endif
+
+#define SAVE_PIXELS(rgb_ptr, R, G, B) \
+{ \
+	uint8x16x4_t rgba; \
+	const uint8x16_t a = vdupq_n_u8(0xFF); \
+	SET_PIXEL_BYTES(rgba, R, G, B, a) \
+	vst4q_u8(rgb_ptr, rgba); \
+}
+
+#else
+#error SAVE_PIXELS unimplemented
+#endif
+
+#define YUV2RGB_LINE(y_ptr, rgb_ptr) \
+{ \
+	int16x8_t y_16_1, y_16_2; \
+	uint8x16_t y, r_8, g_8, b_8; \
+	\
+	READ_Y(y_ptr) \
+	y_16_1 = vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(y))); \
+	y_16_2 = vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(y))); \
+	\
+	ADD_Y2RGB_16(y_16_1, y_16_2, r_8, g_8, b_8) \
+	\
+	SAVE_PIXELS(rgb_ptr, r_8, g_8, b_8) \
+}
+
+#define YUV2RGB_16(U, V, offset) \
+{ \
+	int16x8_t r_uv_16_1, g_uv_16_1, b_uv_16_1, r_uv_16_2, g_uv_16_2, b_uv_16_2; \
+	\
+	UV2RGB_16(U, V, r_uv_16_1, g_uv_16_1, b_uv_16_1, r_uv_16_2, g_uv_16_2, b_uv_16_2) \
+	\
+	YUV2RGB_LINE(y_ptr1+(offset)*y_pixel_stride, rgb_ptr1+(offset)*rgb_pixel_stride) \
+	if (uv_y_sample_interval > 1) \
+	{ \
+		YUV2RGB_LINE(y_ptr2+(offset)*y_pixel_stride, rgb_ptr2+(offset)*rgb_pixel_stride) \
+	} \
+}
+
+#define YUV2RGB_32 \
+	uint8x16_t u, v; \
+	\
+	READ_UV \
+	\
+	YUV2RGB_16(vget_low_u8(u), vget_low_u8(v), 0) \
+	YUV2RGB_16(vget_high_u8(u), vget_high_u8(v), 16) \
+
+
+void NEON_FUNCTION_NAME(uint32_t width, uint32_t height,
+	const uint8_t *Y, const uint8_t *U, const uint8_t *V, uint32_t Y_stride, uint32_t UV_stride,
+	uint8_t *RGB, uint32_t RGB_stride,
+	YCbCrType yuv_type)
+{
+	const YUV2RGBParam *const param = &(YUV2RGB[yuv_type]);
+#if YUV_FORMAT == YUV_FORMAT_420
+	const int y_pixel_stride = 1;
+	const int uv_pixel_stride = 1;
+	const int uv_x_sample_interval = 2;
+	const int uv_y_sample_interval = 2;
+#elif YUV_FORMAT == YUV_FORMAT_422
+	const int y_pixel_stride = 2;
+	const int uv_pixel_stride = 4;
+	const int uv_x_sample_interval = 2;
+	const int uv_y_sample_interval = 1;
+#elif YUV_FORMAT == YUV_FORMAT_NV12
+	const int y_pixel_stride = 1;
+	const int uv_pixel_stride = 2;
+	const int uv_x_sample_interval = 2;
+	const int uv_y_sample_interval = 2;
+#endif
+#if RGB_FORMAT == RGB_FORMAT_RGB565
+	const int rgb_pixel_stride = 2;
+#elif RGB_FORMAT == RGB_FORMAT_RGB24
+	const int rgb_pixel_stride = 3;
+#elif RGB_FORMAT == RGB_FORMAT_RGBA || RGB_FORMAT == RGB_FORMAT_BGRA || \
+      RGB_FORMAT == RGB_FORMAT_ARGB || RGB_FORMAT == RGB_FORMAT_ABGR
+	const int rgb_pixel_stride = 4;
+#else
+#error Unknown RGB pixel size
+#endif
+
+#if YUV_FORMAT == YUV_FORMAT_NV12
+	/* READ_UV reads one byte past the chroma of the last pixel, see the SSE version */
+	const int fix_read_nv12 = ((width & 31) == 0);
+#else
+	const int fix_read_nv12 = 0;
+#endif
+
+#if YUV_FORMAT == YUV_FORMAT_422
+	/* Avoid invalid read on last line */
+	const int fix_read_422 = 1;
+#else
+	const int fix_read_422 = 0;
+#endif
+
+
+	if (width >= 32) {
+		uint32_t xpos, ypos;
+		for(ypos=0; ypos<(height-(uv_y_sample_interval-1)) - fix_read_422; ypos+=uv_y_sample_interval)
+		{
+			const uint8_t *y_ptr1=Y+ypos*Y_stride,
+				*y_ptr2=Y+(ypos+1)*Y_stride,
+				*u_ptr=U+(ypos/uv_y_sample_interval)*UV_stride,
+				*v_ptr=V+(ypos/uv_y_sample_interval)*UV_stride;
+
+			uint8_t *rgb_ptr1=RGB+ypos*RGB_stride,
+				*rgb_ptr2=RGB+(ypos+1)*RGB_stride;
+
+			for(xpos=0; xpos<(width-31) - fix_read_nv12; xpos+=32)
+			{
+				YUV2RGB_32
+
+				y_ptr1+=32*y_pixel_stride;
+				y_ptr2+=32*y_pixel_stride;
+				u_ptr+=32*uv_pixel_stride/uv_x_sample_interval;
+				v_ptr+=32*uv_pixel_stride/uv_x_sample_interval;
+				rgb_ptr1+=32*rgb_pixel_stride;
+				rgb_ptr2+=32*rgb_pixel_stride;
+			}
+		}
+
+		if (fix_read_422) {
+			const uint8_t *y_ptr=Y+ypos*Y_stride,
+				*u_ptr=U+(ypos/uv_y_sample_interval)*UV_stride,
+				*v_ptr=V+(ypos/uv_y_sample_interval)*UV_stride;
+			uint8_t *rgb_ptr=RGB+ypos*RGB_stride;
+			STD_FUNCTION_NAME(width, 1, y_ptr, u_ptr, v_ptr, Y_stride, UV_stride, rgb_ptr, RGB_stride, yuv_type);
+			ypos += uv_y_sample_interval;
+		}
+
+		/* Catch the last line, if needed */
+		if (uv_y_sample_interval == 2 && ypos == (height-1))
+		{
+			const uint8_t *y_ptr=Y+ypos*Y_stride,
+				*u_ptr=U+(ypos/uv_y_sample_interval)*UV_stride,
+				*v_ptr=V+(ypos/uv_y_sample_interval)*UV_stride;
+
+			uint8_t *rgb_ptr=RGB+ypos*RGB_stride;
+
+			STD_FUNCTION_NAME(width, 1, y_ptr, u_ptr, v_ptr, Y_stride, UV_stride, rgb_ptr, RGB_stride, yuv_type);
+		}
+	}
+
+	/* Catch the right column, if needed */
+	{
+		uint32_t converted = (width & ~31);
+		if (fix_read_nv12) {
+			converted -= 32;
+		}
+		if (converted != width)
+		{
+			const uint8_t *y_ptr=Y+converted*y_pixel_stride,
+				*u_ptr=U+converted*uv_pixel_stride/uv_x_sample_interval,
+				*v_ptr=V+converted*uv_pixel_stride/uv_x_sample_interval;
+
+			uint8_t *rgb_ptr=RGB+converted*rgb_pixel_stride;
+
+			STD_FUNCTION_NAME(width-converted, height, y_ptr, u_ptr, v_ptr, Y_stride, UV_stride, rgb_ptr, RGB_stride, yuv_type);
+		}
+	}
+}
+
+#undef NEON_FUNCTION_NAME
+#undef STD_FUNCTION_NAME
+#undef YUV_FORMAT
+#undef RGB_FORMAT
+#undef READ_Y
+#undef READ_UV
+#undef UV2RGB_16
+#undef ADD_Y2RGB_16
+#undef PACK_RGB565_8
+#undef SET_PIXEL_BYTES
+#undef SAVE_PIXELS
+#undef YUV2RGB_LINE
+#undef YUV2RGB_16
+#undef YUV2RGB_32
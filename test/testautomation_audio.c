@@ -1264,6 +1264,342 @@ cleanup:
 
     return status;
 }
+/* Writes a WAVE file with the given fmt chunk fields into buf. The data chunk
+ * claims to hold datalength bytes, but only the first written bytes are there.
+ */
+static size_t audio_makeWAV(Uint8 *buf, size_t bufsize, Uint16 tag, Uint16 channels, Uint16 blockalign, Uint16 bits,
+                            const Uint8 *ext, Uint16 extsize, Uint32 datalength, Uint32 written)
+{
+    SDL_RWops *rw = SDL_RWFromMem(buf, bufsize);
+    const Uint32 fmtlength = ext ? 18 + extsize : 16;
+    size_t size = 0;
+    Uint32 i;
+
+    if (!rw) {
+        return 0;
+    }
+    SDL_WriteU32LE(rw, 0x46464952); /* RIFF */
+    SDL_WriteU32LE(rw, 4 + 8 + fmtlength + 8 + datalength);
+    SDL_WriteU32LE(rw, 0x45564157); /* WAVE */
+    SDL_WriteU32LE(rw, 0x20746D66); /* fmt */
+    SDL_WriteU32LE(rw, fmtlength);
+    SDL_WriteU16LE(rw, tag);
+    SDL_WriteU16LE(rw, channels);
+    SDL_WriteU32LE(rw, 22050);
+    SDL_WriteU32LE(rw, 22050 * blockalign);
+    SDL_WriteU16LE(rw, blockalign);
+    SDL_WriteU16LE(rw, bits);
+    if (ext) {
+        SDL_WriteU16LE(rw, extsize);
+        SDL_RWwrite(rw, ext, extsize);
+    }
+    SDL_WriteU32LE(rw, 0x61746164); /* data */
+    SDL_WriteU32LE(rw, datalength);
+    for (i = 0; i < written; i++) {
+        Uint8 value = SDLTest_RandomUint8();
+        /* Keep the MS ADPCM predictor index of each block in range */
+        if (tag == 0x0002 && i % blockalign < channels) {
+            value %= 7;
+        }
+        SDL_WriteU8(rw, value);
+    }
+    size = (size_t)SDL_RWtell(rw);
+    SDL_RWclose(rw);
+    return size;
+}
+
+/**
+ * Decode WAVE files a piece at a time and compare with SDL_LoadWAV_RW.
+ *
+ * \sa SDL_OpenWAVReader
+ * \sa SDL_ReadWAVFrames
+ * \sa SDL_SeekWAVFrame
+ */
+static int audio_wavReader(void *arg)
+{
+    static const Uint8 ima_ext[2] = { 249, 0 };
+    static const Uint8 ms_ext[32] = {
+        244, 0, 7, 0,
+        0, 1, 0, 0, 0, 2, 0, 0xff, 0, 0, 0, 0, 0xc0, 0, 0x40, 0, 0xf0, 0, 0, 0, 0xcc, 1, 0x30, 0xff, 0x88, 1, 0x18, 0xff
+    };
+    static const struct
+    {
+        const char *name;
+        Uint16 tag, channels, blockalign, bits;
+        const Uint8 *ext;
+        Uint16 extsize;
+        Uint32 datalength, written;
+    } files[] = {
+        { "16-bit PCM", 0x0001, 2, 4, 16, NULL, 0, 40000, 40000 },
+        { "24-bit PCM", 0x0001, 1, 3, 24, NULL, 0, 7001 * 3, 7001 * 3 },
+        { "float", 0x0003, 2, 8, 32, NULL, 0, 80000, 80000 },
+        { "A-law", 0x0006, 1, 1, 8, NULL, 0, 100000, 100000 },
+        { "mu-law", 0x0007, 2, 2, 8, NULL, 0, 5000, 4999 },
+        { "IMA ADPCM", 0x0011, 2, 256, 4, ima_ext, 2, 256 * 21, 256 * 20 + 100 },
+        { "MS ADPCM", 0x0002, 1, 128, 4, ms_ext, 32, 128 * 40, 128 * 40 }
+    };
+    const size_t bufsize = 256 * 1024;
+    Uint8 *wav = (Uint8 *)SDL_malloc(bufsize);
+    Uint8 *decoded = (Uint8 *)SDL_malloc(bufsize);
+    int i;
+
+    if (!wav || !decoded) {
+        SDL_free(wav);
+        SDL_free(decoded);
+        return TEST_ABORTED;
+    }
+
+    for (i = 0; i < SDL_arraysize(files); i++) {
+        SDL_AudioSpec spec, readerspec;
+        SDL_AudioStream *stream;
+        SDL_WAVReader *reader;
+        Uint8 *audio = NULL;
+        Uint32 audio_len = 0;
+        size_t size, framesize;
+        Sint64 frames, frame;
+        int ret, got, total;
+
+        size = audio_makeWAV(wav, bufsize, files[i].tag, files[i].channels, files[i].blockalign, files[i].bits,
+                             files[i].ext, files[i].extsize, files[i].datalength, files[i].written);
+        SDLTest_AssertCheck(size > 0, "Write %s WAVE file", files[i].name);
+
+        ret = SDL_LoadWAV_RW(SDL_RWFromConstMem(wav, size), SDL_TRUE, &spec, &audio, &audio_len);
+        SDLTest_AssertCheck(ret == 0, "Call to SDL_LoadWAV_RW() with %s data, expected 0, got %d", files[i].name, ret);
+        if (ret != 0) {
+            continue;
+        }
+
+        reader = SDL_OpenWAVReader(SDL_RWFromConstMem(wav, size), SDL_TRUE, &readerspec);
+        SDLTest_AssertCheck(reader != NULL, "Call to SDL_OpenWAVReader() with %s data", files[i].name);
+        if (!reader) {
+            SDL_free(audio);
+            continue;
+        }
+        SDLTest_AssertCheck(spec.format == readerspec.format && spec.channels == readerspec.channels && spec.freq == readerspec.freq,
+                            "Verify the format matches SDL_LoadWAV_RW()");
+
+        framesize = SDL_AUDIO_FRAMESIZE(spec);
+        frames = SDL_GetWAVFrameCount(reader);
+        SDLTest_AssertCheck(frames >= (Sint64)(audio_len / framesize), "Verify SDL_GetWAVFrameCount(), expected at least %d, got %d", (int)(audio_len / framesize), (int)frames);
+
+        stream = SDL_CreateAudioStream(&spec, &spec);
+        SDLTest_AssertCheck(stream != NULL, "Call to SDL_CreateAudioStream()");
+        if (stream) {
+            /* Everything, in pieces that don't line up with the blocks */
+            total = 0;
+            while ((got = SDL_ReadWAVFrames(reader, stream, 333)) > 0) {
+                total += got;
+            }
+            SDLTest_AssertCheck(got == 0, "Verify SDL_ReadWAVFrames() ends with 0, got %d", got);
+            SDLTest_AssertCheck(total * framesize == audio_len, "Verify the decoded length, expected %d bytes, got %d", (int)audio_len, (int)(total * framesize));
+            ret = SDL_GetAudioStreamData(stream, decoded, (int)bufsize);
+            SDLTest_AssertCheck(ret == (int)audio_len && SDL_memcmp(decoded, audio, audio_len) == 0, "Verify the decoded data matches SDL_LoadWAV_RW()");
+
+            /* A piece from the middle of a block */
+            frame = (Sint64)(audio_len / framesize) / 3 + 5;
+            ret = SDL_SeekWAVFrame(reader, frame);
+            SDLTest_AssertCheck(ret == 0, "Call to SDL_SeekWAVFrame(%d), expected 0, got %d", (int)frame, ret);
+            got = SDL_ReadWAVFrames(reader, stream, 1000);
+            SDLTest_AssertCheck(got == 1000, "Verify frames read after seeking, expected 1000, got %d", got);
+            SDLTest_AssertCheck(SDL_TellWAVFrame(reader) == frame + 1000, "Verify SDL_TellWAVFrame(), expected %d, got %d", (int)(frame + 1000), (int)SDL_TellWAVFrame(reader));
+            ret = SDL_GetAudioStreamData(stream, decoded, (int)bufsize);
+            SDLTest_AssertCheck(ret == (int)(1000 * framesize) && SDL_memcmp(decoded, audio + frame * framesize, 1000 * framesize) == 0, "Verify the data after seeking matches SDL_LoadWAV_RW()");
+
+            SDL_DestroyAudioStream(stream);
+        }
+
+        SDL_CloseWAVReader(reader);
+        SDL_free(audio);
+    }
+
+    SDL_free(wav);
+    SDL_free(decoded);
+    return TEST_COMPLETED;
+}
+
+/* Scalar G.711 expansion, to check the table and SIMD decoders against */
+static Sint16 audio_expandLaw(Uint16 tag, Uint8 byte)
+{
+    int x, e, m, magnitude;
+
+    if (tag == 0x0006) {
+        x = byte ^ 0x55;
+        e = (x >> 4) & 7;
+        m = x & 15;
+        magnitude = e ? ((m << 4) + 0x108) << (e - 1) : (m << 4) + 8;
+        return (Sint16)((x & 0x80) ? magnitude : -magnitude);
+    }
+    x = ~byte & 0xff;
+    e = (x >> 4) & 7;
+    m = x & 15;
+    magnitude = (((m << 3) + 0x84) << e) - 0x84;
+    return (Sint16)((x & 0x80) ? -magnitude : magnitude);
+}
+
+/**
+ * Compare the A-law, mu-law and 24-bit PCM decoders with scalar conversions,
+ * for lengths that leave every possible tail after the SIMD loops.
+ *
+ * \sa SDL_LoadWAV_RW
+ */
+static int audio_wavSampleDecoders(void *arg)
+{
+    static const Uint16 tags[3] = { 0x0006, 0x0007, 0x0001 };
+    static const Uint32 lengths[] = { 1, 2, 3, 5, 6, 7, 8, 9, 15, 16, 17, 31, 32, 33, 47, 48, 49, 255, 256, 257, 1001 };
+    const size_t bufsize = 16 * 1024;
+    Uint8 *wav = (Uint8 *)SDL_malloc(bufsize);
+    int t, l;
+
+    if (!wav) {
+        return TEST_ABORTED;
+    }
+
+    for (t = 0; t < SDL_arraysize(tags); t++) {
+        const Uint16 tag = tags[t];
+        const Uint16 bytes = (tag == 0x0001) ? 3 : 1;
+
+        for (l = 0; l < SDL_arraysize(lengths); l++) {
+            const Uint32 samples = lengths[l];
+            SDL_AudioSpec spec;
+            Uint8 *audio = NULL;
+            Uint32 audio_len = 0;
+            const Uint8 *data;
+            size_t size;
+            Uint32 i, mismatch;
+            int ret;
+
+            size = audio_makeWAV(wav, bufsize, tag, 1, bytes, bytes * 8, NULL, 0, samples * bytes, samples * bytes);
+            data = wav + size - samples * bytes;
+            ret = SDL_LoadWAV_RW(SDL_RWFromConstMem(wav, size), SDL_TRUE, &spec, &audio, &audio_len);
+            SDLTest_AssertCheck(ret == 0, "Call to SDL_LoadWAV_RW() with format 0x%.4x and %d samples, expected 0, got %d", tag, (int)samples, ret);
+            if (ret != 0) {
+                continue;
+            }
+
+            mismatch = samples;
+            if (tag == 0x0001) {
+                SDLTest_AssertCheck(audio_len == samples * 4, "Verify the decoded length, expected %d, got %d", (int)(samples * 4), (int)audio_len);
+                for (i = 0; i < samples && audio_len == samples * 4; i++) {
+                    if (audio[i * 4] != 0 || SDL_memcmp(&audio[i * 4 + 1], &data[i * 3], 3) != 0) {
+                        mismatch = i;
+                        break;
+                    }
+                }
+            } else {
+                const Sint16 *decoded = (const Sint16 *)audio;
+
+                SDLTest_AssertCheck(audio_len == samples * 2, "Verify the decoded length, expected %d, got %d", (int)(samples * 2), (int)audio_len);
+                for (i = 0; i < samples && audio_len == samples * 2; i++) {
+                    if (decoded[i] != audio_expandLaw(tag, data[i])) {
+                        mismatch = i;
+                        break;
+                    }
+                }
+            }
+            SDLTest_AssertCheck(mismatch == samples, "Verify format 0x%.4x with %d samples matches the scalar conversion, first mismatch at %d",
+                                tag, (int)samples, (int)mismatch);
+            SDL_free(audio);
+        }
+    }
+
+    SDL_free(wav);
+    return TEST_COMPLETED;
+}
+
+/**
+ * Decode ADPCM files with enough blocks to be split across threads, and
+ * compare them with pieces small enough to be decoded on one thread.
+ *
+ * \sa SDL_LoadWAV_RW
+ */
+static int audio_wavADPCMBlocks(void *arg)
+{
+    static const Uint8 ima_ext[2] = { 249, 0 };
+    static const Uint8 ms_ext[32] = {
+        244, 0, 7, 0,
+        0, 1, 0, 0, 0, 2, 0, 0xff, 0, 0, 0, 0, 0xc0, 0, 0x40, 0, 0xf0, 0, 0, 0, 0xcc, 1, 0x30, 0xff, 0x88, 1, 0x18, 0xff
+    };
+    static const struct
+    {
+        const char *name;
+        Uint16 tag, channels, blockalign;
+        const Uint8 *ext;
+        Uint16 extsize;
+    } formats[] = {
+        { "IMA ADPCM", 0x0011, 2, 256, ima_ext, 2 },
+        { "MS ADPCM", 0x0002, 1, 128, ms_ext, 32 }
+    };
+    /* Threads are used for every 512 blocks, starting at two of them */
+    static const Uint32 blockcounts[] = { 511, 512, 1023, 1024, 1025, 1537, 2049 };
+    const Uint32 piece = 500;
+    const size_t bufsize = 2049 * 256 + 1024;
+    Uint8 *wav = (Uint8 *)SDL_malloc(bufsize);
+    Uint8 *part = (Uint8 *)SDL_malloc(piece * 256 + 1024);
+    int f, b;
+
+    if (!wav || !part) {
+        SDL_free(wav);
+        SDL_free(part);
+        return TEST_ABORTED;
+    }
+    if (SDL_GetCPUCount() < 2) {
+        SDLTest_Log("There is only one CPU, the blocks won't be decoded on several threads");
+    }
+
+    for (f = 0; f < SDL_arraysize(formats); f++) {
+        for (b = 0; b < SDL_arraysize(blockcounts); b++) {
+            const Uint16 blockalign = formats[f].blockalign;
+            const Uint32 blocks = blockcounts[b];
+            SDL_AudioSpec spec;
+            Uint8 *audio = NULL;
+            Uint32 audio_len = 0;
+            const Uint8 *data;
+            size_t size, offset;
+            Uint32 first;
+            SDL_bool matches;
+            int ret;
+
+            size = audio_makeWAV(wav, bufsize, formats[f].tag, formats[f].channels, blockalign, 4,
+                                 formats[f].ext, formats[f].extsize, blocks * blockalign, blocks * blockalign);
+            data = wav + size - blocks * blockalign;
+            ret = SDL_LoadWAV_RW(SDL_RWFromConstMem(wav, size), SDL_TRUE, &spec, &audio, &audio_len);
+            SDLTest_AssertCheck(ret == 0, "Call to SDL_LoadWAV_RW() with %d %s blocks, expected 0, got %d", (int)blocks, formats[f].name, ret);
+            if (ret != 0) {
+                continue;
+            }
+
+            /* Every block resets the decoder, so the pieces have to add up to the whole */
+            matches = SDL_TRUE;
+            offset = 0;
+            for (first = 0; first < blocks && matches; first += piece) {
+                const Uint32 count = SDL_min(piece, blocks - first);
+                Uint8 *partaudio = NULL;
+                Uint32 partaudio_len = 0;
+                size_t partsize;
+
+                partsize = audio_makeWAV(part, piece * 256 + 1024, formats[f].tag, formats[f].channels, blockalign, 4,
+                                         formats[f].ext, formats[f].extsize, count * blockalign, 0);
+                SDL_memcpy(part + partsize, data + (size_t)first * blockalign, (size_t)count * blockalign);
+                partsize += (size_t)count * blockalign;
+                ret = SDL_LoadWAV_RW(SDL_RWFromConstMem(part, partsize), SDL_TRUE, &spec, &partaudio, &partaudio_len);
+                if (ret != 0 || offset + partaudio_len > audio_len ||
+                    SDL_memcmp(audio + offset, partaudio, partaudio_len) != 0) {
+                    matches = SDL_FALSE;
+                }
+                offset += partaudio_len;
+                SDL_free(partaudio);
+            }
+            SDLTest_AssertCheck(matches && offset == audio_len, "Verify %d %s blocks match decoding them %d at a time",
+                                (int)blocks, formats[f].name, (int)piece);
+            SDL_free(audio);
+        }
+    }
+
+    SDL_free(wav);
+    SDL_free(part);
+    return TEST_COMPLETED;
+}
+
 /* ================= Test Case References ================== */
 
 /* Audio test cases */
@@ -1341,12 +1677,24 @@ static const SDLTest_TestCaseReference audioTest18 = {
     audio_formatChange, "audio_formatChange", "Check handling of format changes.", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference audioTest19 = {
+    audio_wavReader, "audio_wavReader", "Decode WAVE files a piece at a time.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest20 = {
+    audio_wavSampleDecoders, "audio_wavSampleDecoders", "Compare the A-law, mu-law and 24-bit PCM decoders with scalar conversions.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest21 = {
+    audio_wavADPCMBlocks, "audio_wavADPCMBlocks", "Compare ADPCM decoded on several threads with single threaded decoding.", TEST_ENABLED
+};
+
 /* Sequence of Audio test cases */
 static const SDLTest_TestCaseReference *audioTests[] = {
     &audioTest1, &audioTest2, &audioTest3, &audioTest4, &audioTest5, &audioTest6,
     &audioTest7, &audioTest8, &audioTest9, &audioTest10, &audioTest11,
     &audioTest12, &audioTest13, &audioTest14, &audioTest15, &audioTest16,
-    &audioTest17, &audioTest18, NULL
+    &audioTest17, &audioTest18, &audioTest19, &audioTest20, &audioTest21, NULL
 };
 
 /* Audio test suite (global) */
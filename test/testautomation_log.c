@@ -188,6 +188,63 @@ static int log_testHint(void *arg)
     return TEST_COMPLETED;
 }
 
+typedef struct
+{
+    int count;
+    size_t length;
+} AsyncLogResult;
+
+static void SDLCALL TestAsyncLogOutput(void *userdata, int category, SDL_LogPriority priority, const char *message)
+{
+    AsyncLogResult *result = (AsyncLogResult *)userdata;
+    ++result->count;
+    result->length += SDL_strlen(message);
+}
+
+/**
+ * Check SDL_HINT_LOGGING_ASYNC functionality
+ */
+static int log_testAsync(void *arg)
+{
+    AsyncLogResult result;
+    char long_message[1024];
+    int i;
+
+    SDL_memset(long_message, 'x', sizeof(long_message) - 1);
+    long_message[sizeof(long_message) - 1] = '\0';
+
+    SDL_SetHint(SDL_HINT_LOGGING, "app=info");
+    SDL_SetHint(SDL_HINT_LOGGING_ASYNC, "1");
+    SDLTest_AssertPass("SDL_SetHint(SDL_HINT_LOGGING_ASYNC, \"1\")");
+
+    SDL_zero(result);
+    SDL_LogGetOutputFunction(&original_function, &original_userdata);
+    SDL_LogSetOutputFunction(TestAsyncLogOutput, &result);
+    for (i = 0; i < 10; ++i) {
+        SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO, "test");
+    }
+    SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO, "%s", long_message);
+    SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_DEBUG, "test");
+
+    /* Changing the output function flushes the queued messages */
+    SDL_LogSetOutputFunction(original_function, original_userdata);
+    SDLTest_AssertPass("SDL_LogMessage() with SDL_HINT_LOGGING_ASYNC set");
+    SDLTest_AssertCheck(result.count == 11, "Check message count, expected: 11, got: %d", result.count);
+    SDLTest_AssertCheck(result.length == 10 * 4 + sizeof(long_message) - 1,
+                        "Check message length, expected: %d, got: %d", (int)(10 * 4 + sizeof(long_message) - 1), (int)result.length);
+
+    SDL_SetHint(SDL_HINT_LOGGING_ASYNC, NULL);
+    SDL_SetHint(SDL_HINT_LOGGING, NULL);
+
+    /* Messages go out directly again */
+    EnableTestLog(&i);
+    SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO, "test");
+    SDLTest_AssertCheck(i == 1, "Check result value, expected: 1, got: %d", i);
+    DisableTestLog();
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Log test cases */
@@ -195,9 +252,13 @@ static const SDLTest_TestCaseReference logTestHint = {
     (SDLTest_TestCaseFp)log_testHint, "log_testHint", "Check SDL_HINT_LOGGING functionality", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference logTestAsync = {
+    (SDLTest_TestCaseFp)log_testAsync, "log_testAsync", "Check SDL_HINT_LOGGING_ASYNC functionality", TEST_ENABLED
+};
+
 /* Sequence of Log test cases */
 static const SDLTest_TestCaseReference *logTests[] = {
-    &logTestHint, NULL
+    &logTestHint, &logTestAsync, NULL
 };
 
 /* Timer test suite (global) */
@@ -367,6 +367,87 @@ static int pixels_allocFreePalette(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Call to SDL_MapRGB and SDL_MapRGBA with a palettized format
+ *
+ * \sa SDL_MapRGB
+ * \sa SDL_MapRGBA
+ */
+static int pixels_mapPalette(void *arg)
+{
+    SDL_PixelFormat *format;
+    SDL_Palette *palette;
+    SDL_Color colors[256];
+    int variation;
+    int i, j;
+    int mismatches;
+
+    format = SDL_CreatePixelFormat(SDL_PIXELFORMAT_INDEX8);
+    SDLTest_AssertPass("Call to SDL_CreatePixelFormat(SDL_PIXELFORMAT_INDEX8)");
+    SDLTest_AssertCheck(format != NULL, "Verify result is not NULL");
+    if (!format) {
+        return TEST_ABORTED;
+    }
+    palette = SDL_CreatePalette(256);
+    SDLTest_AssertCheck(palette != NULL, "Verify SDL_CreatePalette(256) is not NULL");
+    if (!palette) {
+        SDL_DestroyPixelFormat(format);
+        return TEST_ABORTED;
+    }
+    SDL_SetPixelFormatPalette(format, palette);
+
+    for (variation = 1; variation <= 3; variation++) {
+        /* Fill the palette with coarse colors so lookups hit many ties */
+        for (i = 0; i < (int)SDL_arraysize(colors); i++) {
+            colors[i].r = (Uint8)(SDLTest_RandomIntegerInRange(0, 4) * 63);
+            colors[i].g = (Uint8)(SDLTest_RandomIntegerInRange(0, 4) * 63);
+            colors[i].b = (Uint8)(variation == 1 ? SDLTest_RandomUint8() : SDLTest_RandomIntegerInRange(0, 3) * 85);
+            colors[i].a = (Uint8)(variation == 3 && (i & 1) ? SDLTest_RandomUint8() : 255);
+        }
+        SDL_SetPaletteColors(palette, colors, 0, SDL_arraysize(colors));
+        SDLTest_AssertPass("Call to SDL_SetPaletteColors()");
+
+        mismatches = 0;
+        for (i = 0; i < 10000; i++) {
+            Uint8 r = SDLTest_RandomUint8();
+            Uint8 g = SDLTest_RandomUint8();
+            Uint8 b = SDLTest_RandomUint8();
+            Uint8 a = (i & 1) ? 255 : SDLTest_RandomUint8();
+            Uint32 expected = 0;
+            Uint32 smallest = ~0U;
+            Uint32 pixel;
+
+            for (j = 0; j < palette->ncolors; j++) {
+                int rd = palette->colors[j].r - r;
+                int gd = palette->colors[j].g - g;
+                int bd = palette->colors[j].b - b;
+                int ad = palette->colors[j].a - a;
+                Uint32 distance = (Uint32)(rd * rd + gd * gd + bd * bd + ad * ad);
+                if (distance < smallest) {
+                    expected = (Uint32)j;
+                    smallest = distance;
+                }
+            }
+            if (a == 255) {
+                pixel = SDL_MapRGB(format, r, g, b);
+            } else {
+                pixel = SDL_MapRGBA(format, r, g, b, a);
+            }
+            if (pixel != expected) {
+                if (mismatches++ == 0) {
+                    SDLTest_AssertCheck(pixel == expected, "Verify mapping of (%u,%u,%u,%u); expected: %" SDL_PRIu32 ", got %" SDL_PRIu32, r, g, b, a, expected, pixel);
+                }
+            }
+        }
+        SDLTest_AssertCheck(mismatches == 0, "Verify all colors map to the nearest palette entry; %d mismatches", mismatches);
+    }
+
+    SDL_DestroyPalette(palette);
+    SDL_DestroyPixelFormat(format);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Pixels test cases */
@@ -383,8 +464,12 @@ static const SDLTest_TestCaseReference pixelsTest3 = {
 };
 
 /* Sequence of Pixels test cases */
+static const SDLTest_TestCaseReference pixelsTest4 = {
+    (SDLTest_TestCaseFp)pixels_mapPalette, "pixels_mapPalette", "Call to SDL_MapRGB and SDL_MapRGBA with a palette", TEST_ENABLED
+};
+
 static const SDLTest_TestCaseReference *pixelsTests[] = {
-    &pixelsTest1, &pixelsTest2, &pixelsTest3, NULL
+    &pixelsTest1, &pixelsTest2, &pixelsTest3, &pixelsTest4, NULL
 };
 
 /* Pixels test suite (global) */
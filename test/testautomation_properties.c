@@ -382,6 +382,115 @@ static int properties_testLocking(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Test atom functionality
+ */
+struct properties_atom_thread_data
+{
+    SDL_AtomicInt done;
+    SDL_PropertiesID props;
+};
+static int properties_atom_thread(void *arg)
+{
+    struct properties_atom_thread_data *data = (struct properties_atom_thread_data *)arg;
+    char key[8];
+    int i = 0;
+
+    /* Keep rewriting the value and adding new properties, so the table grows under the readers */
+    while (!SDL_AtomicGet(&data->done)) {
+        SDL_SetNumberProperty(data->props, "value", (i & 1) ? 1 : -1);
+        SDL_snprintf(key, SDL_arraysize(key), "k%d", i % 500);
+        SDL_SetNumberProperty(data->props, key, i);
+        ++i;
+    }
+    return 0;
+}
+static int properties_testAtoms(void *arg)
+{
+    struct properties_atom_thread_data data;
+    SDL_PropertyAtom atom, atom2;
+    SDL_PropertiesID props;
+    SDL_Thread *thread;
+    const char *value_string;
+    Sint64 value_number;
+    float value_float;
+    SDL_bool value_bool;
+    int i, bad;
+
+    atom = SDL_GetPropertyAtom("atom.test");
+    SDLTest_AssertPass("Call to SDL_GetPropertyAtom(\"atom.test\")");
+    SDLTest_AssertCheck(atom != 0,
+        "Verify atom was created, got: %" SDL_PRIu32, atom);
+    atom2 = SDL_GetPropertyAtom("atom.test");
+    SDLTest_AssertCheck(atom2 == atom,
+        "Verify same name gives same atom, expected %" SDL_PRIu32 ", got: %" SDL_PRIu32, atom, atom2);
+    atom2 = SDL_GetPropertyAtom("atom.test2");
+    SDLTest_AssertCheck(atom2 != 0 && atom2 != atom,
+        "Verify different name gives different atom, got: %" SDL_PRIu32, atom2);
+    atom2 = SDL_GetPropertyAtom(NULL);
+    SDLTest_AssertCheck(atom2 == 0,
+        "Verify NULL name gives no atom, got: %" SDL_PRIu32, atom2);
+
+    props = SDL_CreateProperties();
+
+    value_number = SDL_GetNumberPropertyByAtom(props, atom, 1234);
+    SDLTest_AssertCheck(value_number == 1234,
+        "Verify unset number property, expected 1234, got: %" SDL_PRIs64, value_number);
+
+    SDL_SetNumberProperty(props, "atom.test", 42);
+    value_number = SDL_GetNumberPropertyByAtom(props, atom, 0);
+    SDLTest_AssertCheck(value_number == 42,
+        "Verify number property, expected 42, got: %" SDL_PRIs64, value_number);
+    value_string = SDL_GetStringPropertyByAtom(props, atom, NULL);
+    SDLTest_AssertCheck(value_string && SDL_strcmp(value_string, "42") == 0,
+        "Verify string property, expected 42, got: %s", value_string);
+    value_float = SDL_GetFloatPropertyByAtom(props, atom, 0.0f);
+    SDLTest_AssertCheck(value_float == 42.0f,
+        "Verify float property, expected 42, got: %f", value_float);
+    value_bool = SDL_GetBooleanPropertyByAtom(props, atom, SDL_FALSE);
+    SDLTest_AssertCheck(value_bool == SDL_TRUE,
+        "Verify boolean property, expected SDL_TRUE, got: %s", value_bool ? "SDL_TRUE" : "SDL_FALSE");
+
+    SDL_SetStringProperty(props, "atom.test", "17");
+    value_number = SDL_GetNumberPropertyByAtom(props, atom, 0);
+    SDLTest_AssertCheck(value_number == 17,
+        "Verify number property from string, expected 17, got: %" SDL_PRIs64, value_number);
+
+    SDL_SetProperty(props, "atom.test", &props);
+    SDLTest_AssertCheck(SDL_GetPropertyByAtom(props, atom, NULL) == &props,
+        "Verify pointer property by atom");
+
+    SDL_ClearProperty(props, "atom.test");
+    SDLTest_AssertCheck(SDL_GetPropertyByAtom(props, atom, NULL) == NULL,
+        "Verify cleared property by atom");
+    SDLTest_AssertCheck(SDL_GetPropertyByAtom(0, atom, NULL) == NULL,
+        "Verify invalid properties by atom");
+
+    SDLTest_AssertPass("Reading properties by atom while another thread is writing");
+    SDL_AtomicSet(&data.done, 0);
+    data.props = props;
+    atom = SDL_GetPropertyAtom("value");
+    SDL_SetNumberProperty(props, "value", 1);
+    thread = SDL_CreateThread(properties_atom_thread, "properties_atom_thread", &data);
+    if (thread) {
+        bad = 0;
+        for (i = 0; i < 100000; ++i) {
+            value_number = SDL_GetNumberPropertyByAtom(props, atom, 0);
+            if (value_number != 1 && value_number != -1) {
+                ++bad;
+            }
+        }
+        SDL_AtomicSet(&data.done, 1);
+        SDL_WaitThread(thread, NULL);
+        SDLTest_AssertCheck(bad == 0,
+            "Verify values read while writing, got %d bad values", bad);
+    }
+
+    SDL_DestroyProperties(props);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Properties test cases */
@@ -401,12 +510,17 @@ static const SDLTest_TestCaseReference propertiesTestLocking = {
     (SDLTest_TestCaseFp)properties_testLocking, "properties_testLocking", "Test property locking functionality", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference propertiesTestAtoms = {
+    (SDLTest_TestCaseFp)properties_testAtoms, "properties_testAtoms", "Test property atom functionality", TEST_ENABLED
+};
+
 /* Sequence of Properties test cases */
 static const SDLTest_TestCaseReference *propertiesTests[] = {
     &propertiesTestBasic,
     &propertiesTestCopy,
     &propertiesTestCleanup,
     &propertiesTestLocking,
+    &propertiesTestAtoms,
     NULL
 };
 
@@ -365,6 +365,305 @@ static int rwops_testFileRead(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Tests reading from a file mapped into memory.
+ *
+ * \sa SDL_RWFromMappedFile
+ * \sa SDL_LoadFile
+ */
+static int rwops_testMappedFile(void *arg)
+{
+    SDL_RWops *rw;
+    const char *data;
+    void *loaded;
+    size_t size;
+    FILE *handle;
+    int result;
+
+    rw = SDL_RWFromMappedFile(RWopsReadTestFilename);
+    SDLTest_AssertPass("Call to SDL_RWFromMappedFile() succeeded");
+    SDLTest_AssertCheck(rw != NULL, "Verify opening file with SDL_RWFromMappedFile does not return NULL");
+    if (rw == NULL) {
+        return TEST_ABORTED;
+    }
+    SDLTest_AssertCheck(rw->type == SDL_RWOPS_MEMORY_RO, "Verify RWops type is SDL_RWOPS_MEMORY_RO; expected: %d, got: %" SDL_PRIu32, SDL_RWOPS_MEMORY_RO, rw->type);
+
+    data = (const char *)SDL_GetProperty(SDL_GetRWProperties(rw), SDL_PROP_RWOPS_DATA_POINTER, NULL);
+    SDLTest_AssertCheck(data != NULL, "Verify the stream has a data pointer");
+    SDLTest_AssertCheck(SDL_RWsize(rw) == (Sint64)SDL_strlen(RWopsHelloWorldTestString), "Verify the stream size, expected %d, got %d", (int)SDL_strlen(RWopsHelloWorldTestString), (int)SDL_RWsize(rw));
+    if (data) {
+        SDLTest_AssertCheck(SDL_memcmp(data, RWopsHelloWorldTestString, SDL_strlen(RWopsHelloWorldTestString)) == 0, "Verify the mapped data");
+    }
+
+    /* Run generic tests */
+    testGenericRWopsValidations(rw, SDL_FALSE);
+
+    result = SDL_RWclose(rw);
+    SDLTest_AssertCheck(result == 0, "Verify result value is 0; got: %d", result);
+
+    /* Empty files can't be mapped, but still work */
+    handle = fopen(RWopsWriteTestFilename, "w");
+    SDLTest_AssertCheck(handle != NULL, "Verify creation of file '%s' returned non NULL handle", RWopsWriteTestFilename);
+    if (handle) {
+        fclose(handle);
+        rw = SDL_RWFromMappedFile(RWopsWriteTestFilename);
+        SDLTest_AssertCheck(rw != NULL, "Verify opening an empty file with SDL_RWFromMappedFile does not return NULL");
+        if (rw) {
+            SDLTest_AssertCheck(SDL_RWsize(rw) == 0, "Verify the stream size, expected 0, got %d", (int)SDL_RWsize(rw));
+            SDLTest_AssertCheck(SDL_GetProperty(SDL_GetRWProperties(rw), SDL_PROP_RWOPS_DATA_POINTER, NULL) != NULL, "Verify the stream has a data pointer");
+            SDL_RWclose(rw);
+        }
+    }
+
+    rw = SDL_RWFromMappedFile("nonexistent_file");
+    SDLTest_AssertCheck(rw == NULL, "Verify opening a nonexistent file with SDL_RWFromMappedFile returns NULL");
+
+    loaded = SDL_LoadFile(RWopsAlphabetFilename, &size);
+    SDLTest_AssertCheck(loaded != NULL, "Verify SDL_LoadFile() does not return NULL");
+    if (loaded) {
+        SDLTest_AssertCheck(size == SDL_strlen(RWopsAlphabetString), "Verify the loaded size, expected %d, got %d", (int)SDL_strlen(RWopsAlphabetString), (int)size);
+        SDLTest_AssertCheck(SDL_strcmp((const char *)loaded, RWopsAlphabetString) == 0, "Verify the loaded data is terminated and matches");
+        SDL_free(loaded);
+    }
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests reading and writing through the stream buffer.
+ *
+ * \sa SDL_SetRWBuffer
+ * \sa SDL_FlushRW
+ */
+static int rwops_testBuffered(void *arg)
+{
+    const size_t sizes[] = { 1, 3, 7, 64 };
+    const Sint64 record = 1 + 2 + 4 + 8 + 20;
+    char block[20], check[20];
+    char mem[sizeof(RWopsHelloWorldTestString)];
+    SDL_RWops *rw;
+    Uint8 u8;
+    Uint16 u16;
+    Uint32 u32;
+    Uint64 u64;
+    SDL_bool ok;
+    Sint64 pos;
+    int i, j, result, mismatches;
+
+    /* The generic tests, with a buffer smaller than the data */
+    rw = SDL_RWFromMem(mem, sizeof(RWopsHelloWorldTestString) - 1);
+    SDLTest_AssertCheck(rw != NULL, "Verify opening memory with SDL_RWFromMem does not return NULL");
+    if (rw) {
+        result = SDL_SetRWBuffer(rw, 5);
+        SDLTest_AssertCheck(result == 0, "Verify result from SDL_SetRWBuffer(), expected 0, got %d", result);
+        testGenericRWopsValidations(rw, SDL_TRUE);
+        SDL_RWclose(rw);
+    }
+
+    for (i = 0; i < SDL_arraysize(sizes); ++i) {
+        rw = SDL_RWFromFile(RWopsWriteTestFilename, "w+b");
+        SDLTest_AssertCheck(rw != NULL, "Verify opening file with SDL_RWFromFile in write mode does not return NULL");
+        if (!rw) {
+            return TEST_ABORTED;
+        }
+        result = SDL_SetRWBuffer(rw, sizes[i]);
+        SDLTest_AssertCheck(result == 0, "Verify result from SDL_SetRWBuffer(%d), expected 0, got %d", (int)sizes[i], result);
+
+        ok = SDL_TRUE;
+        for (j = 0; j < 100; ++j) {
+            SDL_memset(block, j, sizeof(block));
+            ok &= SDL_WriteU8(rw, (Uint8)j);
+            ok &= SDL_WriteU16LE(rw, (Uint16)(j * 3));
+            ok &= SDL_WriteU32BE(rw, (Uint32)(j * 7));
+            ok &= SDL_WriteU64LE(rw, (Uint64)(j * 11));
+            ok &= (SDL_RWwrite(rw, block, sizeof(block)) == sizeof(block));
+        }
+        SDLTest_AssertCheck(ok, "Verify buffered writes with a %d byte buffer", (int)sizes[i]);
+        pos = SDL_RWtell(rw);
+        SDLTest_AssertCheck(pos == 100 * record, "Verify position after writing, expected %d, got %d", (int)(100 * record), (int)pos);
+        result = SDL_FlushRW(rw);
+        SDLTest_AssertCheck(result == 0, "Verify result from SDL_FlushRW(), expected 0, got %d", result);
+
+        pos = SDL_RWseek(rw, 0, SDL_RW_SEEK_SET);
+        SDLTest_AssertCheck(pos == 0, "Verify seeking to the start, expected 0, got %d", (int)pos);
+        mismatches = 0;
+        for (j = 0; j < 100; ++j) {
+            SDL_memset(block, j, sizeof(block));
+            if (!SDL_ReadU8(rw, &u8) || u8 != (Uint8)j ||
+                !SDL_ReadU16LE(rw, &u16) || u16 != (Uint16)(j * 3) ||
+                !SDL_ReadU32BE(rw, &u32) || u32 != (Uint32)(j * 7)) {
+                ++mismatches;
+            }
+            /* Seeking back and forth within the buffered data */
+            if (SDL_RWseek(rw, -4, SDL_RW_SEEK_CUR) != j * record + 3 ||
+                SDL_RWseek(rw, 4, SDL_RW_SEEK_CUR) != j * record + 7) {
+                ++mismatches;
+            }
+            if (!SDL_ReadU64LE(rw, &u64) || u64 != (Uint64)(j * 11) ||
+                SDL_RWread(rw, check, sizeof(check)) != sizeof(check) || SDL_memcmp(block, check, sizeof(block)) != 0) {
+                ++mismatches;
+            }
+        }
+        SDLTest_AssertCheck(mismatches == 0, "Verify buffered reads with a %d byte buffer, expected 0 mismatches, got %d", (int)sizes[i], mismatches);
+        ok = SDL_ReadU8(rw, &u8);
+        SDLTest_AssertCheck(!ok && rw->status == SDL_RWOPS_STATUS_EOF, "Verify reading past the end");
+
+        /* Writing after reading, then reading what was written */
+        pos = SDL_RWseek(rw, record, SDL_RW_SEEK_SET);
+        SDLTest_AssertCheck(pos == record, "Verify seeking to the second record, expected %d, got %d", (int)record, (int)pos);
+        SDL_ReadU8(rw, &u8);
+        SDL_WriteU16BE(rw, 0x1234);
+        SDL_RWseek(rw, record + 1, SDL_RW_SEEK_SET);
+        ok = SDL_ReadU16BE(rw, &u16);
+        SDLTest_AssertCheck(ok && u16 == 0x1234, "Verify reading back a buffered write, expected 0x1234, got 0x%.4x", u16);
+        SDLTest_AssertCheck(SDL_RWsize(rw) == 100 * record, "Verify the size, expected %d, got %d", (int)(100 * record), (int)SDL_RWsize(rw));
+
+        result = SDL_SetRWBuffer(rw, 0);
+        SDLTest_AssertCheck(result == 0, "Verify result from SDL_SetRWBuffer(0), expected 0, got %d", result);
+        pos = SDL_RWtell(rw);
+        SDLTest_AssertCheck(pos == record + 3, "Verify position after removing the buffer, expected %d, got %d", (int)(record + 3), (int)pos);
+
+        result = SDL_RWclose(rw);
+        SDLTest_AssertCheck(result == 0, "Verify result value is 0; got: %d", result);
+    }
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests asynchronous reads and writes, with and without io_uring.
+ *
+ * \sa SDL_CreateRWQueue
+ * \sa SDL_ReadRWAsync
+ * \sa SDL_WriteRWAsync
+ * \sa SDL_GetRWCompletion
+ */
+static int rwops_testAsync(void *arg)
+{
+    const char *modes[] = { "1", "0" };
+    const int length = 64 * 1024;
+    Uint8 *data, *buffer;
+    char mem[sizeof(RWopsAlphabetString)];
+    SDL_RWSegment segments[3];
+    SDL_RWCompletion completion;
+    SDL_RWQueue *queue;
+    SDL_RWops *rw, *memrw;
+    Uint64 id;
+    Sint64 pos;
+    int i, m, result, completed, mismatches;
+
+    data = (Uint8 *)SDL_malloc(length);
+    buffer = (Uint8 *)SDL_malloc(length);
+    if (!data || !buffer) {
+        SDL_free(data);
+        SDL_free(buffer);
+        return TEST_ABORTED;
+    }
+    for (i = 0; i < length; ++i) {
+        data[i] = (Uint8)(i * 7 + (i >> 8));
+    }
+    rw = SDL_RWFromFile(RWopsWriteTestFilename, "wb");
+    SDLTest_AssertCheck(rw != NULL, "Verify opening file with SDL_RWFromFile in write mode does not return NULL");
+    if (!rw || SDL_RWwrite(rw, data, length) != (size_t)length || SDL_RWclose(rw) != 0) {
+        SDL_free(data);
+        SDL_free(buffer);
+        return TEST_ABORTED;
+    }
+
+    for (m = 0; m < SDL_arraysize(modes); ++m) {
+        SDL_SetHint(SDL_HINT_RWOPS_IO_URING, modes[m]);
+        queue = SDL_CreateRWQueue(8);
+        SDLTest_AssertCheck(queue != NULL, "Verify SDL_CreateRWQueue() with %s=%s does not return NULL", SDL_HINT_RWOPS_IO_URING, modes[m]);
+        if (!queue) {
+            continue;
+        }
+        SDLTest_AssertCheck(!SDL_GetRWCompletion(queue, &completion, -1), "Verify SDL_GetRWCompletion() returns SDL_FALSE on an idle queue");
+        SDLTest_AssertCheck(SDL_CancelRWRequest(queue, 12345) < 0, "Verify SDL_CancelRWRequest() fails for an unknown request");
+
+        /* More scattered reads than the queue depth, the last one past the end */
+        rw = SDL_RWFromFile(RWopsWriteTestFilename, "rb");
+        SDLTest_AssertCheck(rw != NULL, "Verify opening file with SDL_RWFromFile in read mode does not return NULL");
+        if (!rw) {
+            SDL_DestroyRWQueue(queue);
+            continue;
+        }
+        SDL_memset(buffer, 0, length);
+        for (i = 0; i < 32; ++i) {
+            segments[0].data = buffer + i * 2048;
+            segments[0].size = 1000;
+            segments[1].data = buffer + i * 2048 + 1000;
+            segments[1].size = 0;
+            segments[2].data = buffer + i * 2048 + 1000;
+            segments[2].size = (i == 31) ? 2048 : 1048;
+            id = SDL_ReadRWAsync(queue, rw, i * 2048, segments, 3, (void *)(uintptr_t)i);
+            SDLTest_AssertCheck(id != 0, "Verify SDL_ReadRWAsync() returns a request ID");
+        }
+        completed = mismatches = 0;
+        while (SDL_GetRWCompletion(queue, &completion, -1)) {
+            i = (int)(uintptr_t)completion.userdata;
+            if (completion.status != SDL_RWREQUEST_COMPLETE || completion.type != SDL_RWREQUEST_READ ||
+                completion.context != rw || completion.offset != (Uint64)i * 2048 ||
+                completion.transferred != 2048 || completion.requested != ((i == 31) ? 3048 : 2048)) {
+                ++mismatches;
+            }
+            ++completed;
+        }
+        SDLTest_AssertCheck(completed == 32, "Verify all reads completed, expected 32, got %d", completed);
+        SDLTest_AssertCheck(mismatches == 0, "Verify the completions, expected 0 mismatches, got %d", mismatches);
+        SDLTest_AssertCheck(SDL_memcmp(buffer, data, length) == 0, "Verify the data read");
+        pos = SDL_RWtell(rw);
+        SDLTest_AssertCheck(pos == 0, "Verify the stream position is unchanged, expected 0, got %d", (int)pos);
+
+        /* Canceling, the request either stops or finishes */
+        id = 0;
+        for (i = 0; i < 16; ++i) {
+            segments[0].data = buffer + i * 4096;
+            segments[0].size = 4096;
+            id = SDL_ReadRWAsync(queue, rw, i * 4096, segments, 1, NULL);
+        }
+        /* This fails if the request already finished */
+        result = SDL_CancelRWRequest(queue, id);
+        completed = mismatches = 0;
+        while (SDL_GetRWCompletion(queue, &completion, -1)) {
+            if (completion.request == id) {
+                if (completion.status != SDL_RWREQUEST_COMPLETE && (result < 0 || completion.status != SDL_RWREQUEST_CANCELED)) {
+                    ++mismatches;
+                }
+            } else if (completion.status != SDL_RWREQUEST_COMPLETE || completion.transferred != 4096) {
+                ++mismatches;
+            }
+            ++completed;
+        }
+        SDLTest_AssertCheck(completed == 16 && mismatches == 0, "Verify reads with a cancellation, expected 16 completed and 0 mismatches, got %d and %d", completed, mismatches);
+        SDL_RWclose(rw);
+
+        /* A gathered write to a memory stream */
+        SDL_memset(mem, '.', sizeof(mem));
+        memrw = SDL_RWFromMem(mem, sizeof(mem));
+        SDLTest_AssertCheck(memrw != NULL, "Verify opening memory with SDL_RWFromMem does not return NULL");
+        if (memrw) {
+            segments[0].data = (void *)RWopsAlphabetString;
+            segments[0].size = 3;
+            segments[1].data = (void *)(RWopsAlphabetString + 10);
+            segments[1].size = 4;
+            id = SDL_WriteRWAsync(queue, memrw, 5, segments, 2, NULL);
+            SDLTest_AssertCheck(id != 0, "Verify SDL_WriteRWAsync() returns a request ID");
+            SDLTest_AssertCheck(SDL_GetRWCompletion(queue, &completion, 5000), "Verify the write completed");
+            SDLTest_AssertCheck(completion.request == id && completion.status == SDL_RWREQUEST_COMPLETE && completion.transferred == 7,
+                                "Verify the write completion, expected 7 bytes written, got %d", (int)completion.transferred);
+            SDLTest_AssertCheck(SDL_memcmp(mem, ".....ABCKLMN", 12) == 0, "Verify the data written");
+            SDL_RWclose(memrw);
+        }
+
+        SDL_DestroyRWQueue(queue);
+    }
+    SDL_ResetHint(SDL_HINT_RWOPS_IO_URING);
+
+    SDL_free(data);
+    SDL_free(buffer);
+    return TEST_COMPLETED;
+}
+
 /**
  * Tests writing from file.
  *
@@ -670,10 +969,22 @@ static const SDLTest_TestCaseReference rwopsTest8 = {
     (SDLTest_TestCaseFp)rwops_testCompareRWFromMemWithRWFromFile, "rwops_testCompareRWFromMemWithRWFromFile", "Compare RWFromMem and RWFromFile RWops for read and seek", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference rwopsTest9 = {
+    (SDLTest_TestCaseFp)rwops_testMappedFile, "rwops_testMappedFile", "Tests reading from a file mapped into memory", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference rwopsTest10 = {
+    (SDLTest_TestCaseFp)rwops_testBuffered, "rwops_testBuffered", "Tests reading and writing through the stream buffer", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference rwopsTest11 = {
+    (SDLTest_TestCaseFp)rwops_testAsync, "rwops_testAsync", "Tests asynchronous reads and writes", TEST_ENABLED
+};
+
 /* Sequence of RWops test cases */
 static const SDLTest_TestCaseReference *rwopsTests[] = {
     &rwopsTest1, &rwopsTest2, &rwopsTest3, &rwopsTest4, &rwopsTest5, &rwopsTest6,
-    &rwopsTest7, &rwopsTest8, NULL
+    &rwopsTest7, &rwopsTest8, &rwopsTest9, &rwopsTest10, &rwopsTest11, NULL
 };
 
 /* RWops test suite (global) */
@@ -871,6 +871,733 @@ static int stdlib_aligned_alloc(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Call to SDL_GetMemoryStats
+ */
+static int SDLCALL memory_stats_thread(void *data)
+{
+    void *blocks[64];
+    int i, pass;
+
+    for (pass = 0; pass < 2; ++pass) {
+        for (i = 0; i < SDL_arraysize(blocks); ++i) {
+            blocks[i] = SDL_malloc(200);
+        }
+        for (i = 0; i < SDL_arraysize(blocks); ++i) {
+            SDL_free(blocks[i]);
+        }
+    }
+    return 0;
+}
+
+static int stdlib_memory_stats(void *arg)
+{
+    SDL_Thread *thread;
+    SDL_MemoryStats before, after;
+    void *blocks[64];
+    int i, result;
+
+    result = SDL_GetMemoryStats(NULL);
+    SDLTest_AssertCheck(result < 0, "SDL_GetMemoryStats(NULL), expected < 0, got %d", result);
+
+    result = SDL_GetMemoryStats(&before);
+    if (result < 0) {
+        SDLTest_Log("SDL_GetMemoryStats() isn't available: %s", SDL_GetError());
+        return TEST_SKIPPED;
+    }
+
+    for (i = 0; i < SDL_arraysize(blocks); ++i) {
+        blocks[i] = SDL_malloc(100);
+        SDLTest_AssertCheck(blocks[i] != NULL, "SDL_malloc(100)");
+    }
+    result = SDL_GetMemoryStats(&after);
+    SDLTest_AssertCheck(result == 0, "SDL_GetMemoryStats(), expected 0, got %d", result);
+    SDLTest_AssertCheck(after.num_allocations >= before.num_allocations + SDL_arraysize(blocks),
+                        "Check num_allocations, expected at least %d more, got %d more",
+                        (int)SDL_arraysize(blocks), (int)(after.num_allocations - before.num_allocations));
+    SDLTest_AssertCheck(after.allocations_by_size[3] >= before.allocations_by_size[3] + SDL_arraysize(blocks),
+                        "Check allocations_by_size[3], expected at least %d more, got %d more",
+                        (int)SDL_arraysize(blocks), (int)(after.allocations_by_size[3] - before.allocations_by_size[3]));
+    SDLTest_AssertCheck(after.peak_bytes >= after.bytes_in_use + after.bytes_cached,
+                        "Check peak_bytes, expected at least %d, got %d",
+                        (int)(after.bytes_in_use + after.bytes_cached), (int)after.peak_bytes);
+
+    for (i = 0; i < SDL_arraysize(blocks); ++i) {
+        SDL_free(blocks[i]);
+    }
+    result = SDL_GetMemoryStats(&after);
+    SDLTest_AssertCheck(result == 0, "SDL_GetMemoryStats(), expected 0, got %d", result);
+    SDLTest_AssertCheck(after.num_frees >= before.num_frees + SDL_arraysize(blocks),
+                        "Check num_frees, expected at least %d more, got %d more",
+                        (int)SDL_arraysize(blocks), (int)(after.num_frees - before.num_frees));
+
+    /* The same size again should come from the cache */
+    blocks[0] = SDL_malloc(100);
+    SDLTest_AssertCheck(blocks[0] != NULL, "SDL_malloc(100)");
+    SDL_free(blocks[0]);
+    result = SDL_GetMemoryStats(&before);
+    SDLTest_AssertCheck(result == 0, "SDL_GetMemoryStats(), expected 0, got %d", result);
+    SDLTest_AssertCheck(before.num_cache_hits > after.num_cache_hits, "Check num_cache_hits increased");
+
+    /* Threads created by SDL have their own cache, which goes away when they exit.
+       The first thread can leave some state behind, so only the second one is checked. */
+    thread = SDL_CreateThread(memory_stats_thread, "memory_stats", NULL);
+    SDLTest_AssertCheck(thread != NULL, "SDL_CreateThread()");
+    SDL_WaitThread(thread, NULL);
+    result = SDL_GetMemoryStats(&before);
+    SDLTest_AssertCheck(result == 0, "SDL_GetMemoryStats(), expected 0, got %d", result);
+
+    thread = SDL_CreateThread(memory_stats_thread, "memory_stats", NULL);
+    SDLTest_AssertCheck(thread != NULL, "SDL_CreateThread()");
+    SDL_WaitThread(thread, NULL);
+    result = SDL_GetMemoryStats(&after);
+    SDLTest_AssertCheck(result == 0, "SDL_GetMemoryStats(), expected 0, got %d", result);
+    SDLTest_AssertCheck(after.num_cache_hits >= before.num_cache_hits + SDL_arraysize(blocks),
+                        "Check num_cache_hits, expected at least %d more, got %d more",
+                        (int)SDL_arraysize(blocks), (int)(after.num_cache_hits - before.num_cache_hits));
+    SDLTest_AssertCheck(after.num_allocations - after.num_frees == before.num_allocations - before.num_frees,
+                        "Check that the thread freed everything it allocated, expected %d blocks in use, got %d",
+                        (int)(before.num_allocations - before.num_frees), (int)(after.num_allocations - after.num_frees));
+    SDLTest_AssertCheck(after.bytes_in_use + after.bytes_cached <= before.bytes_in_use + before.bytes_cached,
+                        "Check that the thread's cache was released, expected at most %d bytes, got %d",
+                        (int)(before.bytes_in_use + before.bytes_cached), (int)(after.bytes_in_use + after.bytes_cached));
+
+    return TEST_COMPLETED;
+}
+
+static int SDLCALL sort_compare_r(void *userdata, const void *a, const void *b)
+{
+    int *calls = (int *)userdata;
+    const int x = *(const int *)a;
+    const int y = *(const int *)b;
+
+    ++*calls;
+    return (x < y) ? 1 : ((x > y) ? -1 : 0); /* descending */
+}
+
+/**
+ * Call to SDL_qsort_r and SDL_bsearch_r
+ */
+static int stdlib_qsort_r(void *arg)
+{
+    int nums[1000];
+    int calls = 0;
+    int i, key;
+    int *found;
+
+    for (i = 0; i < SDL_arraysize(nums); ++i) {
+        nums[i] = SDLTest_RandomIntegerInRange(-5000, 5000) * 2;
+    }
+    SDL_qsort_r(nums, SDL_arraysize(nums), sizeof(nums[0]), sort_compare_r, &calls);
+    SDLTest_AssertPass("Call to SDL_qsort_r()");
+    SDLTest_AssertCheck(calls > 0, "Check comparison calls, expected > 0, got %d", calls);
+    for (i = 1; i < SDL_arraysize(nums); ++i) {
+        if (nums[i - 1] < nums[i]) {
+            break;
+        }
+    }
+    SDLTest_AssertCheck(i == SDL_arraysize(nums), "Check descending order, first out of order element %d", i);
+
+    for (i = 0; i < SDL_arraysize(nums); i += 37) {
+        found = (int *)SDL_bsearch_r(&nums[i], nums, SDL_arraysize(nums), sizeof(nums[0]), sort_compare_r, &calls);
+        SDLTest_AssertCheck(found && *found == nums[i], "SDL_bsearch_r(%d), expected to find it", nums[i]);
+    }
+    key = nums[0] + 1;
+    found = (int *)SDL_bsearch_r(&key, nums, SDL_arraysize(nums), sizeof(nums[0]), sort_compare_r, &calls);
+    SDLTest_AssertCheck(found == NULL, "SDL_bsearch_r(%d), expected NULL", key);
+
+    return TEST_COMPLETED;
+}
+
+typedef struct
+{
+    int key;
+    int index;
+} SortRecord;
+
+static int SDLCALL sort_record_compare(void *userdata, const void *a, const void *b)
+{
+    const SortRecord *x = (const SortRecord *)a;
+    const SortRecord *y = (const SortRecord *)b;
+
+    return (x->key < y->key) ? -1 : ((x->key > y->key) ? 1 : 0);
+}
+
+/**
+ * Call to SDL_ParallelSort
+ */
+static int stdlib_parallel_sort(void *arg)
+{
+    static const int counts[] = { 0, 1, 2, 15, 100, 1000, 100000 };
+    SortRecord *records;
+    int i, j, result;
+
+    records = (SortRecord *)SDL_malloc(counts[SDL_arraysize(counts) - 1] * sizeof(*records));
+    SDLTest_AssertCheck(records != NULL, "SDL_malloc()");
+    if (!records) {
+        return TEST_ABORTED;
+    }
+
+    for (i = 0; i < SDL_arraysize(counts); ++i) {
+        const int count = counts[i];
+
+        /* Lots of equal keys, to check the sort is stable */
+        for (j = 0; j < count; ++j) {
+            records[j].key = SDLTest_RandomIntegerInRange(-500, 500);
+            records[j].index = j;
+        }
+        result = SDL_ParallelSort(records, count, sizeof(*records), sort_record_compare, NULL);
+        SDLTest_AssertCheck(result == 0, "SDL_ParallelSort(%d elements), expected 0, got %d", count, result);
+        for (j = 1; j < count; ++j) {
+            if (records[j - 1].key > records[j].key ||
+                (records[j - 1].key == records[j].key && records[j - 1].index > records[j].index)) {
+                break;
+            }
+        }
+        SDLTest_AssertCheck(j >= count, "Check stable order of %d elements, first out of order element %d", count, j);
+    }
+
+    result = SDL_ParallelSort(NULL, 1, sizeof(*records), sort_record_compare, NULL);
+    SDLTest_AssertCheck(result < 0, "SDL_ParallelSort(NULL), expected < 0, got %d", result);
+
+    SDL_free(records);
+
+    return TEST_COMPLETED;
+}
+
+#define RADIX_RECORD_SIZE   13  /* the key is unaligned at offset 5 */
+#define RADIX_KEY_OFFSET    5
+
+static int radix_key_order(const Uint8 *a, const Uint8 *b, SDL_SortKeyType key_type)
+{
+    union
+    {
+        Uint32 u32;
+        Sint32 s32;
+        float f;
+        Uint64 u64;
+        Sint64 s64;
+        double d;
+    } x, y;
+
+    SDL_memcpy(&x, a + RADIX_KEY_OFFSET, sizeof(x));
+    SDL_memcpy(&y, b + RADIX_KEY_OFFSET, sizeof(y));
+    switch (key_type) {
+    case SDL_SORTKEY_UINT32:
+        return (x.u32 < y.u32) ? -1 : (x.u32 > y.u32);
+    case SDL_SORTKEY_SINT32:
+        return (x.s32 < y.s32) ? -1 : (x.s32 > y.s32);
+    case SDL_SORTKEY_FLOAT:
+        if (x.f == y.f && x.u32 != y.u32) {
+            return (x.u32 > y.u32) ? -1 : 1; /* -0.0 goes before 0.0 */
+        }
+        return (x.f < y.f) ? -1 : (x.f > y.f);
+    case SDL_SORTKEY_UINT64:
+        return (x.u64 < y.u64) ? -1 : (x.u64 > y.u64);
+    case SDL_SORTKEY_SINT64:
+        return (x.s64 < y.s64) ? -1 : (x.s64 > y.s64);
+    case SDL_SORTKEY_DOUBLE:
+        if (x.d == y.d && x.u64 != y.u64) {
+            return (x.u64 > y.u64) ? -1 : 1;
+        }
+        return (x.d < y.d) ? -1 : (x.d > y.d);
+    default:
+        return 0;
+    }
+}
+
+/**
+ * Call to SDL_RadixSort
+ */
+static int stdlib_radix_sort(void *arg)
+{
+    static const SDL_SortKeyType key_types[] = {
+        SDL_SORTKEY_UINT32, SDL_SORTKEY_SINT32, SDL_SORTKEY_FLOAT,
+        SDL_SORTKEY_UINT64, SDL_SORTKEY_SINT64, SDL_SORTKEY_DOUBLE
+    };
+    const int count = 10000;
+    Uint8 *records;
+    int i, j, result;
+
+    records = (Uint8 *)SDL_malloc(count * RADIX_RECORD_SIZE);
+    SDLTest_AssertCheck(records != NULL, "SDL_malloc()");
+    if (!records) {
+        return TEST_ABORTED;
+    }
+
+    for (i = 0; i < SDL_arraysize(key_types); ++i) {
+        const SDL_SortKeyType key_type = key_types[i];
+
+        for (j = 0; j < count; ++j) {
+            Uint8 *record = records + j * RADIX_RECORD_SIZE;
+            /* Half small values with lots of duplicates, half anything */
+            const Sint64 value = (j & 1) ? SDLTest_RandomIntegerInRange(-100, 100) : SDLTest_RandomSint64();
+            Uint32 u32 = (Uint32)value;
+            float f = (j % 3) ? (float)value : (float)value / 7.0f;
+            double d = (j % 3) ? (double)value : (double)value / 7.0;
+
+            if (j % 101 == 0) {
+                f = -0.0f;
+                d = -0.0;
+            }
+            SDL_memcpy(record, &j, sizeof(j));
+            SDL_memset(record + RADIX_KEY_OFFSET, 0, 8);
+            switch (key_type) {
+            case SDL_SORTKEY_UINT32:
+            case SDL_SORTKEY_SINT32:
+                SDL_memcpy(record + RADIX_KEY_OFFSET, &u32, sizeof(u32));
+                break;
+            case SDL_SORTKEY_FLOAT:
+                SDL_memcpy(record + RADIX_KEY_OFFSET, &f, sizeof(f));
+                break;
+            case SDL_SORTKEY_DOUBLE:
+                SDL_memcpy(record + RADIX_KEY_OFFSET, &d, sizeof(d));
+                break;
+            default:
+                SDL_memcpy(record + RADIX_KEY_OFFSET, &value, sizeof(value));
+                break;
+            }
+        }
+
+        result = SDL_RadixSort(records, count, RADIX_RECORD_SIZE, RADIX_KEY_OFFSET, key_type);
+        SDLTest_AssertCheck(result == 0, "SDL_RadixSort(key type %d), expected 0, got %d", (int)key_type, result);
+        for (j = 1; j < count; ++j) {
+            const Uint8 *a = records + (j - 1) * RADIX_RECORD_SIZE;
+            const Uint8 *b = records + j * RADIX_RECORD_SIZE;
+            const int order = radix_key_order(a, b, key_type);
+            int index_a, index_b;
+
+            SDL_memcpy(&index_a, a, sizeof(index_a));
+            SDL_memcpy(&index_b, b, sizeof(index_b));
+            if (order > 0 || (order == 0 && index_a > index_b)) {
+                break;
+            }
+        }
+        SDLTest_AssertCheck(j >= count, "Check stable order for key type %d, first out of order element %d", (int)key_type, j);
+    }
+
+    result = SDL_RadixSort(records, count, RADIX_RECORD_SIZE, RADIX_RECORD_SIZE - 7, SDL_SORTKEY_UINT64);
+    SDLTest_AssertCheck(result < 0, "SDL_RadixSort() with the key past the element, expected < 0, got %d", result);
+    result = SDL_RadixSort(records, count, RADIX_RECORD_SIZE, 0, (SDL_SortKeyType)100);
+    SDLTest_AssertCheck(result < 0, "SDL_RadixSort() with an invalid key type, expected < 0, got %d", result);
+
+    SDL_free(records);
+
+    return TEST_COMPLETED;
+}
+
+/* Encode code points the way the converter should, to check it against */
+static size_t iconv_encode(const Uint32 *text, int count, int unitsize, char *out)
+{
+    Uint8 *dst = (Uint8 *)out;
+    int i;
+
+    for (i = 0; i < count; ++i) {
+        Uint32 ch = text[i];
+
+        if (unitsize == 1) {
+            if (ch < 0x80) {
+                *dst++ = (Uint8)ch;
+            } else if (ch < 0x800) {
+                *dst++ = (Uint8)(0xC0 | (ch >> 6));
+                *dst++ = (Uint8)(0x80 | (ch & 0x3F));
+            } else if (ch < 0x10000) {
+                *dst++ = (Uint8)(0xE0 | (ch >> 12));
+                *dst++ = (Uint8)(0x80 | ((ch >> 6) & 0x3F));
+                *dst++ = (Uint8)(0x80 | (ch & 0x3F));
+            } else {
+                *dst++ = (Uint8)(0xF0 | (ch >> 18));
+                *dst++ = (Uint8)(0x80 | ((ch >> 12) & 0x3F));
+                *dst++ = (Uint8)(0x80 | ((ch >> 6) & 0x3F));
+                *dst++ = (Uint8)(0x80 | (ch & 0x3F));
+            }
+        } else if (unitsize == 2) {
+            if (ch >= 0x10000) {
+                const Uint32 high = 0xD800 | ((ch - 0x10000) >> 10);
+                *dst++ = (Uint8)high;
+                *dst++ = (Uint8)(high >> 8);
+                ch = 0xDC00 | ((ch - 0x10000) & 0x3FF);
+            }
+            *dst++ = (Uint8)ch;
+            *dst++ = (Uint8)(ch >> 8);
+        } else {
+            *dst++ = (Uint8)ch;
+            *dst++ = (Uint8)(ch >> 8);
+            *dst++ = (Uint8)(ch >> 16);
+            *dst++ = (Uint8)(ch >> 24);
+        }
+    }
+    return (size_t)(dst - (Uint8 *)out);
+}
+
+/* Convert text both ways between UTF-8 and the wide encodings */
+static void iconv_check_text(const Uint32 *text, int count, const char *what)
+{
+    static const struct
+    {
+        const char *name;
+        int unitsize;
+    } encodings[] = {
+        { "UTF-16LE", 2 },
+        { "UTF-32LE", 4 }
+    };
+    char utf8[512], wide[512];
+    size_t utf8_len, wide_len;
+    char *result;
+    int i;
+
+    utf8_len = iconv_encode(text, count, 1, utf8);
+    for (i = 0; i < SDL_arraysize(encodings); ++i) {
+        wide_len = iconv_encode(text, count, encodings[i].unitsize, wide);
+
+        result = SDL_iconv_string(encodings[i].name, "UTF-8", utf8, utf8_len);
+        SDLTest_AssertCheck(result && SDL_memcmp(result, wide, wide_len) == 0,
+                            "Check UTF-8 to %s, %s", encodings[i].name, what);
+        SDL_free(result);
+
+        result = SDL_iconv_string("UTF-8", encodings[i].name, wide, wide_len);
+        SDLTest_AssertCheck(result && SDL_memcmp(result, utf8, utf8_len) == 0 && result[utf8_len] == '\0',
+                            "Check %s to UTF-8, %s", encodings[i].name, what);
+        SDL_free(result);
+    }
+}
+
+/* Convert in pieces with SDL_iconv(), which has to stop cleanly between characters */
+static void iconv_check_e2big(const char *tocode, const char *fromcode, const char *src, size_t srclen,
+                              const char *expected, size_t expected_len, size_t chunk)
+{
+    SDL_iconv_t cd;
+    char out[512];
+    size_t outlen = 0;
+    size_t rc = SDL_ICONV_E2BIG;
+    int calls = 0;
+
+    cd = SDL_iconv_open(tocode, fromcode);
+    SDLTest_AssertCheck(cd != (SDL_iconv_t)-1, "SDL_iconv_open(\"%s\", \"%s\")", tocode, fromcode);
+    if (cd == (SDL_iconv_t)-1) {
+        return;
+    }
+    while (rc == SDL_ICONV_E2BIG && outlen + chunk <= sizeof(out)) {
+        const size_t srclen_before = srclen;
+        char *dst = out + outlen;
+        size_t dstlen = chunk;
+
+        rc = SDL_iconv(cd, &src, &srclen, &dst, &dstlen);
+        outlen += chunk - dstlen;
+        ++calls;
+        if (rc == SDL_ICONV_E2BIG && srclen == srclen_before) {
+            break;
+        }
+    }
+    SDLTest_AssertCheck(rc != SDL_ICONV_E2BIG && rc != SDL_ICONV_ERROR && rc != SDL_ICONV_EILSEQ && rc != SDL_ICONV_EINVAL && srclen == 0,
+                        "Check %s to %s in %d byte pieces finished, got %d with %d bytes left",
+                        fromcode, tocode, (int)chunk, (int)rc, (int)srclen);
+    SDLTest_AssertCheck(calls > 1, "Check %s to %s in %d byte pieces ran out of space, took %d calls",
+                        fromcode, tocode, (int)chunk, calls);
+    SDLTest_AssertCheck(outlen == expected_len && SDL_memcmp(out, expected, expected_len) == 0,
+                        "Check %s to %s in %d byte pieces, expected %d bytes, got %d",
+                        fromcode, tocode, (int)chunk, (int)expected_len, (int)outlen);
+    SDL_iconv_close(cd);
+}
+
+/**
+ * Call to SDL_iconv and SDL_iconv_string
+ */
+static int stdlib_iconv(void *arg)
+{
+    static const Uint32 multibyte[] = { 0xE9, 0x20AC, 0xFFFD, 0x1F600, 0x10FFFF };
+    static const struct
+    {
+        const char *text;
+        size_t bad_offset;
+    } invalid[] = {
+        { "0123456789abcdef\xFFghij", 16 },                /* byte that never starts a sequence */
+        { "0123456789abcd\xE2\x82xyz", 14 },               /* truncated 3 byte sequence */
+        { "0123456789abcde\x80xyz", 15 },                  /* stray continuation byte */
+        { "0123456789abcdef0123456\xED\xA0\x80xyz", 23 }, /* encoded surrogate */
+        { "0123456789ab\xC0\xAFxyz", 12 }                  /* overlong encoding */
+    };
+    Uint32 text[128];
+    char utf8[512], wide[512];
+    size_t utf8_len, wide_len;
+    int i, j, k, length, offset, count;
+
+    /* ASCII runs shorter and longer than a SIMD block, with and without a tail */
+    for (j = 0; j <= 41; ++j) {
+        length = (j <= 40) ? j : 100;
+        for (i = 0; i < length; ++i) {
+            text[i] = 'A' + (i % 26);
+        }
+        iconv_check_text(text, length, "ASCII");
+    }
+
+    /* Multibyte characters at every offset around the 16 byte block boundary */
+    for (j = 0; j < SDL_arraysize(multibyte); ++j) {
+        for (offset = 0; offset <= 33; ++offset) {
+            char what[64];
+
+            count = 0;
+            for (i = 0; i < offset; ++i) {
+                text[count++] = 'a' + (i % 26);
+            }
+            text[count++] = multibyte[j];
+            for (i = 0; i < 20; ++i) {
+                text[count++] = '0' + (i % 10);
+            }
+            SDL_snprintf(what, sizeof(what), "U+%04X at offset %d", (unsigned int)multibyte[j], offset);
+            iconv_check_text(text, count, what);
+        }
+    }
+
+    /* Several multibyte characters in a row, straddling a block */
+    count = 0;
+    for (i = 0; i < 14; ++i) {
+        text[count++] = 'a' + i;
+    }
+    for (j = 0; j < SDL_arraysize(multibyte); ++j) {
+        text[count++] = multibyte[j];
+    }
+    for (i = 0; i < 30; ++i) {
+        text[count++] = 'A' + (i % 26);
+    }
+    iconv_check_text(text, count, "mixed run");
+
+    /* Invalid input is either rejected or replaced, but the valid text around it survives */
+    for (i = 0; i < SDL_arraysize(invalid); ++i) {
+        const char *src = invalid[i].text;
+        const size_t len = SDL_strlen(src);
+        const size_t bad_offset = invalid[i].bad_offset;
+        SDL_iconv_t cd;
+        char *result;
+        size_t srclen = len, dstlen = sizeof(wide), rc;
+        char *dst = wide;
+
+        cd = SDL_iconv_open("UTF-32LE", "UTF-8");
+        SDLTest_AssertCheck(cd != (SDL_iconv_t)-1, "SDL_iconv_open(\"UTF-32LE\", \"UTF-8\")");
+        if (cd == (SDL_iconv_t)-1) {
+            continue;
+        }
+        rc = SDL_iconv(cd, &src, &srclen, &dst, &dstlen);
+        SDL_iconv_close(cd);
+        wide_len = sizeof(wide) - dstlen;
+        if (rc == SDL_ICONV_EILSEQ) {
+            SDLTest_AssertCheck(len - srclen == bad_offset && wide_len == bad_offset * 4,
+                                "Check invalid input %d stopped at offset %d, got %d",
+                                i, (int)bad_offset, (int)(len - srclen));
+        } else {
+            SDLTest_AssertCheck(rc != SDL_ICONV_ERROR && rc != SDL_ICONV_E2BIG && rc != SDL_ICONV_EINVAL && srclen == 0,
+                                "Check invalid input %d was converted, got %d with %d bytes left",
+                                i, (int)rc, (int)srclen);
+        }
+        for (k = 0; k < (int)bad_offset && (size_t)k * 4 < wide_len; ++k) {
+            if (wide[k * 4] != invalid[i].text[k] || wide[k * 4 + 1] || wide[k * 4 + 2] || wide[k * 4 + 3]) {
+                break;
+            }
+        }
+        SDLTest_AssertCheck(k == (int)bad_offset, "Check invalid input %d kept the text before it, got %d characters", i, k);
+
+        /* Dropped or replaced, the bad bytes never come out as anything but U+FFFD */
+        result = SDL_iconv_string("UTF-32LE", "UTF-8", invalid[i].text, len);
+        SDLTest_AssertCheck(result != NULL, "SDL_iconv_string() with invalid input %d", i);
+        if (result) {
+            const Uint8 *p = (const Uint8 *)result;
+            Uint32 ch;
+
+            count = 0;
+            for (k = 0;; k += 4) {
+                ch = (Uint32)p[k] | ((Uint32)p[k + 1] << 8) | ((Uint32)p[k + 2] << 16) | ((Uint32)p[k + 3] << 24);
+                if (ch == 0) {
+                    break;
+                }
+                if (ch != 0xFFFD) {
+                    utf8[count++] = (char)ch;
+                    if (ch >= 0x80 || count == sizeof(utf8)) {
+                        break;
+                    }
+                }
+            }
+            utf8[count] = '\0';
+            SDLTest_AssertCheck(SDL_strncmp(utf8, invalid[i].text, bad_offset) == 0 &&
+                                (SDL_strcmp(utf8 + bad_offset, "ghij") == 0 || SDL_strcmp(utf8 + bad_offset, "xyz") == 0),
+                                "Check invalid input %d without replacements, got \"%s\"", i, utf8);
+            SDL_free(result);
+        }
+    }
+
+    /* Running out of output space has to stop between characters and resume there */
+    count = 0;
+    for (i = 0; i < 60; ++i) {
+        text[count++] = (i % 13 == 12) ? multibyte[(i / 13) % SDL_arraysize(multibyte)] : (Uint32)('a' + (i % 26));
+    }
+    utf8_len = iconv_encode(text, count, 1, utf8);
+    wide_len = iconv_encode(text, count, 2, wide);
+    for (i = 4; i <= 9; ++i) {
+        iconv_check_e2big("UTF-16LE", "UTF-8", utf8, utf8_len, wide, wide_len, i);
+        iconv_check_e2big("UTF-8", "UTF-16LE", wide, wide_len, utf8, utf8_len, i);
+    }
+    wide_len = iconv_encode(text, count, 4, wide);
+    iconv_check_e2big("UTF-32LE", "UTF-8", utf8, utf8_len, wide, wide_len, 6);
+    iconv_check_e2big("UTF-8", "UTF-32LE", wide, wide_len, utf8, utf8_len, 6);
+
+    return TEST_COMPLETED;
+}
+
+/* The original bit-at-a-time algorithms, to check the optimized ones against */
+static Uint32 reference_crc32(Uint32 crc, const Uint8 *data, size_t len)
+{
+    size_t i;
+    int bit;
+
+    for (i = 0; i < len; ++i) {
+        Uint32 r = (Uint8)crc ^ data[i];
+        for (bit = 0; bit < 8; ++bit) {
+            r = (r & 1 ? 0 : (Uint32)0xEDB88320L) ^ r >> 1;
+        }
+        crc = (r ^ (Uint32)0xFF000000L) ^ crc >> 8;
+    }
+    return crc;
+}
+
+static Uint16 reference_crc16(Uint16 crc, const Uint8 *data, size_t len)
+{
+    size_t i;
+    int bit;
+
+    for (i = 0; i < len; ++i) {
+        Uint8 r = (Uint8)crc ^ data[i];
+        Uint16 value = 0;
+        for (bit = 0; bit < 8; ++bit) {
+            value = ((value ^ r) & 1 ? 0xA001 : 0) ^ value >> 1;
+            r >>= 1;
+        }
+        crc = value ^ crc >> 8;
+    }
+    return crc;
+}
+
+static int stdlib_crc(void *arg)
+{
+    const size_t size = 70000;
+    const char *check = "123456789";
+    Uint8 *data;
+    Uint32 crc32;
+    Uint16 crc16;
+    size_t i, len, offset;
+
+    crc32 = SDL_crc32(0, check, 9);
+    SDLTest_AssertCheck(crc32 == 0xCBF43926, "SDL_crc32(\"%s\"), expected 0xCBF43926, got 0x%.8" SDL_PRIX32, check, crc32);
+    crc16 = SDL_crc16(0, check, 9);
+    SDLTest_AssertCheck(crc16 == 0xBB3D, "SDL_crc16(\"%s\"), expected 0xBB3D, got 0x%.4X", check, crc16);
+
+    data = (Uint8 *)SDL_malloc(size);
+    SDLTest_AssertCheck(data != NULL, "Check SDL_malloc");
+    if (!data) {
+        return TEST_ABORTED;
+    }
+    for (i = 0; i < size; ++i) {
+        data[i] = (Uint8)SDLTest_RandomUint32();
+    }
+
+    /* Every length and alignment around the sizes where the implementation changes */
+    for (offset = 0; offset < 16; ++offset) {
+        for (len = 0; len < 1100; ++len) {
+            const Uint32 seed = SDLTest_RandomUint32();
+            crc32 = SDL_crc32(seed, data + offset, len);
+            if (crc32 != reference_crc32(seed, data + offset, len)) {
+                SDLTest_AssertCheck(SDL_FALSE, "SDL_crc32(0x%.8" SDL_PRIX32 ", data + %d, %d) gave the wrong result 0x%.8" SDL_PRIX32, seed, (int)offset, (int)len, crc32);
+                SDL_free(data);
+                return TEST_COMPLETED;
+            }
+            crc16 = SDL_crc16((Uint16)seed, data + offset, len);
+            if (crc16 != reference_crc16((Uint16)seed, data + offset, len)) {
+                SDLTest_AssertCheck(SDL_FALSE, "SDL_crc16(0x%.4X, data + %d, %d) gave the wrong result 0x%.4X", (Uint16)seed, (int)offset, (int)len, crc16);
+                SDL_free(data);
+                return TEST_COMPLETED;
+            }
+        }
+    }
+    SDLTest_AssertPass("SDL_crc32 and SDL_crc16 match the reference for lengths 0 to 1099");
+
+    /* A CRC done in pieces has to match the CRC done at once */
+    crc32 = 0;
+    crc16 = 0;
+    for (i = 0; i < size; i += len) {
+        len = (size_t)SDLTest_RandomIntegerInRange(1, 5000);
+        len = SDL_min(size - i, len);
+        crc32 = SDL_crc32(crc32, data + i, len);
+        crc16 = SDL_crc16(crc16, data + i, len);
+    }
+    SDLTest_AssertCheck(crc32 == reference_crc32(0, data, size), "SDL_crc32 in pieces, expected 0x%.8" SDL_PRIX32 ", got 0x%.8" SDL_PRIX32, reference_crc32(0, data, size), crc32);
+    SDLTest_AssertCheck(crc16 == reference_crc16(0, data, size), "SDL_crc16 in pieces, expected 0x%.4X, got 0x%.4X", reference_crc16(0, data, size), crc16);
+
+    SDL_free(data);
+
+    return TEST_COMPLETED;
+}
+
+static size_t reference_utf8strlen(const char *str)
+{
+    size_t count = 0;
+    for (; *str; ++str) {
+        if ((*str & 0xC0) != 0x80) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+/**
+ * Call to SDL_utf8strlen, SDL_strlen and SDL_strchr on strings of every alignment
+ */
+static int stdlib_utf8strlen(void *arg)
+{
+    const char *text = "\x48\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80!";
+    char buffer[256];
+    size_t i, len, offset, expected;
+
+    expected = SDL_utf8strlen(text);
+    SDLTest_AssertCheck(expected == 5, "SDL_utf8strlen(\"%s\"), expected 5, got %d", text, (int)expected);
+    expected = SDL_utf8strlen("");
+    SDLTest_AssertCheck(expected == 0, "SDL_utf8strlen(\"\"), expected 0, got %d", (int)expected);
+
+    /* Every length and alignment around the block sizes, with bytes after the terminator */
+    for (offset = 0; offset < 32; ++offset) {
+        for (len = 0; len < 200; ++len) {
+            char *str = buffer + offset;
+            for (i = 0; i < sizeof(buffer); ++i) {
+                buffer[i] = (char)SDLTest_RandomIntegerInRange(1, 255);
+            }
+            str[len] = '\0';
+
+            if (SDL_strlen(str) != len) {
+                SDLTest_AssertCheck(SDL_FALSE, "SDL_strlen(buffer + %d), expected %d, got %d", (int)offset, (int)len, (int)SDL_strlen(str));
+                return TEST_COMPLETED;
+            }
+            expected = reference_utf8strlen(str);
+            if (SDL_utf8strlen(str) != expected) {
+                SDLTest_AssertCheck(SDL_FALSE, "SDL_utf8strlen(buffer + %d) with %d bytes, expected %d, got %d", (int)offset, (int)len, (int)expected, (int)SDL_utf8strlen(str));
+                return TEST_COMPLETED;
+            }
+            if (SDL_strchr(str, '\0') != str + len) {
+                SDLTest_AssertCheck(SDL_FALSE, "SDL_strchr(buffer + %d, '\\0') didn't find the terminator at %d", (int)offset, (int)len);
+                return TEST_COMPLETED;
+            }
+            if (len > 0) {
+                const char c = str[len - 1];
+                for (i = 0; str[i] != c; ++i) {
+                }
+                if (SDL_strchr(str, (unsigned char)c) != str + i) {
+                    SDLTest_AssertCheck(SDL_FALSE, "SDL_strchr(buffer + %d, 0x%.2X) didn't find the first match at %d", (int)offset, (unsigned char)c, (int)i);
+                    return TEST_COMPLETED;
+                }
+            }
+        }
+    }
+    SDLTest_AssertPass("SDL_strlen, SDL_utf8strlen and SDL_strchr match the reference for lengths 0 to 199");
+
+    return TEST_COMPLETED;
+}
+
 typedef struct
 {
     size_t a;
@@ -1058,6 +1785,34 @@ static const SDLTest_TestCaseReference stdlibTest8 = {
     stdlib_aligned_alloc, "stdlib_aligned_alloc", "Call to SDL_aligned_alloc", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference stdlibTest9 = {
+    stdlib_crc, "stdlib_crc", "Call to SDL_crc32 and SDL_crc16", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference stdlibTest10 = {
+    stdlib_utf8strlen, "stdlib_utf8strlen", "Call to SDL_utf8strlen, SDL_strlen and SDL_strchr", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference stdlibTest11 = {
+    stdlib_memory_stats, "stdlib_memory_stats", "Call to SDL_GetMemoryStats", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference stdlibTest12 = {
+    stdlib_qsort_r, "stdlib_qsort_r", "Call to SDL_qsort_r and SDL_bsearch_r", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference stdlibTest13 = {
+    stdlib_parallel_sort, "stdlib_parallel_sort", "Call to SDL_ParallelSort", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference stdlibTest14 = {
+    stdlib_radix_sort, "stdlib_radix_sort", "Call to SDL_RadixSort", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference stdlibTest15 = {
+    stdlib_iconv, "stdlib_iconv", "Call to SDL_iconv and SDL_iconv_string", TEST_ENABLED
+};
+
 static const SDLTest_TestCaseReference stdlibTestOverflow = {
     stdlib_overflow, "stdlib_overflow", "Overflow detection", TEST_ENABLED
 };
@@ -1072,6 +1827,13 @@ static const SDLTest_TestCaseReference *stdlibTests[] = {
     &stdlibTest6,
     &stdlibTest7,
     &stdlibTest8,
+    &stdlibTest9,
+    &stdlibTest10,
+    &stdlibTest11,
+    &stdlibTest12,
+    &stdlibTest13,
+    &stdlibTest14,
+    &stdlibTest15,
     &stdlibTestOverflow,
     NULL
 };
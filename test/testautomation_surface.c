@@ -849,6 +849,295 @@ static int surface_testFlip(void *arg)
     return TEST_COMPLETED;
 }
 
+static int surface_testFlipFormats(void *arg)
+{
+    const Uint32 formats[] = {
+        SDL_PIXELFORMAT_INDEX8, SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_RGB24, SDL_PIXELFORMAT_ARGB8888,
+        SDL_PIXELFORMAT_RGB48, SDL_PIXELFORMAT_RGBA64, SDL_PIXELFORMAT_BGR96_FLOAT, SDL_PIXELFORMAT_RGBA128_FLOAT
+    };
+    const int widths[] = { 1, 2, 5, 16, 17, 33, 64, 71 };
+    SDL_Surface *surface, *original;
+    const Uint8 *a, *b;
+    int i, j, k, x, y, bpp, mismatches;
+
+    for (i = 0; i < SDL_arraysize(formats); ++i) {
+        for (j = 0; j < SDL_arraysize(widths); ++j) {
+            surface = SDL_CreateSurface(widths[j], 3, formats[i]);
+            SDLTest_AssertCheck(surface != NULL, "SDL_CreateSurface(%d, 3, %s)", widths[j], SDL_GetPixelFormatName(formats[i]));
+            if (!surface) {
+                continue;
+            }
+            for (k = 0; k < surface->pitch * surface->h; ++k) {
+                ((Uint8 *)surface->pixels)[k] = (Uint8)SDLTest_RandomUint8();
+            }
+            /* Copy the bytes directly, converting would change random float values and needs a palette */
+            original = SDL_CreateSurface(widths[j], 3, formats[i]);
+            SDLTest_AssertCheck(original != NULL, "SDL_CreateSurface(%d, 3, %s)", widths[j], SDL_GetPixelFormatName(formats[i]));
+            if (!original) {
+                SDL_DestroySurface(surface);
+                continue;
+            }
+            SDL_memcpy(original->pixels, surface->pixels, (size_t)surface->pitch * surface->h);
+            bpp = surface->format->bytes_per_pixel;
+
+            CHECK_FUNC(SDL_FlipSurface, (surface, SDL_FLIP_HORIZONTAL));
+            mismatches = 0;
+            for (y = 0; y < surface->h; ++y) {
+                for (x = 0; x < surface->w; ++x) {
+                    a = (const Uint8 *)surface->pixels + y * surface->pitch + x * bpp;
+                    b = (const Uint8 *)original->pixels + y * original->pitch + (surface->w - 1 - x) * bpp;
+                    if (SDL_memcmp(a, b, bpp) != 0) {
+                        ++mismatches;
+                    }
+                }
+            }
+            SDLTest_AssertCheck(mismatches == 0, "Flipped %s with width %d horizontally, expected 0 mismatches, got %d", SDL_GetPixelFormatName(formats[i]), widths[j], mismatches);
+
+            CHECK_FUNC(SDL_FlipSurface, (surface, SDL_FLIP_VERTICAL));
+            mismatches = 0;
+            for (y = 0; y < surface->h; ++y) {
+                a = (const Uint8 *)surface->pixels + y * surface->pitch;
+                b = (const Uint8 *)original->pixels + (surface->h - 1 - y) * original->pitch;
+                for (x = 0; x < surface->w; ++x) {
+                    if (SDL_memcmp(a + x * bpp, b + (surface->w - 1 - x) * bpp, bpp) != 0) {
+                        ++mismatches;
+                    }
+                }
+            }
+            SDLTest_AssertCheck(mismatches == 0, "Flipped %s with width %d vertically, expected 0 mismatches, got %d", SDL_GetPixelFormatName(formats[i]), widths[j], mismatches);
+
+            SDL_DestroySurface(original);
+            SDL_DestroySurface(surface);
+        }
+    }
+
+    return TEST_COMPLETED;
+}
+
+static int surface_testConvertPixelsFlipped(void *arg)
+{
+    const Uint32 formats[] = {
+        SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_RGB24,
+        SDL_PIXELFORMAT_XRGB2101010, SDL_PIXELFORMAT_RGBA64_FLOAT
+    };
+    const int w = 7, h = 5;
+    Uint32 src[7 * 5];
+    Uint8 expected[7 * 5 * 8], flipped[7 * 5 * 8];
+    int i, y, ret, pitch;
+
+    for (i = 0; i < w * h; ++i) {
+        src[i] = (Uint32)i * 0x9E3779B9;
+    }
+
+    for (i = 0; i < SDL_arraysize(formats); ++i) {
+        pitch = w * SDL_BYTESPERPIXEL(formats[i]);
+        SDL_ConvertPixels(w, h, SDL_PIXELFORMAT_XBGR8888, src, w * 4, formats[i], expected, pitch);
+        for (y = 0; y < h / 2; ++y) {
+            SDL_memcpy(flipped, &expected[y * pitch], pitch);
+            SDL_memcpy(&expected[y * pitch], &expected[(h - 1 - y) * pitch], pitch);
+            SDL_memcpy(&expected[(h - 1 - y) * pitch], flipped, pitch);
+        }
+
+        ret = SDL_ConvertPixels(w, h, SDL_PIXELFORMAT_XBGR8888, &src[(h - 1) * w], -w * 4, formats[i], flipped, pitch);
+        SDLTest_AssertCheck(ret == 0, "Convert XBGR8888 to %s with a negative pitch, expected 0, got %d", SDL_GetPixelFormatName(formats[i]), ret);
+        SDLTest_AssertCheck(SDL_memcmp(expected, flipped, (size_t)pitch * h) == 0, "Converted XBGR8888 to %s flipped vertically", SDL_GetPixelFormatName(formats[i]));
+    }
+
+    /* The same format is copied, flipped */
+    SDL_ConvertPixels(w, h, SDL_PIXELFORMAT_XBGR8888, &src[(h - 1) * w], -w * 4, SDL_PIXELFORMAT_XBGR8888, flipped, w * 4);
+    SDLTest_AssertCheck(SDL_memcmp(&src[(h - 1) * w], flipped, w * 4) == 0, "Copied XBGR8888 flipped vertically");
+
+    ret = SDL_ConvertPixels(w, h, SDL_PIXELFORMAT_XBGR8888, &src[(h - 1) * w], -w * 4, SDL_PIXELFORMAT_NV12, flipped, w);
+    SDLTest_AssertCheck(ret < 0, "Convert XBGR8888 to NV12 with a negative pitch, expected failure, got %d", ret);
+
+    return TEST_COMPLETED;
+}
+
+static int surface_testFloatRoundTrip(void *arg)
+{
+    const int w = 1024, h = 1;
+    Uint32 src[1024], dst[1024];
+    float *linear;
+    int i, ret, pass, mismatches, maxdiff;
+
+    linear = (float *)SDL_malloc(w * h * 4 * sizeof(float));
+    if (!linear) {
+        return TEST_ABORTED;
+    }
+
+    /* The encode tables are built by the first conversion, so go around more than once */
+    for (pass = 0; pass < 2; ++pass) {
+        /* Every 8-bit sRGB value goes through linear float and comes back unchanged */
+        for (i = 0; i < w; ++i) {
+            src[i] = 0xFF000000 | ((Uint32)(i & 0xFF) << 16) | ((Uint32)(255 - (i & 0xFF)) << 8) | (Uint32)((i * 7) & 0xFF);
+        }
+        ret = SDL_ConvertPixelsAndColorspace(w, h, SDL_PIXELFORMAT_ARGB8888, SDL_COLORSPACE_SRGB, 0, src, w * 4,
+                                             SDL_PIXELFORMAT_RGBA128_FLOAT, SDL_COLORSPACE_SRGB_LINEAR, 0, linear, w * 16);
+        SDLTest_AssertCheck(ret == 0, "Convert ARGB8888 to linear RGBA128_FLOAT, expected 0, got %d", ret);
+        ret = SDL_ConvertPixelsAndColorspace(w, h, SDL_PIXELFORMAT_RGBA128_FLOAT, SDL_COLORSPACE_SRGB_LINEAR, 0, linear, w * 16,
+                                             SDL_PIXELFORMAT_ARGB8888, SDL_COLORSPACE_SRGB, 0, dst, w * 4);
+        SDLTest_AssertCheck(ret == 0, "Convert linear RGBA128_FLOAT to ARGB8888, expected 0, got %d", ret);
+        mismatches = 0;
+        for (i = 0; i < w; ++i) {
+            if (dst[i] != src[i]) {
+                ++mismatches;
+            }
+        }
+        SDLTest_AssertCheck(mismatches == 0, "Round trip of ARGB8888 through linear float, expected 0 mismatches, got %d", mismatches);
+
+        /* Every 10-bit PQ gray level comes back within one code. Saturated BT.2020 colors
+           are outside of the sRGB primaries and would be clipped on the way. */
+        for (i = 0; i < w; ++i) {
+            src[i] = 0xC0000000 | ((Uint32)i << 20) | ((Uint32)i << 10) | (Uint32)i;
+        }
+        ret = SDL_ConvertPixelsAndColorspace(w, h, SDL_PIXELFORMAT_XRGB2101010, SDL_COLORSPACE_HDR10, 0, src, w * 4,
+                                             SDL_PIXELFORMAT_RGBA128_FLOAT, SDL_COLORSPACE_SRGB_LINEAR, 0, linear, w * 16);
+        SDLTest_AssertCheck(ret == 0, "Convert XRGB2101010 to linear RGBA128_FLOAT, expected 0, got %d", ret);
+        ret = SDL_ConvertPixelsAndColorspace(w, h, SDL_PIXELFORMAT_RGBA128_FLOAT, SDL_COLORSPACE_SRGB_LINEAR, 0, linear, w * 16,
+                                             SDL_PIXELFORMAT_XRGB2101010, SDL_COLORSPACE_HDR10, 0, dst, w * 4);
+        SDLTest_AssertCheck(ret == 0, "Convert linear RGBA128_FLOAT to XRGB2101010, expected 0, got %d", ret);
+        maxdiff = 0;
+        for (i = 0; i < w; ++i) {
+            int c;
+            for (c = 0; c < 30; c += 10) {
+                const int diff = SDL_abs((int)((dst[i] >> c) & 0x3FF) - (int)((src[i] >> c) & 0x3FF));
+                maxdiff = SDL_max(maxdiff, diff);
+            }
+        }
+        SDLTest_AssertCheck(maxdiff <= 1, "Round trip of XRGB2101010 through linear float, expected a difference of at most 1, got %d", maxdiff);
+    }
+
+    SDL_free(linear);
+    return TEST_COMPLETED;
+}
+
+static int surface_testPremultiplyAlpha(void *arg)
+{
+    const Uint32 formats[] = {
+        SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGRA8888
+    };
+    const int w = 67, h = 3; /* odd width, to cover both the vectorized and the leftover pixels */
+    SDL_PixelFormat *src_fmt, *dst_fmt;
+    Uint32 src[67 * 3], dst[67 * 3], premultiplied[67 * 3];
+    Uint8 r, g, b, a, r2, g2, b2, a2, pr, pg, pb, pa;
+    int i, j, k, ret, mismatches, tolerance, maxdiff;
+
+    for (i = 0; i < SDL_arraysize(formats); ++i) {
+        src_fmt = SDL_CreatePixelFormat(formats[i]);
+        for (k = 0; k < w * h; ++k) {
+            src[k] = SDL_MapRGBA(src_fmt, (Uint8)(k * 37), (Uint8)(k * 11), (Uint8)(255 - k), (Uint8)((k % 5) ? k * 3 : 255));
+        }
+
+        for (j = 0; j < SDL_arraysize(formats); ++j) {
+            dst_fmt = SDL_CreatePixelFormat(formats[j]);
+
+            ret = SDL_PremultiplyAlpha(w, h, formats[i], src, w * 4, formats[j], dst, w * 4);
+            SDLTest_AssertCheck(ret == 0, "SDL_PremultiplyAlpha(%s, %s), expected 0, got %d", SDL_GetPixelFormatName(formats[i]), SDL_GetPixelFormatName(formats[j]), ret);
+            mismatches = 0;
+            for (k = 0; k < w * h; ++k) {
+                SDL_GetRGBA(src[k], src_fmt, &r, &g, &b, &a);
+                SDL_GetRGBA(dst[k], dst_fmt, &r2, &g2, &b2, &a2);
+                if (a2 != a || r2 != (r * a + 127) / 255 || g2 != (g * a + 127) / 255 || b2 != (b * a + 127) / 255) {
+                    ++mismatches;
+                }
+            }
+            SDLTest_AssertCheck(mismatches == 0, "Premultiplied %s to %s, expected 0 mismatches, got %d", SDL_GetPixelFormatName(formats[i]), SDL_GetPixelFormatName(formats[j]), mismatches);
+
+            /* Opaque pixels round trip exactly, transparent ones become black */
+            SDL_memcpy(premultiplied, dst, sizeof(dst));
+            ret = SDL_UnpremultiplyAlpha(w, h, formats[j], dst, w * 4, formats[j], dst, w * 4);
+            SDLTest_AssertCheck(ret == 0, "SDL_UnpremultiplyAlpha(%s) in place, expected 0, got %d", SDL_GetPixelFormatName(formats[j]), ret);
+            mismatches = 0;
+            maxdiff = 0;
+            for (k = 0; k < w * h; ++k) {
+                SDL_GetRGBA(src[k], src_fmt, &r, &g, &b, &a);
+                SDL_GetRGBA(premultiplied[k], dst_fmt, &pr, &pg, &pb, &pa);
+                SDL_GetRGBA(dst[k], dst_fmt, &r2, &g2, &b2, &a2);
+                if (a2 != a || (a == 255 && (r2 != r || g2 != g || b2 != b)) || (a == 0 && (r2 | g2 | b2))) {
+                    ++mismatches;
+                } else if (a != 0 && a != 255) {
+                    /* Partial alpha matches the scalar formula on the premultiplied color exactly */
+                    if (r2 != SDL_min((pr * 255 + a / 2) / a, 255) ||
+                        g2 != SDL_min((pg * 255 + a / 2) / a, 255) ||
+                        b2 != SDL_min((pb * 255 + a / 2) / a, 255)) {
+                        ++mismatches;
+                    }
+                    /* and is within the rounding of premultiplying, 127.5 / a + 0.5, of the original */
+                    tolerance = 128 / a + 1;
+                    maxdiff = SDL_max(maxdiff, SDL_abs(r2 - r) - tolerance);
+                    maxdiff = SDL_max(maxdiff, SDL_abs(g2 - g) - tolerance);
+                    maxdiff = SDL_max(maxdiff, SDL_abs(b2 - b) - tolerance);
+                }
+            }
+            SDLTest_AssertCheck(mismatches == 0, "Unpremultiplied %s, expected 0 mismatches, got %d", SDL_GetPixelFormatName(formats[j]), mismatches);
+            SDLTest_AssertCheck(maxdiff == 0, "Unpremultiplied %s, expected to be within 128 / alpha + 1 of the original, got %d more", SDL_GetPixelFormatName(formats[j]), maxdiff);
+
+            SDL_DestroyPixelFormat(dst_fmt);
+        }
+
+        /* In place gives the same result as a copy */
+        SDL_PremultiplyAlpha(w, h, formats[i], src, w * 4, formats[i], dst, w * 4);
+        SDL_PremultiplyAlpha(w, h, formats[i], src, w * 4, formats[i], src, w * 4);
+        SDLTest_AssertCheck(SDL_memcmp(src, dst, sizeof(src)) == 0, "Premultiplied %s in place", SDL_GetPixelFormatName(formats[i]));
+
+        SDL_DestroyPixelFormat(src_fmt);
+    }
+
+    ret = SDL_PremultiplyAlpha(w, h, SDL_PIXELFORMAT_XRGB8888, src, w * 4, SDL_PIXELFORMAT_ARGB8888, dst, w * 4);
+    SDLTest_AssertCheck(ret < 0, "SDL_PremultiplyAlpha() without an alpha channel, expected failure, got %d", ret);
+
+    return TEST_COMPLETED;
+}
+
+static int surface_testConvertPixelsTiles(void *arg)
+{
+    const Uint32 formats[] = {
+        SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGRA8888,
+        SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_ARGB1555, SDL_PIXELFORMAT_RGBA4444, SDL_PIXELFORMAT_RGB24,
+        SDL_PIXELFORMAT_BGR24, SDL_PIXELFORMAT_XRGB2101010, SDL_PIXELFORMAT_RGBA64, SDL_PIXELFORMAT_RGBA64_FLOAT
+    };
+    const int w = 32, h = 16, tile_w = 8, tile_h = 4;
+    Uint32 src[32 * 16];
+    Uint8 whole[32 * 16 * 8], tiled[32 * 16 * 8];
+    SDL_PropertiesID props;
+    int i, x, y, ret, bpp, pitch;
+
+    for (i = 0; i < w * h; ++i) {
+        src[i] = (Uint32)i * 0x9E3779B9;
+    }
+    props = SDL_CreateProperties();
+
+    /* Go through more format pairs than the conversion cache holds, twice */
+    for (i = 0; i < 2 * SDL_arraysize(formats); ++i) {
+        const Uint32 format = formats[i % SDL_arraysize(formats)];
+
+        bpp = SDL_BYTESPERPIXEL(format);
+        pitch = w * bpp;
+        SDL_memset(whole, 0, sizeof(whole));
+        SDL_memset(tiled, 0xCC, sizeof(tiled));
+
+        /* Converting with properties doesn't use a cached conversion */
+        ret = SDL_ConvertPixelsAndColorspace(w, h, SDL_PIXELFORMAT_ARGB8888, SDL_COLORSPACE_UNKNOWN, props, src, w * 4, format, SDL_COLORSPACE_UNKNOWN, 0, whole, pitch);
+        SDLTest_AssertCheck(ret == 0, "Convert ARGB8888 to %s, expected 0, got %d", SDL_GetPixelFormatName(format), ret);
+
+        for (y = 0; y < h; y += tile_h) {
+            for (x = 0; x < w; x += tile_w) {
+                ret = SDL_ConvertPixels(tile_w, tile_h, SDL_PIXELFORMAT_ARGB8888, &src[y * w + x], w * 4, format, &tiled[y * pitch + x * bpp], pitch);
+                if (ret < 0) {
+                    break;
+                }
+            }
+        }
+        SDLTest_AssertCheck(ret == 0, "Convert ARGB8888 tiles to %s, expected 0, got %d", SDL_GetPixelFormatName(format), ret);
+        SDLTest_AssertCheck(SDL_memcmp(whole, tiled, (size_t)pitch * h) == 0, "Tiled conversion to %s matches the whole image", SDL_GetPixelFormatName(format));
+    }
+    SDL_DestroyProperties(props);
+
+    ret = SDL_ConvertPixels(w, h, SDL_PIXELFORMAT_ARGB8888, src, w * 4, SDL_PIXELFORMAT_INDEX8, whole, w);
+    SDLTest_AssertCheck(ret < 0, "Convert ARGB8888 to INDEX8, expected failure, got %d", ret);
+
+    return TEST_COMPLETED;
+}
 
 /* ================= Test References ================== */
 
@@ -912,11 +1201,33 @@ static const SDLTest_TestCaseReference surfaceTestFlip = {
     surface_testFlip, "surface_testFlip", "Test surface flipping.", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference surfaceTestFlipFormats = {
+    surface_testFlipFormats, "surface_testFlipFormats", "Test surface flipping across pixel sizes.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestConvertPixelsFlipped = {
+    surface_testConvertPixelsFlipped, "surface_testConvertPixelsFlipped", "Test pixel conversion with a negative source pitch.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestFloatRoundTrip = {
+    surface_testFloatRoundTrip, "surface_testFloatRoundTrip", "Test pixel conversion through linear float and back.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestPremultiplyAlpha = {
+    surface_testPremultiplyAlpha, "surface_testPremultiplyAlpha", "Test alpha premultiplication.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestConvertPixelsTiles = {
+    surface_testConvertPixelsTiles, "surface_testConvertPixelsTiles", "Test repeated pixel conversion of small tiles.", TEST_ENABLED
+};
+
 /* Sequence of Surface test cases */
 static const SDLTest_TestCaseReference *surfaceTests[] = {
     &surfaceTest1, &surfaceTest2, &surfaceTest3, &surfaceTest4, &surfaceTest5,
     &surfaceTest6, &surfaceTest7, &surfaceTest8, &surfaceTest9, &surfaceTest10,
-    &surfaceTest11, &surfaceTest12, &surfaceTestOverflow, &surfaceTestFlip, NULL
+    &surfaceTest11, &surfaceTest12, &surfaceTestOverflow, &surfaceTestFlip,
+    &surfaceTestFlipFormats, &surfaceTestConvertPixelsFlipped, &surfaceTestFloatRoundTrip,
+    &surfaceTestPremultiplyAlpha, &surfaceTestConvertPixelsTiles, NULL
 };
 
 /* Surface test suite (global) */
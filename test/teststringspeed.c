@@ -0,0 +1,192 @@
+/*
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Compares the speed of SDL's string and memory functions against the C
+   runtime. When SDL is built with the C runtime most of these simply call
+   into it, so this is mostly interesting for builds with SDL_LIBC=OFF. */
+
+/* We want the real SDL_memcpy, not the compiler builtin */
+#define SDL_SLOW_MEMCPY
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#include <string.h>
+
+#define BUFFER_SIZE (1024 * 1024)
+
+static const size_t sizes[] = { 15, 64, 256, 4096, BUFFER_SIZE - 64 };
+
+static char *source;
+static char *target;
+static volatile size_t sink;
+
+typedef size_t (*StringFunc)(const char *str, size_t len);
+
+static size_t sdl_strlen(const char *str, size_t len)
+{
+    return SDL_strlen(str);
+}
+
+static size_t libc_strlen(const char *str, size_t len)
+{
+    return strlen(str);
+}
+
+static size_t sdl_strchr(const char *str, size_t len)
+{
+    return (size_t)(SDL_strchr(str, '!') - str);
+}
+
+static size_t libc_strchr(const char *str, size_t len)
+{
+    return (size_t)(strchr(str, '!') - str);
+}
+
+static size_t sdl_memcmp(const char *str, size_t len)
+{
+    return (size_t)(SDL_memcmp(str, target, len) < 0);
+}
+
+static size_t libc_memcmp(const char *str, size_t len)
+{
+    return (size_t)(memcmp(str, target, len) < 0);
+}
+
+static size_t sdl_memcpy(const char *str, size_t len)
+{
+    SDL_memcpy(target, str, len);
+    return (size_t)target[len - 1];
+}
+
+static size_t libc_memcpy(const char *str, size_t len)
+{
+    memcpy(target, str, len);
+    return (size_t)target[len - 1];
+}
+
+static size_t sdl_utf8strlen(const char *str, size_t len)
+{
+    return SDL_utf8strlen(str);
+}
+
+static size_t bytewise_utf8strlen(const char *str, size_t len)
+{
+    size_t count = 0;
+    for (; *str; ++str) {
+        if ((*str & 0xC0) != 0x80) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+/* Returns the average time in nanoseconds per call */
+static double time_function(StringFunc func, const char *str, size_t len, size_t *result)
+{
+    const Uint64 frequency = SDL_GetPerformanceFrequency();
+    const int iterations = (int)SDL_max(16, (64 * 1024 * 1024) / (len + 16));
+    Uint64 start, elapsed;
+    int i;
+
+    *result = func(str, len);
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < iterations; ++i) {
+        sink = func(str, len);
+    }
+    elapsed = SDL_GetPerformanceCounter() - start;
+
+    return ((double)elapsed * 1e9) / ((double)frequency * iterations);
+}
+
+static SDL_bool compare(const char *name, const char *other, StringFunc sdlfunc, StringFunc otherfunc)
+{
+    SDL_bool success = SDL_TRUE;
+    size_t i;
+
+    for (i = 0; i < SDL_arraysize(sizes); ++i) {
+        const size_t len = sizes[i];
+        const char *str = source + 1; /* deliberately misaligned */
+        size_t sdlresult, otherresult;
+        double sdltime, othertime;
+
+        /* Every function scans to the end of the string, which has the only '!' */
+        SDL_memcpy(target, str, len);
+        target[len - 1] = '\x7f';
+        source[1 + len - 1] = '!';
+        source[1 + len] = '\0';
+
+        sdltime = time_function(sdlfunc, str, len, &sdlresult);
+        othertime = time_function(otherfunc, str, len, &otherresult);
+
+        source[1 + len - 1] = 'x';
+        source[1 + len] = 'x';
+
+        SDL_Log("%-14s %8d bytes: %10.1f ns (%7.2f GB/s), %-20s %10.1f ns (%7.2f GB/s)",
+                name, (int)len,
+                sdltime, (double)len / sdltime,
+                other, othertime, (double)len / othertime);
+
+        if (sdlresult != otherresult) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s returned %d for %d bytes, %s returned %d",
+                         name, (int)sdlresult, (int)len, other, (int)otherresult);
+            success = SDL_FALSE;
+        }
+    }
+    return success;
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    SDL_bool success = SDL_TRUE;
+    int i;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    if (!SDLTest_CommonDefaultArgs(state, argc, argv)) {
+        return 1;
+    }
+
+    source = (char *)SDL_malloc(BUFFER_SIZE + 16);
+    target = (char *)SDL_malloc(BUFFER_SIZE + 16);
+    if (!source || !target) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory");
+        return 1;
+    }
+
+    /* Mostly ASCII text with some multibyte sequences, and no '!' */
+    for (i = 0; i < BUFFER_SIZE + 16; ++i) {
+        static const char text[] = "The quick brown fox jumps over the lazy dog. \xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80 ";
+        source[i] = text[i % (sizeof(text) - 1)];
+    }
+
+    success &= compare("SDL_strlen", "strlen", sdl_strlen, libc_strlen);
+    success &= compare("SDL_strchr", "strchr", sdl_strchr, libc_strchr);
+    success &= compare("SDL_memcmp", "memcmp", sdl_memcmp, libc_memcmp);
+    success &= compare("SDL_memcpy", "memcpy", sdl_memcpy, libc_memcpy);
+    success &= compare("SDL_utf8strlen", "byte loop", sdl_utf8strlen, bytewise_utf8strlen);
+
+    SDL_free(source);
+    SDL_free(target);
+
+    SDLTest_CommonDestroyState(state);
+
+    return success ? 0 : 1;
+}
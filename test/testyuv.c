@@ -65,6 +65,30 @@ static SDL_Surface *generate_test_pattern(int pattern_size)
     return pattern;
 }
 
+/* Widen NV12 data to P010, the U/V rows are rounded up to whole U/V pairs like NV12 */
+static void convert_nv12_to_p010(int w, int h, const Uint8 *nv12, int nv12_pitch, Uint8 *p010, int p010_pitch)
+{
+    const int uv_width = ((w + 1) / 2) * 2;
+    const int nv12_uv_pitch = ((nv12_pitch + 1) / 2) * 2;
+    const int p010_uv_pitch = ((p010_pitch / 2 + 1) / 2) * 4;
+    const Uint8 *nv12_uv = nv12 + nv12_pitch * h;
+    Uint8 *p010_uv = p010 + p010_pitch * h;
+    int x, y;
+
+    for (y = 0; y < h; ++y) {
+        Uint16 *dst = (Uint16 *)(p010 + y * p010_pitch);
+        for (x = 0; x < w; ++x) {
+            dst[x] = (Uint16)(nv12[y * nv12_pitch + x] << 8);
+        }
+    }
+    for (y = 0; y < (h + 1) / 2; ++y) {
+        Uint16 *dst = (Uint16 *)(p010_uv + y * p010_uv_pitch);
+        for (x = 0; x < uv_width; ++x) {
+            dst[x] = (Uint16)(nv12_uv[y * nv12_uv_pitch + x] << 8);
+        }
+    }
+}
+
 static SDL_bool verify_yuv_data(Uint32 format, SDL_Colorspace colorspace, const Uint8 *yuv, int yuv_pitch, SDL_Surface *surface)
 {
     const int tolerance = 20;
@@ -127,11 +151,13 @@ static int run_automated_tests(int pattern_size, int extra_pitch)
     Uint8 *yuv1 = (Uint8 *)SDL_malloc(yuv_len);
     Uint8 *yuv2 = (Uint8 *)SDL_malloc(yuv_len);
     int yuv1_pitch, yuv2_pitch;
+    const int p010_pitch = (pattern ? pattern->w : 0) * 2 + extra_pitch * 2;
+    Uint8 *p010 = (Uint8 *)SDL_malloc(p010_pitch * (pattern ? pattern->h + 1 : 0) * 2);
     YUV_CONVERSION_MODE mode;
     SDL_Colorspace colorspace;
     int result = -1;
 
-    if (!pattern || !yuv1 || !yuv2) {
+    if (!pattern || !yuv1 || !yuv2 || !p010) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't allocate test surfaces");
         goto done;
     }
@@ -211,9 +237,30 @@ static int run_automated_tests(int pattern_size, int extra_pitch)
         }
     }
 
+    /* Verify conversion from P010 to RGB and NV12, using NV12 data widened to 10 bits */
+    if (!ConvertRGBtoYUV(SDL_PIXELFORMAT_NV12, pattern->pixels, pattern->pitch, yuv1, pattern->w, pattern->h, mode, 0, 100)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "ConvertRGBtoYUV() doesn't support converting to %s\n", SDL_GetPixelFormatName(SDL_PIXELFORMAT_NV12));
+        goto done;
+    }
+    yuv1_pitch = CalculateYUVPitch(SDL_PIXELFORMAT_NV12, pattern->w);
+    convert_nv12_to_p010(pattern->w, pattern->h, yuv1, yuv1_pitch, p010, p010_pitch);
+    if (!verify_yuv_data(SDL_PIXELFORMAT_P010, colorspace, p010, p010_pitch, pattern)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed conversion from %s to RGB\n", SDL_GetPixelFormatName(SDL_PIXELFORMAT_P010));
+        goto done;
+    }
+    if (SDL_ConvertPixelsAndColorspace(pattern->w, pattern->h, SDL_PIXELFORMAT_P010, colorspace, 0, p010, p010_pitch, SDL_PIXELFORMAT_NV12, colorspace, 0, yuv2, yuv1_pitch) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't convert %s to %s: %s\n", SDL_GetPixelFormatName(SDL_PIXELFORMAT_P010), SDL_GetPixelFormatName(SDL_PIXELFORMAT_NV12), SDL_GetError());
+        goto done;
+    }
+    if (SDL_memcmp(yuv1, yuv2, yuv1_pitch * pattern->h + ((yuv1_pitch + 1) / 2) * 2 * ((pattern->h + 1) / 2)) != 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed conversion from %s to %s\n", SDL_GetPixelFormatName(SDL_PIXELFORMAT_P010), SDL_GetPixelFormatName(SDL_PIXELFORMAT_NV12));
+        goto done;
+    }
+
     result = 0;
 
 done:
+    SDL_free(p010);
     SDL_free(yuv1);
     SDL_free(yuv2);
     SDL_DestroySurface(pattern);